@@ -0,0 +1,268 @@
+#ifndef SLANG_CPP_GROUP_FIBER_H
+#define SLANG_CPP_GROUP_FIBER_H
+
+// Support for executing the threads of a compute thread group as fibers.
+//
+// Normally the threads of a group are executed one after another. That doesn't work if the kernel
+// synchronizes the threads of a group with a barrier (such as `GroupMemoryBarrierWithGroupSync`),
+// because all threads must reach the barrier before any may continue. When the generated code
+// uses such a barrier, the emitter defines `SLANG_PRELUDE_ENABLE_GROUP_FIBERS`, and each thread
+// of a group runs on its own fiber. At a barrier a fiber yields back to the group scheduler, which
+// resumes the fibers once all of them have reached the barrier.
+
+#ifdef SLANG_PRELUDE_ENABLE_GROUP_FIBERS
+
+#ifdef SLANG_LLVM
+#   error "Thread group synchronization is not supported when compiling with slang-llvm"
+#endif
+
+#if SLANG_WINDOWS_FAMILY
+#   ifndef WIN32_LEAN_AND_MEAN
+#       define WIN32_LEAN_AND_MEAN
+#   endif
+#   ifndef NOMINMAX
+#       define NOMINMAX
+#   endif
+#   include <windows.h>
+#else
+#   include <ucontext.h>
+#endif
+
+// The size of the stack of each fiber. Can be defined (for example via a define passed to the
+// downstream compiler) if kernels need more stack space.
+#ifndef SLANG_PRELUDE_FIBER_STACK_SIZE
+#   define SLANG_PRELUDE_FIBER_STACK_SIZE (64 * 1024)
+#endif
+
+#ifdef SLANG_PRELUDE_NAMESPACE
+namespace SLANG_PRELUDE_NAMESPACE {
+#endif
+
+struct GroupFiberScheduler
+{
+    struct Fiber
+    {
+#if SLANG_WINDOWS_FAMILY
+        void* handle = nullptr;
+#else
+        ucontext_t context;
+#endif
+        ComputeThreadVaryingInput threadInput;
+        bool isDone = true;
+    };
+
+        /// Fibers (and their stacks) are kept for the lifetime of the OS thread, and reused for
+        /// every group executed on it.
+    ~GroupFiberScheduler()
+    {
+#if SLANG_WINDOWS_FAMILY
+        for (int i = 0; i < fiberCapacity; ++i)
+        {
+            DeleteFiber(fibers[i].handle);
+        }
+#else
+        free(stacks);
+#endif
+        delete[] fibers;
+    }
+
+    void reserve(int fiberCount)
+    {
+        if (fiberCount <= fiberCapacity)
+        {
+            return;
+        }
+#if SLANG_WINDOWS_FAMILY
+        for (int i = 0; i < fiberCapacity; ++i)
+        {
+            DeleteFiber(fibers[i].handle);
+        }
+#else
+        free(stacks);
+        stacks = (char*)malloc(size_t(fiberCount) * SLANG_PRELUDE_FIBER_STACK_SIZE);
+#endif
+        delete[] fibers;
+        fibers = new Fiber[fiberCount];
+        fiberCapacity = fiberCount;
+#if SLANG_WINDOWS_FAMILY
+        for (int i = 0; i < fiberCount; ++i)
+        {
+            fibers[i].handle = CreateFiber(SLANG_PRELUDE_FIBER_STACK_SIZE, &_fiberMain, this);
+        }
+#endif
+    }
+
+        /// Run all the threads of the group in `groupInput->groupID`, with the group size `groupSize`.
+    void run(ComputeThreadFunc inFunc, const ComputeThreadVaryingInput* groupInput, const uint32_t groupSize[3], void* inEntryPointParams, void* inGlobalParams)
+    {
+        func = inFunc;
+        entryPointParams = inEntryPointParams;
+        globalParams = inGlobalParams;
+
+        const int fiberCount = int(groupSize[0] * groupSize[1] * groupSize[2]);
+        reserve(fiberCount);
+
+        // Set up the fibers in the same order as the threads are executed without fibers, x fastest.
+        int index = 0;
+        for (uint32_t z = 0; z < groupSize[2]; ++z)
+        {
+            for (uint32_t y = 0; y < groupSize[1]; ++y)
+            {
+                for (uint32_t x = 0; x < groupSize[0]; ++x)
+                {
+                    Fiber& fiber = fibers[index];
+                    fiber.threadInput = *groupInput;
+                    fiber.threadInput.groupThreadID.x = x;
+                    fiber.threadInput.groupThreadID.y = y;
+                    fiber.threadInput.groupThreadID.z = z;
+                    fiber.isDone = false;
+#if !SLANG_WINDOWS_FAMILY
+                    getcontext(&fiber.context);
+                    fiber.context.uc_stack.ss_sp = stacks + size_t(index) * SLANG_PRELUDE_FIBER_STACK_SIZE;
+                    fiber.context.uc_stack.ss_size = SLANG_PRELUDE_FIBER_STACK_SIZE;
+                    fiber.context.uc_link = &schedulerContext;
+                    makecontext(&fiber.context, (void(*)())&_fiberMain, 0);
+#endif
+                    index++;
+                }
+            }
+        }
+
+        GroupFiberScheduler*& current = getCurrent();
+        GroupFiberScheduler* previous = current;
+        current = this;
+
+#if SLANG_WINDOWS_FAMILY
+        const bool wasFiber = IsThreadAFiber() != FALSE;
+        schedulerFiber = wasFiber ? GetCurrentFiber() : ConvertThreadToFiber(nullptr);
+#endif
+
+        // Each pass resumes every fiber that hasn't completed. A fiber runs until it either
+        // completes or reaches a barrier, so at the end of a pass all remaining fibers are waiting
+        // at the barrier, and the next pass releases them.
+        int remaining = fiberCount;
+        while (remaining > 0)
+        {
+            for (int i = 0; i < fiberCount; ++i)
+            {
+                if (fibers[i].isDone)
+                {
+                    continue;
+                }
+                currentFiber = i;
+#if SLANG_WINDOWS_FAMILY
+                SwitchToFiber(fibers[i].handle);
+#else
+                swapcontext(&schedulerContext, &fibers[i].context);
+#endif
+                remaining -= fibers[i].isDone ? 1 : 0;
+            }
+        }
+
+#if SLANG_WINDOWS_FAMILY
+        if (!wasFiber)
+        {
+            ConvertFiberToThread();
+        }
+#endif
+        current = previous;
+    }
+
+        /// Called by a fiber at a barrier. Returns once all threads of the group have reached it.
+    void yield()
+    {
+#if SLANG_WINDOWS_FAMILY
+        SwitchToFiber(schedulerFiber);
+#else
+        swapcontext(&fibers[currentFiber].context, &schedulerContext);
+#endif
+    }
+
+        /// The scheduler of the group currently executing on this OS thread (or nullptr).
+    static GroupFiberScheduler*& getCurrent()
+    {
+        static thread_local GroupFiberScheduler* current = nullptr;
+        return current;
+    }
+
+        /// The scheduler used by this OS thread.
+    static GroupFiberScheduler& getForThread()
+    {
+        static thread_local GroupFiberScheduler scheduler;
+        return scheduler;
+    }
+
+#if SLANG_WINDOWS_FAMILY
+    static void WINAPI _fiberMain(void* param)
+    {
+        GroupFiberScheduler* scheduler = (GroupFiberScheduler*)param;
+        // Windows fibers can't return, so each fiber loops, executing a thread each time it's started.
+        for (;;)
+        {
+            Fiber& fiber = scheduler->fibers[scheduler->currentFiber];
+            scheduler->func(&fiber.threadInput, scheduler->entryPointParams, scheduler->globalParams);
+            fiber.isDone = true;
+            SwitchToFiber(scheduler->schedulerFiber);
+        }
+    }
+#else
+    static void _fiberMain()
+    {
+        // Returning switches back to the scheduler through `uc_link`
+        GroupFiberScheduler* scheduler = getCurrent();
+        Fiber& fiber = scheduler->fibers[scheduler->currentFiber];
+        scheduler->func(&fiber.threadInput, scheduler->entryPointParams, scheduler->globalParams);
+        fiber.isDone = true;
+    }
+#endif
+
+    ComputeThreadFunc func = nullptr;
+    void* entryPointParams = nullptr;
+    void* globalParams = nullptr;
+
+    Fiber* fibers = nullptr;
+    int fiberCapacity = 0;
+    int currentFiber = 0;
+
+#if SLANG_WINDOWS_FAMILY
+    void* schedulerFiber = nullptr;
+#else
+    char* stacks = nullptr;
+    ucontext_t schedulerContext;
+#endif
+};
+
+// Run all of the threads of a group as fibers, such that slang_groupSync can be used.
+SLANG_FORCE_INLINE void slang_runGroupFibers(ComputeThreadFunc func, const ComputeThreadVaryingInput* groupInput, uint32_t sizeX, uint32_t sizeY, uint32_t sizeZ, void* entryPointParams, void* globalParams)
+{
+    const uint32_t groupSize[3] = { sizeX, sizeY, sizeZ };
+    GroupFiberScheduler::getForThread().run(func, groupInput, groupSize, entryPointParams, globalParams);
+}
+
+#ifdef SLANG_PRELUDE_NAMESPACE
+}
+#endif
+
+#endif // SLANG_PRELUDE_ENABLE_GROUP_FIBERS
+
+#ifdef SLANG_PRELUDE_NAMESPACE
+namespace SLANG_PRELUDE_NAMESPACE {
+#endif
+
+// Synchronizes the threads of a group. If the group isn't executing as fibers (for example when
+// a single thread is invoked via the `_Thread` entry point) there is nothing to wait for.
+SLANG_FORCE_INLINE void slang_groupSync()
+{
+#ifdef SLANG_PRELUDE_ENABLE_GROUP_FIBERS
+    if (GroupFiberScheduler* scheduler = GroupFiberScheduler::getCurrent())
+    {
+        scheduler->yield();
+    }
+#endif
+}
+
+#ifdef SLANG_PRELUDE_NAMESPACE
+}
+#endif
+
+#endif // SLANG_CPP_GROUP_FIBER_H
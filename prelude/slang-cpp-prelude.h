@@ -287,6 +287,8 @@ struct ISlangUnknown
 
 #include "slang-cpp-types.h"
 #include "slang-cpp-scalar-intrinsics.h"
+#include "slang-cpp-vector-intrinsics.h"
+#include "slang-cpp-group-fiber.h"
 
 // TODO(JS): Hack! Output C++ code from slang can copy uninitialized variables. 
 #if defined(_MSC_VER)
@@ -297,4 +299,41 @@ struct ISlangUnknown
 #   define SLANG_UNROLL
 #endif
 
+// Lane vectorization of compute kernels.
+//
+// When `SLANG_ENABLE_LANE_VECTORIZATION` is defined, the innermost loop over the threads of a group is
+// marked such that the C++ compiler may pack consecutive threads into SIMD lanes (in the style of ISPC),
+// with divergent control flow handled by the compiler through masking. The per-thread function is forced
+// inline into the loop, as that is required for the loop to be vectorized. `SLANG_LANE_COUNT` can be
+// defined to hint the number of lanes - for example 4 for SSE, 8 for AVX2, 16 for AVX-512. The
+// instruction set used is determined by the options passed to the C++ compiler.
+//
+// The loop hint only asks for vectorization, it doesn't assert that iterations are independent (as
+// `ivdep` would) - threads of a group may access the same memory, so the compiler still has to prove
+// that vectorization is safe. Compilers without such a hint rely on their auto vectorizer.
+#ifdef SLANG_ENABLE_LANE_VECTORIZATION
+#   define SLANG_LANE_STRINGIZE_IMPL(x) #x
+#   define SLANG_LANE_STRINGIZE(x) SLANG_LANE_STRINGIZE_IMPL(x)
+#   if SLANG_CLANG
+#       ifdef SLANG_LANE_COUNT
+#           define SLANG_LANE_LOOP _Pragma(SLANG_LANE_STRINGIZE(clang loop vectorize(enable) vectorize_width(SLANG_LANE_COUNT)))
+#       else
+#           define SLANG_LANE_LOOP _Pragma("clang loop vectorize(enable)")
+#       endif
+#       define SLANG_LANE_INLINE __attribute__((always_inline)) inline
+#   elif SLANG_GCC_FAMILY
+#       define SLANG_LANE_INLINE __attribute__((always_inline)) inline
+#   elif SLANG_VC
+#       define SLANG_LANE_INLINE __forceinline
+#   endif
+#endif
+
+#ifndef SLANG_LANE_LOOP
+#   define SLANG_LANE_LOOP
+#endif
+
+#ifndef SLANG_LANE_INLINE
+#   define SLANG_LANE_INLINE
+#endif
+
 #endif
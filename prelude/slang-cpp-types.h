@@ -316,8 +316,9 @@ struct RWByteAddressBuffer
     size_t sizeInBytes; //< Must be multiple of 4 
 };
 
-struct ISamplerState;
-struct ISamplerComparisonState;
+// Sampler states are opaque to generated code. They are interpreted by the `ITexture` implementation.
+struct ISamplerState {};
+struct ISamplerComparisonState {};
 
 struct SamplerState
 {
@@ -482,6 +483,10 @@ struct ITexture
     virtual void Load(const int32_t* v, void* outData, size_t dataSize) = 0;
     virtual void Sample(SamplerState samplerState, const float* loc, void* outData, size_t dataSize) = 0;
     virtual void SampleLevel(SamplerState samplerState, const float* loc, float level, void* outData, size_t dataSize) = 0;
+    virtual void SampleGrad(SamplerState samplerState, const float* loc, const float* gradX, const float* gradY, void* outData, size_t dataSize) = 0;
+        /// Sample `count` locations, each made up of as many floats as a single `SampleLevel` location.
+        /// `levels` can be nullptr to sample level 0. Results are written `dataSize` bytes apart to `outData`.
+    virtual void SampleLevelBatch(SamplerState samplerState, const float* locs, const float* levels, size_t count, void* outData, size_t dataSize) = 0;
 };
 
 template <typename T>
@@ -506,6 +511,8 @@ struct Texture1D
     T Load(const int2& loc) const { T out; texture->Load(&loc.x, &out, sizeof(out)); return out; }
     T Sample(SamplerState samplerState, float loc) const { T out; texture->Sample(samplerState, &loc, &out, sizeof(out)); return out; }
     T SampleLevel(SamplerState samplerState, float loc, float level) { T out; texture->SampleLevel(samplerState, &loc, level, &out, sizeof(out)); return out; }
+    T SampleGrad(SamplerState samplerState, float loc, float gradX, float gradY) { T out; texture->SampleGrad(samplerState, &loc, &gradX, &gradY, &out, sizeof(out)); return out; }
+    void SampleLevel(SamplerState samplerState, const float* locs, const float* levels, size_t count, T* outValues) { texture->SampleLevelBatch(samplerState, locs, levels, count, outValues, sizeof(T)); }
     
     ITexture* texture;              
 };
@@ -543,6 +550,8 @@ struct Texture2D
     T Load(const int3& loc) const { T out; texture->Load(&loc.x, &out, sizeof(out)); return out; }
     T Sample(SamplerState samplerState, const float2& loc) const { T out; texture->Sample(samplerState, &loc.x, &out, sizeof(out)); return out; }
     T SampleLevel(SamplerState samplerState, const float2& loc, float level) { T out; texture->SampleLevel(samplerState, &loc.x, level, &out, sizeof(out)); return out; }
+    T SampleGrad(SamplerState samplerState, const float2& loc, const float2& gradX, const float2& gradY) { T out; texture->SampleGrad(samplerState, &loc.x, &gradX.x, &gradY.x, &out, sizeof(out)); return out; }
+    void SampleLevel(SamplerState samplerState, const float2* locs, const float* levels, size_t count, T* outValues) { texture->SampleLevelBatch(samplerState, &locs->x, levels, count, outValues, sizeof(T)); }
     
     ITexture* texture;              
 };
@@ -584,6 +593,8 @@ struct Texture3D
     T Load(const int4& loc) const { T out; texture->Load(&loc.x, &out, sizeof(out)); return out; }
     T Sample(SamplerState samplerState, const float3& loc) const { T out; texture->Sample(samplerState, &loc.x, &out, sizeof(out)); return out; }
     T SampleLevel(SamplerState samplerState, const float3& loc, float level) { T out; texture->SampleLevel(samplerState, &loc.x, level, &out, sizeof(out)); return out; }
+    T SampleGrad(SamplerState samplerState, const float3& loc, const float3& gradX, const float3& gradY) { T out; texture->SampleGrad(samplerState, &loc.x, &gradX.x, &gradY.x, &out, sizeof(out)); return out; }
+    void SampleLevel(SamplerState samplerState, const float3* locs, const float* levels, size_t count, T* outValues) { texture->SampleLevelBatch(samplerState, &locs->x, levels, count, outValues, sizeof(T)); }
     
     ITexture* texture;              
 };
@@ -620,6 +631,8 @@ struct TextureCube
     
     T Sample(SamplerState samplerState, const float3& loc) const { T out; texture->Sample(samplerState, &loc.x, &out, sizeof(out)); return out; }
     T SampleLevel(SamplerState samplerState, const float3& loc, float level) { T out; texture->SampleLevel(samplerState, &loc.x, level, &out, sizeof(out)); return out; }
+    T SampleGrad(SamplerState samplerState, const float3& loc, const float3& gradX, const float3& gradY) { T out; texture->SampleGrad(samplerState, &loc.x, &gradX.x, &gradY.x, &out, sizeof(out)); return out; }
+    void SampleLevel(SamplerState samplerState, const float3* locs, const float* levels, size_t count, T* outValues) { texture->SampleLevelBatch(samplerState, &locs->x, levels, count, outValues, sizeof(T)); }
     
     ITexture* texture;              
 };
@@ -647,6 +660,8 @@ struct Texture1DArray
     T Load(const int3& loc) const { T out; texture->Load(&loc.x, &out, sizeof(out)); return out; }
     T Sample(SamplerState samplerState, const float2& loc) const { T out; texture->Sample(samplerState, &loc.x, &out, sizeof(out)); return out; }
     T SampleLevel(SamplerState samplerState, const float2& loc, float level) { T out; texture->SampleLevel(samplerState, &loc.x, level, &out, sizeof(out)); return out; }
+    T SampleGrad(SamplerState samplerState, const float2& loc, float gradX, float gradY) { T out; texture->SampleGrad(samplerState, &loc.x, &gradX, &gradY, &out, sizeof(out)); return out; }
+    void SampleLevel(SamplerState samplerState, const float2* locs, const float* levels, size_t count, T* outValues) { texture->SampleLevelBatch(samplerState, &locs->x, levels, count, outValues, sizeof(T)); }
     
     ITexture* texture;              
 };
@@ -689,6 +704,8 @@ struct Texture2DArray
     T Load(const int4& loc) const { T out; texture->Load(&loc.x, &out, sizeof(out)); return out; }
     T Sample(SamplerState samplerState, const float3& loc) const { T out; texture->Sample(samplerState, &loc.x, &out, sizeof(out)); return out; }
     T SampleLevel(SamplerState samplerState, const float3& loc, float level) { T out; texture->SampleLevel(samplerState, &loc.x, level, &out, sizeof(out)); return out; }
+    T SampleGrad(SamplerState samplerState, const float3& loc, const float2& gradX, const float2& gradY) { T out; texture->SampleGrad(samplerState, &loc.x, &gradX.x, &gradY.x, &out, sizeof(out)); return out; }
+    void SampleLevel(SamplerState samplerState, const float3* locs, const float* levels, size_t count, T* outValues) { texture->SampleLevelBatch(samplerState, &locs->x, levels, count, outValues, sizeof(T)); }
     
     ITexture* texture;              
 };
@@ -730,6 +747,8 @@ struct TextureCubeArray
     
     T Sample(SamplerState samplerState, const float4& loc) const { T out; texture->Sample(samplerState, &loc.x, &out, sizeof(out)); return out; }
     T SampleLevel(SamplerState samplerState, const float4& loc, float level) { T out; texture->SampleLevel(samplerState, &loc.x, level, &out, sizeof(out)); return out; }
+    T SampleGrad(SamplerState samplerState, const float4& loc, const float3& gradX, const float3& gradY) { T out; texture->SampleGrad(samplerState, &loc.x, &gradX.x, &gradY.x, &out, sizeof(out)); return out; }
+    void SampleLevel(SamplerState samplerState, const float4* locs, const float* levels, size_t count, T* outValues) { texture->SampleLevelBatch(samplerState, &locs->x, levels, count, outValues, sizeof(T)); }
     
     ITexture* texture;              
 };
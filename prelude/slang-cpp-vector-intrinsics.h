@@ -0,0 +1,463 @@
+#ifndef SLANG_PRELUDE_CPP_VECTOR_INTRINSICS_H
+#define SLANG_PRELUDE_CPP_VECTOR_INTRINSICS_H
+
+// Vector and matrix operations used by generated C++ code.
+//
+// Every operation has a generic implementation that works on each element in turn. If `SLANG_PRELUDE_SIMD`
+// is not `SLANG_PRELUDE_SIMD_NONE`, then 4 element float, int and uint vectors (and so the rows of matrices
+// with 4 columns) are also operated on with SSE or NEON instructions.
+//
+// By default SIMD is used if the C++ compiler is targetting a processor that has SSE2 (x86). The NEON (Arm64)
+// implementation isn't built or tested by CI, so it is only used if `SLANG_PRELUDE_SIMD` is defined as
+// `SLANG_PRELUDE_SIMD_NEON` (2). Define `SLANG_PRELUDE_SIMD` as `SLANG_PRELUDE_SIMD_NONE` (0) to always use the
+// generic implementations.
+//
+// The layout of `Vector` and `Matrix` is unchanged by SIMD use - values are loaded and stored unaligned.
+
+#ifndef SLANG_FORCE_INLINE
+#    define SLANG_FORCE_INLINE inline
+#endif
+
+#define SLANG_PRELUDE_SIMD_NONE 0
+#define SLANG_PRELUDE_SIMD_SSE  1
+#define SLANG_PRELUDE_SIMD_NEON 2
+
+#ifndef SLANG_PRELUDE_SIMD
+#   if defined(SLANG_LLVM)
+        // There are no system headers available with slang-llvm
+#       define SLANG_PRELUDE_SIMD SLANG_PRELUDE_SIMD_NONE
+#   elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#       define SLANG_PRELUDE_SIMD SLANG_PRELUDE_SIMD_SSE
+#   else
+#       define SLANG_PRELUDE_SIMD SLANG_PRELUDE_SIMD_NONE
+#   endif
+#endif
+
+#if SLANG_PRELUDE_SIMD == SLANG_PRELUDE_SIMD_SSE
+#   include <emmintrin.h>
+    // SSE4.1 has instructions for dot products, and 32 bit integer multiply and min/max.
+    // VC doesn't indicate SSE4.1 on its own, but it is implied by AVX.
+#   if defined(__SSE4_1__) || defined(__AVX__)
+#       include <smmintrin.h>
+#       define SLANG_PRELUDE_SSE4_1 1
+#   else
+#       define SLANG_PRELUDE_SSE4_1 0
+#   endif
+#elif SLANG_PRELUDE_SIMD == SLANG_PRELUDE_SIMD_NEON
+#   if !((defined(__ARM_NEON) && defined(__aarch64__)) || defined(_M_ARM64))
+#       error "SLANG_PRELUDE_SIMD_NEON requires a compiler targetting Arm64"
+#   endif
+#   include <arm_neon.h>
+#endif
+
+#ifdef SLANG_PRELUDE_NAMESPACE
+namespace SLANG_PRELUDE_NAMESPACE {
+#endif
+
+// ----------------------------- Scalar helpers -----------------------------------------
+
+// min and max follow HLSL, in that if one of the values is NaN the other is returned.
+
+template <typename T>
+SLANG_FORCE_INLINE T _slang_scalar_min(T a, T b) { return a < b ? a : b; }
+template <typename T>
+SLANG_FORCE_INLINE T _slang_scalar_max(T a, T b) { return a > b ? a : b; }
+
+SLANG_FORCE_INLINE float _slang_scalar_min(float a, float b) { return (a < b || b != b) ? a : b; }
+SLANG_FORCE_INLINE float _slang_scalar_max(float a, float b) { return (a > b || b != b) ? a : b; }
+SLANG_FORCE_INLINE double _slang_scalar_min(double a, double b) { return (a < b || b != b) ? a : b; }
+SLANG_FORCE_INLINE double _slang_scalar_max(double a, double b) { return (a > b || b != b) ? a : b; }
+
+template <typename T, int N>
+SLANG_FORCE_INLINE T* _slang_vector_elements(Vector<T, N>& v) { return &v.x; }
+template <typename T, int N>
+SLANG_FORCE_INLINE const T* _slang_vector_elements(const Vector<T, N>& v) { return &v.x; }
+
+// ----------------------------- Generic vector -----------------------------------------
+
+#define SLANG_PRELUDE_VECTOR_BINARY(NAME, EXPR) \
+    template <typename T, int N> \
+    SLANG_FORCE_INLINE Vector<T, N> NAME(const Vector<T, N>& inA, const Vector<T, N>& inB) \
+    { \
+        Vector<T, N> r; \
+        T* dst = _slang_vector_elements(r); \
+        const T* a = _slang_vector_elements(inA); \
+        const T* b = _slang_vector_elements(inB); \
+        for (int i = 0; i < N; ++i) \
+        { \
+            dst[i] = EXPR; \
+        } \
+        return r; \
+    }
+
+SLANG_PRELUDE_VECTOR_BINARY(_slang_vector_add, a[i] + b[i])
+SLANG_PRELUDE_VECTOR_BINARY(_slang_vector_sub, a[i] - b[i])
+SLANG_PRELUDE_VECTOR_BINARY(_slang_vector_mul, a[i] * b[i])
+SLANG_PRELUDE_VECTOR_BINARY(_slang_vector_div, a[i] / b[i])
+SLANG_PRELUDE_VECTOR_BINARY(_slang_vector_min, _slang_scalar_min(a[i], b[i]))
+SLANG_PRELUDE_VECTOR_BINARY(_slang_vector_max, _slang_scalar_max(a[i], b[i]))
+
+#undef SLANG_PRELUDE_VECTOR_BINARY
+
+template <typename T, int N>
+SLANG_FORCE_INLINE Vector<T, N> _slang_vector_neg(const Vector<T, N>& inA)
+{
+    Vector<T, N> r;
+    T* dst = _slang_vector_elements(r);
+    const T* a = _slang_vector_elements(inA);
+    for (int i = 0; i < N; ++i)
+    {
+        dst[i] = -a[i];
+    }
+    return r;
+}
+
+// Computed as x * (1 - s) + y * s, as it is in the stdlib
+template <typename T, int N>
+SLANG_FORCE_INLINE Vector<T, N> _slang_vector_lerp(const Vector<T, N>& inX, const Vector<T, N>& inY, const Vector<T, N>& inS)
+{
+    Vector<T, N> r;
+    T* dst = _slang_vector_elements(r);
+    const T* x = _slang_vector_elements(inX);
+    const T* y = _slang_vector_elements(inY);
+    const T* s = _slang_vector_elements(inS);
+    for (int i = 0; i < N; ++i)
+    {
+        dst[i] = x[i] * (T(1) - s[i]) + y[i] * s[i];
+    }
+    return r;
+}
+
+template <typename T, int N>
+SLANG_FORCE_INLINE T _slang_vector_dot(const Vector<T, N>& inA, const Vector<T, N>& inB)
+{
+    const T* a = _slang_vector_elements(inA);
+    const T* b = _slang_vector_elements(inB);
+    T r = T(0);
+    for (int i = 0; i < N; ++i)
+    {
+        r += a[i] * b[i];
+    }
+    return r;
+}
+
+template <typename T>
+SLANG_FORCE_INLINE Vector<T, 3> _slang_vector_cross(const Vector<T, 3>& a, const Vector<T, 3>& b)
+{
+    Vector<T, 3> r;
+    r.x = a.y * b.z - a.z * b.y;
+    r.y = a.z * b.x - a.x * b.z;
+    r.z = a.x * b.y - a.y * b.x;
+    return r;
+}
+
+// Swizzle to a 4 element vector. `I0` to `I3` are the indices of the source elements.
+template <int I0, int I1, int I2, int I3, typename T, int N>
+SLANG_FORCE_INLINE Vector<T, 4> _slang_vector_swizzle(const Vector<T, N>& inA)
+{
+    const T* a = _slang_vector_elements(inA);
+    Vector<T, 4> r;
+    r.x = a[I0];
+    r.y = a[I1];
+    r.z = a[I2];
+    r.w = a[I3];
+    return r;
+}
+
+// ----------------------------- SIMD vector -----------------------------------------
+
+#if SLANG_PRELUDE_SIMD == SLANG_PRELUDE_SIMD_SSE
+
+typedef __m128 SlangSimdF32x4;
+typedef __m128i SlangSimdI32x4;
+
+SLANG_FORCE_INLINE SlangSimdF32x4 _slang_simd_load(const Vector<float, 4>& v) { return _mm_loadu_ps(&v.x); }
+SLANG_FORCE_INLINE SlangSimdI32x4 _slang_simd_load(const Vector<int32_t, 4>& v) { return _mm_loadu_si128((const __m128i*)&v.x); }
+SLANG_FORCE_INLINE SlangSimdI32x4 _slang_simd_load(const Vector<uint32_t, 4>& v) { return _mm_loadu_si128((const __m128i*)&v.x); }
+
+SLANG_FORCE_INLINE Vector<float, 4> _slang_simd_storeF32(SlangSimdF32x4 v) { Vector<float, 4> r; _mm_storeu_ps(&r.x, v); return r; }
+SLANG_FORCE_INLINE Vector<int32_t, 4> _slang_simd_storeI32(SlangSimdI32x4 v) { Vector<int32_t, 4> r; _mm_storeu_si128((__m128i*)&r.x, v); return r; }
+SLANG_FORCE_INLINE Vector<uint32_t, 4> _slang_simd_storeU32(SlangSimdI32x4 v) { Vector<uint32_t, 4> r; _mm_storeu_si128((__m128i*)&r.x, v); return r; }
+
+SLANG_FORCE_INLINE SlangSimdF32x4 _slang_simd_splat(float v) { return _mm_set1_ps(v); }
+
+SLANG_FORCE_INLINE SlangSimdF32x4 _slang_simd_add(SlangSimdF32x4 a, SlangSimdF32x4 b) { return _mm_add_ps(a, b); }
+SLANG_FORCE_INLINE SlangSimdF32x4 _slang_simd_sub(SlangSimdF32x4 a, SlangSimdF32x4 b) { return _mm_sub_ps(a, b); }
+SLANG_FORCE_INLINE SlangSimdF32x4 _slang_simd_mul(SlangSimdF32x4 a, SlangSimdF32x4 b) { return _mm_mul_ps(a, b); }
+SLANG_FORCE_INLINE SlangSimdF32x4 _slang_simd_div(SlangSimdF32x4 a, SlangSimdF32x4 b) { return _mm_div_ps(a, b); }
+SLANG_FORCE_INLINE SlangSimdF32x4 _slang_simd_neg(SlangSimdF32x4 a) { return _mm_xor_ps(a, _mm_set1_ps(-0.0f)); }
+
+// minps/maxps return the second operand if either is NaN, so select the first where the second is NaN
+SLANG_FORCE_INLINE SlangSimdF32x4 _slang_simd_min(SlangSimdF32x4 a, SlangSimdF32x4 b)
+{
+    const __m128 bIsNaN = _mm_cmpunord_ps(b, b);
+    return _mm_or_ps(_mm_and_ps(bIsNaN, a), _mm_andnot_ps(bIsNaN, _mm_min_ps(a, b)));
+}
+SLANG_FORCE_INLINE SlangSimdF32x4 _slang_simd_max(SlangSimdF32x4 a, SlangSimdF32x4 b)
+{
+    const __m128 bIsNaN = _mm_cmpunord_ps(b, b);
+    return _mm_or_ps(_mm_and_ps(bIsNaN, a), _mm_andnot_ps(bIsNaN, _mm_max_ps(a, b)));
+}
+
+SLANG_FORCE_INLINE float _slang_simd_dot(SlangSimdF32x4 a, SlangSimdF32x4 b)
+{
+#   if SLANG_PRELUDE_SSE4_1
+    return _mm_cvtss_f32(_mm_dp_ps(a, b, 0xf1));
+#   else
+    const __m128 m = _mm_mul_ps(a, b);
+    // (x + y, x + y, z + w, z + w) then add the high pair to the low
+    const __m128 s = _mm_add_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtss_f32(_mm_add_ss(s, _mm_movehl_ps(s, s)));
+#   endif
+}
+
+template <int I0, int I1, int I2, int I3>
+SLANG_FORCE_INLINE SlangSimdF32x4 _slang_simd_shuffle(SlangSimdF32x4 a) { return _mm_shuffle_ps(a, a, _MM_SHUFFLE(I3, I2, I1, I0)); }
+
+SLANG_FORCE_INLINE SlangSimdI32x4 _slang_simd_add(SlangSimdI32x4 a, SlangSimdI32x4 b) { return _mm_add_epi32(a, b); }
+SLANG_FORCE_INLINE SlangSimdI32x4 _slang_simd_sub(SlangSimdI32x4 a, SlangSimdI32x4 b) { return _mm_sub_epi32(a, b); }
+
+#   if SLANG_PRELUDE_SSE4_1
+#       define SLANG_PRELUDE_SIMD_HAS_I32_MUL_MIN_MAX 1
+SLANG_FORCE_INLINE SlangSimdI32x4 _slang_simd_mul(SlangSimdI32x4 a, SlangSimdI32x4 b) { return _mm_mullo_epi32(a, b); }
+SLANG_FORCE_INLINE SlangSimdI32x4 _slang_simd_minI32(SlangSimdI32x4 a, SlangSimdI32x4 b) { return _mm_min_epi32(a, b); }
+SLANG_FORCE_INLINE SlangSimdI32x4 _slang_simd_maxI32(SlangSimdI32x4 a, SlangSimdI32x4 b) { return _mm_max_epi32(a, b); }
+SLANG_FORCE_INLINE SlangSimdI32x4 _slang_simd_minU32(SlangSimdI32x4 a, SlangSimdI32x4 b) { return _mm_min_epu32(a, b); }
+SLANG_FORCE_INLINE SlangSimdI32x4 _slang_simd_maxU32(SlangSimdI32x4 a, SlangSimdI32x4 b) { return _mm_max_epu32(a, b); }
+#   endif
+
+#elif SLANG_PRELUDE_SIMD == SLANG_PRELUDE_SIMD_NEON
+
+typedef float32x4_t SlangSimdF32x4;
+typedef int32x4_t SlangSimdI32x4;
+
+SLANG_FORCE_INLINE SlangSimdF32x4 _slang_simd_load(const Vector<float, 4>& v) { return vld1q_f32(&v.x); }
+SLANG_FORCE_INLINE SlangSimdI32x4 _slang_simd_load(const Vector<int32_t, 4>& v) { return vld1q_s32(&v.x); }
+SLANG_FORCE_INLINE SlangSimdI32x4 _slang_simd_load(const Vector<uint32_t, 4>& v) { return vreinterpretq_s32_u32(vld1q_u32(&v.x)); }
+
+SLANG_FORCE_INLINE Vector<float, 4> _slang_simd_storeF32(SlangSimdF32x4 v) { Vector<float, 4> r; vst1q_f32(&r.x, v); return r; }
+SLANG_FORCE_INLINE Vector<int32_t, 4> _slang_simd_storeI32(SlangSimdI32x4 v) { Vector<int32_t, 4> r; vst1q_s32(&r.x, v); return r; }
+SLANG_FORCE_INLINE Vector<uint32_t, 4> _slang_simd_storeU32(SlangSimdI32x4 v) { Vector<uint32_t, 4> r; vst1q_u32(&r.x, vreinterpretq_u32_s32(v)); return r; }
+
+SLANG_FORCE_INLINE SlangSimdF32x4 _slang_simd_splat(float v) { return vdupq_n_f32(v); }
+
+SLANG_FORCE_INLINE SlangSimdF32x4 _slang_simd_add(SlangSimdF32x4 a, SlangSimdF32x4 b) { return vaddq_f32(a, b); }
+SLANG_FORCE_INLINE SlangSimdF32x4 _slang_simd_sub(SlangSimdF32x4 a, SlangSimdF32x4 b) { return vsubq_f32(a, b); }
+SLANG_FORCE_INLINE SlangSimdF32x4 _slang_simd_mul(SlangSimdF32x4 a, SlangSimdF32x4 b) { return vmulq_f32(a, b); }
+SLANG_FORCE_INLINE SlangSimdF32x4 _slang_simd_div(SlangSimdF32x4 a, SlangSimdF32x4 b) { return vdivq_f32(a, b); }
+SLANG_FORCE_INLINE SlangSimdF32x4 _slang_simd_neg(SlangSimdF32x4 a) { return vnegq_f32(a); }
+
+// vminnm/vmaxnm return the number if one of the values is NaN
+SLANG_FORCE_INLINE SlangSimdF32x4 _slang_simd_min(SlangSimdF32x4 a, SlangSimdF32x4 b) { return vminnmq_f32(a, b); }
+SLANG_FORCE_INLINE SlangSimdF32x4 _slang_simd_max(SlangSimdF32x4 a, SlangSimdF32x4 b) { return vmaxnmq_f32(a, b); }
+
+SLANG_FORCE_INLINE float _slang_simd_dot(SlangSimdF32x4 a, SlangSimdF32x4 b) { return vaddvq_f32(vmulq_f32(a, b)); }
+
+template <int I0, int I1, int I2, int I3>
+SLANG_FORCE_INLINE SlangSimdF32x4 _slang_simd_shuffle(SlangSimdF32x4 a)
+{
+    float32x4_t r = vmovq_n_f32(vgetq_lane_f32(a, I0));
+    r = vsetq_lane_f32(vgetq_lane_f32(a, I1), r, 1);
+    r = vsetq_lane_f32(vgetq_lane_f32(a, I2), r, 2);
+    return vsetq_lane_f32(vgetq_lane_f32(a, I3), r, 3);
+}
+
+SLANG_FORCE_INLINE SlangSimdI32x4 _slang_simd_add(SlangSimdI32x4 a, SlangSimdI32x4 b) { return vaddq_s32(a, b); }
+SLANG_FORCE_INLINE SlangSimdI32x4 _slang_simd_sub(SlangSimdI32x4 a, SlangSimdI32x4 b) { return vsubq_s32(a, b); }
+
+#   define SLANG_PRELUDE_SIMD_HAS_I32_MUL_MIN_MAX 1
+SLANG_FORCE_INLINE SlangSimdI32x4 _slang_simd_mul(SlangSimdI32x4 a, SlangSimdI32x4 b) { return vmulq_s32(a, b); }
+SLANG_FORCE_INLINE SlangSimdI32x4 _slang_simd_minI32(SlangSimdI32x4 a, SlangSimdI32x4 b) { return vminq_s32(a, b); }
+SLANG_FORCE_INLINE SlangSimdI32x4 _slang_simd_maxI32(SlangSimdI32x4 a, SlangSimdI32x4 b) { return vmaxq_s32(a, b); }
+SLANG_FORCE_INLINE SlangSimdI32x4 _slang_simd_minU32(SlangSimdI32x4 a, SlangSimdI32x4 b) { return vreinterpretq_s32_u32(vminq_u32(vreinterpretq_u32_s32(a), vreinterpretq_u32_s32(b))); }
+SLANG_FORCE_INLINE SlangSimdI32x4 _slang_simd_maxU32(SlangSimdI32x4 a, SlangSimdI32x4 b) { return vreinterpretq_s32_u32(vmaxq_u32(vreinterpretq_u32_s32(a), vreinterpretq_u32_s32(b))); }
+
+#endif
+
+#if SLANG_PRELUDE_SIMD != SLANG_PRELUDE_SIMD_NONE
+
+// Overloads for 4 element vectors, which are picked over the generic implementations above.
+
+#define SLANG_PRELUDE_SIMD_BINARY(NAME, TYPE, STORE, EXPR) \
+    SLANG_FORCE_INLINE Vector<TYPE, 4> NAME(const Vector<TYPE, 4>& inA, const Vector<TYPE, 4>& inB) \
+    { \
+        const auto a = _slang_simd_load(inA); \
+        const auto b = _slang_simd_load(inB); \
+        return STORE(EXPR); \
+    }
+
+SLANG_PRELUDE_SIMD_BINARY(_slang_vector_add, float, _slang_simd_storeF32, _slang_simd_add(a, b))
+SLANG_PRELUDE_SIMD_BINARY(_slang_vector_sub, float, _slang_simd_storeF32, _slang_simd_sub(a, b))
+SLANG_PRELUDE_SIMD_BINARY(_slang_vector_mul, float, _slang_simd_storeF32, _slang_simd_mul(a, b))
+SLANG_PRELUDE_SIMD_BINARY(_slang_vector_div, float, _slang_simd_storeF32, _slang_simd_div(a, b))
+SLANG_PRELUDE_SIMD_BINARY(_slang_vector_min, float, _slang_simd_storeF32, _slang_simd_min(a, b))
+SLANG_PRELUDE_SIMD_BINARY(_slang_vector_max, float, _slang_simd_storeF32, _slang_simd_max(a, b))
+
+SLANG_PRELUDE_SIMD_BINARY(_slang_vector_add, int32_t, _slang_simd_storeI32, _slang_simd_add(a, b))
+SLANG_PRELUDE_SIMD_BINARY(_slang_vector_sub, int32_t, _slang_simd_storeI32, _slang_simd_sub(a, b))
+SLANG_PRELUDE_SIMD_BINARY(_slang_vector_add, uint32_t, _slang_simd_storeU32, _slang_simd_add(a, b))
+SLANG_PRELUDE_SIMD_BINARY(_slang_vector_sub, uint32_t, _slang_simd_storeU32, _slang_simd_sub(a, b))
+
+#ifdef SLANG_PRELUDE_SIMD_HAS_I32_MUL_MIN_MAX
+SLANG_PRELUDE_SIMD_BINARY(_slang_vector_mul, int32_t, _slang_simd_storeI32, _slang_simd_mul(a, b))
+SLANG_PRELUDE_SIMD_BINARY(_slang_vector_min, int32_t, _slang_simd_storeI32, _slang_simd_minI32(a, b))
+SLANG_PRELUDE_SIMD_BINARY(_slang_vector_max, int32_t, _slang_simd_storeI32, _slang_simd_maxI32(a, b))
+SLANG_PRELUDE_SIMD_BINARY(_slang_vector_mul, uint32_t, _slang_simd_storeU32, _slang_simd_mul(a, b))
+SLANG_PRELUDE_SIMD_BINARY(_slang_vector_min, uint32_t, _slang_simd_storeU32, _slang_simd_minU32(a, b))
+SLANG_PRELUDE_SIMD_BINARY(_slang_vector_max, uint32_t, _slang_simd_storeU32, _slang_simd_maxU32(a, b))
+#endif
+
+#undef SLANG_PRELUDE_SIMD_BINARY
+
+SLANG_FORCE_INLINE Vector<float, 4> _slang_vector_neg(const Vector<float, 4>& a)
+{
+    return _slang_simd_storeF32(_slang_simd_neg(_slang_simd_load(a)));
+}
+
+SLANG_FORCE_INLINE Vector<float, 4> _slang_vector_lerp(const Vector<float, 4>& inX, const Vector<float, 4>& inY, const Vector<float, 4>& inS)
+{
+    const SlangSimdF32x4 s = _slang_simd_load(inS);
+    const SlangSimdF32x4 x = _slang_simd_mul(_slang_simd_load(inX), _slang_simd_sub(_slang_simd_splat(1.0f), s));
+    return _slang_simd_storeF32(_slang_simd_add(x, _slang_simd_mul(_slang_simd_load(inY), s)));
+}
+
+SLANG_FORCE_INLINE float _slang_vector_dot(const Vector<float, 4>& a, const Vector<float, 4>& b)
+{
+    return _slang_simd_dot(_slang_simd_load(a), _slang_simd_load(b));
+}
+
+// A 3 element vector can't be loaded as 4 elements (it could read past the end of the data)
+SLANG_FORCE_INLINE SlangSimdF32x4 _slang_simd_load3(const Vector<float, 3>& v)
+{
+    const Vector<float, 4> v4 = { v.x, v.y, v.z, 0.0f };
+    return _slang_simd_load(v4);
+}
+
+SLANG_FORCE_INLINE Vector<float, 3> _slang_vector_cross(const Vector<float, 3>& inA, const Vector<float, 3>& inB)
+{
+    const SlangSimdF32x4 a = _slang_simd_load3(inA);
+    const SlangSimdF32x4 b = _slang_simd_load3(inB);
+
+    // a.yzx * b.zxy - a.zxy * b.yzx
+    const SlangSimdF32x4 r = _slang_simd_sub(
+        _slang_simd_mul(_slang_simd_shuffle<1, 2, 0, 3>(a), _slang_simd_shuffle<2, 0, 1, 3>(b)),
+        _slang_simd_mul(_slang_simd_shuffle<2, 0, 1, 3>(a), _slang_simd_shuffle<1, 2, 0, 3>(b)));
+
+    const Vector<float, 4> r4 = _slang_simd_storeF32(r);
+    Vector<float, 3> result;
+    result.x = r4.x;
+    result.y = r4.y;
+    result.z = r4.z;
+    return result;
+}
+
+template <int I0, int I1, int I2, int I3>
+SLANG_FORCE_INLINE Vector<float, 4> _slang_vector_swizzle(const Vector<float, 4>& a)
+{
+    return _slang_simd_storeF32(_slang_simd_shuffle<I0, I1, I2, I3>(_slang_simd_load(a)));
+}
+
+#endif // SLANG_PRELUDE_SIMD != SLANG_PRELUDE_SIMD_NONE
+
+// ----------------------------- Matrix -----------------------------------------
+
+// Element-wise matrix operations are performed a row at a time with the vector operations.
+
+#define SLANG_PRELUDE_MATRIX_BINARY(NAME, VECTOR_NAME) \
+    template <typename T, int ROWS, int COLS> \
+    SLANG_FORCE_INLINE Matrix<T, ROWS, COLS> NAME(const Matrix<T, ROWS, COLS>& a, const Matrix<T, ROWS, COLS>& b) \
+    { \
+        Matrix<T, ROWS, COLS> r; \
+        for (int i = 0; i < ROWS; ++i) \
+        { \
+            r.rows[i] = VECTOR_NAME(a.rows[i], b.rows[i]); \
+        } \
+        return r; \
+    }
+
+SLANG_PRELUDE_MATRIX_BINARY(_slang_matrix_add, _slang_vector_add)
+SLANG_PRELUDE_MATRIX_BINARY(_slang_matrix_sub, _slang_vector_sub)
+SLANG_PRELUDE_MATRIX_BINARY(_slang_matrix_mul, _slang_vector_mul)
+SLANG_PRELUDE_MATRIX_BINARY(_slang_matrix_div, _slang_vector_div)
+SLANG_PRELUDE_MATRIX_BINARY(_slang_matrix_min, _slang_vector_min)
+SLANG_PRELUDE_MATRIX_BINARY(_slang_matrix_max, _slang_vector_max)
+
+#undef SLANG_PRELUDE_MATRIX_BINARY
+
+template <typename T, int ROWS, int COLS>
+SLANG_FORCE_INLINE Matrix<T, ROWS, COLS> _slang_matrix_neg(const Matrix<T, ROWS, COLS>& a)
+{
+    Matrix<T, ROWS, COLS> r;
+    for (int i = 0; i < ROWS; ++i)
+    {
+        r.rows[i] = _slang_vector_neg(a.rows[i]);
+    }
+    return r;
+}
+
+// mul(vector, matrix) - a row vector times a matrix
+template <typename T, int ROWS, int COLS>
+SLANG_FORCE_INLINE Vector<T, COLS> _slang_vector_matrix_mul(const Vector<T, ROWS>& inV, const Matrix<T, ROWS, COLS>& m)
+{
+    const T* v = _slang_vector_elements(inV);
+    Vector<T, COLS> r;
+    T* dst = _slang_vector_elements(r);
+    for (int j = 0; j < COLS; ++j)
+    {
+        T sum = T(0);
+        for (int i = 0; i < ROWS; ++i)
+        {
+            sum += v[i] * _slang_vector_elements(m.rows[i])[j];
+        }
+        dst[j] = sum;
+    }
+    return r;
+}
+
+// mul(matrix, vector) - a matrix times a column vector
+template <typename T, int ROWS, int COLS>
+SLANG_FORCE_INLINE Vector<T, ROWS> _slang_matrix_vector_mul(const Matrix<T, ROWS, COLS>& m, const Vector<T, COLS>& v)
+{
+    Vector<T, ROWS> r;
+    T* dst = _slang_vector_elements(r);
+    for (int i = 0; i < ROWS; ++i)
+    {
+        dst[i] = _slang_vector_dot(m.rows[i], v);
+    }
+    return r;
+}
+
+#if SLANG_PRELUDE_SIMD != SLANG_PRELUDE_SIMD_NONE
+
+// With 4 columns the result is a sum of the rows of the matrix scaled by the elements of the vector
+template <int ROWS>
+SLANG_FORCE_INLINE Vector<float, 4> _slang_vector_matrix_mul(const Vector<float, ROWS>& inV, const Matrix<float, ROWS, 4>& m)
+{
+    const float* v = _slang_vector_elements(inV);
+    SlangSimdF32x4 sum = _slang_simd_mul(_slang_simd_splat(v[0]), _slang_simd_load(m.rows[0]));
+    for (int i = 1; i < ROWS; ++i)
+    {
+        sum = _slang_simd_add(sum, _slang_simd_mul(_slang_simd_splat(v[i]), _slang_simd_load(m.rows[i])));
+    }
+    return _slang_simd_storeF32(sum);
+}
+
+#endif
+
+// mul(matrix, matrix). Each row of the result is the row of `a` times `b`.
+template <typename T, int ROWS, int N, int COLS>
+SLANG_FORCE_INLINE Matrix<T, ROWS, COLS> _slang_matrix_matrix_mul(const Matrix<T, ROWS, N>& a, const Matrix<T, N, COLS>& b)
+{
+    Matrix<T, ROWS, COLS> r;
+    for (int i = 0; i < ROWS; ++i)
+    {
+        r.rows[i] = _slang_vector_matrix_mul(a.rows[i], b);
+    }
+    return r;
+}
+
+#ifdef SLANG_PRELUDE_NAMESPACE
+}
+#endif
+
+#endif
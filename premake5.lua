@@ -930,6 +930,11 @@ tool "slangd"
      includedirs { ".", "external", "source" }
  
      files {"slang-gfx.h"}
+
+     -- The CPU device executes dispatches on a thread pool
+     if not targetInfo.isWindows then
+         links { "pthread" }
+     end
  
      -- Will compile across targets
      addSourceDir "tools/gfx/cpu"
@@ -1050,7 +1055,7 @@ tool "slangd"
  standardProject("slangc", "source/slangc")
      uuid "D56CBCEB-1EB5-4CA8-AEC4-48EA35ED61C7"
      kind "ConsoleApp"
-     links { "core", "slang" }
+     links { "compiler-core", "core", "slang" }
  
  function getWinArm64Filter(isArm64)
      if isArm64 then
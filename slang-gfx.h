@@ -129,6 +129,7 @@ enum class AccessFlag
 const GfxCount kMaxRenderTargetCount = 8;
 
 class ITransientResourceHeap;
+class IPipelineState;
 
 enum class ShaderModuleSourceType
 {
@@ -1333,12 +1334,22 @@ struct GraphicsPipelineStateDesc
     DepthStencilDesc    depthStencil;
     RasterizerDesc      rasterizer;
     BlendDesc           blend;
+    // (optional) The pipeline to use whilst the specialization of this pipeline for the bound shader objects is
+    // created in the background (see `IDevice::Desc::asyncPipelineSpecialization`). It must not need to be specialized
+    // itself, and must have the same parameter layout as this pipeline (for example, by using dynamic dispatch).
+    // If null, draws wait for the specialization to be created.
+    IPipelineState* specializationFallback = nullptr;
 };
 
 struct ComputePipelineStateDesc
 {
     IShaderProgram*  program = nullptr;
     void* d3d12RootSignatureOverride = nullptr;
+    // (optional) The pipeline to use whilst the specialization of this pipeline for the bound shader objects is
+    // created in the background (see `IDevice::Desc::asyncPipelineSpecialization`). It must not need to be specialized
+    // itself, and must have the same parameter layout as this pipeline (for example, by using dynamic dispatch).
+    // If null, dispatches wait for the specialization to be created.
+    IPipelineState* specializationFallback = nullptr;
 };
 
 struct RayTracingPipelineFlags
@@ -2106,6 +2117,7 @@ public:
         SlangOptimizationLevel optimizationLevel = SLANG_OPTIMIZATION_LEVEL_DEFAULT;
         SlangTargetFlags targetFlags = 0;
         SlangLineDirectiveMode lineDirectiveMode = SLANG_LINE_DIRECTIVE_MODE_DEFAULT;
+        const char* compileCacheDirectory = nullptr; // (optional) Directory to cache compiled kernels in, so later runs can reuse them.
     };
 
     struct InteropHandles
@@ -2134,6 +2146,15 @@ public:
         // The file system for loading cached shader kernels. The layer does not maintain a strong reference to the object,
         // instead the user is responsible for holding the object alive during the lifetime of an `IDevice`.
         ISlangFileSystem* shaderCacheFileSystem = nullptr;
+        // The number of threads the CPU device uses to execute compute dispatches (including the calling thread).
+        // If 0, one thread per hardware thread is used. Ignored by other device types.
+        GfxCount cpuWorkerThreadCount = 0;
+        // If true, pipelines that need to be specialized for the bound shader objects are created on a background
+        // thread. Until a specialization is ready, draws and dispatches use the pipeline's `specializationFallback`,
+        // or wait for it if there is none. The device's Slang session must not be used by the application whilst
+        // specializations are being created. Ignored by OpenGL and CUDA devices, as their contexts are only current
+        // on the thread that created the device.
+        bool asyncPipelineSpecialization = false;
         // Configurations for Slang compiler.
         SlangDesc slang = {};
 
@@ -2463,6 +2484,17 @@ public:
         const ITextureResource::Desc& desc, Size* outSize, Size* outAlignment) = 0;
 
     virtual SLANG_NO_THROW Result SLANG_MCALL getTextureRowAlignment(Size* outAlignment) = 0;
+
+        /// Create the specializations of `pipeline` for `keys` ahead of their use, in the background if
+        /// `Desc::asyncPipelineSpecialization` is set. `keys` is in the form returned by `getSpecializedPipelineKeys`.
+        /// Keys whose types can't be found (for example, because the shader code changed) are skipped.
+    virtual SLANG_NO_THROW Result SLANG_MCALL prewarmSpecializedPipelines(
+        IPipelineState* pipeline, ISlangBlob* keys) = 0;
+
+        /// Get the keys of the specializations of `pipeline` that have been created (or are being created).
+        /// The keys can be stored (for example, on disk) and passed to `prewarmSpecializedPipelines` in a later run.
+    virtual SLANG_NO_THROW Result SLANG_MCALL getSpecializedPipelineKeys(
+        IPipelineState* pipeline, ISlangBlob** outKeys) = 0;
 };
 
 #define SLANG_UUID_IDevice                                                               \
@@ -1793,6 +1793,12 @@ extern "C"
     /*! @see slang::ICompileRequest::setDiagnosticFlags */
     SLANG_API void spSetDiagnosticFlags(SlangCompileRequest* request, SlangDiagnosticFlags flags);
 
+    /*! @see slang::ICompileRequest::setCompileTraceEnabled */
+    SLANG_API void spSetCompileTraceEnabled(SlangCompileRequest* request, bool enable);
+
+    /*! @see slang::ICompileRequest::getCompileTrace */
+    SLANG_API SlangResult spGetCompileTrace(SlangCompileRequest* request, ISlangBlob** outTrace);
+
     /*
     Forward declarations of types used in the reflection interface;
     */
@@ -4006,6 +4012,20 @@ namespace slang
             /** Sets the flags of the request's diagnostic sink.
                 The previously specified flags are discarded. */
         virtual SLANG_NO_THROW void SLANG_MCALL setDiagnosticFlags(SlangDiagnosticFlags flags) = 0;
+
+            /** Enable or disable recording a trace of where compilation time goes.
+
+            The trace covers the phases of the front end (preprocessing, parsing, checking, lowering to IR),
+            each IR pass, emission and downstream compilation, for all compilations using the request's linkage.
+            */
+        virtual SLANG_NO_THROW void SLANG_MCALL setCompileTraceEnabled(bool enable) = 0;
+
+            /** Get the trace recorded since tracing was enabled, in the Chrome trace event (JSON) format.
+            The trace can be viewed with chrome://tracing or https://ui.perfetto.dev.
+
+            Returns SLANG_E_NOT_AVAILABLE if tracing isn't enabled.
+            */
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL getCompileTrace(ISlangBlob** outTrace) = 0;
     };
 
     #define SLANG_UUID_ICompileRequest ICompileRequest::getTypeGuid()
@@ -4096,6 +4116,16 @@ namespace slang
         SlangInt                        preprocessorMacroCount = 0;
 
         ISlangFileSystem* fileSystem = nullptr;
+
+            /** If set, compiled target code is cached in this directory, such that it can be reused
+            (also by other processes) when the same code is compiled with the same options again.
+            */
+        char const* compileCacheDirectory = nullptr;
+
+            /** If set, imported modules are serialized into this directory, and used from it in place of
+            compiling the source of a module again, as long as the source (and the modules it imports) didn't change.
+            */
+        char const* moduleCacheDirectory = nullptr;
     };
 
     enum class ContainerType
@@ -4270,6 +4300,25 @@ namespace slang
             ITypeConformance** outConformance,
             SlangInt conformanceIdOverride,
             ISlangBlob** outDiagnostics) = 0;
+
+            /** Get the host callable code for each of `componentTypes` for the target at `targetIndex`.
+
+            This is the same as calling `IComponentType::getTargetHostCallable` on each component type, except that
+            up to `threadCount` of them are compiled concurrently (0 uses the number of hardware threads). As all
+            of the entry points of a component type are compiled with a single invocation of the downstream
+            compiler, many specializations can be compiled with a few concurrent compiler processes by grouping
+            them into a few composite component types.
+
+            `outSharedLibraries` must have `componentTypeCount` entries. If a component type fails to compile
+            its entry is set to null, the result is a failure, and the errors are written to `outDiagnostics`.
+            */
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL getTargetHostCallables(
+            IComponentType* const*  componentTypes,
+            SlangInt                componentTypeCount,
+            SlangInt                targetIndex,
+            SlangInt                threadCount,
+            ISlangSharedLibrary**   outSharedLibraries,
+            ISlangBlob**            outDiagnostics = nullptr) = 0;
     };
 
     #define SLANG_UUID_ISession ISession::getTypeGuid()
@@ -4449,6 +4498,26 @@ namespace slang
             */
         virtual SLANG_NO_THROW SlangResult SLANG_MCALL renameEntryPoint(
             const char* newName, IComponentType** outEntryPoint) = 0;
+
+            /** Get 'callable' functions for all of the entry points of the component type, in a single ISlangSharedLibrary.
+
+            The entry points are compiled together into one translation unit, with a single invocation of
+            the downstream compiler, which is typically much faster than compiling each of them separately
+            with `getEntryPointHostCallable`. A batch of specializations can be compiled this way by creating
+            a composite component type of them. Entry points are found by name in the shared library, so
+            entry points with the same name (such as specializations of the same entry point) should be
+            given distinct names with `renameEntryPoint`.
+
+            NOTE! Requires a compilation target of SLANG_HOST_CALLABLE.
+
+            @param targetIndex      The index of the target to get code for.
+            @param outSharedLibrary A pointer to a ISharedLibrary interface which functions can be queried on.
+            @returns                A `SlangResult` to indicate success or failure.
+            */
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL getTargetHostCallable(
+            SlangInt                targetIndex,
+            ISlangSharedLibrary**   outSharedLibrary,
+            slang::IBlob**          outDiagnostics = nullptr) = 0;
     };
     #define SLANG_UUID_IComponentType IComponentType::getTypeGuid()
 
@@ -0,0 +1,114 @@
+// slang-artifact-disk-cache.cpp
+#include "slang-artifact-disk-cache.h"
+
+#include "slang-artifact-util.h"
+
+#include "../core/slang-blob.h"
+#include "../core/slang-hash.h"
+#include "../core/slang-io.h"
+
+namespace Slang {
+
+namespace { // anonymous
+
+// The layout of the start of an entry file. It is followed by the key, and then the payload.
+struct EntryHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t packedDesc;
+    uint64_t keySize;
+    uint64_t payloadSize;
+};
+
+static const char kEntryMagic[8] = { 'S', 'L', 'A', 'N', 'G', 'A', 'D', 'C' };
+static const uint32_t kEntryVersion = 1;
+
+} // anonymous
+
+ArtifactDiskCache::ArtifactDiskCache(const String& directory):
+    m_directory(directory)
+{
+}
+
+String ArtifactDiskCache::_getEntryPath(const UnownedStringSlice& key)
+{
+    const HashCode64 hash = getStableHashCode64(key.begin(), size_t(key.getLength()));
+
+    StringBuilder fileName;
+    fileName.append(uint64_t(hash), 16);
+    fileName << ".slang-cache";
+    return Path::combine(m_directory, fileName);
+}
+
+SlangResult ArtifactDiskCache::load(const UnownedStringSlice& key, ComPtr<IArtifact>& outArtifact)
+{
+    const String path = _getEntryPath(key);
+
+    List<unsigned char> contents;
+    if (SLANG_FAILED(File::readAllBytes(path, contents)))
+    {
+        return SLANG_E_NOT_FOUND;
+    }
+
+    // Check the entry is complete, and really is for this key (and not a different key with the same hash)
+    const size_t size = size_t(contents.getCount());
+    if (size < sizeof(EntryHeader))
+    {
+        return SLANG_E_NOT_FOUND;
+    }
+
+    EntryHeader header;
+    ::memcpy(&header, contents.getBuffer(), sizeof(header));
+
+    if (::memcmp(header.magic, kEntryMagic, sizeof(kEntryMagic)) != 0 ||
+        header.version != kEntryVersion ||
+        header.keySize != uint64_t(key.getLength()) ||
+        sizeof(EntryHeader) + header.keySize + header.payloadSize != size)
+    {
+        return SLANG_E_NOT_FOUND;
+    }
+
+    const unsigned char* keyData = contents.getBuffer() + sizeof(EntryHeader);
+    if (::memcmp(keyData, key.begin(), size_t(header.keySize)) != 0)
+    {
+        return SLANG_E_NOT_FOUND;
+    }
+
+    auto artifact = ArtifactUtil::createArtifact(ArtifactDesc::make(ArtifactDesc::Packed(header.packedDesc)));
+    artifact->addRepresentationUnknown(RawBlob::create(keyData + header.keySize, size_t(header.payloadSize)));
+
+    outArtifact.swap(artifact);
+    return SLANG_OK;
+}
+
+SlangResult ArtifactDiskCache::store(const UnownedStringSlice& key, IArtifact* artifact)
+{
+    ComPtr<ISlangBlob> blob;
+    SLANG_RETURN_ON_FAIL(artifact->loadBlob(ArtifactKeep::Yes, blob.writeRef()));
+
+    EntryHeader header;
+    ::memcpy(header.magic, kEntryMagic, sizeof(kEntryMagic));
+    header.version = kEntryVersion;
+    header.packedDesc = uint32_t(artifact->getDesc().getPacked());
+    header.keySize = uint64_t(key.getLength());
+    header.payloadSize = uint64_t(blob->getBufferSize());
+
+    List<uint8_t> contents;
+    contents.addRange((const uint8_t*)&header, Index(sizeof(header)));
+    contents.addRange((const uint8_t*)key.begin(), key.getLength());
+    contents.addRange((const uint8_t*)blob->getBufferPointer(), Index(blob->getBufferSize()));
+
+    SlangPathType pathType;
+    if (SLANG_FAILED(Path::getPathType(m_directory, &pathType)))
+    {
+        Path::createDirectory(m_directory);
+    }
+
+    // Other processes using the same directory never see a partially written entry. Failing
+    // to store isn't an error, as another process may be storing the same entry at the same time.
+    File::writeAllBytesAtomically(_getEntryPath(key), contents.getBuffer(), size_t(contents.getCount()));
+    return SLANG_OK;
+}
+
+} // namespace Slang
@@ -0,0 +1,47 @@
+// slang-artifact-disk-cache.h
+#ifndef SLANG_ARTIFACT_DISK_CACHE_H
+#define SLANG_ARTIFACT_DISK_CACHE_H
+
+#include "slang-artifact.h"
+
+#include "../core/slang-string.h"
+
+namespace Slang
+{
+
+/* A persistent cache of artifacts, stored as files in a directory.
+
+An entry is identified by a key, which is a textual description of everything that
+influences the contents of the artifact (for example the source, the options and the compiler version).
+The key can be arbitrarily long - the file name of an entry is derived from a hash of the key,
+and the key itself is stored in the entry, such that a hash collision can never produce the wrong artifact.
+
+Entries are written to a temporary file which is then renamed, so multiple processes can safely
+share the same cache directory.
+
+Only artifacts that can be represented as a blob can be stored. */
+class ArtifactDiskCache : public RefObject
+{
+public:
+        /// Try to load the artifact stored for `key`.
+        /// Returns SLANG_E_NOT_FOUND if there is no entry for the key.
+    SlangResult load(const UnownedStringSlice& key, ComPtr<IArtifact>& outArtifact);
+
+        /// Store `artifact` as the entry for `key`, replacing any previous entry.
+    SlangResult store(const UnownedStringSlice& key, IArtifact* artifact);
+
+        /// Get the directory that holds the entries
+    const String& getDirectory() const { return m_directory; }
+
+        /// Ctor. The directory will be created if it doesn't exist when the first entry is stored.
+    explicit ArtifactDiskCache(const String& directory);
+
+protected:
+    String _getEntryPath(const UnownedStringSlice& key);
+
+    String m_directory;
+};
+
+} // namespace Slang
+
+#endif
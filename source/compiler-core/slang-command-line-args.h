@@ -144,6 +144,9 @@ struct DownstreamArgs
         /// Find the index of a name. Returns < 0 if not found.
     Index findName(const String& name) const { return m_entries.findFirstIndex([&](const Entry& entry) -> bool { return entry.name == name; }); }
 
+        /// Get all of the entries
+    const List<Entry>& getEntries() const { return m_entries; }
+
         /// Get the args at the nameIndex
     CommandLineArgs& getArgsAt(Index nameIndex) { return m_entries[nameIndex].args; }
         /// Get args by name - will assert if name isn't found
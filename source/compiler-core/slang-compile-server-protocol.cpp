@@ -0,0 +1,38 @@
+#include "slang-compile-server-protocol.h"
+
+namespace CompileServerProtocol {
+
+static const StructRttiInfo _makeCompileArgsRtti()
+{
+    CompileArgs obj;
+    StructRttiBuilder builder(&obj, "CompileServerProtocol::CompileArgs", nullptr);
+    builder.addField("args", &obj.args);
+    return builder.make();
+}
+/* static */const StructRttiInfo CompileArgs::g_rttiInfo = _makeCompileArgsRtti();
+/* static */const UnownedStringSlice CompileArgs::g_methodName = UnownedStringSlice::fromLiteral("compile");
+
+static const StructRttiInfo _makeCompileResultRtti()
+{
+    CompileResult obj;
+    StructRttiBuilder builder(&obj, "CompileServerProtocol::CompileResult", nullptr);
+    builder.addField("stdOut", &obj.stdOut);
+    builder.addField("stdError", &obj.stdError);
+    builder.addField("result", &obj.result);
+    builder.addField("returnCode", &obj.returnCode);
+    builder.addField("reusedLinkage", &obj.reusedLinkage);
+    return builder.make();
+}
+/* static */const StructRttiInfo CompileResult::g_rttiInfo = _makeCompileResultRtti();
+
+/* static */const UnownedStringSlice QuitArgs::g_methodName = UnownedStringSlice::fromLiteral("quit");
+
+static const StructRttiInfo _makeQuitResultRtti()
+{
+    QuitResult obj;
+    StructRttiBuilder builder(&obj, "CompileServerProtocol::QuitResult", nullptr);
+    return builder.make();
+}
+/* static */const StructRttiInfo QuitResult::g_rttiInfo = _makeQuitResultRtti();
+
+} // namespace CompileServerProtocol
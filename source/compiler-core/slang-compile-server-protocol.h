@@ -0,0 +1,51 @@
+#ifndef SLANG_COMPILER_CORE_COMPILE_SERVER_PROTOCOL_H
+#define SLANG_COMPILER_CORE_COMPILE_SERVER_PROTOCOL_H
+
+#include "../../slang.h"
+#include "../../slang-com-helper.h"
+#include "../../slang-com-ptr.h"
+
+#include "../core/slang-rtti-info.h"
+#include "slang-json-value.h"
+
+/* The JSON-RPC protocol used to talk to slangc when it is run as a compile server (`slangc -compile-server`).
+
+The server keeps a global session (and so the stdlib, and anything cached on the session) for as long as it runs,
+so a client that compiles many small things avoids paying for starting a process and loading the stdlib each time. */
+namespace CompileServerProtocol {
+
+using namespace Slang;
+
+struct CompileArgs
+{
+    List<String> args;                  ///< The slangc command line arguments (not including the executable name)
+
+    static const UnownedStringSlice g_methodName;
+    static const StructRttiInfo g_rttiInfo;
+};
+
+struct QuitArgs
+{
+    static const UnownedStringSlice g_methodName;
+};
+
+    /// The (empty) result of a `quit` call, sent before the server exits
+struct QuitResult
+{
+    static const StructRttiInfo g_rttiInfo;
+};
+
+struct CompileResult
+{
+    String stdOut;
+    String stdError;
+    int32_t result = SLANG_OK;
+    int32_t returnCode = 0;             ///< What slangc would return if invoked from the command line
+    bool reusedLinkage = false;         ///< True if the compilation was made on the linkage of an earlier one
+
+    static const StructRttiInfo g_rttiInfo;
+};
+
+} // namespace CompileServerProtocol
+
+#endif // SLANG_COMPILER_CORE_COMPILE_SERVER_PROTOCOL_H
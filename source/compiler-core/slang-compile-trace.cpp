@@ -0,0 +1,98 @@
+// slang-compile-trace.cpp
+#include "slang-compile-trace.h"
+
+#include "../core/slang-string-escape-util.h"
+
+namespace Slang {
+
+CompileTrace::CompileTrace():
+    m_startTime(std::chrono::steady_clock::now())
+{
+}
+
+int64_t CompileTrace::_getMicroseconds() const
+{
+    return int64_t(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_startTime).count());
+}
+
+Index CompileTrace::_getThreadIndex()
+{
+    // Called with the mutex held
+    const auto id = std::this_thread::get_id();
+    Index index = m_threadIds.indexOf(id);
+    if (index < 0)
+    {
+        index = m_threadIds.getCount();
+        m_threadIds.add(id);
+    }
+    return index;
+}
+
+Index CompileTrace::beginEvent(const char* category, const UnownedStringSlice& name)
+{
+    const int64_t startMicroseconds = _getMicroseconds();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    Event event;
+    event.category = category;
+    event.name = name;
+    event.startMicroseconds = startMicroseconds;
+    event.durationMicroseconds = 0;
+    event.threadIndex = _getThreadIndex();
+
+    const Index eventIndex = m_events.getCount();
+    m_events.add(_Move(event));
+    return eventIndex;
+}
+
+void CompileTrace::endEvent(Index eventIndex)
+{
+    const int64_t endMicroseconds = _getMicroseconds();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Event& event = m_events[eventIndex];
+    event.durationMicroseconds = endMicroseconds - event.startMicroseconds;
+}
+
+void CompileTrace::addArg(Index eventIndex, const char* name, int64_t value)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_events[eventIndex].args.add(Arg{ name, value });
+}
+
+void CompileTrace::writeChromeTrace(StringBuilder& out)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto handler = StringEscapeUtil::getHandler(StringEscapeUtil::Style::JSON);
+
+    // Uses 'complete' events (phase "X"), which hold both the start and the duration
+    out << "{\"traceEvents\":[\n";
+    for (Index i = 0; i < m_events.getCount(); ++i)
+    {
+        const Event& event = m_events[i];
+
+        out << "{\"name\":";
+        StringEscapeUtil::appendQuoted(handler, event.name.getUnownedSlice(), out);
+        out << ",\"cat\":\"" << event.category << "\",\"ph\":\"X\"";
+        out << ",\"ts\":" << event.startMicroseconds << ",\"dur\":" << event.durationMicroseconds;
+        out << ",\"pid\":1,\"tid\":" << event.threadIndex;
+
+        if (event.args.getCount())
+        {
+            out << ",\"args\":{";
+            for (Index j = 0; j < event.args.getCount(); ++j)
+            {
+                const Arg& arg = event.args[j];
+                out << (j ? "," : "") << "\"" << arg.name << "\":" << arg.value;
+            }
+            out << "}";
+        }
+
+        out << ((i + 1 < m_events.getCount()) ? "},\n" : "}\n");
+    }
+    out << "],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+} // namespace Slang
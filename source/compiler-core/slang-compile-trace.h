@@ -0,0 +1,103 @@
+// slang-compile-trace.h
+#ifndef SLANG_COMPILE_TRACE_H
+#define SLANG_COMPILE_TRACE_H
+
+#include "../core/slang-basic.h"
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+namespace Slang
+{
+
+/* Records a hierarchical trace of where the time of a compilation goes.
+
+Each event has a category (like "frontend", "ir-pass" or "downstream"), a name, a start time and a duration,
+and optionally a set of integer arguments (such as the instruction count after an IR pass).
+Events nest by time - an event that starts and ends within another event on the same thread is a child of it.
+
+The trace can be written in the Chrome trace event format, which can be viewed with chrome://tracing
+or https://ui.perfetto.dev.
+
+Events can be recorded from multiple threads. */
+class CompileTrace : public RefObject
+{
+public:
+    struct Arg
+    {
+        const char* name;                   ///< Must be a string literal (or otherwise outlive the trace)
+        int64_t value;
+    };
+
+    struct Event
+    {
+        const char* category;               ///< Must be a string literal (or otherwise outlive the trace)
+        String name;
+        int64_t startMicroseconds;          ///< Relative to the creation of the trace
+        int64_t durationMicroseconds;
+        Index threadIndex;
+        List<Arg> args;
+    };
+
+        /// Begin an event. Returns the index of the event, which is used to end it.
+    Index beginEvent(const char* category, const UnownedStringSlice& name);
+        /// End the event at eventIndex
+    void endEvent(Index eventIndex);
+        /// Add an argument to the event at eventIndex
+    void addArg(Index eventIndex, const char* name, int64_t value);
+
+        /// Get all of the events recorded so far. Not thread safe.
+    const List<Event>& getEvents() const { return m_events; }
+
+        /// Append the trace in the Chrome trace event (JSON) format
+    void writeChromeTrace(StringBuilder& out);
+
+    CompileTrace();
+
+protected:
+    int64_t _getMicroseconds() const;
+    Index _getThreadIndex();
+
+    std::mutex m_mutex;
+    std::chrono::steady_clock::time_point m_startTime;
+    List<Event> m_events;
+    List<std::thread::id> m_threadIds;
+};
+
+/* RAII type that records an event (if there is a trace) for the duration of a scope */
+struct CompileTraceScope
+{
+        /// Add an argument to the event
+    void addArg(const char* name, int64_t value)
+    {
+        if (m_trace)
+        {
+            m_trace->addArg(m_eventIndex, name, value);
+        }
+    }
+
+    CompileTraceScope(CompileTrace* trace, const char* category, const UnownedStringSlice& name):
+        m_trace(trace),
+        m_eventIndex(trace ? trace->beginEvent(category, name) : -1)
+    {
+    }
+    CompileTraceScope(CompileTrace* trace, const char* category, const char* name):
+        CompileTraceScope(trace, category, UnownedStringSlice(name))
+    {
+    }
+    ~CompileTraceScope()
+    {
+        if (m_trace)
+        {
+            m_trace->endEvent(m_eventIndex);
+        }
+    }
+
+    CompileTrace* m_trace;
+    Index m_eventIndex;
+};
+
+} // namespace Slang
+
+#endif
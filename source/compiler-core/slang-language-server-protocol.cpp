@@ -626,6 +626,18 @@ static const StructRttiInfo _makeCancelParamsRtti()
 }
 const StructRttiInfo CancelParams::g_rttiInfo = _makeCancelParamsRtti();
 
+static const StructRttiInfo _makeSetTraceParamsRtti()
+{
+    SetTraceParams obj;
+    StructRttiBuilder builder(&obj, "LanguageServerProtocol::SetTraceParams", nullptr);
+    builder.addField("value", &obj.value);
+    builder.ignoreUnknownFields();
+    return builder.make();
+}
+const StructRttiInfo SetTraceParams::g_rttiInfo = _makeSetTraceParamsRtti();
+const UnownedStringSlice SetTraceParams::methodName =
+    UnownedStringSlice::fromLiteral("$/setTrace");
+
 static const StructRttiInfo _makeLogMessageParamsRtti()
 {
     LogMessageParams obj;
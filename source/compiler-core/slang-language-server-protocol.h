@@ -863,6 +863,17 @@ struct CancelParams
     static const StructRttiInfo g_rttiInfo;
 };
 
+struct SetTraceParams
+{
+    /**
+     * The new value that should be assigned to the trace setting ("off", "messages" or "verbose").
+     */
+    String value;
+
+    static const StructRttiInfo g_rttiInfo;
+    static const UnownedStringSlice methodName;
+};
+
 struct LogMessageParams
 {
     /**
@@ -19,24 +19,86 @@ const char* getCstr(Name* name)
     return name ? name->text.getBuffer() : nullptr;
 }
 
-Name* NamePool::getName(String const& text)
+Index RootNamePool::Shard::findEntryIndex(const UnownedStringSlice& text, HashCode hash) const
 {
-    RefPtr<Name> name;
-    if (rootPool->names.TryGetValue(text, name))
-        return name;
+    const Index mask = entries.getCount() - 1;
+    for (Index i = Index(UInt32(hash)) & mask; ; i = (i + 1) & mask)
+    {
+        const Entry& entry = entries[i];
+        if (!entry.name || (entry.hash == hash && entry.name->text.getUnownedSlice() == text))
+        {
+            return i;
+        }
+    }
+}
+
+void RootNamePool::Shard::grow()
+{
+    List<Entry> oldEntries;
+    oldEntries.swapWith(entries);
+
+    const Entry emptyEntry = { 0, nullptr };
+    entries.setCount(oldEntries.getCount() ? oldEntries.getCount() * 2 : 64);
+    for (auto& entry : entries)
+    {
+        entry = emptyEntry;
+    }
+
+    for (const auto& entry : oldEntries)
+    {
+        if (entry.name)
+        {
+            entries[findEntryIndex(entry.name->text.getUnownedSlice(), entry.hash)] = entry;
+        }
+    }
+}
+
+Name* RootNamePool::getName(const UnownedStringSlice& text, HashCode hash)
+{
+    Shard& shard = m_shards[_getShardIndex(hash)];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    // Keep the table at most half full, so probe sequences stay short
+    if ((shard.count + 1) * 2 > shard.entries.getCount())
+    {
+        shard.grow();
+    }
+
+    auto& entry = shard.entries[shard.findEntryIndex(text, hash)];
+    if (!entry.name)
+    {
+        RefPtr<Name> name = new Name();
+        name->text = text;
+        shard.names.add(name);
+
+        entry.hash = hash;
+        entry.name = name;
+        shard.count++;
+    }
+    return entry.name;
+}
+
+Name* RootNamePool::tryGetName(const UnownedStringSlice& text, HashCode hash)
+{
+    Shard& shard = m_shards[_getShardIndex(hash)];
+    std::lock_guard<std::mutex> lock(shard.mutex);
 
-    name = new Name();
-    name->text = text;
-    rootPool->names.Add(text, name);
-    return name;
+    if (shard.count == 0)
+    {
+        return nullptr;
+    }
+    return shard.entries[shard.findEntryIndex(text, hash)].name;
 }
 
-Name* NamePool::tryGetName(String const& text)
+Index RootNamePool::getCount()
 {
-    RefPtr<Name> name;
-    if (rootPool->names.TryGetValue(text, name))
-        return name;
-    return nullptr;
+    Index count = 0;
+    for (auto& shard : m_shards)
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        count += shard.count;
+    }
+    return count;
 }
 
 } // namespace Slang
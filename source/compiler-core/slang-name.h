@@ -7,6 +7,8 @@
 
 #include "../core/slang-basic.h"
 
+#include <mutex>
+
 namespace Slang {
 
 // The `Name` type is used to represent the name of a type, variable, etc.
@@ -47,10 +49,46 @@ const char* getCstr(Name* name);
 // get equivalent names for a string like `"Foo"`, then they need to use
 // the same root name pool (directly or indirectly).
 //
-struct RootNamePool
+// Names are looked up directly by their text and hash, so finding an existing name
+// doesn't allocate. The pool is split into shards (selected by the hash) that each
+// have their own lock, so that it can be shared by front-end work on multiple threads.
+//
+class RootNamePool
 {
-    // The mapping from text strings to the corresponding name.
-    Dictionary<String, RefPtr<Name> > names;
+public:
+        /// Find or create the name for `text`, with `hash` as `getHashCode(text)`.
+    Name* getName(const UnownedStringSlice& text, HashCode hash);
+        /// Find the name for `text`, with `hash` as `getHashCode(text)`. Returns nullptr if there isn't one.
+    Name* tryGetName(const UnownedStringSlice& text, HashCode hash);
+
+        /// Get the number of names in the pool
+    Index getCount();
+
+protected:
+    enum { kShardCount = 16 };
+
+    struct Shard
+    {
+            /// Find the index in `entries` holding the name for `text`, or the empty entry where it would go
+        Index findEntryIndex(const UnownedStringSlice& text, HashCode hash) const;
+            /// Double the size of `entries`
+        void grow();
+
+        struct Entry
+        {
+            HashCode hash;
+            Name* name;             ///< nullptr if the entry is empty
+        };
+
+        std::mutex mutex;
+        List<Entry> entries;        ///< Open addressed hash table. The count is a power of 2 (or 0).
+        Index count = 0;            ///< The number of names in `entries`
+        List<RefPtr<Name>> names;   ///< Owns the names in the shard
+    };
+
+    static Index _getShardIndex(HashCode hash) { return Index((UInt32(hash) >> 16) & (kShardCount - 1)); }
+
+    Shard m_shards[kShardCount];
 };
 
 // A `NamePool` is effectively a way of storing a subset of the
@@ -68,10 +106,13 @@ struct RootNamePool
 struct NamePool
 {
     // Find or create the `Name` that represents the given `text`.
-    Name* getName(String const& text);
+    Name* getName(const UnownedStringSlice& text) { return rootPool->getName(text, text.getHashCode()); }
+    Name* getName(String const& text) { return getName(text.getUnownedSlice()); }
+    Name* getName(const char* text) { return getName(UnownedStringSlice(text)); }
     // Try find the `Name` that represents the given `text`.
     // If the name does not exist, return nullptr
-    Name* tryGetName(String const& text);
+    Name* tryGetName(const UnownedStringSlice& text) { return rootPool->tryGetName(text, text.getHashCode()); }
+    Name* tryGetName(String const& text) { return tryGetName(text.getUnownedSlice()); }
     // Set the parent name pool to use for lookup
     void setRootNamePool(RootNamePool* rootNamePool)
     {
@@ -8,6 +8,16 @@
 #include "slang-exception.h"
 #include "slang-math.h"
 #include "slang-hash.h"
+#include "slang-byte-encode-util.h"
+
+#include <new>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define SLANG_DICTIONARY_SSE2 1
+#   include <emmintrin.h>
+#else
+#   define SLANG_DICTIONARY_SSE2 0
+#endif
 
 namespace Slang
 {
@@ -75,6 +85,80 @@ namespace Slang
 
 	const float MaxLoadFactor = 0.7f;
 
+        /// The control bytes of a `Dictionary`, and operations on groups of them
+    struct DictionaryControl
+    {
+        typedef int8_t Control;
+
+            /// A slot that is full has a control value in [0, 127] holding 7 bits of the key's hash.
+            /// Both empty and deleted are negative.
+        static const Control kEmpty = -128;
+        static const Control kDeleted = -2;
+
+            /// The number of slots (and so control bytes) in a group, which are probed together
+        static const Index kGroupSize = 16;
+
+            /// A bit mask holding a bit for each slot in a group
+        typedef uint32_t BitMask;
+
+            /// Get the index of the lowest set bit. `mask` must not be 0.
+        static int getLowestBitIndex(BitMask mask) { return ByteEncodeUtil::calcMsb32(mask & (0u - mask)); }
+
+#if SLANG_DICTIONARY_SSE2
+        static BitMask match(const Control* group, Control value)
+        {
+            const __m128i controls = _mm_loadu_si128((const __m128i*)group);
+            return BitMask(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(value), controls)));
+        }
+        static BitMask matchEmptyOrDeleted(const Control* group)
+        {
+            // Both are negative, so just need the sign bits
+            return BitMask(_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)group)));
+        }
+#else
+        static BitMask match(const Control* group, Control value)
+        {
+            BitMask mask = 0;
+            for (Index i = 0; i < kGroupSize; ++i)
+            {
+                mask |= BitMask(group[i] == value) << i;
+            }
+            return mask;
+        }
+        static BitMask matchEmptyOrDeleted(const Control* group)
+        {
+            BitMask mask = 0;
+            for (Index i = 0; i < kGroupSize; ++i)
+            {
+                mask |= BitMask(group[i] < 0) << i;
+            }
+            return mask;
+        }
+#endif
+        static BitMask matchEmpty(const Control* group) { return match(group, kEmpty); }
+
+            /// Mix the hash code, such that all of its bits affect both the group index and the control value
+        static uint64_t mixHash(HashCode hash) { const uint64_t m = uint64_t(hash) * 0x9e3779b97f4a7c15ull; return m ^ (m >> 32); }
+            /// Get the control value (7 bits) for a mixed hash
+        static Control getControl(uint64_t mixedHash) { return Control(mixedHash >> 57); }
+    };
+
+    /* Dictionary is an open addressing hash table, in the style of 'SwissTable'.
+
+    Alongside the slots holding the key/value pairs, there is an array holding a control byte for
+    each slot, which records if the slot is empty, deleted, or full. For a full slot the control byte
+    also holds 7 bits of the key's hash. Slots are probed a group (of DictionaryControl::kGroupSize)
+    at a time - the control bytes of a whole group are compared against the control value for a key
+    at once (using SSE2 where available), and only the slots that match have their keys compared.
+
+    The capacity is a power of 2 multiple of the group size, so the first group to probe is found from
+    the hash with a mask, and groups are then probed in a triangular sequence which visits every group.
+    Probing stops at the first group with an empty slot.
+
+    The iteration order is unspecified - it depends on the hashes of the keys (which for pointers
+    differ between runs), the capacity, and the history of adds and removes. Anything that produces
+    output (such as diagnostics, reflection or serialized data) from iterating over the contents
+    should use OrderedDictionary, or sort. */
 	template<typename TKey, typename TValue>
 	class Dictionary
 	{
@@ -83,185 +167,225 @@ namespace Slang
     public:
         typedef TValue ValueType;
         typedef TKey KeyType;
-	private:
-		inline int GetProbeOffset(int /*probeId*/) const
-		{
-			// linear probing
-			return 1;
-		}
-	private:
-		int bucketSizeMinusOne;
-		int _count;
-		UIntSet marks;
-		KeyValuePair<TKey, TValue>* hashMap;
-		void Free()
-		{
-			if (hashMap)
-				delete[] hashMap;
-			hashMap = 0;
-		}
-		inline bool IsDeleted(int pos) const
-		{
-			return marks.contains((pos << 1) + 1);
-		}
-		inline bool IsEmpty(int pos) const
-		{
-			return !marks.contains((pos << 1));
-		}
-		inline void SetDeleted(int pos, bool val)
-		{
-			if (val)
-				marks.add((pos << 1) + 1);
-			else
-				marks.remove((pos << 1) + 1);
-		}
-		inline void SetEmpty(int pos, bool val)
-		{
-			if (val)
-				marks.remove((pos << 1));
-			else
-				marks.add((pos << 1));
-		}
-		struct FindPositionResult
-		{
-			int ObjectPosition;
-			int InsertionPosition;
-			FindPositionResult()
-			{
-				ObjectPosition = -1;
-				InsertionPosition = -1;
-			}
-			FindPositionResult(int objPos, int insertPos)
-			{
-				ObjectPosition = objPos;
-				InsertionPosition = insertPos;
-			}
 
-		};
+    private:
+        typedef KeyValuePair<TKey, TValue> Pair;
+        typedef DictionaryControl::Control Control;
+        typedef DictionaryControl::BitMask BitMask;
+
+        static const Index kGroupSize = DictionaryControl::kGroupSize;
+
+            /// The maximum amount of slots that can be used (full or deleted) for a capacity - a load factor of 7/8
+        static Index _calcMaxUsed(Index capacity) { return capacity - (capacity >> 3); }
+
+            /// Find the slot index holding `key`, or -1 if not found
         template<typename KeyType>
-		inline int GetHashPos(KeyType& key) const
+        Index _find(const KeyType& key, uint64_t mixedHash) const
         {
-            SLANG_ASSERT(bucketSizeMinusOne > 0);
-            const unsigned int hash = (unsigned int)getHashCode(key);
-            return (hash * 2654435761u) % (unsigned int)(bucketSizeMinusOne);
-		}
-        template<typename KeyType>
-		FindPositionResult FindPosition(const KeyType& key) const
-		{
-			int hashPos = GetHashPos(const_cast<KeyType&>(key));
-			int insertPos = -1;
-			int numProbes = 0;
-			while (numProbes <= bucketSizeMinusOne)
-			{
-				if (IsEmpty(hashPos))
-				{
-					if (insertPos == -1)
-						return FindPositionResult(-1, hashPos);
-					else
-						return FindPositionResult(-1, insertPos);
-				}
-				else if (IsDeleted(hashPos))
-				{
-					if (insertPos == -1)
-						insertPos = hashPos;
-				}
-				else if (hashMap[hashPos].Key == key)
-				{
-					return FindPositionResult(hashPos, -1);
-				}
-				numProbes++;
-				hashPos = (hashPos + GetProbeOffset(numProbes)) & bucketSizeMinusOne;
-			}
-			if (insertPos != -1)
-				return FindPositionResult(-1, insertPos);
-			SLANG_ASSERT_FAILURE("Hash map is full. This indicates an error in Key::Equal or Key::getHashCode.");
-		}
-		TValue & _Insert(KeyValuePair<TKey, TValue>&& kvPair, int pos)
-		{
-			hashMap[pos] = _Move(kvPair);
-			SetEmpty(pos, false);
-			SetDeleted(pos, false);
-			return hashMap[pos].Value;
-		}
-		void Rehash()
-		{
-			if (bucketSizeMinusOne == -1 || _count >= int(MaxLoadFactor * bucketSizeMinusOne))
-			{
-				int newSize = (bucketSizeMinusOne + 1) * 2;
-				if (newSize == 0)
-				{
-					newSize = 16;
-				}
-				Dictionary<TKey, TValue> newDict;
-				newDict.bucketSizeMinusOne = newSize - 1;
-				newDict.hashMap = new KeyValuePair<TKey, TValue>[newSize];
-				newDict.marks.resizeAndClear(newSize * 2);
-				if (hashMap)
-				{
-					for (auto & kvPair : *this)
-					{
-						newDict.Add(_Move(kvPair));
-					}
-				}
-				*this = _Move(newDict);
-			}
-		}
+            if (m_capacity == 0)
+            {
+                return -1;
+            }
 
-		bool AddIfNotExists(KeyValuePair<TKey, TValue>&& kvPair)
+            const Control control = DictionaryControl::getControl(mixedHash);
+            const Index groupMask = (m_capacity / kGroupSize) - 1;
+
+            Index groupIndex = Index(mixedHash) & groupMask;
+            for (Index probe = 1; ; ++probe)
+            {
+                const Index groupStart = groupIndex * kGroupSize;
+                const Control* group = m_controls + groupStart;
+
+                for (BitMask mask = DictionaryControl::match(group, control); mask; mask &= mask - 1)
+                {
+                    const Index slotIndex = groupStart + DictionaryControl::getLowestBitIndex(mask);
+                    if (m_slots[slotIndex].Key == key)
+                    {
+                        return slotIndex;
+                    }
+                }
+                if (DictionaryControl::matchEmpty(group) || probe > groupMask)
+                {
+                    return -1;
+                }
+                groupIndex = (groupIndex + probe) & groupMask;
+            }
+        }
+
+            /// Find a slot to insert a key with the mixedHash. There must be a slot that is empty or deleted.
+        Index _findInsertSlot(uint64_t mixedHash) const
+        {
+            const Index groupMask = (m_capacity / kGroupSize) - 1;
+
+            Index groupIndex = Index(mixedHash) & groupMask;
+            for (Index probe = 1; ; ++probe)
+            {
+                const Index groupStart = groupIndex * kGroupSize;
+                if (const BitMask mask = DictionaryControl::matchEmptyOrDeleted(m_controls + groupStart))
+                {
+                    return groupStart + DictionaryControl::getLowestBitIndex(mask);
+                }
+                SLANG_ASSERT(probe <= groupMask);
+                groupIndex = (groupIndex + probe) & groupMask;
+            }
+        }
+
+            /// Construct a pair in a slot that is empty or deleted. Returns the value.
+        TValue& _insertAt(Index slotIndex, uint64_t mixedHash, Pair&& pair)
+        {
+            Control& control = m_controls[slotIndex];
+            SLANG_ASSERT(control < 0);
+
+            m_used += Index(control == DictionaryControl::kEmpty);
+            control = DictionaryControl::getControl(mixedHash);
+            m_count++;
+
+            Pair* slot = new (m_slots + slotIndex) Pair(_Move(pair));
+            return slot->Value;
+        }
+
+            /// Make sure there is space to insert another key, without exceeding the load factor
+        void _reserveForInsert()
+        {
+            if (m_used < _calcMaxUsed(m_capacity))
+            {
+                return;
+            }
+            // If a lot of the used slots are just deleted, rehash in place, else grow
+            if (m_capacity && m_count * 32 <= m_capacity * 25)
+            {
+                _rehash(m_capacity);
+            }
+            else
+            {
+                _rehash(m_capacity ? m_capacity * 2 : kGroupSize);
+            }
+        }
+
+        void _rehash(Index newCapacity)
+        {
+            Dictionary newDict;
+            newDict._allocate(newCapacity);
+
+            for (Index i = 0; i < m_capacity; ++i)
+            {
+                if (m_controls[i] >= 0)
+                {
+                    Pair& pair = m_slots[i];
+                    const uint64_t mixedHash = DictionaryControl::mixHash(getHashCode(pair.Key));
+                    newDict._insertAt(newDict._findInsertSlot(mixedHash), mixedHash, _Move(pair));
+                }
+            }
+            *this = _Move(newDict);
+        }
+
+            /// Allocate storage for `capacity` slots, which are all empty. Must not be holding any storage.
+        void _allocate(Index capacity)
+        {
+            SLANG_ASSERT(m_slots == nullptr && capacity > 0 && (capacity & (capacity - 1)) == 0 && capacity >= kGroupSize);
+
+            // The slots and then the controls are held in a single allocation
+            m_slots = (Pair*)::operator new(size_t(capacity) * (sizeof(Pair) + sizeof(Control)));
+            m_controls = (Control*)(m_slots + capacity);
+            ::memset(m_controls, uint8_t(DictionaryControl::kEmpty), size_t(capacity));
+
+            m_capacity = capacity;
+            m_used = 0;
+            m_count = 0;
+        }
+
+            /// Destroy all of the pairs, leaving all slots empty
+        void _destroyAll()
+        {
+            for (Index i = 0; i < m_capacity; ++i)
+            {
+                if (m_controls[i] >= 0)
+                {
+                    m_slots[i].~Pair();
+                }
+            }
+            if (m_capacity)
+            {
+                ::memset(m_controls, uint8_t(DictionaryControl::kEmpty), size_t(m_capacity));
+            }
+            m_count = 0;
+            m_used = 0;
+        }
+
+        void Free()
+        {
+            _destroyAll();
+            ::operator delete(m_slots);
+            m_slots = nullptr;
+            m_controls = nullptr;
+            m_capacity = 0;
+        }
+
+		bool AddIfNotExists(Pair&& kvPair)
 		{
-			Rehash();
-			auto pos = FindPosition(kvPair.Key);
-			if (pos.ObjectPosition != -1)
-				return false;
-			else if (pos.InsertionPosition != -1)
-			{
-				_count++;
-				_Insert(_Move(kvPair), pos.InsertionPosition);
-				return true;
-			}
-			else
-				SLANG_ASSERT_FAILURE("Inconsistent find result returned. This is a bug in Dictionary implementation.");
+            const uint64_t mixedHash = DictionaryControl::mixHash(getHashCode(kvPair.Key));
+            if (_find(kvPair.Key, mixedHash) >= 0)
+            {
+                return false;
+            }
+            _reserveForInsert();
+            _insertAt(_findInsertSlot(mixedHash), mixedHash, _Move(kvPair));
+            return true;
 		}
-		void Add(KeyValuePair<TKey, TValue>&& kvPair)
+		void Add(Pair&& kvPair)
 		{
 			if (!AddIfNotExists(_Move(kvPair)))
                 SLANG_ASSERT_FAILURE("The key already exists in Dictionary.");
 		}
-		TValue& Set(KeyValuePair<TKey, TValue>&& kvPair)
+		TValue& Set(Pair&& kvPair)
 		{
-			Rehash();
-			auto pos = FindPosition(kvPair.Key);
-			if (pos.ObjectPosition != -1)
-				return _Insert(_Move(kvPair), pos.ObjectPosition);
-			else if (pos.InsertionPosition != -1)
-			{
-				_count++;
-				return _Insert(_Move(kvPair), pos.InsertionPosition);
-			}
-			else
-                SLANG_ASSERT_FAILURE("Inconsistent find result returned. This is a bug in Dictionary implementation.");
+            const uint64_t mixedHash = DictionaryControl::mixHash(getHashCode(kvPair.Key));
+            const Index slotIndex = _find(kvPair.Key, mixedHash);
+            if (slotIndex >= 0)
+            {
+                m_slots[slotIndex] = _Move(kvPair);
+                return m_slots[slotIndex].Value;
+            }
+            _reserveForInsert();
+            return _insertAt(_findInsertSlot(mixedHash), mixedHash, _Move(kvPair));
 		}
+
+            /// Returns the value for key, adding value if there isn't one. Sets isAdded if value was added.
+        TValue& _getOrAdd(const TKey& key, const TValue& value, bool& outIsAdded)
+        {
+            const uint64_t mixedHash = DictionaryControl::mixHash(getHashCode(const_cast<TKey&>(key)));
+            const Index slotIndex = _find(key, mixedHash);
+            if (slotIndex >= 0)
+            {
+                outIsAdded = false;
+                return m_slots[slotIndex].Value;
+            }
+            _reserveForInsert();
+            outIsAdded = true;
+            return _insertAt(_findInsertSlot(mixedHash), mixedHash, Pair(key, value));
+        }
+
 	public:
 		class Iterator
 		{
 		private:
 			const Dictionary<TKey, TValue> * dict;
-			int pos;
+			Index pos;
 		public:
 			KeyValuePair<TKey, TValue> & operator *() const
 			{
-				return dict->hashMap[pos];
+				return dict->m_slots[pos];
 			}
 			KeyValuePair<TKey, TValue> * operator ->() const
 			{
-				return dict->hashMap + pos;
+				return dict->m_slots + pos;
 			}
 			Iterator & operator ++()
 			{
-				if (pos > dict->bucketSizeMinusOne)
+				if (pos >= dict->m_capacity)
 					return *this;
 				pos++;
-				while (pos <= dict->bucketSizeMinusOne && (dict->IsDeleted(pos) || dict->IsEmpty(pos)))
+				while (pos < dict->m_capacity && dict->m_controls[pos] < 0)
 				{
 					pos++;
 				}
@@ -281,7 +405,7 @@ namespace Slang
 			{
 				return pos == _that.pos && dict == _that.dict;
 			}
-			Iterator(const Dictionary<TKey, TValue> * _dict, int _pos)
+			Iterator(const Dictionary<TKey, TValue> * _dict, Index _pos)
 			{
 				this->dict = _dict;
 				this->pos = _pos;
@@ -295,19 +419,16 @@ namespace Slang
 
 		Iterator begin() const
 		{
-			int pos = 0;
-			while (pos < bucketSizeMinusOne + 1)
+			Index pos = 0;
+			while (pos < m_capacity && m_controls[pos] < 0)
 			{
-				if (IsEmpty(pos) || IsDeleted(pos))
-					pos++;
-				else
-					break;
+				pos++;
 			}
 			return Iterator(this, pos);
 		}
 		Iterator end() const
 		{
-			return Iterator(this, bucketSizeMinusOne + 1);
+			return Iterator(this, m_capacity);
 		}
 	public:
 		void Add(const TKey & key, const TValue & value)
@@ -328,61 +449,48 @@ namespace Slang
 		}
 		void Remove(const TKey & key)
 		{
-			if (_count == 0)
+			if (m_count == 0)
 				return;
-			auto pos = FindPosition(key);
-			if (pos.ObjectPosition != -1)
-			{
-				SetDeleted(pos.ObjectPosition, true);
-				_count--;
-			}
+            const Index slotIndex = _find(key, DictionaryControl::mixHash(getHashCode(const_cast<TKey&>(key))));
+            if (slotIndex < 0)
+            {
+                return;
+            }
+
+            m_slots[slotIndex].~Pair();
+            m_count--;
+
+            // If the group still has an empty slot, no probe can have continued past this group, so
+            // the slot can be made empty. Otherwise it has to be marked deleted so probes continue past it.
+            const Index groupStart = slotIndex & ~(kGroupSize - 1);
+            if (DictionaryControl::matchEmpty(m_controls + groupStart))
+            {
+                m_controls[slotIndex] = DictionaryControl::kEmpty;
+                m_used--;
+            }
+            else
+            {
+                m_controls[slotIndex] = DictionaryControl::kDeleted;
+            }
 		}
 		void Clear()
 		{
-			_count = 0;
-
-			marks.clear();
+            _destroyAll();
 		}
 
         TValue* TryGetValueOrAdd(const TKey& key, const TValue& value)
         {
-            Rehash();
-            auto pos = FindPosition(key);
-            if (pos.ObjectPosition != -1)
-            {
-                return &hashMap[pos.ObjectPosition].Value;
-            }
-            else if (pos.InsertionPosition != -1)
-            {
-                // Make pair
-                KeyValuePair<TKey, TValue> kvPair(_Move(key), _Move(value));
-                _count++;
-                _Insert(_Move(kvPair), pos.InsertionPosition);
-                return nullptr;
-            }
-            else
-                SLANG_ASSERT_FAILURE("Inconsistent find result returned. This is a bug in Dictionary implementation.");
+            bool isAdded;
+            TValue& dictValue = _getOrAdd(key, value, isAdded);
+            return isAdded ? nullptr : &dictValue;
         }
 
             /// This differs from TryGetValueOrAdd, in that it always returns the Value held in the Dictionary.
             /// If there isn't already an entry for 'key', a value is added with defaultValue. 
         TValue& GetOrAddValue(const TKey& key, const TValue& defaultValue)
         {
-            Rehash();
-            auto pos = FindPosition(key);
-            if (pos.ObjectPosition != -1)
-            {
-                return hashMap[pos.ObjectPosition].Value;
-            }
-            else if (pos.InsertionPosition != -1)
-            {
-                // Make pair
-                KeyValuePair<TKey, TValue> kvPair(_Move(key), _Move(defaultValue));
-                _count++;
-                return _Insert(_Move(kvPair), pos.InsertionPosition);
-            }
-            else
-                SLANG_ASSERT_FAILURE("Inconsistent find result returned. This is a bug in Dictionary implementation.");
+            bool isAdded;
+            return _getOrAdd(key, defaultValue, isAdded);
         }
         void Set(const TKey& key, const TValue& value)
 		{
@@ -395,35 +503,34 @@ namespace Slang
         template<typename KeyType>
 		bool ContainsKey(const KeyType& key) const
 		{
-			if (bucketSizeMinusOne == -1)
-				return false;
-			auto pos = FindPosition(key);
-			return pos.ObjectPosition != -1;
+            return m_count && _find(key, DictionaryControl::mixHash(getHashCode(const_cast<KeyType&>(key)))) >= 0;
 		}
         template<typename KeyType>
 		bool TryGetValue(const KeyType& key, TValue& value) const
 		{
-			if (bucketSizeMinusOne == -1)
-				return false;
-			auto pos = FindPosition(key);
-			if (pos.ObjectPosition != -1)
-			{
-				value = hashMap[pos.ObjectPosition].Value;
-				return true;
-			}
-			return false;
+            if (m_count == 0)
+            {
+                return false;
+            }
+            // Don't go through the pointer returning overload, as that requires TValue to
+            // support taking its address (ComPtr for example does not).
+            const Index slotIndex = _find(key, DictionaryControl::mixHash(getHashCode(const_cast<KeyType&>(key))));
+            if (slotIndex >= 0)
+            {
+                value = m_slots[slotIndex].Value;
+                return true;
+            }
+            return false;
 		}
         template<typename KeyType>
 		TValue* TryGetValue(const KeyType& key) const
 		{
-			if (bucketSizeMinusOne == -1)
-				return nullptr;
-			auto pos = FindPosition(key);
-			if (pos.ObjectPosition != -1)
-			{
-				return &hashMap[pos.ObjectPosition].Value;
-			}
-			return nullptr;
+            if (m_count == 0)
+            {
+                return nullptr;
+            }
+            const Index slotIndex = _find(key, DictionaryControl::mixHash(getHashCode(const_cast<KeyType&>(key))));
+            return slotIndex >= 0 ? &m_slots[slotIndex].Value : nullptr;
 		}
 
 		class ItemProxy
@@ -444,11 +551,10 @@ namespace Slang
 			}
 			TValue & GetValue() const
 			{
-				auto pos = dict->FindPosition(key);
-				if (pos.ObjectPosition != -1)
-				{
-					return dict->hashMap[pos.ObjectPosition].Value;
-				}
+                if (TValue* value = dict->TryGetValue(key))
+                {
+                    return *value;
+                }
 				else
                     SLANG_ASSERT_FAILURE("The key does not exists in dictionary.");
 			}
@@ -477,9 +583,9 @@ namespace Slang
 		{
 			return ItemProxy(_Move(key), this);
 		}
-		int Count() const
+		Index Count() const
 		{
-			return _count;
+			return m_count;
 		}
 	private:
 		template<typename... Args>
@@ -491,9 +597,6 @@ namespace Slang
 	public:
 		Dictionary()
 		{
-			bucketSizeMinusOne = -1;
-			_count = 0;
-			hashMap = nullptr;
 		}
 		template<typename Arg, typename... Args>
 		Dictionary(Arg arg, Args... args)
@@ -501,12 +604,10 @@ namespace Slang
 			Init(arg, args...);
 		}
 		Dictionary(const Dictionary<TKey, TValue>& other)
-			: bucketSizeMinusOne(-1), _count(0), hashMap(nullptr)
 		{
 			*this = other;
 		}
 		Dictionary(Dictionary<TKey, TValue>&& other)
-			: bucketSizeMinusOne(-1), _count(0), hashMap(nullptr)
 		{
 			*this = (_Move(other));
 		}
@@ -515,12 +616,21 @@ namespace Slang
 			if (this == &other)
 				return *this;
 			Free();
-			bucketSizeMinusOne = other.bucketSizeMinusOne;
-			_count = other._count;
-			hashMap = new KeyValuePair<TKey, TValue>[other.bucketSizeMinusOne + 1];
-			marks = other.marks;
-			for (int i = 0; i <= bucketSizeMinusOne; i++)
-				hashMap[i] = other.hashMap[i];
+            if (other.m_capacity)
+            {
+                // Copy with the same layout, so doesn't require any hashing
+                _allocate(other.m_capacity);
+                for (Index i = 0; i < m_capacity; ++i)
+                {
+                    if (other.m_controls[i] >= 0)
+                    {
+                        new (m_slots + i) Pair(other.m_slots[i]);
+                    }
+                }
+                ::memcpy(m_controls, other.m_controls, size_t(m_capacity));
+                m_count = other.m_count;
+                m_used = other.m_used;
+            }
 			return *this;
 		}
 		Dictionary<TKey, TValue> & operator = (Dictionary<TKey, TValue>&& other)
@@ -528,19 +638,30 @@ namespace Slang
 			if (this == &other)
 				return *this;
 			Free();
-			bucketSizeMinusOne = other.bucketSizeMinusOne;
-			_count = other._count;
-			hashMap = other.hashMap;
-			marks = _Move(other.marks);
-			other.hashMap = 0;
-			other._count = 0;
-			other.bucketSizeMinusOne = -1;
+            m_slots = other.m_slots;
+            m_controls = other.m_controls;
+            m_capacity = other.m_capacity;
+            m_count = other.m_count;
+            m_used = other.m_used;
+
+            other.m_slots = nullptr;
+            other.m_controls = nullptr;
+            other.m_capacity = 0;
+            other.m_count = 0;
+            other.m_used = 0;
 			return *this;
 		}
 		~Dictionary()
 		{
 			Free();
 		}
+
+    private:
+        Pair* m_slots = nullptr;            ///< The slots. Only slots whose control is full hold a constructed pair
+        Control* m_controls = nullptr;      ///< A control byte for each slot
+        Index m_capacity = 0;               ///< The number of slots. 0, or a power of 2 multiple of kGroupSize
+        Index m_count = 0;                  ///< The number of full slots
+        Index m_used = 0;                   ///< The number of full or deleted slots
 	};
 
 	class _DummyClass
@@ -632,7 +753,7 @@ namespace Slang
 			return Iterator(dict.end());
 		}
 	public:
-		int Count() const
+		Index Count() const
 		{
 			return dict.Count();
 		}
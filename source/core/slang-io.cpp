@@ -39,6 +39,10 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <chrono>
+#include <functional>
+#include <thread>
+
 namespace Slang
 {
 
@@ -915,6 +919,41 @@ namespace Slang
         return SLANG_OK;
     }
     
+    /* static */SlangResult File::writeAllBytesAtomically(const String& path, const void* data, size_t size)
+    {
+        // The temporary name has to be unique across threads and processes writing the same file
+        StringBuilder tempPath;
+        tempPath << path << ".";
+        tempPath.append(uint64_t(std::hash<std::thread::id>()(std::this_thread::get_id())), 16);
+        tempPath << ".";
+        tempPath.append(uint64_t(std::chrono::steady_clock::now().time_since_epoch().count()), 16);
+
+        SLANG_RETURN_ON_FAIL(writeAllBytes(tempPath, data, size));
+
+        const SlangResult res = move(tempPath, path);
+        if (SLANG_FAILED(res))
+        {
+            remove(tempPath);
+        }
+        return res;
+    }
+
+    /* static */SlangResult File::move(const String& fromPath, const String& toPath)
+    {
+#ifdef _WIN32
+        // `rename` fails on Windows if the destination exists.
+        // https://docs.microsoft.com/en-us/windows/win32/api/winbase/nf-winbase-movefileexw
+        if (MoveFileExW(fromPath.toWString(), toPath.toWString(), MOVEFILE_REPLACE_EXISTING))
+        {
+            return SLANG_OK;
+        }
+        return SLANG_FAIL;
+#else
+        // https://linux.die.net/man/3/rename
+        return (::rename(fromPath.getBuffer(), toPath.getBuffer()) == 0) ? SLANG_OK : SLANG_FAIL;
+#endif
+    }
+
     SlangResult File::writeAllText(const Slang::String& fileName, const Slang::String& text)
     {
         RefPtr<FileStream> stream = new FileStream;
@@ -25,9 +25,16 @@ namespace Slang
         static SlangResult writeNativeText(const String& filename, const void* data, size_t size);
 
         static SlangResult writeAllBytes(const String& fileName, const void* data, size_t size);
+
+            /// Write the bytes to a temporary file next to `fileName`, which is then moved to `fileName`
+            /// (replacing any existing file). Other processes never see a partially written file.
+        static SlangResult writeAllBytesAtomically(const String& fileName, const void* data, size_t size);
         
         static SlangResult remove(const String& fileName);
 
+            /// Move the file at `fromPath` to `toPath`, replacing any file already at `toPath`.
+        static SlangResult move(const String& fromPath, const String& toPath);
+
         static SlangResult makeExecutable(const String& fileName);
 
             /// Creates a temporary file typically in some way based on the prefix
@@ -294,6 +294,19 @@ void MemoryArena::addExternalBlock(void* inData, size_t size)
     }
 }
 
+void MemoryArena::swapWith(ThisType& rhs)
+{
+    Swap(m_start, rhs.m_start);
+    Swap(m_end, rhs.m_end);
+    Swap(m_current, rhs.m_current);
+    Swap(m_blockPayloadSize, rhs.m_blockPayloadSize);
+    Swap(m_blockAllocSize, rhs.m_blockAllocSize);
+    Swap(m_blockAlignment, rhs.m_blockAlignment);
+    Swap(m_availableBlocks, rhs.m_availableBlocks);
+    Swap(m_usedBlocks, rhs.m_usedBlocks);
+    m_blockFreeList.swapWith(rhs.m_blockFreeList);
+}
+
 void* MemoryArena::_allocateAlignedFromNewBlockAndZero(size_t sizeInBytes, size_t alignment)
 {
     void* mem = _allocateAlignedFromNewBlock(sizeInBytes, alignment);
@@ -275,8 +275,11 @@ struct DumpVisitor : public RiffContainer::Visitor
     return write(container->getRoot(), true, stream);
 }
 
-/* static */SlangResult RiffUtil::read(Stream* stream, RiffContainer& outContainer)
+// If `inPlaceData` is set, `stream` reads from it, and data payloads that are suitably aligned reference it
+// rather than being copied.
+static SlangResult _read(Stream* stream, const uint8_t* inPlaceData, RiffContainer& outContainer)
 {
+    typedef RiffUtil::Chunk Chunk;
     typedef RiffContainer::ScopeChunk ScopeChunk;
     typedef RiffContainer::ScopeChunk ScopeContainer;
     outContainer.reset();
@@ -285,13 +288,13 @@ struct DumpVisitor : public RiffContainer::Visitor
     {
         RiffListHeader header;
 
-        SLANG_RETURN_ON_FAIL(readHeader(stream, header));
-        if (!isListType(header.chunk.type))
+        SLANG_RETURN_ON_FAIL(RiffUtil::readHeader(stream, header));
+        if (!RiffUtil::isListType(header.chunk.type))
         {
             return SLANG_FAIL;
         }
 
-        remaining = getPadSize(header.chunk.size) - (sizeof(RiffListHeader) - sizeof(RiffHeader));
+        remaining = RiffUtil::getPadSize(header.chunk.size) - (sizeof(RiffListHeader) - sizeof(RiffHeader));
         outContainer.startChunk(Chunk::Kind::List, header.subType);
     }
 
@@ -314,7 +317,7 @@ struct DumpVisitor : public RiffContainer::Visitor
         else
         {
             RiffListHeader header;
-            SLANG_RETURN_ON_FAIL(readHeader(stream, header));
+            SLANG_RETURN_ON_FAIL(RiffUtil::readHeader(stream, header));
 
             // The amount of data can't be larger than what remains
             if (header.chunk.size > remaining)
@@ -331,7 +334,7 @@ struct DumpVisitor : public RiffContainer::Visitor
                 }
 
                 // Work out the pad size
-                const size_t padSize = getPadSize(header.chunk.size);
+                const size_t padSize = RiffUtil::getPadSize(header.chunk.size);
 
                 // Subtract the size of this chunk from remaining of the current chunk
                 remaining -= sizeof(RiffHeader) + padSize;                
@@ -347,12 +350,36 @@ struct DumpVisitor : public RiffContainer::Visitor
             else
             {
                 ScopeChunk scopeChunk(&outContainer, Chunk::Kind::Data, header.chunk.type);
+
+                // An empty chunk has no data (as it is when written)
+                if (header.chunk.size == 0)
+                {
+                    remaining -= sizeof(RiffHeader);
+                    continue;
+                }
+
                 RiffContainer::Data* data = outContainer.addData();
-                
-                outContainer.setPayload(data, nullptr, header.chunk.size);
+
+                const uint8_t* inPlacePayload = inPlaceData ? (inPlaceData + stream->getPosition()) : nullptr;
 
                 size_t readSize;
-                SLANG_RETURN_ON_FAIL(readPayload(stream, header.chunk.size, data->getPayload(), readSize));
+                if (inPlacePayload && (size_t(inPlacePayload) & (RiffContainer::kPayloadMinAlignment - 1)) == 0)
+                {
+                    // Skip over the payload (and padding), checking all of the payload is in the data
+                    const Int64 position = stream->getPosition();
+                    readSize = RiffUtil::getPadSize(header.chunk.size);
+                    SLANG_RETURN_ON_FAIL(stream->seek(SeekOrigin::Current, readSize));
+                    if (stream->getPosition() - position < Int64(header.chunk.size))
+                    {
+                        return SLANG_FAIL;
+                    }
+                    outContainer.setUnowned(data, const_cast<uint8_t*>(inPlacePayload), header.chunk.size);
+                }
+                else
+                {
+                    outContainer.setPayload(data, nullptr, header.chunk.size);
+                    SLANG_RETURN_ON_FAIL(RiffUtil::readPayload(stream, header.chunk.size, data->getPayload(), readSize));
+                }
 
                 // All read sizes must end up aligned
                 SLANG_ASSERT((readSize & kRiffPadMask) == 0);
@@ -366,6 +393,17 @@ struct DumpVisitor : public RiffContainer::Visitor
     return outContainer.isFullyConstructed() ? SLANG_OK : SLANG_FAIL;
 }
 
+/* static */SlangResult RiffUtil::read(Stream* stream, RiffContainer& outContainer)
+{
+    return _read(stream, nullptr, outContainer);
+}
+
+/* static */SlangResult RiffUtil::readInPlace(const void* data, size_t dataSizeInBytes, RiffContainer& outContainer)
+{
+    MemoryStreamBase stream(FileAccess::Read, data, dataSizeInBytes);
+    return _read(&stream, (const uint8_t*)data, outContainer);
+}
+
 // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!! RiffContainer::Chunk !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
 
 SlangResult RiffContainer::Chunk::visit(Visitor* visitor)
@@ -483,6 +483,11 @@ struct RiffUtil
 
         /// Read the stream into the container
     static SlangResult read(Stream* stream, RiffContainer& outContainer);
+
+        /// Read the riff held in memory at `data` into the container.
+        /// Data chunk payloads that are suitably aligned (see RiffContainer::kPayloadMinAlignment) are not copied,
+        /// but reference `data` - so `data` must stay in scope for as long as the container is used.
+    static SlangResult readInPlace(const void* data, size_t dataSizeInBytes, RiffContainer& outContainer);
 };
 
 }
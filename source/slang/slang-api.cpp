@@ -872,3 +872,19 @@ SLANG_API void spSetDiagnosticFlags(slang::ICompileRequest* request, SlangDiagno
 
     request->setDiagnosticFlags(flags);
 }
+
+SLANG_API void spSetCompileTraceEnabled(slang::ICompileRequest* request, bool enable)
+{
+    if (!request)
+        return;
+
+    request->setCompileTraceEnabled(enable);
+}
+
+SLANG_API SlangResult spGetCompileTrace(slang::ICompileRequest* request, ISlangBlob** outTrace)
+{
+    if (!request)
+        return SLANG_E_INVALID_ARG;
+
+    return request->getCompileTrace(outTrace);
+}
@@ -336,10 +336,67 @@ Type* ASTBuilder::getAndType(Type* left, Type* right)
 
 Type* ASTBuilder::getModifiedType(Type* base, Count modifierCount, Val* const* modifiers)
 {
-    auto type = create<ModifiedType>();
-    type->base = base;
-    type->modifiers.addRange(modifiers, modifierCount);
-    return type;
+    NodeDesc desc;
+    desc.type = ModifiedType::kType;
+    desc.operands.add(base);
+    for (Index i = 0; i < modifierCount; ++i)
+    {
+        desc.operands.add(modifiers[i]);
+    }
+    // The fields are set when the node is created, as `base` isn't initialized
+    return (ModifiedType*)_getOrCreateImpl(desc, [&]()
+        {
+            auto type = create<ModifiedType>();
+            type->base = base;
+            type->modifiers.addRange(modifiers, modifierCount);
+            return type;
+        });
+}
+
+FuncType* ASTBuilder::getFuncType(ConstArrayView<Type*> paramTypes, Type* resultType, Type* errorType)
+{
+    NodeDesc desc;
+    desc.type = FuncType::kType;
+    desc.operands.add(resultType);
+    desc.operands.add(errorType);
+    for (auto paramType : paramTypes)
+    {
+        desc.operands.add(paramType);
+    }
+    return (FuncType*)_getOrCreateImpl(desc, [&]()
+        {
+            auto type = create<FuncType>();
+            type->resultType = resultType;
+            type->errorType = errorType;
+            type->paramTypes.addRange(paramTypes.getBuffer(), paramTypes.getCount());
+            return type;
+        });
+}
+
+ThisType* ASTBuilder::getThisType(DeclRef<InterfaceDecl> const& interfaceDeclRef)
+{
+    NodeDesc desc;
+    desc.type = ThisType::kType;
+    desc.operands.add(interfaceDeclRef.decl);
+    desc.operands.add(interfaceDeclRef.substitutions.substitutions);
+    return (ThisType*)_getOrCreateImpl(desc, [&]()
+        {
+            auto type = create<ThisType>();
+            type->interfaceDeclRef = interfaceDeclRef;
+            return type;
+        });
+}
+
+bool ASTBuilder::canMemoizeSubstitution(Val* val, SubstitutionSet subst)
+{
+    if (!m_uniqueNodes.Contains(val))
+        return false;
+    for (auto s = subst.substitutions; s; s = s->outer)
+    {
+        if (!m_uniqueNodes.Contains(s))
+            return false;
+    }
+    return true;
 }
 
 Val* ASTBuilder::getUNormModifierVal()
@@ -133,6 +133,7 @@ public:
 
         auto node = createFunc();
         m_cachedNodes.Add(desc, node);
+        m_uniqueNodes.Add(node);
         return node;
     }
 
@@ -140,6 +141,31 @@ public:
     /// no need for additional state.
     Dictionary<NodeDesc, NodeBase*> m_cachedNodes;
 
+    /// The nodes in `m_cachedNodes`.
+    /// These are defined by their operands, so aren't modified after being created.
+    HashSet<NodeBase*> m_uniqueNodes;
+
+    // Substitution cache:
+    struct SubstitutionKey
+    {
+        Val*            val;
+        Substitutions*  substitutions;
+
+        bool operator==(SubstitutionKey const& that) const { return val == that.val && substitutions == that.substitutions; }
+        HashCode getHashCode() const { return combineHash(Slang::getHashCode(val), Slang::getHashCode(substitutions)); }
+    };
+
+    /// Results of `Val::substitute` for unique values and substitutions (see `canMemoizeSubstitution`).
+    Dictionary<SubstitutionKey, Val*> m_substitutionCache;
+
+    /// Incremented for each lookup in a witness table. Witness tables are filled in whilst checking,
+    /// so a substitution that looked up a witness isn't memoized.
+    Index m_witnessLookupCount = 0;
+
+        /// True if the result of substituting `subst` into `val` can be memoized.
+        /// That is the case when `val` and the substitutions were all created through the node cache.
+    bool canMemoizeSubstitution(Val* val, SubstitutionSet subst);
+
 public:
 
     // For compile time check to see if thing being constructed is an AST type
@@ -260,6 +286,21 @@ public:
         return result;
     }
 
+    DeclaredSubtypeWitness* getDeclaredSubtypeWitness(Type* sub, Type* sup, DeclRefBase const& declRef)
+    {
+        return getOrCreate<DeclaredSubtypeWitness>(sub, sup, declRef.decl, declRef.substitutions.substitutions);
+    }
+
+    TransitiveSubtypeWitness* getTransitiveSubtypeWitness(Type* sub, Type* sup, SubtypeWitness* subToMid, SubtypeWitness* midToSup)
+    {
+        auto witness = getOrCreateWithDefaultCtor<TransitiveSubtypeWitness>(sub, sup, subToMid, midToSup);
+        witness->sub = sub;
+        witness->sup = sup;
+        witness->subToMid = subToMid;
+        witness->midToSup = midToSup;
+        return witness;
+    }
+
     NodeBase* createByNodeType(ASTNodeType nodeType);
 
         /// Get the built in types
@@ -329,6 +370,10 @@ public:
 
     TypeType* getTypeType(Type* type);
 
+    FuncType* getFuncType(ConstArrayView<Type*> paramTypes, Type* resultType, Type* errorType);
+
+    ThisType* getThisType(DeclRef<InterfaceDecl> const& interfaceDeclRef);
+
         /// Helpers to get type info from the SharedASTBuilder
     const ReflectClassInfo* findClassInfo(const UnownedStringSlice& slice) { return m_sharedASTBuilder->findClassInfo(slice); }
     SyntaxClass<NodeBase> findSyntaxClass(const UnownedStringSlice& slice) { return m_sharedASTBuilder->findSyntaxClass(slice); }
@@ -18,7 +18,17 @@ Type* Type::createCanonicalType()
 
 bool Type::equals(Type* type)
 {
-    return getCanonicalType()->equalsImpl(type->getCanonicalType());
+    auto canonicalType = getCanonicalType();
+    auto otherCanonicalType = type->getCanonicalType();
+
+    // Canonical types are unique nodes, so in the common case of equal types
+    // there is no need for a structural comparison.
+    if (canonicalType == otherCanonicalType)
+    {
+        // Overload groups and initializer lists aren't equal to anything
+        return !as<OverloadGroupType>(canonicalType) && !as<InitializerListType>(canonicalType);
+    }
+    return canonicalType->equalsImpl(otherCanonicalType);
 }
 
 bool Type::equalsImpl(Type* type)
@@ -660,11 +670,7 @@ Val* FuncType::_substituteImplOverride(ASTBuilder* astBuilder, SubstitutionSet s
         return this;
 
     (*ioDiff)++;
-    FuncType* substType = astBuilder->create<FuncType>();
-    substType->resultType = substResultType;
-    substType->paramTypes = substParamTypes;
-    substType->errorType = substErrorType;
-    return substType;
+    return astBuilder->getFuncType(substParamTypes.getArrayView(), substResultType, substErrorType);
 }
 
 Type* FuncType::_createCanonicalTypeOverride()
@@ -680,11 +686,7 @@ Type* FuncType::_createCanonicalTypeOverride()
         canParamTypes.add(pp->getCanonicalType());
     }
 
-    FuncType* canType = getASTBuilder()->create<FuncType>();
-    canType->resultType = canResultType;
-    canType->paramTypes = canParamTypes;
-    canType->errorType = canErrorType;
-    return canType;
+    return getASTBuilder()->getFuncType(canParamTypes.getArrayView(), canResultType, canErrorType);
 }
 
 HashCode FuncType::_getHashCodeOverride()
@@ -769,10 +771,8 @@ DeclRef<InterfaceDecl> ExtractExistentialType::getSpecializedInterfaceDeclRef()
 
     SubtypeWitness* openedWitness = getSubtypeWitness();
 
-    ThisTypeSubstitution* openedThisType = m_astBuilder->create<ThisTypeSubstitution>();
-    openedThisType->outer = originalInterfaceDeclRef.substitutions.substitutions;
-    openedThisType->interfaceDecl = interfaceDecl;
-    openedThisType->witness = openedWitness;
+    ThisTypeSubstitution* openedThisType = m_astBuilder->getOrCreateThisTypeSubstitution(
+        interfaceDecl, openedWitness, originalInterfaceDeclRef.substitutions.substitutions);
 
     DeclRef<InterfaceDecl> specialiedInterfaceDeclRef = DeclRef<InterfaceDecl>(interfaceDecl, openedThisType);
 
@@ -1000,11 +1000,8 @@ HashCode ThisType::_getHashCodeOverride()
 
 Type* ThisType::_createCanonicalTypeOverride()
 {
-    ThisType* canType = m_astBuilder->create<ThisType>();
-
     // TODO: need to canonicalize the decl-ref
-    canType->interfaceDeclRef = interfaceDeclRef;
-    return canType;
+    return m_astBuilder->getThisType(interfaceDeclRef);
 }
 
 Val* ThisType::_substituteImplOverride(ASTBuilder* astBuilder, SubstitutionSet subst, int* ioDiff)
@@ -1024,9 +1021,7 @@ Val* ThisType::_substituteImplOverride(ASTBuilder* astBuilder, SubstitutionSet s
 
     (*ioDiff)++;
 
-    ThisType* substType = m_astBuilder->create<ThisType>();
-    substType->interfaceDeclRef = substInterfaceDeclRef;
-    return substType;
+    return m_astBuilder->getThisType(substInterfaceDeclRef);
 }
 
 // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! AndType !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
@@ -1183,13 +1178,7 @@ HashCode ModifiedType::_getHashCodeOverride()
 
 Type* ModifiedType::_createCanonicalTypeOverride()
 {
-    ModifiedType* canonical = m_astBuilder->create<ModifiedType>();
-    canonical->base = base->getCanonicalType();
-    for( auto modifier : modifiers )
-    {
-        canonical->modifiers.add(modifier);
-    }
-    return canonical;
+    return m_astBuilder->getModifiedType(base->getCanonicalType(), modifiers);
 }
 
 Val* ModifiedType::_substituteImplOverride(ASTBuilder* astBuilder, SubstitutionSet subst, int* ioDiff)
@@ -1209,10 +1198,7 @@ Val* ModifiedType::_substituteImplOverride(ASTBuilder* astBuilder, SubstitutionS
 
     *ioDiff = 1;
 
-    ModifiedType* substType = m_astBuilder->create<ModifiedType>();
-    substType->base = substBase;
-    substType->modifiers = _Move(substModifiers);
-    return substType;
+    return m_astBuilder->getModifiedType(substBase, substModifiers);
 }
 
 
@@ -12,8 +12,27 @@ namespace Slang {
 Val* Val::substitute(ASTBuilder* astBuilder, SubstitutionSet subst)
 {
     if (!subst) return this;
+
+    // If the value and substitutions are unique nodes, they can't change, so the
+    // result can be memoized (as long as it didn't depend on a witness table).
+    const bool canMemoize = astBuilder->canMemoizeSubstitution(this, subst);
+    const ASTBuilder::SubstitutionKey key = { this, subst.substitutions };
+    if (canMemoize)
+    {
+        if (auto found = astBuilder->m_substitutionCache.TryGetValue(key))
+            return *found;
+    }
+
+    const Index witnessLookupCount = astBuilder->m_witnessLookupCount;
+
     int diff = 0;
-    return substituteImpl(astBuilder, subst, &diff);
+    Val* result = substituteImpl(astBuilder, subst, &diff);
+
+    if (canMemoize && astBuilder->m_witnessLookupCount == witnessLookupCount)
+    {
+        astBuilder->m_substitutionCache.Add(key, result);
+    }
+    return result;
 }
 
 Val* Val::substituteImpl(ASTBuilder* astBuilder, SubstitutionSet subst, int* ioDiff)
@@ -23,6 +42,10 @@ Val* Val::substituteImpl(ASTBuilder* astBuilder, SubstitutionSet subst, int* ioD
 
 bool Val::equalsVal(Val* val)
 {
+    // A value is always equal to itself. Types are handled by `Type::equals`, as some
+    // types aren't equal to anything.
+    if (val == this && !as<Type>(this))
+        return true;
     SLANG_AST_NODE_VIRTUAL_CALL(Val, equalsVal, (val))
 }
 
@@ -388,12 +411,7 @@ Val* TransitiveSubtypeWitness::_substituteImplOverride(ASTBuilder* astBuilder, S
 
     // In the simple case, we just construct a new transitive subtype
     // witness, and we move on with life.
-    TransitiveSubtypeWitness* result = astBuilder->create<TransitiveSubtypeWitness>();
-    result->sub = substSub;
-    result->sup = substSup;
-    result->subToMid = substSubToMid;
-    result->midToSup = substMidToSup;
-    return result;
+    return astBuilder->getTransitiveSubtypeWitness(substSub, substSup, substSubToMid, substMidToSup);
 }
 
 void TransitiveSubtypeWitness::_toTextOverride(StringBuilder& out)
@@ -1060,7 +1060,7 @@ namespace Slang
     
         if( cacheKey.isValid())
         {
-            if (typeCheckingCache->conversionCostCache.TryGetValue(cacheKey, cost))
+            if (typeCheckingCache->tryGetConversionCost(cacheKey, cost))
             {
                 if (outCost)
                     *outCost = cost;
@@ -1822,10 +1822,12 @@ namespace Slang
                 auto satisfyingConstraintDeclRef = satisfyingMemberDeclRef.as<GenericTypeConstraintDecl>();
                 SLANG_ASSERT(satisfyingConstraintDeclRef);
 
-                auto satisfyingWitness = m_astBuilder->getOrCreate<DeclaredSubtypeWitness>();
-                satisfyingWitness->sub = getSub(m_astBuilder, satisfyingConstraintDeclRef);
-                satisfyingWitness->sup = getSup(m_astBuilder, satisfyingConstraintDeclRef);
-                satisfyingWitness->declRef = satisfyingConstraintDeclRef;
+                // Note: the witness must be keyed on its operands, so that witnesses
+                // for different constraints are distinct.
+                auto satisfyingWitness = m_astBuilder->getDeclaredSubtypeWitness(
+                    getSub(m_astBuilder, satisfyingConstraintDeclRef),
+                    getSup(m_astBuilder, satisfyingConstraintDeclRef),
+                    satisfyingConstraintDeclRef);
 
                 requiredSubstArgs.add(satisfyingWitness);
             }
@@ -3005,10 +3007,10 @@ namespace Slang
         // of `This` in the interface as equivalent to the concrete type for the
         // purpose of signature matching (and similarly for associated types).
         //
-        ThisTypeSubstitution* thisTypeSubst = m_astBuilder->create<ThisTypeSubstitution>();
-        thisTypeSubst->interfaceDecl = superInterfaceDeclRef.getDecl();
-        thisTypeSubst->witness = subTypeConformsToSuperInterfaceWitness;
-        thisTypeSubst->outer = superInterfaceDeclRef.substitutions.substitutions;
+        ThisTypeSubstitution* thisTypeSubst = m_astBuilder->getOrCreateThisTypeSubstitution(
+            superInterfaceDeclRef.getDecl(),
+            subTypeConformsToSuperInterfaceWitness,
+            superInterfaceDeclRef.substitutions.substitutions);
 
         auto specializedSuperInterfaceDeclRef = DeclRef<InterfaceDecl>(superInterfaceDeclRef.getDecl(), thisTypeSubst);
 
@@ -3240,10 +3242,8 @@ namespace Slang
         // Look at the type being inherited from, and validate
         // appropriately.
 
-        DeclaredSubtypeWitness* subIsSuperWitness = m_astBuilder->create<DeclaredSubtypeWitness>();
-        subIsSuperWitness->declRef = makeDeclRef(inheritanceDecl);
-        subIsSuperWitness->sub = subType;
-        subIsSuperWitness->sup = superType;
+        DeclaredSubtypeWitness* subIsSuperWitness = m_astBuilder->getDeclaredSubtypeWitness(
+            subType, superType, makeDeclRef(inheritanceDecl));
 
         ConformanceCheckingContext context;
         context.conformingType = subType;
@@ -4898,9 +4898,7 @@ namespace Slang
             // conform to the interface and fill in its
             // requirements.
             //
-            ThisType* thisType = m_astBuilder->create<ThisType>();
-            thisType->interfaceDeclRef = interfaceDeclRef;
-            return thisType;
+            return m_astBuilder->getThisType(interfaceDeclRef);
         }
         else if (auto aggTypeDeclRef = declRef.as<AggTypeDecl>())
         {
@@ -5258,10 +5256,10 @@ namespace Slang
                                     SLANG_ASSERT(!as<ThisTypeSubstitution>(targetInterfaceDeclRef.substitutions.substitutions));
 
                                     // We will create a new substitution to apply to the target type.
-                                    ThisTypeSubstitution* newTargetSubst = m_astBuilder->create<ThisTypeSubstitution>();
-                                    newTargetSubst->interfaceDecl = appThisTypeSubst->interfaceDecl;
-                                    newTargetSubst->witness = appThisTypeSubst->witness;
-                                    newTargetSubst->outer = targetInterfaceDeclRef.substitutions.substitutions;
+                                    ThisTypeSubstitution* newTargetSubst = m_astBuilder->getOrCreateThisTypeSubstitution(
+                                        appThisTypeSubst->interfaceDecl,
+                                        appThisTypeSubst->witness,
+                                        targetInterfaceDeclRef.substitutions.substitutions);
 
                                     targetType = DeclRefType::create(m_astBuilder,
                                         DeclRef<InterfaceDecl>(targetInterfaceDeclRef.getDecl(), newTargetSubst));
@@ -5273,10 +5271,10 @@ namespace Slang
                                     // references to the target type of the extension
                                     // declaration have a chance to resolve the way we want them to.
 
-                                    ThisTypeSubstitution* newExtSubst = m_astBuilder->create<ThisTypeSubstitution>();
-                                    newExtSubst->interfaceDecl = appThisTypeSubst->interfaceDecl;
-                                    newExtSubst->witness = appThisTypeSubst->witness;
-                                    newExtSubst->outer = extDeclRef.substitutions.substitutions;
+                                    ThisTypeSubstitution* newExtSubst = m_astBuilder->getOrCreateThisTypeSubstitution(
+                                        appThisTypeSubst->interfaceDecl,
+                                        appThisTypeSubst->witness,
+                                        extDeclRef.substitutions.substitutions);
 
                                     extDeclRef = DeclRef<ExtensionDecl>(
                                         extDeclRef.getDecl(),
@@ -9,6 +9,9 @@
 #include "slang-compiler.h"
 #include "slang-visitor.h"
 
+#include <memory>
+#include <mutex>
+
 namespace Slang
 {
     
@@ -223,11 +226,54 @@ namespace Slang
         }
     };
 
+        /// The part of the type checking cache that can be shared between all of the linkages of a `Session`.
+        ///
+        /// Only results that reference nothing but stdlib declarations (and types owned by them) are held,
+        /// as anything else may have been created by (and will be freed with) a specific linkage.
+        ///
+        /// The entries are immutable once published, so a linkage can look them up without taking a lock.
+        /// Adding entries takes a lock, and publishes a new copy of the entries.
+    class SharedTypeCheckingCache
+    {
+    public:
+        struct Entries
+        {
+            Dictionary<OperatorOverloadCacheKey, OverloadCandidate> resolvedOperatorOverloadCache;
+            Dictionary<BasicTypeKeyPair, ConversionCost> conversionCostCache;
+        };
+
+            /// Get the currently published entries
+        std::shared_ptr<const Entries> getEntries();
+
+            /// Add the entries of `cache` that can be shared. Publishes new entries if any were added.
+            /// Nothing is copied if all of the entries that can be shared already are.
+        void addEntries(TypeCheckingCache* cache);
+
+            /// True if `candidate` only references stdlib declarations and types, and so can be shared
+        static bool canShare(const OverloadCandidate& candidate);
+
+    protected:
+        std::mutex m_mutex;
+        std::shared_ptr<const Entries> m_entries;
+    };
+
+        /// The type checking cache for a linkage.
+        ///
+        /// Entries are held in the linkage's own dictionaries, which are looked up first, followed by the
+        /// entries shared from the `Session` at the time the cache was created.
     struct TypeCheckingCache
     {
+        bool tryGetOperatorOverload(const OperatorOverloadCacheKey& key, OverloadCandidate& outCandidate) const;
+        bool tryGetConversionCost(const BasicTypeKeyPair& key, ConversionCost& outCost) const;
+
         Dictionary<OperatorOverloadCacheKey, OverloadCandidate> resolvedOperatorOverloadCache;
         Dictionary<BasicTypeKeyPair, ConversionCost> conversionCostCache;
         Dictionary<LookupRequestKey, LookupResult> lookupCache;
+
+            /// Entries shared across the session's linkages (can be null)
+        std::shared_ptr<const SharedTypeCheckingCache::Entries> sharedEntries;
+            /// The number of lookups that were found in `sharedEntries`
+        mutable Index sharedHitCount = 0;
     };
 
         /// Shared state for a semantics-checking session.
@@ -1408,7 +1408,7 @@ namespace Slang
             if (key.fromOperatorExpr(opExpr))
             {
                 OverloadCandidate candidate;
-                if (typeCheckingCache->resolvedOperatorOverloadCache.TryGetValue(key, candidate))
+                if (typeCheckingCache->tryGetOperatorOverload(key, candidate))
                 {
                     context.bestCandidateStorage = candidate;
                     context.bestCandidate = &context.bestCandidateStorage;
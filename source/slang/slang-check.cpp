@@ -57,6 +57,114 @@ namespace Slang
 
     } // anonymous
 
+    std::shared_ptr<const SharedTypeCheckingCache::Entries> SharedTypeCheckingCache::getEntries()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_entries;
+    }
+
+    void SharedTypeCheckingCache::addEntries(TypeCheckingCache* cache)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        // Most linkages only find what has already been shared, so check if there is anything to add
+        // before copying the entries
+        bool hasNewEntries = false;
+        for (const auto& pair : cache->conversionCostCache)
+        {
+            if (!m_entries || !m_entries->conversionCostCache.ContainsKey(pair.Key))
+            {
+                hasNewEntries = true;
+                break;
+            }
+        }
+        if (!hasNewEntries)
+        {
+            for (const auto& pair : cache->resolvedOperatorOverloadCache)
+            {
+                if ((!m_entries || !m_entries->resolvedOperatorOverloadCache.ContainsKey(pair.Key)) && canShare(pair.Value))
+                {
+                    hasNewEntries = true;
+                    break;
+                }
+            }
+        }
+        if (!hasNewEntries)
+        {
+            return;
+        }
+
+        // The published entries may be in use by other linkages, so we add to a copy
+        std::shared_ptr<Entries> entries = m_entries ? std::make_shared<Entries>(*m_entries) : std::make_shared<Entries>();
+
+        // Conversion costs between basic types are just values, so can always be shared
+        for (const auto& pair : cache->conversionCostCache)
+        {
+            entries->conversionCostCache.AddIfNotExists(pair.Key, pair.Value);
+        }
+        for (const auto& pair : cache->resolvedOperatorOverloadCache)
+        {
+            if (canShare(pair.Value))
+            {
+                entries->resolvedOperatorOverloadCache.AddIfNotExists(pair.Key, pair.Value);
+            }
+        }
+
+        m_entries = entries;
+    }
+
+    /* static */bool SharedTypeCheckingCache::canShare(const OverloadCandidate& candidate)
+    {
+        // Generic candidates (such as the vector and matrix operators) hold substitutions, and
+        // other flavors hold types, that are created by the linkage being checked.
+        if (candidate.flavor != OverloadCandidate::Flavor::Func ||
+            candidate.status != OverloadCandidate::Status::Applicable ||
+            candidate.funcType ||
+            candidate.subst ||
+            candidate.item.breadcrumbs)
+        {
+            return false;
+        }
+
+        const DeclRef<Decl>& declRef = candidate.item.declRef;
+        if (declRef.substitutions.substitutions || !isFromStdLib(declRef.getDecl()))
+        {
+            return false;
+        }
+
+        // Without substitutions the result type should be the declared one, but check to be sure
+        auto callableDecl = as<CallableDecl>(declRef.getDecl());
+        return callableDecl && candidate.resultType == callableDecl->returnType.type;
+    }
+
+    bool TypeCheckingCache::tryGetOperatorOverload(const OperatorOverloadCacheKey& key, OverloadCandidate& outCandidate) const
+    {
+        if (resolvedOperatorOverloadCache.TryGetValue(key, outCandidate))
+        {
+            return true;
+        }
+        if (sharedEntries && sharedEntries->resolvedOperatorOverloadCache.TryGetValue(key, outCandidate))
+        {
+            sharedHitCount++;
+            return true;
+        }
+        return false;
+    }
+
+    bool TypeCheckingCache::tryGetConversionCost(const BasicTypeKeyPair& key, ConversionCost& outCost) const
+    {
+        if (conversionCostCache.TryGetValue(key, outCost))
+        {
+            return true;
+        }
+        if (sharedEntries && sharedEntries->conversionCostCache.TryGetValue(key, outCost))
+        {
+            sharedHitCount++;
+            return true;
+        }
+        return false;
+    }
+
 
     void Session::_setSharedLibraryLoader(ISlangSharedLibraryLoader* loader)
     {
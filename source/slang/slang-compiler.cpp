@@ -1152,6 +1152,15 @@ namespace Slang
         options.fileSystemExt = getFileSystemExt();
         options.sourceManager = getSourceManager();
 
+        // When generating code on multiple threads, the downstream compiler runs without holding
+        // the lock, so it can only access the file system through the lock (and not the source manager)
+        ParallelCodeGen* parallelCodeGen = getLinkage()->m_parallelCodeGen;
+        if (parallelCodeGen)
+        {
+            options.fileSystemExt = parallelCodeGen->getLockingFileSystem(options.fileSystemExt);
+            options.sourceManager = nullptr;
+        }
+
         // Set the source type
         options.sourceLanguage = SlangSourceLanguage(sourceLanguage);
         
@@ -1379,7 +1388,13 @@ namespace Slang
         // Compile
         ComPtr<IArtifact> artifact;
         auto downstreamStartTime = std::chrono::high_resolution_clock::now();
-        SLANG_RETURN_ON_FAIL(compiler->compile(options, artifact.writeRef()));
+        {
+            CompileTraceScope downstreamScope(getLinkage()->getCompileTrace(), "downstream", TypeTextUtil::getPassThroughName(SlangPassThrough(compilerType)));
+
+            // Other code generation can proceed whilst the downstream compiler runs
+            ParallelCodeGen::UnlockScope unlockScope(parallelCodeGen);
+            SLANG_RETURN_ON_FAIL(compiler->compile(options, artifact.writeRef()));
+        }
         auto downstreamElapsedTime =
             (std::chrono::high_resolution_clock::now() - downstreamStartTime).count() * 0.000000001;
         getSession()->addDownstreamCompileTime(downstreamElapsedTime);
@@ -1521,6 +1536,8 @@ namespace Slang
     {
         auto target = getTargetFormat();
 
+        CompileTraceScope codeGenScope(getLinkage()->getCompileTrace(), "codegen", TypeTextUtil::getCompileTargetName(SlangCompileTarget(target)));
+
         switch (target)
         {
         case CodeGenTarget::SPIRVAssembly:
@@ -1706,15 +1723,256 @@ namespace Slang
             m_entryPointResults.setCount(entryPointIndex + 1);
 
         
+        // If the linkage has a persistent compile cache, the code may
+        // have been generated before (possibly by another process).
+        //
+        auto compileCache = m_program->getLinkage()->m_compileCache.Ptr();
+
+        StringBuilder cacheKey;
+        if (compileCache && !_calcCompileCacheKey(entryPointIndex, endToEndReq, cacheKey))
+        {
+            compileCache = nullptr;
+        }
+
+        if (compileCache)
+        {
+            ComPtr<IArtifact> cachedArtifact;
+            if (SLANG_SUCCEEDED(compileCache->load(cacheKey.getUnownedSlice(), cachedArtifact)))
+            {
+                m_entryPointResults[entryPointIndex] = cachedArtifact;
+                return cachedArtifact;
+            }
+        }
+
         CodeGenContext::EntryPointIndices entryPointIndices;
         entryPointIndices.add(entryPointIndex);
 
         CodeGenContext::Shared sharedCodeGenContext(this, entryPointIndices, sink, endToEndReq);
         CodeGenContext codeGenContext(&sharedCodeGenContext);
 
-        codeGenContext.emitEntryPoints(m_entryPointResults[entryPointIndex]);
+        // Note that the result is not written directly into `m_entryPointResults`, because
+        // with parallel code generation (see `ParallelCodeGen`) other entry points can be
+        // generated whilst this one is being compiled downstream.
+        //
+        ComPtr<IArtifact> artifact;
+        const SlangResult res = codeGenContext.emitEntryPoints(artifact);
+        m_entryPointResults[entryPointIndex] = artifact;
+
+        // Failing to store isn't an error, as the cache is only an optimization. It also fails
+        // for artifacts that can't be represented as a blob (like code JIT compiled into memory).
+        //
+        if (compileCache && SLANG_SUCCEEDED(res) && artifact)
+        {
+            compileCache->store(cacheKey.getUnownedSlice(), artifact);
+        }
 
-        return m_entryPointResults[entryPointIndex];
+        return artifact;
+    }
+
+        /// Visitor used by `TargetProgram::_calcCompileCacheKey` to describe the
+        /// structure and specialization of a program.
+    struct CompileCacheKeyVisitor : ComponentTypeVisitor
+    {
+        CompileCacheKeyVisitor(ASTBuilder* astBuilder, StringBuilder& builder)
+            : m_astBuilder(astBuilder)
+            , m_builder(builder)
+        {}
+
+        void appendVal(Val* val)
+        {
+            if (val)
+                val->toText(m_builder);
+            else
+                m_builder << "null";
+        }
+
+        void appendArgs(List<ExpandedSpecializationArg> const& args)
+        {
+            for (auto& arg : args)
+            {
+                m_builder << " ";
+                appendVal(arg.val);
+                m_builder << ":";
+                appendVal(arg.witness);
+            }
+        }
+
+        void visitEntryPoint(EntryPoint* entryPoint, EntryPoint::EntryPointSpecializationInfo* specializationInfo) SLANG_OVERRIDE
+        {
+            auto funcDeclRef = entryPoint->getFuncDeclRef();
+            if (specializationInfo)
+                funcDeclRef = specializationInfo->specializedFuncDeclRef;
+
+            m_builder << "entryPoint " << getMangledName(m_astBuilder, funcDeclRef) << " " << uint32_t(entryPoint->getProfile().raw);
+            if (specializationInfo)
+                appendArgs(specializationInfo->existentialSpecializationArgs);
+            m_builder << "\n";
+        }
+
+        void visitRenamedEntryPoint(
+            RenamedEntryPointComponentType* entryPoint,
+            EntryPoint::EntryPointSpecializationInfo* specializationInfo) SLANG_OVERRIDE
+        {
+            entryPoint->getBase()->acceptVisitor(this, specializationInfo);
+            m_builder << "renamed " << entryPoint->getEntryPointNameOverride(0) << "\n";
+        }
+
+        void visitModule(Module* module, Module::ModuleSpecializationInfo* specializationInfo) SLANG_OVERRIDE
+        {
+            m_builder << "module " << getText(module->getModuleDecl()->getName());
+            if (specializationInfo)
+            {
+                for (auto& genericArg : specializationInfo->genericArgs)
+                {
+                    m_builder << " " << getMangledName(m_astBuilder, genericArg.paramDecl) << "=";
+                    appendVal(genericArg.argVal);
+                }
+                appendArgs(specializationInfo->existentialArgs);
+            }
+            m_builder << "\n";
+        }
+
+        void visitComposite(CompositeComponentType* composite, CompositeComponentType::CompositeSpecializationInfo* specializationInfo) SLANG_OVERRIDE
+        {
+            m_builder << "composite {\n";
+            visitChildren(composite, specializationInfo);
+            m_builder << "}\n";
+        }
+
+        void visitSpecialized(SpecializedComponentType* specialized) SLANG_OVERRIDE
+        {
+            m_builder << "specialized {\n";
+            visitChildren(specialized);
+            m_builder << "}\n";
+        }
+
+        void visitTypeConformance(TypeConformance* conformance) SLANG_OVERRIDE
+        {
+            m_builder << "conformance ";
+            appendVal(conformance->getSubtypeWitness());
+            m_builder << " " << conformance->getConformanceIdOverride() << "\n";
+        }
+
+        ASTBuilder* m_astBuilder;
+        StringBuilder& m_builder;
+    };
+
+    bool TargetProgram::_calcCompileCacheKey(
+        Int                     entryPointIndex,
+        EndToEndCompileRequest* endToEndReq,
+        StringBuilder&          outKey)
+    {
+        // In pass-through mode the code doesn't come from the modules of the program
+        if (endToEndReq && endToEndReq->m_passThrough != PassThroughMode::None)
+        {
+            return false;
+        }
+
+        auto linkage = m_program->getLinkage();
+        auto targetReq = m_targetReq;
+
+        outKey << "version " << getBuildTagString() << "\n";
+
+        // Target options
+        outKey << "target " << int(targetReq->getTarget()) << " " << uint32_t(targetReq->getTargetProfile().raw)
+            << " " << uint32_t(targetReq->getTargetFlags())
+            << " " << int(targetReq->getFloatingPointMode())
+            << " " << int(targetReq->getLineDirectiveMode())
+            << " " << int(targetReq->getForceGLSLScalarBufferLayout())
+            << " " << int(targetReq->shouldTrackLiveness());
+        for (auto atom : targetReq->getRawCapabilities())
+        {
+            outKey << " " << int(atom);
+        }
+        outKey << "\n";
+
+        // Linkage options
+        outKey << "linkage " << int(linkage->defaultMatrixLayoutMode)
+            << " " << int(linkage->debugInfoLevel)
+            << " " << int(linkage->optimizationLevel)
+            << " " << int(linkage->m_obfuscateCode)
+            << " " << int(linkage->m_useFalcorCustomSharedKeywordSemantics) << "\n";
+
+        // The linkage definitions are also passed to downstream compilers
+        {
+            List<String> names;
+            for (auto& definition : linkage->preprocessorDefinitions)
+            {
+                names.add(definition.Key);
+            }
+            names.sort();
+            for (auto& name : names)
+            {
+                String value;
+                linkage->preprocessorDefinitions.TryGetValue(name, value);
+                outKey << "#define " << name << " " << value << "\n";
+            }
+        }
+
+        // Options of an end-to-end request that change the generated code
+        if (endToEndReq)
+        {
+            outKey << "endToEnd " << int(endToEndReq->useUnknownImageFormatAsDefault)
+                << " " << int(endToEndReq->disableSpecialization)
+                << " " << int(endToEndReq->disableDynamicDispatch) << "\n";
+        }
+
+        // The downstream compiler (if any) that produces the target code, and its version
+        {
+            auto session = linkage->getSessionImpl();
+
+            const CodeGenTarget sourceTarget = _getDefaultSourceForTarget(targetReq->getTarget());
+            const PassThroughMode compilerType = (sourceTarget == CodeGenTarget::Unknown) ?
+                PassThroughMode::None :
+                PassThroughMode(session->getDownstreamCompilerForTransition(SlangCompileTarget(sourceTarget), SlangCompileTarget(targetReq->getTarget())));
+
+            outKey << "compiler " << int(compilerType);
+            if (compilerType != PassThroughMode::None)
+            {
+                // If the compiler can't be loaded compilation will fail, so there is nothing to cache
+                IDownstreamCompiler* compiler = session->getOrLoadDownstreamCompiler(compilerType, nullptr);
+                if (!compiler)
+                {
+                    return false;
+                }
+                const auto& version = compiler->getDesc().version;
+                outKey << " " << int(compiler->getDesc().type) << " " << version.m_major << "." << version.m_minor << "." << version.m_patch;
+            }
+            outKey << "\n";
+        }
+
+        for (auto& entry : linkage->m_downstreamArgs.getEntries())
+        {
+            outKey << "downstream " << entry.name;
+            for (Index i = 0; i < entry.args.getArgCount(); ++i)
+            {
+                outKey << " " << entry.args[i].value;
+            }
+            outKey << "\n";
+        }
+
+        // The source of all the modules involved. The standard library is identified by the version.
+        auto builtinLinkage = linkage->getSessionImpl()->getBuiltinLinkage();
+        for (auto module : m_program->getModuleDependencies())
+        {
+            const auto sourceDigest = module->getSourceDigest();
+            if (sourceDigest.getLength() == 0)
+            {
+                if (module->getLinkage() == builtinLinkage)
+                {
+                    continue;
+                }
+                return false;
+            }
+            outKey << "source " << getText(module->getModuleDecl()->getName()) << "\n" << sourceDigest;
+        }
+
+        // How the program is composed and specialized
+        CompileCacheKeyVisitor visitor(linkage->getASTBuilder(), outKey);
+        m_program->acceptVisitor(&visitor, nullptr);
+
+        outKey << "entryPointIndex " << entryPointIndex << "\n";
+        return true;
     }
 
     IArtifact* TargetProgram::getOrCreateWholeProgramResult(
@@ -1999,6 +2257,12 @@ namespace Slang
         // has specified, and generate code for each of them.
         //
         auto linkage = getLinkage();
+        if (m_codeGenThreadCount != 1)
+        {
+            _generateOutputInParallel(program);
+            return;
+        }
+
         for (auto targetReq : linkage->targets)
         {
             auto targetProgram = program->getTargetProgram(targetReq);
@@ -2006,6 +2270,65 @@ namespace Slang
         }
     }
 
+    void EndToEndCompileRequest::_generateOutputInParallel(
+        ComponentType* program)
+    {
+        auto linkage = getLinkage();
+
+        // Each work item is the code for an entry point (or the whole program) on a target
+        struct WorkItem
+        {
+            TargetProgram* targetProgram;
+            Index entryPointIndex;                  ///< -1 for a whole program
+        };
+
+        List<WorkItem> workItems;
+        for (auto targetReq : linkage->targets)
+        {
+            auto targetProgram = program->getTargetProgram(targetReq);
+            if (targetReq->isWholeProgramRequest())
+            {
+                workItems.add(WorkItem{ targetProgram, -1 });
+            }
+            else
+            {
+                const Index entryPointCount = program->getEntryPointCount();
+                for (Index ii = 0; ii < entryPointCount; ++ii)
+                {
+                    workItems.add(WorkItem{ targetProgram, ii });
+                }
+            }
+        }
+
+        ParallelCodeGen parallelCodeGen;
+
+        SLANG_ASSERT(linkage->m_parallelCodeGen == nullptr);
+        linkage->m_parallelCodeGen = &parallelCodeGen;
+
+        try
+        {
+            parallelCodeGen.run(workItems.getCount(), m_codeGenThreadCount, [&](Index index)
+            {
+                const WorkItem& workItem = workItems[index];
+                if (workItem.entryPointIndex < 0)
+                {
+                    workItem.targetProgram->_createWholeProgramResult(getSink(), this);
+                }
+                else
+                {
+                    workItem.targetProgram->_createEntryPointResult(workItem.entryPointIndex, getSink(), this);
+                }
+            });
+        }
+        catch (...)
+        {
+            linkage->m_parallelCodeGen = nullptr;
+            throw;
+        }
+
+        linkage->m_parallelCodeGen = nullptr;
+    }
+
     void EndToEndCompileRequest::generateOutput()
     {
         generateOutput(getSpecializedGlobalAndEntryPointsComponentType());
@@ -2138,6 +2461,15 @@ namespace Slang
         return false;
     }
 
+    bool CodeGenContext::shouldCompactIR()
+    {
+        if (auto endToEndReq = isEndToEndCompile())
+        {
+            return endToEndReq->getFrontEndReq()->shouldCompactIR;
+        }
+        return false;
+    }
+
     bool CodeGenContext::shouldDumpIR()
     {
         if (getTargetReq()->getTargetFlags() & SLANG_TARGET_FLAG_DUMP_IR)
@@ -22,13 +22,19 @@
 #include "slang-profile.h"
 #include "slang-syntax.h"
 #include "slang-content-assist-info.h"
+#include "slang-parallel-codegen.h"
 
 #include "slang-serialize-ir-types.h"
 
 #include "../compiler-core/slang-artifact-representation-impl.h"
+#include "../compiler-core/slang-artifact-disk-cache.h"
+#include "../compiler-core/slang-compile-trace.h"
 
 #include "../../slang.h"
 
+#include <atomic>
+#include <mutex>
+
 namespace Slang
 {
     struct PathInfo;
@@ -38,6 +44,7 @@ namespace Slang
     class TargetProgram;
     class TargetRequest;
     class TypeLayout;
+    class TypeLayoutCache;
     class Artifact;
 
     enum class CompilerMode
@@ -289,6 +296,10 @@ namespace Slang
             int                     targetIndex,
             ISlangSharedLibrary**   outSharedLibrary,
             slang::IBlob**          outDiagnostics) SLANG_OVERRIDE;
+        SLANG_NO_THROW SlangResult SLANG_MCALL getTargetHostCallable(
+            SlangInt                targetIndex,
+            ISlangSharedLibrary**   outSharedLibrary,
+            slang::IBlob**          outDiagnostics) SLANG_OVERRIDE;
 
             /// Get the linkage (aka "session" in the public API) for this component type.
         Linkage* getLinkage() { return m_linkage; }
@@ -709,6 +720,14 @@ namespace Slang
                 entryPointIndex, targetIndex, outSharedLibrary, outDiagnostics);
         }
 
+        SLANG_NO_THROW SlangResult SLANG_MCALL getTargetHostCallable(
+            SlangInt targetIndex,
+            ISlangSharedLibrary** outSharedLibrary,
+            slang::IBlob** outDiagnostics) SLANG_OVERRIDE
+        {
+            return Super::getTargetHostCallable(targetIndex, outSharedLibrary, outDiagnostics);
+        }
+
         List<Module*> const& getModuleDependencies() SLANG_OVERRIDE
         {
             return m_base->getModuleDependencies();
@@ -846,6 +865,14 @@ namespace Slang
             return Super::getEntryPointHostCallable(entryPointIndex, targetIndex, outSharedLibrary, outDiagnostics);
         }
 
+        SLANG_NO_THROW SlangResult SLANG_MCALL getTargetHostCallable(
+            SlangInt                targetIndex,
+            ISlangSharedLibrary**   outSharedLibrary,
+            slang::IBlob**          outDiagnostics) SLANG_OVERRIDE
+        {
+            return Super::getTargetHostCallable(targetIndex, outSharedLibrary, outDiagnostics);
+        }
+
             /// Create an entry point that refers to the given function.
         static RefPtr<EntryPoint> create(
             Linkage*            linkage,
@@ -1051,6 +1078,14 @@ namespace Slang
                 entryPointIndex, targetIndex, outSharedLibrary, outDiagnostics);
         }
 
+        SLANG_NO_THROW SlangResult SLANG_MCALL getTargetHostCallable(
+            SlangInt targetIndex,
+            ISlangSharedLibrary** outSharedLibrary,
+            slang::IBlob** outDiagnostics) SLANG_OVERRIDE
+        {
+            return Super::getTargetHostCallable(targetIndex, outSharedLibrary, outDiagnostics);
+        }
+
         List<Module*> const& getModuleDependencies() SLANG_OVERRIDE;
         List<String> const& getFilePathDependencies() SLANG_OVERRIDE;
 
@@ -1082,6 +1117,7 @@ namespace Slang
         }
 
         SubtypeWitness* getSubtypeWitness() { return m_subtypeWitness; }
+        Int getConformanceIdOverride() { return m_conformanceIdOverride; }
         IRModule* getIRModule() { return m_irModule.Ptr(); }
     protected:
         void acceptVisitor(ComponentTypeVisitor* visitor, SpecializationInfo* specializationInfo)
@@ -1196,6 +1232,14 @@ namespace Slang
             return Super::getEntryPointHostCallable(entryPointIndex, targetIndex, outSharedLibrary, outDiagnostics);
         }
 
+        SLANG_NO_THROW SlangResult SLANG_MCALL getTargetHostCallable(
+            SlangInt                targetIndex,
+            ISlangSharedLibrary**   outSharedLibrary,
+            slang::IBlob**          outDiagnostics) SLANG_OVERRIDE
+        {
+            return Super::getTargetHostCallable(targetIndex, outSharedLibrary, outDiagnostics);
+        }
+
         SLANG_NO_THROW SlangResult SLANG_MCALL findEntryPointByName(
             char const*             name,
             slang::IEntryPoint**     outEntryPoint) SLANG_OVERRIDE
@@ -1232,7 +1276,16 @@ namespace Slang
         ModuleDecl* getModuleDecl() { return m_moduleDecl; }
 
             /// The the IR for the module (if it has been generated)
-        IRModule* getIRModule() { return m_irModule; }
+            ///
+            /// If the module was loaded with its IR to be read lazily, it is read now. If reading
+            /// fails nullptr is returned - use `readIRModule` to have the failure diagnosed.
+        IRModule* getIRModule() { readIRModule(nullptr); return m_irModule; }
+
+            /// Read the IR for the module if it is to be read lazily and hasn't been read yet.
+            ///
+            /// Can be called from multiple threads, the IR is only read once. If reading fails
+            /// the failure is reported to `sink` (if set), and all subsequent calls fail.
+        SlangResult readIRModule(DiagnosticSink* sink);
 
             /// Get the list of other modules this module depends on
         List<Module*> const& getModuleDependencyList() { return m_moduleDependencyList.getModuleList(); }
@@ -1246,6 +1299,24 @@ namespace Slang
             /// Register a filesystem path that this module depends on
         void addFilePathDependency(String const& path);
 
+            /// Register a source file (of the module itself, or `#include`d by it) that this module depends on
+        void addFileDependency(SourceFile* sourceFile);
+
+            /// Register the preprocessor definitions the source of this module is preprocessed with
+        void addPreprocessorDefinitionsDependency(Dictionary<String, String> const& definitions);
+
+            /// Get the source files (of the module itself, or `#include`d by it) that were loaded from the file system
+        List<SourceFile*> const& getSourceFileDependencyList() { return m_sourceFileDependencyList; }
+
+            /// Get a digest of the source files (and definitions) this module was compiled from.
+            ///
+            /// Empty if the source of the module isn't known, for example if it was
+            /// loaded from a serialized module that doesn't record it.
+        UnownedStringSlice getSourceDigest() { return m_sourceDigest.getUnownedSlice(); }
+
+            /// Set the digest of the source, for a module that was not compiled from source
+        void setSourceDigest(UnownedStringSlice const& digest) { m_sourceDigest.Clear(); m_sourceDigest << digest; }
+
             /// Set the AST for this module.
             ///
             /// This should only be called once, during creation of the module.
@@ -1258,6 +1329,12 @@ namespace Slang
             ///
         void setIRModule(IRModule* irModule) { m_irModule = irModule; }
 
+            /// Set a reader the IR for this module will be read with when it is first needed.
+            ///
+            /// Used so that the IR of the standard library is only deserialized if it is used.
+            ///
+        void setIRModuleReader(IRSerialContainerModuleReader* reader) { m_irModuleReader = reader; m_hasIRModuleReader = (reader != nullptr); }
+
         Index getEntryPointCount() SLANG_OVERRIDE { return 0; }
         RefPtr<EntryPoint> getEntryPoint(Index index) SLANG_OVERRIDE { SLANG_UNUSED(index); return nullptr; }
         String getEntryPointMangledName(Index index) SLANG_OVERRIDE { SLANG_UNUSED(index); return String(); }
@@ -1327,6 +1404,15 @@ namespace Slang
         // The IR for the module
         RefPtr<IRModule> m_irModule = nullptr;
 
+        // If set the IR for the module has not been read yet (see `setIRModuleReader`)
+        RefPtr<IRSerialContainerModuleReader> m_irModuleReader;
+        // Set while m_irModuleReader is, so the common case of the IR having been read doesn't need the lock
+        std::atomic<bool> m_hasIRModuleReader = { false };
+        // Set if reading the IR failed
+        bool m_irModuleReadFailed = false;
+        // Guards reading the IR
+        std::mutex m_irModuleReaderMutex;
+
         List<ShaderParamInfo> m_shaderParams;
         SpecializationParams m_specializationParams;
 
@@ -1338,6 +1424,13 @@ namespace Slang
         // List of filesystem paths this module depends on
         FilePathDependencyList m_filePathDependencyList;
 
+        // The source files this module depends on that were loaded from the file system
+        List<SourceFile*> m_sourceFileDependencyList;
+
+        // The path, size and hash of each source file this module depends on,
+        // and the preprocessor definitions they were preprocessed with
+        StringBuilder m_sourceDigest;
+
         // Entry points that were defined in thsi module
         //
         // Note: the entry point defined in the module are *not*
@@ -1518,6 +1611,7 @@ namespace Slang
         SlangTargetFlags getTargetFlags() { return targetFlags; }
         CapabilitySet getTargetCaps();
         bool getForceGLSLScalarBufferLayout() { return forceGLSLScalarBufferLayout; }
+        List<CapabilityAtom> const& getRawCapabilities() { return rawCapabilities; }
 
         Session* getSession();
         MatrixLayoutMode getDefaultMatrixLayoutMode();
@@ -1529,6 +1623,9 @@ namespace Slang
 
         TypeLayout* getTypeLayout(Type* type);
 
+            /// Get the type layouts memoized for this target (see `TypeLayoutCache`)
+        TypeLayoutCache* getTypeLayoutCache();
+
     private:
         Linkage*                linkage = nullptr;
         CodeGenTarget           format = CodeGenTarget::Unknown;
@@ -1541,6 +1638,7 @@ namespace Slang
         bool                    dumpIntermediates = false;
         bool                    forceGLSLScalarBufferLayout = false;
         bool                    enableLivenessTracking = false;
+        RefPtr<TypeLayoutCache> m_typeLayoutCache;
     };
 
         /// Are we generating code for a D3D API?
@@ -1580,6 +1678,7 @@ namespace Slang
     const char* getBuildTagString();
 
     struct TypeCheckingCache;
+    class SharedTypeCheckingCache;
 
     struct ContainerTypeKey
     {
@@ -1656,6 +1755,13 @@ namespace Slang
             ISlangBlob** outDiagnostics) override;
         SLANG_NO_THROW SlangResult SLANG_MCALL createCompileRequest(
             SlangCompileRequest**   outCompileRequest) override;
+        SLANG_NO_THROW SlangResult SLANG_MCALL getTargetHostCallables(
+            slang::IComponentType* const*   componentTypes,
+            SlangInt                        componentTypeCount,
+            SlangInt                        targetIndex,
+            SlangInt                        threadCount,
+            ISlangSharedLibrary**           outSharedLibraries,
+            ISlangBlob**                    outDiagnostics) override;
 
         void addTarget(
             slang::TargetDesc const& desc);
@@ -1701,11 +1807,41 @@ namespace Slang
         /// Holds any args that are destined for downstream compilers/tools etc
         DownstreamArgs m_downstreamArgs;
 
+            /// Persistent cache of compiled target code. Null if no cache directory was specified.
+        RefPtr<ArtifactDiskCache> m_compileCache;
+
+            /// Use `directory` to persistently cache compiled target code (across processes).
+            /// An empty directory disables the cache.
+        void setCompileCacheDirectory(String const& directory);
+
+            /// If set, modules that are imported (and compiled from source) are serialized into this
+            /// directory, and serialized modules found in it are used in place of compiling the source.
+        String m_moduleCacheDirectory;
+
+            /// Trace of where the time of compilation goes. Null if tracing isn't enabled.
+        RefPtr<CompileTrace> m_compileTrace;
+
+        CompileTrace* getCompileTrace() { return m_compileTrace; }
+
+            /// Set whilst code generation is running on multiple threads. Null otherwise.
+        ParallelCodeGen* m_parallelCodeGen = nullptr;
+
         // Name pool for looking up names
         NamePool namePool;
 
         NamePool* getNamePool() { return &namePool; }
 
+            /// Get the cache of tokens lexed from source files, shared by all preprocessing on this linkage
+        PreprocessorTokenCache* getPreprocessorTokenCache()
+        {
+            if (!m_preprocessorTokenCache)
+            {
+                m_preprocessorTokenCache = new PreprocessorTokenCache(&namePool);
+            }
+            return m_preprocessorTokenCache;
+        }
+        RefPtr<PreprocessorTokenCache> m_preprocessorTokenCache;
+
         ASTBuilder* getASTBuilder() { return m_astBuilder; }
 
        
@@ -1717,6 +1853,8 @@ namespace Slang
             // cache used by type checking, implemented in check.cpp
         TypeCheckingCache* getTypeCheckingCache();
         void destroyTypeCheckingCache();
+            /// Pass on the entries of the type checking cache that can be used by the other linkages of the session
+        void shareTypeCheckingCacheEntries();
 
         TypeCheckingCache* m_typeCheckingCache = nullptr;
 
@@ -1731,6 +1869,12 @@ namespace Slang
         // Map from the logical name of a module to its definition
         Dictionary<Name*, RefPtr<LoadedModule>> mapNameToLoadedModules;
 
+            /// Remove `modules` from the loaded modules, so they will be loaded again if they are imported.
+            ///
+            /// Imports that previously failed are also forgotten, so that they are tried again. Anything
+            /// cached on the linkage that could refer to the removed modules is discarded.
+        void removeLoadedModules(HashSet<Module*> const& modules);
+
         // Map from the mangled name of RTTI objects to sequential IDs
         // used by `switch`-based dynamic dispatch.
         Dictionary<String, uint32_t> mapMangledNameToRTTIObjectIndex;
@@ -1897,6 +2041,48 @@ namespace Slang
         void _diagnoseErrorInImportedModule(
             DiagnosticSink*     sink);
 
+            /// Try to load the module `name` from a serialized module next to its source, or in the module cache directory.
+            ///
+            /// A serialized module is only used if it was produced from the same source (including `#include`s),
+            /// the same imported modules, and the same options. Returns nullptr if there is no valid serialized module.
+        RefPtr<Module> _findSerializedModule(
+            Name*                           name,
+            const PathInfo&                 filePathInfo,
+            ISlangBlob*                     fileContentsBlob,
+            SourceLoc const&                loc,
+            DiagnosticSink*                 sink,
+            const LoadedModuleDictionary*   loadedModules);
+
+            /// Read a serialized module found by `_findSerializedModule`. Returns nullptr if it isn't valid.
+        RefPtr<Module> _readSerializedModule(
+            Name*                           name,
+            const PathInfo&                 filePathInfo,
+            ISlangBlob*                     fileContentsBlob,
+            ISlangBlob*                     serializedModuleBlob,
+            SourceLoc const&                loc,
+            DiagnosticSink*                 sink,
+            const LoadedModuleDictionary*   loadedModules);
+
+            /// Write `module` into the module cache directory, such that it can be found by `_findSerializedModule`
+        SlangResult _saveSerializedModule(
+            Module*                         module,
+            const PathInfo&                 filePathInfo);
+
+            /// Get the path in the module cache directory of the serialized module for the source at `filePathInfo`.
+            /// The name includes a hash of the canonical path of the source, so that modules with the same
+            /// file name in different directories don't replace each other.
+        String _getModuleCachePath(const PathInfo& filePathInfo);
+
+            /// Calculate the key a serialized module is validated with.
+            ///
+            /// The key identifies the compiler, the options, the contents of each of the `sourceFiles`
+            /// (the path and contents of each), and each of the `importedModules` (by name and source digest).
+            /// Returns false if the key can't be calculated, for example as an imported module's source isn't known.
+        bool _calcSerializedModuleKey(
+            List<KeyValuePair<String, UnownedStringSlice>> const&   sourceFiles,
+            List<Module*> const&                                    importedModules,
+            StringBuilder&                                          outKey);
+
         List<Type*> m_specializedTypes;
 
     };
@@ -1930,6 +2116,9 @@ namespace Slang
 
         bool shouldDumpIR = false;
         bool shouldValidateIR = false;
+            /// If set the IR is compacted at every point it can be (see IRModule::compact), rather than
+            /// only when most of its memory is held by removed instructions. Used for testing.
+        bool shouldCompactIR = false;
 
         bool shouldDumpAST = false;
         bool shouldDocument = false;
@@ -2191,6 +2380,20 @@ namespace Slang
             DiagnosticSink*         sink,
             EndToEndCompileRequest* endToEndReq = nullptr);
 
+            /// Calculate the key identifying the code for an entry point in the linkage's compile cache.
+            ///
+            /// The key describes everything that influences the generated code: the compiler version,
+            /// the target and linkage options, the source of all the modules, and the structure
+            /// and specialization of the program.
+            ///
+            /// Returns false if the code can't be cached, for example because the source of
+            /// one of the modules isn't known.
+            ///
+        bool _calcCompileCacheKey(
+            Int                     entryPointIndex,
+            EndToEndCompileRequest* endToEndReq,
+            StringBuilder&          outKey);
+
         RefPtr<IRModule> getOrCreateIRModuleForLayout(DiagnosticSink* sink);
 
         RefPtr<IRModule> getExistingIRModuleForLayout()
@@ -2389,6 +2592,7 @@ namespace Slang
         IRDumpOptions getIRDumpOptions();
 
         bool shouldValidateIR();
+        bool shouldCompactIR();
         bool shouldDumpIR();
 
         bool shouldTrackLiveness();
@@ -2539,6 +2743,8 @@ namespace Slang
             SlangSeverity overrideSeverity) SLANG_OVERRIDE;
         virtual SLANG_NO_THROW SlangDiagnosticFlags SLANG_MCALL getDiagnosticFlags() SLANG_OVERRIDE;
         virtual SLANG_NO_THROW void SLANG_MCALL setDiagnosticFlags(SlangDiagnosticFlags flags) SLANG_OVERRIDE;
+        virtual SLANG_NO_THROW void SLANG_MCALL setCompileTraceEnabled(bool enable) SLANG_OVERRIDE;
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL getCompileTrace(ISlangBlob** outTrace) SLANG_OVERRIDE;
 
         EndToEndCompileRequest(
             Session* session);
@@ -2579,6 +2785,13 @@ namespace Slang
             /// If set, if a compilation failure occurs will attempt to save off a dump repro with a unique name
         bool m_dumpReproOnError = false;
 
+            /// If set, the compile trace is written to this path (in Chrome trace format) after compilation
+        String m_traceOutputPath;
+
+            /// The number of threads to use for code generation (for different targets and entry points).
+            /// 0 means to use the number of hardware threads.
+        Index m_codeGenThreadCount = 1;
+
             /// A blob holding the diagnostic output
         ComPtr<ISlangBlob> m_diagnosticOutputBlob;
 
@@ -2700,6 +2913,9 @@ namespace Slang
         void generateOutput(ComponentType* program);
         void generateOutput(TargetProgram* targetProgram);
 
+            /// Generate the output for all targets and entry points of `program`, using `m_codeGenThreadCount` threads
+        void _generateOutputInParallel(ComponentType* program);
+
         void init();
 
         Session*                        m_session = nullptr;
@@ -2901,6 +3117,9 @@ namespace Slang
 
         Name* getCompletionRequestTokenName() const { return m_completionTokenName; }
 
+            /// Get the type checking cache entries shared by all of the linkages of this session
+        SharedTypeCheckingCache* getSharedTypeCheckingCache() const { return m_sharedTypeCheckingCache; }
+
         void init();
 
         void addBuiltinSource(
@@ -2931,6 +3150,9 @@ namespace Slang
             /// Linkage used for all built-in (stdlib) code.
         RefPtr<Linkage> m_builtinLinkage;
 
+            /// Type checking cache entries shared across linkages. Implemented in slang-check.cpp
+        SharedTypeCheckingCache* m_sharedTypeCheckingCache = nullptr;
+
         String m_downstreamCompilerPaths[int(PassThroughMode::CountOf)];         ///< Paths for each pass through
         String m_languagePreludes[int(SourceLanguage::CountOf)];                  ///< Prelude for each source language
         PassThroughMode m_defaultDownstreamCompilers[int(SourceLanguage::CountOf)];
@@ -130,6 +130,7 @@ DIAGNOSTIC(    95, Error, unknownLibraryKind, "unknown library kind '$0'")
 DIAGNOSTIC(    96, Error, kindNotLinkable, "not a known linkable kind '$0'")
 DIAGNOSTIC(    97, Error, libraryDoesNotExist, "library '$0' does not exist")
 DIAGNOSTIC(    98, Error, cannotAccessAsBlob, "cannot access as a blob")
+DIAGNOSTIC(    99, Error, unableToReadModuleIR, "unable to read the IR of module '$0'")
 
 //
 // 001xx - Downstream Compilers
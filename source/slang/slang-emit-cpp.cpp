@@ -766,6 +766,40 @@ static bool _isOperator(const UnownedStringSlice& funcName)
     return false;
 }
 
+// Get the name of the function in the C++ prelude that implements the element-wise `specOp`
+// on vectors or matrices, or an empty slice if there isn't one. The prelude functions can use SIMD.
+static UnownedStringSlice _getPreludeElementWiseFuncName(const HLSLIntrinsic* specOp)
+{
+    typedef HLSLIntrinsic::Op Op;
+
+    IRType* type = specOp->returnType;
+    const bool isVector = as<IRVectorType>(type) != nullptr;
+    if (!isVector && !as<IRMatrixType>(type))
+    {
+        return UnownedStringSlice();
+    }
+
+    // All of the parameters must be the same type as the result (so not vector * scalar, for example)
+    IRFuncType* funcType = specOp->signatureType;
+    for (UInt i = 0; i < funcType->getParamCount(); ++i)
+    {
+        if (funcType->getParamType(i) != type)
+        {
+            return UnownedStringSlice();
+        }
+    }
+
+    switch (specOp->op)
+    {
+        case Op::Add:   return isVector ? UnownedStringSlice::fromLiteral("_slang_vector_add") : UnownedStringSlice::fromLiteral("_slang_matrix_add");
+        case Op::Sub:   return isVector ? UnownedStringSlice::fromLiteral("_slang_vector_sub") : UnownedStringSlice::fromLiteral("_slang_matrix_sub");
+        case Op::Mul:   return isVector ? UnownedStringSlice::fromLiteral("_slang_vector_mul") : UnownedStringSlice::fromLiteral("_slang_matrix_mul");
+        case Op::Div:   return isVector ? UnownedStringSlice::fromLiteral("_slang_vector_div") : UnownedStringSlice::fromLiteral("_slang_matrix_div");
+        case Op::Neg:   return isVector ? UnownedStringSlice::fromLiteral("_slang_vector_neg") : UnownedStringSlice::fromLiteral("_slang_matrix_neg");
+        default:        return UnownedStringSlice();
+    }
+}
+
 void CPPSourceEmitter::_emitAryDefinition(const HLSLIntrinsic* specOp)
 {
     auto info = HLSLIntrinsic::getInfo(specOp->op);
@@ -813,6 +847,21 @@ void CPPSourceEmitter::_emitAryDefinition(const HLSLIntrinsic* specOp)
     writer->emit("\n{\n");
     writer->indent();
 
+    if (_isCppTarget(m_target))
+    {
+        const UnownedStringSlice preludeFuncName = _getPreludeElementWiseFuncName(specOp);
+        if (preludeFuncName.getLength())
+        {
+            writer->emit("return ");
+            writer->emit(preludeFuncName);
+            writer->emit(numParams == 1 ? "(a);\n" : "(a, b);\n");
+
+            writer->dedent();
+            writer->emit("}\n\n");
+            return;
+        }
+    }
+
     const bool hasReturnType = retType->getOp() != kIROp_VoidType;
 
     TypeDimension calcDim;
@@ -1423,6 +1472,27 @@ void CPPSourceEmitter::emitCall(const HLSLIntrinsic* specOp, IRInst* inst, const
 
             const UnownedStringSlice* elemNames = getVectorElementNames(srcVecType);
 
+            // A swizzle to 4 elements is implemented in the prelude (which can use SIMD), as
+            // _slang_vector_swizzle<indices...>(base)
+            if (_isCppTarget(m_target) && srcVecType && elementCount == 4)
+            {
+                writer->emit("_slang_vector_swizzle<");
+                for (Index i = 0; i < elementCount; ++i)
+                {
+                    if (i > 0)
+                    {
+                        writer->emit(", ");
+                    }
+                    IRInst* irElementIndex = swizzleInst->getElementIndex(i);
+                    SLANG_RELEASE_ASSERT(irElementIndex->getOp() == kIROp_IntLit);
+                    writer->emit(static_cast<IRConstant*>(irElementIndex)->value.intVal);
+                }
+                writer->emit(">(");
+                emitOperand(swizzleInst->getBase(), getInfo(EmitOp::General));
+                writer->emit(")");
+                return;
+            }
+
             // TODO(JS): Not 100% sure this is correct on the parens handling front
             IRType* retType = specOp->returnType;
             emitType(retType);
@@ -2024,6 +2094,10 @@ void CPPSourceEmitter::emitSimpleFuncImpl(IRFunc* func)
         //
         StringBuilder prefixName;
         prefixName << "_" << name;
+
+        // The workhorse may be inlined into the loop over the threads of a group
+        // to allow that loop to be vectorized (see SLANG_ENABLE_LANE_VECTORIZATION in the prelude).
+        m_writer->emit("SLANG_LANE_INLINE ");
         emitType(resultType, prefixName);
     }
     else
@@ -2296,6 +2370,14 @@ void CPPSourceEmitter::emitIntrinsicCallExprImpl(
         return;
     }
 
+    if (name == "slang_groupSync()")
+    {
+        // Group synchronization requires the threads of a group to execute as fibers.
+        // Note that the entry points are emitted after all other functions, so this is
+        // known by the time they are output.
+        m_hasGroupSync = true;
+    }
+
     {
         Op op = m_opLookup->getOpByName(name);
         if (op != Op::Invalid)
@@ -2563,6 +2645,18 @@ static Index _calcTypeOrder(IRType* a)
     }
 }
 
+void CPPSourceEmitter::emitFrontMatterImpl(TargetRequest* targetReq)
+{
+    SLANG_UNUSED(targetReq);
+
+    // The front matter is emitted before the prelude, so this enables the group fiber
+    // support in the prelude (see slang-cpp-group-fiber.h).
+    if (m_hasGroupSync)
+    {
+        m_writer->emit("#define SLANG_PRELUDE_ENABLE_GROUP_FIBERS 1\n\n");
+    }
+}
+
 void CPPSourceEmitter::emitPreModuleImpl()
 {
     if (m_target == CodeGenTarget::CPPSource)
@@ -2583,6 +2677,15 @@ void CPPSourceEmitter::emitPreModuleImpl()
         m_writer->emit("#endif\n\n");
     }
 
+    // The lane vectorization hints used by entry points are defined in the default prelude.
+    // A user supplied prelude may not define them, so fall back to no hints.
+    m_writer->emit("#ifndef SLANG_LANE_LOOP\n");
+    m_writer->emit("#define SLANG_LANE_LOOP\n");
+    m_writer->emit("#endif\n");
+    m_writer->emit("#ifndef SLANG_LANE_INLINE\n");
+    m_writer->emit("#define SLANG_LANE_INLINE\n");
+    m_writer->emit("#endif\n\n");
+
     // Emit generated functions and types
 
     if (m_target == CodeGenTarget::CSource)
@@ -2665,6 +2768,17 @@ void CPPSourceEmitter::emitVarDecorationsImpl(IRInst* inst)
     Super::emitVarDecorationsImpl(inst);
 }
 
+void CPPSourceEmitter::emitRateQualifiersImpl(IRRate* rate)
+{
+    if (as<IRGroupSharedRate>(rate))
+    {
+        // Thread groups are executed one at a time by each thread, but a dispatch may be spread
+        // over multiple threads. Making groupshared storage thread local gives each concurrently
+        // executing group its own copy.
+        m_writer->emit("thread_local ");
+    }
+}
+
 void CPPSourceEmitter::_getExportStyle(IRInst* inst, bool& outIsExport, bool& outIsExternC)
 {
     outIsExport = false;
@@ -2833,21 +2947,39 @@ void CPPSourceEmitter::_emitEntryPointGroup(const Int sizeAlongAxis[kThreadGroup
     for (Index i = 0; i < axes.getCount(); ++i)
     {
         const auto& axis = axes[i];
+        const bool isInnerLoop = (i == axes.getCount() - 1);
+
         builder.Clear();
         const char elem[2] = { s_xyzwNames[axis.axis], 0 };
+
+        // The inner loop is over lanes, which can be vectorized if SLANG_ENABLE_LANE_VECTORIZATION is defined.
+        if (isInnerLoop)
+        {
+            builder << "SLANG_LANE_LOOP\n";
+        }
+
         builder << "for (uint32_t " << elem << " = 0; " << elem << " < " << axis.size << "; ++" << elem << ")\n{\n";
         m_writer->emit(builder);
         m_writer->indent();
 
         builder.Clear();
-        builder << "threadInput.groupThreadID." << elem << " = " << elem << ";\n";
+        if (isInnerLoop)
+        {
+            // Each lane has its own copy of the input, so iterations don't depend on each other.
+            builder << "ComputeThreadVaryingInput laneInput = threadInput;\n";
+            builder << "laneInput.groupThreadID." << elem << " = " << elem << ";\n";
+        }
+        else
+        {
+            builder << "threadInput.groupThreadID." << elem << " = " << elem << ";\n";
+        }
         m_writer->emit(builder);
     }
 
     // just call at inner loop point
     m_writer->emit("_");
     m_writer->emit(funcName);
-    m_writer->emit("(&threadInput, entryPointParams, globalParams);\n");
+    m_writer->emit(axes.getCount() ? "(&laneInput, entryPointParams, globalParams);\n" : "(&threadInput, entryPointParams, globalParams);\n");
 
     // Close all the loops
     for (Index i = Index(axes.getCount() - 1); i >= 0; --i)
@@ -2857,6 +2989,20 @@ void CPPSourceEmitter::_emitEntryPointGroup(const Int sizeAlongAxis[kThreadGroup
     }
 }
 
+void CPPSourceEmitter::_emitEntryPointGroupFibers(const Int sizeAlongAxis[kThreadGroupAxisCount], const String& funcName)
+{
+    // Each thread of the group runs on its own fiber, such that the threads can be synchronized.
+    // The `_Thread` function is used as the fiber entry point.
+    StringBuilder builder;
+    builder << "slang_runGroupFibers(&" << funcName << "_Thread, &threadInput";
+    for (int i = 0; i < kThreadGroupAxisCount; ++i)
+    {
+        builder << ", " << sizeAlongAxis[i];
+    }
+    builder << ", entryPointParams, globalParams);\n";
+    m_writer->emit(builder);
+}
+
 void CPPSourceEmitter::_emitEntryPointGroupRange(const Int sizeAlongAxis[kThreadGroupAxisCount], const String& funcName)
 {
     List<AxisWithSize> axes;
@@ -3047,7 +3193,14 @@ void CPPSourceEmitter::emitModuleImpl(IRModule* module, DiagnosticSink* sink)
                     m_writer->emit("ComputeThreadVaryingInput threadInput = {};\n");
                     m_writer->emit("threadInput.groupID = varyingInput->startGroupID;\n");
 
-                    _emitEntryPointGroup(groupThreadSize, funcName);
+                    if (m_hasGroupSync)
+                    {
+                        _emitEntryPointGroupFibers(groupThreadSize, funcName);
+                    }
+                    else
+                    {
+                        _emitEntryPointGroup(groupThreadSize, funcName);
+                    }
                     _emitEntryPointDefinitionEnd(func);
                 }
 
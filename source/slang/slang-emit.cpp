@@ -176,6 +176,97 @@ struct LinkingAndOptimizationOptions
     CLikeSourceEmitter* sourceEmitter = nullptr;
 };
 
+static Index _countIRInsts(IRInst* inst)
+{
+    Index count = 1;
+    for (auto child : inst->getDecorationsAndChildren())
+    {
+        count += _countIRInsts(child);
+    }
+    return count;
+}
+
+    /// Records an "ir-pass" event in the compile trace (if there is one) for the duration of a pass,
+    /// along with the size of the module before and after the pass. The module is measured outside of
+    /// the event, so the time taken to measure isn't attributed to the pass.
+struct IRPassTraceScope
+{
+    IRPassTraceScope(CodeGenContext* codeGenContext, IRModule* irModule, const char* passName):
+        m_irModule(irModule),
+        m_trace(codeGenContext->getLinkage()->getCompileTrace())
+    {
+        if (m_trace)
+        {
+            m_instCountBefore = _countIRInsts(irModule->getModuleInst());
+            m_reusedInstCountBefore = irModule->getReusedInstCount();
+            m_eventIndex = m_trace->beginEvent("ir-pass", UnownedStringSlice(passName));
+        }
+    }
+    ~IRPassTraceScope()
+    {
+        if (m_trace)
+        {
+            m_trace->endEvent(m_eventIndex);
+
+            m_trace->addArg(m_eventIndex, "instCountBefore", m_instCountBefore);
+            m_trace->addArg(m_eventIndex, "instCountAfter", _countIRInsts(m_irModule->getModuleInst()));
+            m_trace->addArg(m_eventIndex, "arenaBytes", int64_t(m_irModule->getMemoryArena().calcTotalMemoryUsed()));
+            m_trace->addArg(m_eventIndex, "reusedInstCount", m_irModule->getReusedInstCount() - m_reusedInstCountBefore);
+        }
+    }
+
+    IRModule* m_irModule;
+    CompileTrace* m_trace;
+    Index m_eventIndex = -1;
+    Index m_instCountBefore = 0;
+    Index m_reusedInstCountBefore = 0;
+};
+
+// Runs the pass `CALL` on `irModule`, recording it in the compile trace as `NAME`
+#define SLANG_TRACE_IR_PASS(NAME, CALL) \
+    do { IRPassTraceScope passTraceScope(codeGenContext, irModule, NAME); CALL; } while (0)
+
+// Called between phases of `linkAndOptimizeIR`, where nothing refers to instructions that passes have
+// removed. Their memory is made available to new instructions, and if most of the memory used by the
+// module is held by removed instructions, the module is compacted to release it.
+static void _reclaimIRMemory(CodeGenContext* codeGenContext, IRModule* irModule, LinkedIR& ioLinkedIR, List<IRFunc*>& ioEntryPoints)
+{
+    irModule->recycleDeallocatedInsts();
+
+    const size_t usedSize = irModule->getMemoryArena().calcTotalMemoryUsed();
+    const size_t deallocatedSize = irModule->getDeallocatedInstsSize();
+    if (!codeGenContext->shouldCompactIR() && deallocatedSize < usedSize - deallocatedSize)
+    {
+        return;
+    }
+
+    Dictionary<IRInst*, IRInst*> remap;
+    {
+        IRPassTraceScope passTraceScope(codeGenContext, irModule, "compact");
+        if (!irModule->compact(remap))
+        {
+            return;
+        }
+    }
+
+    // Fix up the instructions referred to from outside of the module. The global scope layout is only
+    // needed by early passes, so may have since been removed as dead, in which case it is cleared.
+    auto remapInst = [&](IRInst* inst) -> IRInst*
+    {
+        IRInst** newInst = inst ? remap.TryGetValue(inst) : nullptr;
+        return newInst ? *newInst : nullptr;
+    };
+    for (auto& entryPoint : ioLinkedIR.entryPoints)
+    {
+        entryPoint = static_cast<IRFunc*>(remapInst(entryPoint));
+    }
+    for (auto& entryPoint : ioEntryPoints)
+    {
+        entryPoint = static_cast<IRFunc*>(remapInst(entryPoint));
+    }
+    ioLinkedIR.globalScopeVarLayout = static_cast<IRVarLayout*>(remapInst(ioLinkedIR.globalScopeVarLayout));
+}
+
 Result linkAndOptimizeIR(
     CodeGenContext*                         codeGenContext,
     LinkingAndOptimizationOptions const&    options,
@@ -197,7 +288,24 @@ Result linkAndOptimizeIR(
     // modules, and also select between the definitions of
     // any "profile-overloaded" symbols.
     //
-    outLinkedIR = linkIR(codeGenContext);
+    // The IR of modules that are read lazily is read first, so that if reading fails it is
+    // diagnosed, rather than the module appearing to have no IR.
+    //
+    {
+        SlangResult readResult = SLANG_OK;
+        codeGenContext->getProgram()->enumerateModules([&](Module* module)
+        {
+            if (SLANG_FAILED(module->readIRModule(sink)))
+            {
+                readResult = SLANG_FAIL;
+            }
+        });
+        SLANG_RETURN_ON_FAIL(readResult);
+    }
+    {
+        CompileTraceScope linkScope(codeGenContext->getLinkage()->getCompileTrace(), "ir-pass", "linkIR");
+        outLinkedIR = linkIR(codeGenContext);
+    }
     auto irModule = outLinkedIR.module;
     auto irEntryPoints = outLinkedIR.entryPoints;
 
@@ -214,7 +322,7 @@ Result linkAndOptimizeIR(
 
     // Replace any global constants with their values.
     //
-    replaceGlobalConstants(irModule);
+    SLANG_TRACE_IR_PASS("replaceGlobalConstants", replaceGlobalConstants(irModule));
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "GLOBAL CONSTANTS REPLACED");
 #endif
@@ -228,7 +336,7 @@ Result linkAndOptimizeIR(
     // shader parameters for those slots, to be wired up to
     // use sites.
     //
-    bindExistentialSlots(irModule, sink);
+    SLANG_TRACE_IR_PASS("bindExistentialSlots", bindExistentialSlots(irModule, sink));
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "EXISTENTIALS BOUND");
 #endif
@@ -252,7 +360,7 @@ Result linkAndOptimizeIR(
     // can assume that all ordinary/uniform data is strictly
     // passed using constant buffers.
     //
-    collectGlobalUniformParameters(irModule, outLinkedIR.globalScopeVarLayout);
+    SLANG_TRACE_IR_PASS("collectGlobalUniformParameters", collectGlobalUniformParameters(irModule, outLinkedIR.globalScopeVarLayout));
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "GLOBAL UNIFORMS COLLECTED");
 #endif
@@ -273,7 +381,7 @@ Result linkAndOptimizeIR(
         case CodeGenTarget::HostCPPSource:
             break;
         case CodeGenTarget::CUDASource:
-            collectOptiXEntryPointUniformParams(irModule);
+            SLANG_TRACE_IR_PASS("collectOptiXEntryPointUniformParams", collectOptiXEntryPointUniformParams(irModule));
             #if 0
             dumpIRIfEnabled(codeGenContext, irModule, "OPTIX ENTRY POINT UNIFORMS COLLECTED");
             #endif
@@ -283,7 +391,7 @@ Result linkAndOptimizeIR(
         case CodeGenTarget::CPPSource:
             passOptions.alwaysCreateCollectedParam = true;
         default:
-            collectEntryPointUniformParams(irModule, passOptions);
+            SLANG_TRACE_IR_PASS("collectEntryPointUniformParams", collectEntryPointUniformParams(irModule, passOptions));
         #if 0
             dumpIRIfEnabled(codeGenContext, irModule, "ENTRY POINT UNIFORMS COLLECTED");
         #endif
@@ -295,7 +403,7 @@ Result linkAndOptimizeIR(
     switch( target )
     {
     default:
-        moveEntryPointUniformParamsToGlobalScope(irModule);
+        SLANG_TRACE_IR_PASS("moveEntryPointUniformParamsToGlobalScope", moveEntryPointUniformParamsToGlobalScope(irModule));
     #if 0
         dumpIRIfEnabled(codeGenContext, irModule, "ENTRY POINT UNIFORMS MOVED");
     #endif
@@ -307,29 +415,29 @@ Result linkAndOptimizeIR(
         break;
     }
 
-    lowerOptionalType(irModule, sink);
-    simplifyIR(irModule);
+    SLANG_TRACE_IR_PASS("lowerOptionalType", lowerOptionalType(irModule, sink));
+    SLANG_TRACE_IR_PASS("simplifyIR", simplifyIR(irModule));
 
     switch (target)
     {
     case CodeGenTarget::CPPSource:
     case CodeGenTarget::HostCPPSource:
     {
-        lowerComInterfaces(irModule, artifactDesc.style, sink);
-        generateDllImportFuncs(codeGenContext->getTargetReq(), irModule, sink);
-        generateDllExportFuncs(irModule, sink);
+        SLANG_TRACE_IR_PASS("lowerComInterfaces", lowerComInterfaces(irModule, artifactDesc.style, sink));
+        SLANG_TRACE_IR_PASS("generateDllImportFuncs", generateDllImportFuncs(codeGenContext->getTargetReq(), irModule, sink));
+        SLANG_TRACE_IR_PASS("generateDllExportFuncs", generateDllExportFuncs(irModule, sink));
         break;
     }
     default: break;
     }
 
     // Lower `Result<T,E>` types into ordinary struct types.
-    lowerResultType(irModule, sink);
+    SLANG_TRACE_IR_PASS("lowerResultType", lowerResultType(irModule, sink));
 
     // Desguar any union types, since these will be illegal on
     // various targets.
     //
-    desugarUnionTypes(irModule);
+    SLANG_TRACE_IR_PASS("desugarUnionTypes", desugarUnionTypes(irModule));
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "UNIONS DESUGARED");
 #endif
@@ -356,13 +464,13 @@ Result linkAndOptimizeIR(
     //
     dumpIRIfEnabled(codeGenContext, irModule, "BEFORE-SPECIALIZE");
     if (!codeGenContext->isSpecializationDisabled())
-        specializeModule(irModule);
+        SLANG_TRACE_IR_PASS("specializeModule", specializeModule(irModule));
     dumpIRIfEnabled(codeGenContext, irModule, "AFTER-SPECIALIZE");
 
-    applySparseConditionalConstantPropagation(irModule);
-    eliminateDeadCode(irModule);
+    SLANG_TRACE_IR_PASS("applySparseConditionalConstantPropagation", applySparseConditionalConstantPropagation(irModule));
+    SLANG_TRACE_IR_PASS("eliminateDeadCode", eliminateDeadCode(irModule));
 
-    lowerReinterpret(targetRequest, irModule, sink);
+    SLANG_TRACE_IR_PASS("lowerReinterpret", lowerReinterpret(targetRequest, irModule, sink));
 
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
@@ -370,7 +478,7 @@ Result linkAndOptimizeIR(
     // generics / interface types to ordinary functions and types using
     // function pointers.
     dumpIRIfEnabled(codeGenContext, irModule, "BEFORE-LOWER-GENERICS");
-    lowerGenerics(targetRequest, irModule, sink);
+    SLANG_TRACE_IR_PASS("lowerGenerics", lowerGenerics(targetRequest, irModule, sink));
     dumpIRIfEnabled(codeGenContext, irModule, "AFTER-LOWER-GENERICS");
 
     if (sink->getErrorCount() != 0)
@@ -384,16 +492,19 @@ Result linkAndOptimizeIR(
 #endif
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
+    // Specialization clones, and then discards, a lot of code
+    _reclaimIRMemory(codeGenContext, irModule, outLinkedIR, irEntryPoints);
+
     // Inline calls to any functions marked with [__unsafeInlineEarly] again,
     // since we may be missing out cases prevented by the generic constructs
     // that we just lowered out.
-    performMandatoryEarlyInlining(irModule);
+    SLANG_TRACE_IR_PASS("performMandatoryEarlyInlining", performMandatoryEarlyInlining(irModule));
 
     // Specialization can introduce dead code that could trip
     // up downstream passes like type legalization, so we
     // will run a DCE pass to clean up after the specialization.
     //
-    simplifyIR(irModule);
+    SLANG_TRACE_IR_PASS("simplifyIR", simplifyIR(irModule));
 
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "AFTER DCE");
@@ -429,10 +540,8 @@ Result linkAndOptimizeIR(
         //  we need to replace it with just an `X`, after which we
         //  will have (more) legal shader code.
         //
-        legalizeExistentialTypeLayout(
-            irModule,
-            sink);
-        eliminateDeadCode(irModule);
+        SLANG_TRACE_IR_PASS("legalizeExistentialTypeLayout", legalizeExistentialTypeLayout(irModule, sink));
+        SLANG_TRACE_IR_PASS("eliminateDeadCode", eliminateDeadCode(irModule));
 
 #if 0
         dumpIRIfEnabled(codeGenContext, irModule, "EXISTENTIALS LEGALIZED");
@@ -450,10 +559,8 @@ Result linkAndOptimizeIR(
         // What used to be individual variables/parameters/arguments/etc.
         // then become multiple variables/parameters/arguments/etc.
         //
-        legalizeResourceTypes(
-            irModule,
-            sink);
-        eliminateDeadCode(irModule);
+        SLANG_TRACE_IR_PASS("legalizeResourceTypes", legalizeResourceTypes(irModule, sink));
+        SLANG_TRACE_IR_PASS("eliminateDeadCode", eliminateDeadCode(irModule));
 
         //  Debugging output of legalization
     #if 0
@@ -467,13 +574,15 @@ Result linkAndOptimizeIR(
     // to see if we can clean up any temporaries created by legalization.
     // (e.g., things that used to be aggregated might now be split up,
     // so that we can work with the individual fields).
-    simplifyIR(irModule);
+    SLANG_TRACE_IR_PASS("simplifyIR", simplifyIR(irModule));
 
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "AFTER SSA");
 #endif
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
+    _reclaimIRMemory(codeGenContext, irModule, outLinkedIR, irEntryPoints);
+
     // After type legalization and subsequent SSA cleanup we expect
     // that any resource types passed to functions are exposed
     // as their own top-level parameters (which might have
@@ -483,19 +592,19 @@ Result linkAndOptimizeIR(
     // resource types can be used, so that having them as
     // function parameters, reults, etc. is invalid.
     // We clean up the usages of resource values here.
-    specializeResourceUsage(codeGenContext, irModule);
-    specializeFuncsForBufferLoadArgs(codeGenContext, irModule);
+    SLANG_TRACE_IR_PASS("specializeResourceUsage", specializeResourceUsage(codeGenContext, irModule));
+    SLANG_TRACE_IR_PASS("specializeFuncsForBufferLoadArgs", specializeFuncsForBufferLoadArgs(codeGenContext, irModule));
 
     //
-    simplifyIR(irModule);
+    SLANG_TRACE_IR_PASS("simplifyIR", simplifyIR(irModule));
 
     // For GLSL targets, we also want to specialize calls to functions that
     // takes array parameters if possible, to avoid performance issues on
     // those platforms.
     if (isKhronosTarget(targetRequest))
     {
-        specializeArrayParameters(codeGenContext, irModule);
-        simplifyIR(irModule);
+        SLANG_TRACE_IR_PASS("specializeArrayParameters", specializeArrayParameters(codeGenContext, irModule));
+        SLANG_TRACE_IR_PASS("simplifyIR", simplifyIR(irModule));
     }
 
 #if 0
@@ -504,6 +613,8 @@ Result linkAndOptimizeIR(
 
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
+    _reclaimIRMemory(codeGenContext, irModule, outLinkedIR, irEntryPoints);
+
     // For HLSL (and fxc/dxc) only, we need to "wrap" any
     // structured buffers defined over matrix types so
     // that they instead use an intermediate `struct`.
@@ -515,7 +626,7 @@ Result linkAndOptimizeIR(
     {
     case CodeGenTarget::HLSL:
         {
-            wrapStructuredBuffersOfMatrices(irModule);
+            SLANG_TRACE_IR_PASS("wrapStructuredBuffersOfMatrices", wrapStructuredBuffersOfMatrices(irModule));
 #if 0
             dumpIRIfEnabled(codeGenContext, irModule, "STRUCTURED BUFFERS WRAPPED");
 #endif
@@ -612,7 +723,7 @@ Result linkAndOptimizeIR(
             break;
         }
 
-        legalizeByteAddressBufferOps(session, targetRequest, irModule, byteAddressBufferOptions);
+        SLANG_TRACE_IR_PASS("legalizeByteAddressBufferOps", legalizeByteAddressBufferOps(session, targetRequest, irModule, byteAddressBufferOptions));
     }
 
     // For CUDA targets only, we will need to turn operations
@@ -624,9 +735,9 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::CUDASource:
     case CodeGenTarget::PTX:
         {
-            synthesizeActiveMask(
+            SLANG_TRACE_IR_PASS("synthesizeActiveMask", synthesizeActiveMask(
                 irModule,
-                codeGenContext->getSink());
+                codeGenContext->getSink()));
 
 #if 0
             dumpIRIfEnabled(codeGenContext, irModule, "AFTER synthesizeActiveMask");
@@ -653,12 +764,12 @@ Result linkAndOptimizeIR(
     {
         auto glslExtensionTracker = as<GLSLExtensionTracker>(options.sourceEmitter->getExtensionTracker());
 
-        legalizeEntryPointsForGLSL(
+        SLANG_TRACE_IR_PASS("legalizeEntryPointsForGLSL", legalizeEntryPointsForGLSL(
             session,
             irModule,
             irEntryPoints,
             codeGenContext->getSink(),
-            glslExtensionTracker);
+            glslExtensionTracker));
 
 #if 0
             dumpIRIfEnabled(codeGenContext, irModule, "GLSL LEGALIZED");
@@ -670,13 +781,13 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::CSource:
     case CodeGenTarget::CPPSource:
         {
-            legalizeEntryPointVaryingParamsForCPU(irModule, codeGenContext->getSink());
+            SLANG_TRACE_IR_PASS("legalizeEntryPointVaryingParamsForCPU", legalizeEntryPointVaryingParamsForCPU(irModule, codeGenContext->getSink()));
         }
         break;
 
     case CodeGenTarget::CUDASource:
         {
-            legalizeEntryPointVaryingParamsForCUDA(irModule, codeGenContext->getSink());
+            SLANG_TRACE_IR_PASS("legalizeEntryPointVaryingParamsForCUDA", legalizeEntryPointVaryingParamsForCUDA(irModule, codeGenContext->getSink()));
         }
         break;
 
@@ -689,7 +800,7 @@ Result linkAndOptimizeIR(
     {
     case CodeGenTarget::GLSL:
         {
-            legalizeImageSubscriptForGLSL(irModule);
+            SLANG_TRACE_IR_PASS("legalizeImageSubscriptForGLSL", legalizeImageSubscriptForGLSL(irModule));
         }
         break;
     default:
@@ -703,11 +814,11 @@ Result linkAndOptimizeIR(
 
     case CodeGenTarget::CPPSource:
     case CodeGenTarget::CUDASource:
-        moveGlobalVarInitializationToEntryPoints(irModule);
-        introduceExplicitGlobalContext(irModule, target);
+        SLANG_TRACE_IR_PASS("moveGlobalVarInitializationToEntryPoints", moveGlobalVarInitializationToEntryPoints(irModule));
+        SLANG_TRACE_IR_PASS("introduceExplicitGlobalContext", introduceExplicitGlobalContext(irModule, target));
         if(target == CodeGenTarget::CPPSource)
         {
-            convertEntryPointPtrParamsToRawPtrs(irModule);
+            SLANG_TRACE_IR_PASS("convertEntryPointPtrParamsToRawPtrs", convertEntryPointPtrParamsToRawPtrs(irModule));
         }
     #if 0
         dumpIRIfEnabled(codeGenContext, irModule, "EXPLICIT GLOBAL CONTEXT INTRODUCED");
@@ -716,18 +827,20 @@ Result linkAndOptimizeIR(
         break;
     }
 
-    stripCachedDictionaries(irModule);
+    SLANG_TRACE_IR_PASS("stripCachedDictionaries", stripCachedDictionaries(irModule));
 
     // TODO: our current dynamic dispatch pass will remove all uses of witness tables.
     // If we are going to support function-pointer based, "real" modular dynamic dispatch,
     // we will need to disable this pass.
-    stripWitnessTables(irModule);
+    SLANG_TRACE_IR_PASS("stripWitnessTables", stripWitnessTables(irModule));
 
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "AFTER STRIP WITNESS TABLES");
 #endif
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
+    _reclaimIRMemory(codeGenContext, irModule, outLinkedIR, irEntryPoints);
+
     // The resource-based specialization pass above
     // may create specialized versions of functions, but
     // it does not try to completely eliminate the original
@@ -736,25 +849,25 @@ Result linkAndOptimizeIR(
     //
     // We run IR simplification passes again to clean things up.
     //
-    simplifyIR(irModule);
+    SLANG_TRACE_IR_PASS("simplifyIR", simplifyIR(irModule));
 
     if (isKhronosTarget(targetRequest))
     {
         // As a fallback, if the above specialization steps failed to remove resource type parameters, we will
         // inline the functions in question to make sure we can produce valid GLSL.
-        performGLSLResourceReturnFunctionInlining(irModule);
+        SLANG_TRACE_IR_PASS("performGLSLResourceReturnFunctionInlining", performGLSLResourceReturnFunctionInlining(irModule));
     }
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "AFTER DCE");
 #endif
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
-    cleanUpVoidType(irModule);
+    SLANG_TRACE_IR_PASS("cleanUpVoidType", cleanUpVoidType(irModule));
 
     // Lower all bit_cast operations on complex types into leaf-level
     // bit_cast on basic types.
-    lowerBitCast(targetRequest, irModule);
-    simplifyIR(irModule);
+    SLANG_TRACE_IR_PASS("lowerBitCast", lowerBitCast(targetRequest, irModule));
+    SLANG_TRACE_IR_PASS("simplifyIR", simplifyIR(irModule));
 
     {
         // Get the liveness mode.
@@ -772,7 +885,7 @@ Result linkAndOptimizeIR(
         //
         if (isEnabled(livenessMode))
         {
-            LivenessUtil::addVariableRangeStarts(irModule, livenessMode);
+            SLANG_TRACE_IR_PASS("addVariableRangeStarts", LivenessUtil::addVariableRangeStarts(irModule, livenessMode));
         }
 
         // As a late step, we need to take the SSA-form IR and move things *out*
@@ -784,7 +897,7 @@ Result linkAndOptimizeIR(
 
         {
             // We only want to accumulate locations if liveness tracking is enabled.
-            eliminatePhis(codeGenContext, livenessMode, irModule);
+            SLANG_TRACE_IR_PASS("eliminatePhis", eliminatePhis(codeGenContext, livenessMode, irModule));
 #if 0
             dumpIRIfEnabled(codeGenContext, irModule, "PHIS ELIMINATED");
 #endif
@@ -794,7 +907,7 @@ Result linkAndOptimizeIR(
 
         if (isEnabled(livenessMode))
         {
-            LivenessUtil::addRangeEnds(irModule, livenessMode);
+            SLANG_TRACE_IR_PASS("addRangeEnds", LivenessUtil::addRangeEnds(irModule, livenessMode));
 
 #if 0
             dumpIRIfEnabled(codeGenContext, irModule, "LIVENESS");
@@ -824,7 +937,7 @@ Result linkAndOptimizeIR(
     {
         if (isKhronosTarget(targetRequest))
         {
-            applyGLSLLiveness(irModule);
+            SLANG_TRACE_IR_PASS("applyGLSLLiveness", applyGLSLLiveness(irModule));
         }
     }
 
@@ -840,13 +953,15 @@ Result linkAndOptimizeIR(
     auto metadata = new ArtifactPostEmitMetadata;
     outLinkedIR.metadata = metadata;
 
-    collectMetadata(irModule, *metadata);
+    SLANG_TRACE_IR_PASS("collectMetadata", collectMetadata(irModule, *metadata));
 
     outLinkedIR.metadata = metadata;
 
     return SLANG_OK;
 }
 
+#undef SLANG_TRACE_IR_PASS
+
 SlangResult CodeGenContext::emitEntryPointsSourceFromIR(ComPtr<IArtifact>& outArtifact)
 {
     outArtifact.setNull();
@@ -964,6 +1079,7 @@ SlangResult CodeGenContext::emitEntryPointsSourceFromIR(ComPtr<IArtifact>& outAr
 #if 0
         dumpIR(compileRequest, irModule, "PRE-EMIT");
 #endif
+        CompileTraceScope emitScope(getLinkage()->getCompileTrace(), "emit", "emitModule");
         sourceEmitter->emitModule(irModule, sink);
     }
 
@@ -1058,7 +1174,10 @@ SlangResult emitSPIRVForEntryPointsDirectly(
     auto irEntryPoints = linkedIR.entryPoints;
 
     List<uint8_t> spirv;
-    emitSPIRVFromIR(codeGenContext, irModule, irEntryPoints, spirv);
+    {
+        CompileTraceScope emitScope(codeGenContext->getLinkage()->getCompileTrace(), "emit", "emitSPIRV");
+        emitSPIRVFromIR(codeGenContext, irModule, irEntryPoints, spirv);
+    }
 
     auto artifact = ArtifactUtil::createArtifactForCompileTarget(asExternal(codeGenContext->getTargetFormat()));
     artifact->addRepresentationUnknown(ListBlob::moveCreate(spirv));
@@ -22,6 +22,21 @@ struct DeadCodeEliminationContext
     // These uses will be replaced with `undefInst`.
     IRInst* undefInst = nullptr;
 
+    // When set, only the descendents of `root` are candidates
+    // for elimination, and everything else is assumed to be live.
+    //
+    IRInst* root = nullptr;
+
+    bool isInsideRoot(IRInst* inst)
+    {
+        for( auto parent = inst->getParent(); parent; parent = parent->getParent() )
+        {
+            if( parent == root )
+                return true;
+        }
+        return false;
+    }
+
     // Our overall process is going to be to determine
     // which instructions in the module are "live"
     // and then eliminate anything that wasn't found to
@@ -74,6 +89,13 @@ struct DeadCodeEliminationContext
         //
         if(!inst) return;
 
+        // When working on the code of a single function (or other
+        // code-bearing value), we don't need to track the liveness
+        // of anything outside of it.
+        //
+        if(root && !isInsideRoot(inst))
+            return;
+
         if(liveInsts.Contains(inst))
             return;
         liveInsts.Add(inst);
@@ -128,6 +150,72 @@ struct DeadCodeEliminationContext
         // processing entries off of our work list
         // until it goes dry.
         //
+        processWorkList();
+
+        // If our work list runs dry, that means we've reached a steady
+        // state where everything that is transitively relevant to
+        // the "outputs" of the module has been marked as live.
+        //
+        // Now we can simply walk through all of our instructions
+        // recursively and eliminate those that are "dead" by
+        // virtue of not having been found live.
+        //
+        return eliminateDeadInstsRec(module->getModuleInst());
+    }
+
+    // Eliminating dead code from just the body of `code` follows
+    // the same approach as for a whole module, treating `code`
+    // itself (and everything outside of it) as live.
+    //
+    bool processCode(IRGlobalValueWithCode* code)
+    {
+        root = code;
+
+        // The structural children (such as the entry block) of
+        // `code` are live, because `code` is.
+        //
+        for( auto child : code->getDecorationsAndChildren() )
+        {
+            if(shouldInstBeLiveIfParentIsLive(child))
+                markInstAsLive(child);
+        }
+
+        // Anything inside of `code` that is referenced from outside
+        // of it must also be kept, since we don't know if the user
+        // is live.
+        //
+        markInstsUsedOutsideRootAsLive(code);
+
+        processWorkList();
+
+        bool changed = false;
+        IRInst* next = nullptr;
+        for( IRInst* child = code->getFirstDecorationOrChild(); child; child = next )
+        {
+            next = child->getNextInst();
+            changed |= eliminateDeadInstsRec(child);
+        }
+        return changed;
+    }
+
+    void markInstsUsedOutsideRootAsLive(IRInst* inst)
+    {
+        for( auto child : inst->getDecorationsAndChildren() )
+        {
+            for( auto use = child->firstUse; use; use = use->nextUse )
+            {
+                if( !isInsideRoot(use->getUser()) )
+                {
+                    markInstAsLive(child);
+                    break;
+                }
+            }
+            markInstsUsedOutsideRootAsLive(child);
+        }
+    }
+
+    void processWorkList()
+    {
         while( workList.getCount() )
         {
             auto inst = workList.getLast();
@@ -195,15 +283,6 @@ struct DeadCodeEliminationContext
             }
         }
 
-        // If our work list runs dry, that means we've reached a steady
-        // state where everything that is transitively relevant to
-        // the "outputs" of the module has been marked as live.
-        //
-        // Now we can simply walk through all of our instructions
-        // recursively and eliminate those that are "dead" by
-        // virtue of not having been found live.
-        //
-        return eliminateDeadInstsRec(module->getModuleInst());
     }
 
     bool eliminateDeadInstsRec(IRInst* inst)
@@ -410,4 +489,15 @@ bool eliminateDeadCode(
     return context.processModule();
 }
 
+bool eliminateDeadCode(
+    IRGlobalValueWithCode*              code,
+    IRDeadCodeEliminationOptions const& options)
+{
+    DeadCodeEliminationContext context;
+    context.module = code->getModule();
+    context.options = options;
+
+    return context.processCode(code);
+}
+
 }
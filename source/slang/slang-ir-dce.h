@@ -24,6 +24,16 @@ namespace Slang
         IRModule*                           module,
         IRDeadCodeEliminationOptions const& options = IRDeadCodeEliminationOptions());
 
+        /// Eliminate dead code from the body of `code` only.
+        ///
+        /// Everything outside of `code` is assumed to be live, so this
+        /// only removes the instructions and blocks of `code` (or
+        /// of code nested inside it) that aren't needed.
+        /// Returns true if changed.
+    bool eliminateDeadCode(
+        IRGlobalValueWithCode*              code,
+        IRDeadCodeEliminationOptions const& options = IRDeadCodeEliminationOptions());
+
     bool shouldInstBeLiveIfParentIsLive(IRInst* inst, IRDeadCodeEliminationOptions options);
 
     bool isWeakReferenceOperand(IRInst* inst, UInt operandIndex);
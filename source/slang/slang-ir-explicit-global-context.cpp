@@ -65,7 +65,15 @@ struct IntroduceExplicitGlobalContextPass
                     // this is represented as a variable with the `@GroupShared`
                     // rate on its type.
                     //
-                    if( m_target == CodeGenTarget::CUDASource )
+                    // For C++ the context is created for each thread, so
+                    // `groupshared` variables can't live there either, as the
+                    // threads of a group must see the same storage. They are
+                    // emitted as `thread_local` globals instead: the threads of
+                    // a group all execute on the same OS thread (one after
+                    // another, or as fibers when they use group barriers).
+                    //
+                    if( m_target == CodeGenTarget::CUDASource ||
+                        m_target == CodeGenTarget::CPPSource )
                     {
                         if( as<IRGroupSharedRate>(globalVar->getRate()) )
                             continue;
@@ -0,0 +1,492 @@
+// slang-ir-frozen.cpp
+#include "slang-ir-frozen.h"
+
+#include "slang-ir-insts.h"
+#include "slang-serialize-ir.h"
+
+namespace Slang {
+
+static const IRFrozenModule::InstIndex kNullInstIndex = IRFrozenModule::InstIndex(0);
+static const IRFrozenModule::InstIndex kModuleInstIndex = IRFrozenModule::InstIndex(1);
+
+static bool _isTextureTypeBase(IROp opIn)
+{
+    const int op = (kIROpMeta_OpMask & opIn);
+    return op >= kIROp_FirstTextureTypeBase && op <= kIROp_LastTextureTypeBase;
+}
+
+static bool _isConstant(IROp opIn)
+{
+    const int op = (kIROpMeta_OpMask & opIn);
+    return op >= kIROp_FirstConstant && op <= kIROp_LastConstant;
+}
+
+static bool _isDecoration(IROp opIn)
+{
+    const int op = (kIROpMeta_OpMask & opIn);
+    return op >= kIROp_FirstDecoration && op <= kIROp_LastDecoration;
+}
+
+/* static */SlangResult IRFrozenModule::createModule(const IRSerialData& data, Session* session, SerialSourceLocReader* sourceLocReader, RefPtr<IRModule>& outModule)
+{
+    RefPtr<IRModule> module = IRModule::create(session);
+
+    RefPtr<IRFrozenModule> frozenModule = new IRFrozenModule(module);
+    SLANG_RETURN_ON_FAIL(frozenModule->_init(data, sourceLocReader));
+
+    module->m_frozenModule = frozenModule;
+
+    // Decorations on the module instruction are found by looking at the module instruction directly,
+    // so they are thawed up front. As nothing else has been thawed, they precede any children.
+    const Inst& moduleInst = frozenModule->m_insts[Index(kModuleInstIndex)];
+    for (uint32_t i = 0; i < moduleInst.m_childCount; ++i)
+    {
+        const InstIndex childIndex = InstIndex(uint32_t(moduleInst.m_childStart) + i);
+        if (_isDecoration(frozenModule->m_insts[Index(childIndex)].m_op))
+        {
+            frozenModule->thaw(childIndex);
+        }
+    }
+
+    outModule = module;
+    return SLANG_OK;
+}
+
+SlangResult IRFrozenModule::_init(const IRSerialData& data, SerialSourceLocReader* sourceLocReader)
+{
+    typedef IRSerialData Ser;
+
+    const Index numInsts = data.m_insts.getCount();
+    if (numInsts < 2 || data.m_insts[1].m_op != kIROp_Module)
+    {
+        return SLANG_FAIL;
+    }
+
+    SerialStringTableUtil::decodeStringTable(data.m_stringTable.getBuffer(), data.m_stringTable.getCount(), m_stringPool);
+
+    m_insts.setCount(numInsts);
+    memset(m_insts.getBuffer(), 0, sizeof(Inst) * numInsts);
+
+    for (Index i = 1; i < numInsts; ++i)
+    {
+        const Ser::Inst& srcInst = data.m_insts[i];
+        Inst& dstInst = m_insts[i];
+
+        dstInst.m_op = IROp(srcInst.m_op);
+        dstInst.m_typeIndex = InstIndex(srcInst.m_resultTypeIndex);
+
+        if (_isConstant(dstInst.m_op))
+        {
+            Constant constant;
+            constant.m_intValue = 0;
+
+            switch (dstInst.m_op)
+            {
+                case kIROp_BoolLit:
+                {
+                    SLANG_ASSERT(srcInst.m_payloadType == Ser::Inst::PayloadType::UInt32);
+                    constant.m_intValue = srcInst.m_payload.m_uint32 != 0;
+                    break;
+                }
+                case kIROp_IntLit:
+                case kIROp_PtrLit:
+                {
+                    SLANG_ASSERT(srcInst.m_payloadType == Ser::Inst::PayloadType::Int64);
+                    constant.m_intValue = srcInst.m_payload.m_int64;
+                    break;
+                }
+                case kIROp_FloatLit:
+                {
+                    SLANG_ASSERT(srcInst.m_payloadType == Ser::Inst::PayloadType::Float64);
+                    constant.m_floatValue = srcInst.m_payload.m_float64;
+                    break;
+                }
+                case kIROp_VoidLit:
+                {
+                    SLANG_ASSERT(srcInst.m_payloadType == Ser::Inst::PayloadType::Empty);
+                    break;
+                }
+                case kIROp_StringLit:
+                {
+                    SLANG_ASSERT(srcInst.m_payloadType == Ser::Inst::PayloadType::String_1);
+                    constant.m_stringHandle = StringSlicePool::Handle(srcInst.m_payload.m_stringIndices[0]);
+                    break;
+                }
+                default:
+                {
+                    SLANG_ASSERT(!"Unknown constant type");
+                    return SLANG_FAIL;
+                }
+            }
+
+            dstInst.m_operandStart = uint32_t(m_constants.getCount());
+            m_constants.add(constant);
+            continue;
+        }
+
+        if (_isTextureTypeBase(dstInst.m_op))
+        {
+            // Reintroduce the texture type bits into the op
+            SLANG_ASSERT(srcInst.m_payloadType == Ser::Inst::PayloadType::OperandAndUInt32);
+            const uint32_t other = srcInst.m_payload.m_operandAndUInt32.m_uint32;
+            dstInst.m_op = IROp(uint32_t(dstInst.m_op) | (other << kIROpMeta_OtherShift));
+        }
+
+        const Ser::InstIndex* srcOperandIndices;
+        const int numOperands = data.getOperands(srcInst, &srcOperandIndices);
+
+        dstInst.m_operandStart = uint32_t(m_operands.getCount());
+        dstInst.m_operandCount = uint32_t(numOperands);
+        for (int j = 0; j < numOperands; ++j)
+        {
+            m_operands.add(InstIndex(srcOperandIndices[j]));
+        }
+    }
+
+    // The children of each instruction are a single run
+    for (const auto& run : data.m_childRuns)
+    {
+        Inst& parentInst = m_insts[Index(run.m_parentIndex)];
+        parentInst.m_childStart = InstIndex(run.m_startInstIndex);
+        parentInst.m_childCount = run.m_numChildren;
+
+        for (uint32_t i = 0; i < run.m_numChildren; ++i)
+        {
+            m_insts[Index(run.m_startInstIndex) + i].m_parentIndex = InstIndex(run.m_parentIndex);
+        }
+    }
+
+    IRSerialReader::calcSourceLocs(data, sourceLocReader, m_sourceLocs);
+
+    m_thawedInsts.setCount(numInsts);
+    memset(m_thawedInsts.getBuffer(), 0, sizeof(IRInst*) * numInsts);
+    m_thawedInsts[Index(kModuleInstIndex)] = m_module->getModuleInst();
+
+    _initIndex();
+    return SLANG_OK;
+}
+
+UnownedStringSlice IRFrozenModule::_getStringSlice(InstIndex index) const
+{
+    const Inst& inst = m_insts[Index(index)];
+    SLANG_ASSERT(inst.m_op == kIROp_StringLit);
+    return m_stringPool.getSlice(m_constants[inst.m_operandStart].m_stringHandle);
+}
+
+void IRFrozenModule::_initIndex()
+{
+    // This mirrors IRModuleSymbolIndex::init, but looks at the frozen instructions
+
+    const Inst& moduleInst = m_insts[Index(kModuleInstIndex)];
+
+    // The mangled name of each global instruction, if it has one
+    List<UnownedStringSlice> names;
+    names.setCount(moduleInst.m_childCount);
+
+    for (uint32_t i = 0; i < moduleInst.m_childCount; ++i)
+    {
+        const InstIndex globalIndex = InstIndex(uint32_t(moduleInst.m_childStart) + i);
+        const Inst& globalInst = m_insts[Index(globalIndex)];
+
+        switch (globalInst.m_op)
+        {
+            case kIROp_BindGlobalGenericParam:
+            {
+                m_bindGlobalGenericParams.add(globalIndex);
+                break;
+            }
+            case kIROp_GlobalHashedStringLiterals:
+            {
+                m_globalHashedStringLiterals.add(globalIndex);
+                break;
+            }
+            default: break;
+        }
+
+        bool isExported = false;
+
+        // Decorations come before any other children
+        for (uint32_t j = 0; j < globalInst.m_childCount; ++j)
+        {
+            const Inst& decoration = m_insts[Index(globalInst.m_childStart) + j];
+            const IROp op = decoration.m_op;
+            if (!_isDecoration(op))
+            {
+                break;
+            }
+
+            if (op >= kIROp_FirstLinkageDecoration && op <= kIROp_LastLinkageDecoration && names[i].getLength() == 0)
+            {
+                SLANG_ASSERT(decoration.m_operandCount > 0);
+                const UnownedStringSlice name = _getStringSlice(m_operands[decoration.m_operandStart]);
+
+                names[i] = name;
+                m_nameToRange.GetOrAddValue(name, Range{ 0, 0 }).count++;
+            }
+            else if (op == kIROp_PublicDecoration || op == kIROp_HLSLExportDecoration)
+            {
+                isExported = true;
+            }
+        }
+
+        if (isExported)
+        {
+            m_exportedInsts.add(globalIndex);
+        }
+    }
+
+    // Group the named instructions by name
+    Index start = 0;
+    for (auto& pair : m_nameToRange)
+    {
+        pair.Value.start = start;
+        start += pair.Value.count;
+        pair.Value.count = 0;
+    }
+    m_namedInsts.setCount(start);
+
+    for (uint32_t i = 0; i < moduleInst.m_childCount; ++i)
+    {
+        if (names[i].getLength())
+        {
+            Range* range = m_nameToRange.TryGetValue(names[i]);
+            m_namedInsts[range->start + range->count++] = InstIndex(uint32_t(moduleInst.m_childStart) + i);
+        }
+    }
+
+    m_thawedNamedInsts.setCount(start);
+    memset(m_thawedNamedInsts.getBuffer(), 0, sizeof(IRInst*) * start);
+}
+
+void IRFrozenModule::initSymbolIndex(IRModuleSymbolIndex* index)
+{
+    for (auto instIndex : m_exportedInsts)
+    {
+        index->m_exportedValues.add(thaw(instIndex));
+    }
+    for (auto instIndex : m_bindGlobalGenericParams)
+    {
+        index->m_bindGlobalGenericParams.add(thaw(instIndex));
+    }
+    for (auto instIndex : m_globalHashedStringLiterals)
+    {
+        index->m_globalHashedStringLiterals.add(thaw(instIndex));
+    }
+}
+
+ConstArrayView<IRInst*> IRFrozenModule::thawValues(const UnownedStringSlice& name)
+{
+    const Range* range = m_nameToRange.TryGetValue(name);
+    if (!range)
+    {
+        return ConstArrayView<IRInst*>();
+    }
+
+    IRInst** values = m_thawedNamedInsts.getBuffer() + range->start;
+    for (Index i = 0; i < range->count; ++i)
+    {
+        if (!values[i])
+        {
+            values[i] = thaw(m_namedInsts[range->start + i]);
+        }
+    }
+    return makeConstArrayView<IRInst*>(values, range->count);
+}
+
+void IRFrozenModule::thawAll()
+{
+    const Inst& moduleInst = m_insts[Index(kModuleInstIndex)];
+    for (uint32_t i = 0; i < moduleInst.m_childCount; ++i)
+    {
+        thaw(InstIndex(uint32_t(moduleInst.m_childStart) + i));
+    }
+}
+
+IRInst* IRFrozenModule::thaw(InstIndex index)
+{
+    if (IRInst* inst = m_thawedInsts[Index(index)])
+    {
+        return inst;
+    }
+    if (index == kNullInstIndex)
+    {
+        return nullptr;
+    }
+
+    // As with IRSerialReader, instructions are allocated before their operands are set,
+    // as they can reference each other in any order (and circularly).
+    List<InstIndex> allocated;
+    _allocateGlobal(index, allocated);
+
+    // Set the types and operands. An instruction that is referenced, but hasn't been thawed,
+    // is allocated along with its global instruction, which adds them to the end of `allocated`.
+    for (Index i = 0; i < allocated.getCount(); ++i)
+    {
+        const Inst& srcInst = m_insts[Index(allocated[i])];
+        IRInst* dstInst = m_thawedInsts[Index(allocated[i])];
+
+        if (srcInst.m_typeIndex != kNullInstIndex)
+        {
+            // NOTE! The type may not be IRType derived (for example IRGlobalGenericParam), as in IRSerialReader
+            dstInst->setFullType(static_cast<IRType*>(_getOrAllocate(srcInst.m_typeIndex, allocated)));
+        }
+
+        if (_isConstant(srcInst.m_op))
+        {
+            continue;
+        }
+
+        auto dstOperands = dstInst->getOperands();
+        const InstIndex* srcOperands = m_operands.getBuffer() + srcInst.m_operandStart;
+        for (uint32_t j = 0; j < srcInst.m_operandCount; ++j)
+        {
+            dstOperands[j].init(dstInst, _getOrAllocate(srcOperands[j], allocated));
+        }
+    }
+
+    return m_thawedInsts[Index(index)];
+}
+
+IRInst* IRFrozenModule::_getOrAllocate(InstIndex index, List<InstIndex>& ioAllocated)
+{
+    if (index != kNullInstIndex && !m_thawedInsts[Index(index)])
+    {
+        _allocateGlobal(index, ioAllocated);
+    }
+    return m_thawedInsts[Index(index)];
+}
+
+void IRFrozenModule::_allocateGlobal(InstIndex index, List<InstIndex>& ioAllocated)
+{
+    // Find the global instruction that holds `index`
+    InstIndex globalIndex = index;
+    while (m_insts[Index(globalIndex)].m_parentIndex != kModuleInstIndex)
+    {
+        globalIndex = m_insts[Index(globalIndex)].m_parentIndex;
+        SLANG_ASSERT(globalIndex != kNullInstIndex);
+    }
+    SLANG_ASSERT(m_thawedInsts[Index(globalIndex)] == nullptr);
+
+    const Index start = ioAllocated.getCount();
+
+    // Keep the global instructions in the order they were serialized, whatever order they are thawed in,
+    // by inserting before the first thawed global that follows it
+    Index lo = 0, hi = m_thawedGlobals.getCount();
+    while (lo < hi)
+    {
+        const Index mid = lo + ((hi - lo) >> 1);
+        if (m_thawedGlobals[mid] < globalIndex)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    IRInst* globalInst = _allocateInst(globalIndex);
+    if (lo < m_thawedGlobals.getCount())
+    {
+        globalInst->insertBefore(m_thawedInsts[Index(m_thawedGlobals[lo])]);
+    }
+    else
+    {
+        globalInst->insertAtEnd(m_module->getModuleInst());
+    }
+    m_thawedGlobals.insert(lo, globalIndex);
+    ioAllocated.add(globalIndex);
+
+    // Allocate all of the descendants, breadth first, adding them to their parents in order
+    for (Index i = start; i < ioAllocated.getCount(); ++i)
+    {
+        const Inst& parentInst = m_insts[Index(ioAllocated[i])];
+        IRInst* parent = m_thawedInsts[Index(ioAllocated[i])];
+
+        for (uint32_t j = 0; j < parentInst.m_childCount; ++j)
+        {
+            const InstIndex childIndex = InstIndex(uint32_t(parentInst.m_childStart) + j);
+            _allocateInst(childIndex)->insertAtEnd(parent);
+            ioAllocated.add(childIndex);
+        }
+    }
+}
+
+IRInst* IRFrozenModule::_allocateInst(InstIndex index)
+{
+    const Inst& srcInst = m_insts[Index(index)];
+    const IROp op = srcInst.m_op;
+
+    IRInst* inst = nullptr;
+    if (_isConstant(op))
+    {
+        // Calculate the minimum object size (ie not including the payload of value)
+        const size_t prefixSize = SLANG_OFFSET_OF(IRConstant, value);
+        const Constant& constant = m_constants[srcInst.m_operandStart];
+
+        IRConstant* irConst = nullptr;
+        switch (op)
+        {
+            case kIROp_BoolLit:
+            case kIROp_IntLit:
+            {
+                irConst = static_cast<IRConstant*>(m_module->_allocateInst(op, 0, prefixSize + sizeof(IRIntegerValue)));
+                irConst->value.intVal = constant.m_intValue;
+                break;
+            }
+            case kIROp_PtrLit:
+            {
+                irConst = static_cast<IRConstant*>(m_module->_allocateInst(op, 0, prefixSize + sizeof(void*)));
+                irConst->value.ptrVal = (void*)(intptr_t)constant.m_intValue;
+                break;
+            }
+            case kIROp_FloatLit:
+            {
+                irConst = static_cast<IRConstant*>(m_module->_allocateInst(op, 0, prefixSize + sizeof(IRFloatingPointValue)));
+                irConst->value.floatVal = constant.m_floatValue;
+                break;
+            }
+            case kIROp_StringLit:
+            {
+                const UnownedStringSlice slice = m_stringPool.getSlice(constant.m_stringHandle);
+
+                const size_t sliceSize = slice.getLength();
+                const size_t instSize = prefixSize + SLANG_OFFSET_OF(IRConstant::StringValue, chars) + sliceSize;
+
+                irConst = static_cast<IRConstant*>(m_module->_allocateInst(op, 0, instSize));
+
+                IRConstant::StringValue& dstString = irConst->value.stringVal;
+                dstString.numChars = uint32_t(sliceSize);
+                // Turn into pointer to avoid warning of array overrun
+                char* dstChars = dstString.chars;
+                memcpy(dstChars, slice.begin(), sliceSize);
+                break;
+            }
+            default:
+            {
+                SLANG_ASSERT(op == kIROp_VoidLit);
+                irConst = static_cast<IRConstant*>(m_module->_allocateInst(op, 0, prefixSize));
+                break;
+            }
+        }
+        inst = irConst;
+    }
+    else if (_isTextureTypeBase(op))
+    {
+        inst = m_module->_allocateInst<IRTextureTypeBase>(op, Int(srcInst.m_operandCount));
+    }
+    else
+    {
+        inst = m_module->_allocateInst(op, Int(srcInst.m_operandCount));
+    }
+
+    if (m_sourceLocs.getCount())
+    {
+        inst->sourceLoc = m_sourceLocs[Index(index)];
+    }
+
+    m_thawedInsts[Index(index)] = inst;
+    return inst;
+}
+
+} // namespace Slang
@@ -0,0 +1,115 @@
+// slang-ir-frozen.h
+#ifndef SLANG_IR_FROZEN_H_INCLUDED
+#define SLANG_IR_FROZEN_H_INCLUDED
+
+#include "../core/slang-basic.h"
+#include "../core/slang-array-view.h"
+#include "../core/slang-string-slice-pool.h"
+
+#include "slang-ir.h"
+
+namespace Slang {
+
+struct IRSerialData;
+class SerialSourceLocReader;
+
+/* A read-only IR module held in a compact, index based form.
+
+Instructions are identified by 32 bit indices, in the order they were serialized. The operands of all instructions
+are held in a single array, and the children of an instruction are contiguous, so there are no use lists, sibling links
+or per-operand `IRUse`s.
+
+Modules that are only ever read by the linker (such as the standard library, precompiled modules and libraries) are
+loaded in this form. The IRModule for a frozen module starts out (almost) empty, and a global value and everything it
+references is "thawed" into it the first time linking looks up its mangled name. So the instructions that are never
+linked are never materialized, and those that are only once, however many times they are linked.
+
+The IRModule is read only - instructions are only added to it by thawing. */
+class IRFrozenModule : public RefObject
+{
+public:
+    enum class InstIndex : uint32_t;
+
+    struct Inst
+    {
+        IROp m_op;                          ///< The op, including any 'other' bits (see kIROpMeta_OtherShift)
+        InstIndex m_typeIndex;              ///< The type, or 0 if the instruction has none
+        InstIndex m_parentIndex;            ///< The parent instruction, or 0 for the module instruction
+        uint32_t m_operandStart;            ///< Index of the first operand in m_operands. For a constant, the index of its value in m_constants
+        uint32_t m_operandCount;            ///< The number of operands
+        InstIndex m_childStart;             ///< The first child (decorations first, then children)
+        uint32_t m_childCount;              ///< The number of children
+    };
+
+        /// The value of a constant instruction
+    union Constant
+    {
+        IRIntegerValue m_intValue;
+        IRFloatingPointValue m_floatValue;
+        StringSlicePool::Handle m_stringHandle;
+    };
+
+        /// Create a frozen module from serialized IR, and the IRModule that its instructions are thawed into.
+        /// The module only holds the decorations of the module instruction until something is thawed.
+    static SlangResult createModule(const IRSerialData& data, Session* session, SerialSourceLocReader* sourceLocReader, RefPtr<IRModule>& outModule);
+
+        /// Get the global values with a linkage decoration with the mangled `name` (thawing them if necessary)
+    ConstArrayView<IRInst*> thawValues(const UnownedStringSlice& name);
+
+        /// Get the IRInst for the instruction at `index`. If it hasn't been thawed yet, the global value that holds it
+        /// is thawed, along with any other global value it references.
+    IRInst* thaw(InstIndex index);
+
+        /// Thaw all of the global instructions, so that the IRModule holds all of the IR (for example, so it can be written out)
+    void thawAll();
+
+        /// Initialize the lists of `index` that aren't looked up by name, thawing the instructions in them
+    void initSymbolIndex(IRModuleSymbolIndex* index);
+
+protected:
+    struct Range
+    {
+        Index start;
+        Index count;
+    };
+
+    IRFrozenModule(IRModule* module) :
+        m_module(module),
+        m_stringPool(StringSlicePool::Style::Default)
+    {
+    }
+
+    SlangResult _init(const IRSerialData& data, SerialSourceLocReader* sourceLocReader);
+    void _initIndex();
+
+        /// Allocate the IRInsts for the global instruction that holds `index` and all of its descendants
+    void _allocateGlobal(InstIndex index, List<InstIndex>& ioAllocated);
+        /// Get the IRInst for `index`, allocating the global instruction that holds it if it hasn't been
+    IRInst* _getOrAllocate(InstIndex index, List<InstIndex>& ioAllocated);
+    IRInst* _allocateInst(InstIndex index);
+
+    UnownedStringSlice _getStringSlice(InstIndex index) const;
+
+    IRModule* m_module;                             ///< The module instructions are thawed into. Owns this frozen module.
+
+    List<Inst> m_insts;                             ///< The instructions. 0 is null, 1 is the module instruction.
+    List<InstIndex> m_operands;                     ///< The operands of all of the instructions
+    List<Constant> m_constants;                     ///< The values of the constants
+    List<SourceLoc> m_sourceLocs;                   ///< The source location of each instruction, or empty if there are none
+    StringSlicePool m_stringPool;                   ///< The strings referenced by the constants
+
+    Dictionary<UnownedStringSlice, Range> m_nameToRange;    ///< Range in m_namedInsts of global values with a name
+    List<InstIndex> m_namedInsts;                   ///< Global values with a linkage decoration grouped by name
+    List<IRInst*> m_thawedNamedInsts;               ///< The IRInsts for m_namedInsts, or nullptr if not thawed yet
+
+    List<InstIndex> m_exportedInsts;                ///< Global values that are `public` or (HLSL) `export`ed
+    List<InstIndex> m_bindGlobalGenericParams;      ///< The `IRBindGlobalGenericParam` instructions
+    List<InstIndex> m_globalHashedStringLiterals;   ///< The `IRGlobalHashedStringLiterals` instructions
+
+    List<IRInst*> m_thawedInsts;                    ///< The IRInst for each instruction, or nullptr if not thawed yet
+    List<InstIndex> m_thawedGlobals;                ///< The global instructions that have been thawed, in index order
+};
+
+} // namespace Slang
+
+#endif
@@ -58,11 +58,18 @@ namespace Slang
 
         template <typename Func>
         void processAllInsts(const Func& f)
+        {
+            processInstsUnder(module->getModuleInst(), f);
+        }
+
+            /// Call `f` on `root`, and then on all of its descendents
+        template <typename Func>
+        void processInstsUnder(IRInst* root, const Func& f)
         {
             workList.clear();
             workListSet.Clear();
 
-            addToWorkList(module->getModuleInst());
+            addToWorkList(root);
 
             while (workList.getCount() != 0)
             {
@@ -48,9 +48,13 @@ struct IRSharedSpecContext
     // The specialized module we are building
     RefPtr<IRModule>   module;
 
+    // The *original* modules that symbols are looked up in, in order.
+    List<IRModule*> symbolModules;
+
     // A map from mangled symbol names to zero or
     // more global IR values that have that name,
-    // in the *original* module.
+    // in the *original* modules. Entries are added
+    // as names are looked up (see `findSymbol`).
     typedef Dictionary<String, RefPtr<IRSpecSymbol>> SymbolDictionary;
     SymbolDictionary symbols;
 
@@ -61,6 +65,44 @@ struct IRSharedSpecContext
     IRSpecEnv globalEnv;
 };
 
+IRSpecSymbol* findSymbol(
+    IRSharedSpecContext*    sharedContext,
+    String const&           mangledName)
+{
+    RefPtr<IRSpecSymbol> sym;
+    if (sharedContext->symbols.TryGetValue(mangledName, sym))
+    {
+        return sym;
+    }
+
+    // Look the name up in each of the modules (which thaws the values
+    // found in frozen modules, see IRFrozenModule). The chain of symbols
+    // starts with the first value found, followed by the rest in
+    // reverse order.
+    for (auto module : sharedContext->symbolModules)
+    {
+        for (auto gv : module->getSymbolIndex()->findValues(mangledName.getUnownedSlice()))
+        {
+            RefPtr<IRSpecSymbol> newSym = new IRSpecSymbol();
+            newSym->irGlobalValue = gv;
+
+            if (sym)
+            {
+                newSym->nextWithSameName = sym->nextWithSameName;
+                sym->nextWithSameName = newSym;
+            }
+            else
+            {
+                sym = newSym;
+            }
+        }
+    }
+
+    // Also record a name that isn't found, so it's only looked up once
+    sharedContext->symbols.Add(mangledName, sym);
+    return sym;
+}
+
 struct IRSpecContextBase
 {
     IRSharedSpecContext* shared;
@@ -69,8 +111,6 @@ struct IRSpecContextBase
 
     IRModule* getModule() { return getShared()->module; }
 
-    IRSharedSpecContext::SymbolDictionary& getSymbols() { return getShared()->symbols; }
-
     // The current specialization environment to use.
     IRSpecEnv* env = nullptr;
     IRSpecEnv* getEnv()
@@ -829,12 +869,13 @@ IRFunc* specializeIRForEntryPoint(
     // so that the mangled name of the decl-ref is
     // not the same as the mangled name of the decl.
     //
-    RefPtr<IRSpecSymbol> sym;
-    if (!context->getSymbols().TryGetValue(mangledName, sym))
+    IRSpecSymbol* sym = findSymbol(context->getShared(), mangledName);
+    if (!sym)
     {
         String hashedName = getHashedName(mangledName.getUnownedSlice());
 
-        if (!context->getSymbols().TryGetValue(hashedName, sym))
+        sym = findSymbol(context->getShared(), hashedName);
+        if (!sym)
         {
             SLANG_UNEXPECTED("no matching IR symbol");
             return nullptr;
@@ -1199,8 +1240,8 @@ IRInst* cloneGlobalValueWithLinkage(
     // to pick the "best" one for our target.
 
     auto mangledName = String(originalLinkage->getMangledName());
-    RefPtr<IRSpecSymbol> sym;
-    if( !context->getSymbols().TryGetValue(mangledName, sym) )
+    IRSpecSymbol* sym = findSymbol(context->getShared(), mangledName);
+    if( !sym )
     {
         if(!originalVal)
             return nullptr;
@@ -1257,48 +1298,6 @@ IRInst* cloneGlobalValue(IRSpecContext* context, IRInst* originalVal)
         originalVal->findDecoration<IRLinkageDecoration>());
 }
 
-void insertGlobalValueSymbol(
-    IRSharedSpecContext*    sharedContext,
-    IRInst*                 gv)
-{
-    auto linkage = gv->findDecoration<IRLinkageDecoration>();
-
-    // Don't try to register a symbol for global values
-    // that don't have linkage.
-    //
-    if (!linkage)
-        return;
-
-    auto mangledName = String(linkage->getMangledName());
-
-    RefPtr<IRSpecSymbol> sym = new IRSpecSymbol();
-    sym->irGlobalValue = gv;
-
-    RefPtr<IRSpecSymbol> prev;
-    if (sharedContext->symbols.TryGetValue(mangledName, prev))
-    {
-        sym->nextWithSameName = prev->nextWithSameName;
-        prev->nextWithSameName = sym;
-    }
-    else
-    {
-        sharedContext->symbols.Add(mangledName, sym);
-    }
-}
-
-void insertGlobalValueSymbols(
-    IRSharedSpecContext*    sharedContext,
-    IRModule*               originalModule)
-{
-    if (!originalModule)
-        return;
-
-    for(auto ii : originalModule->getGlobalInsts())
-    {
-        insertGlobalValueSymbol(sharedContext, ii);
-    }
-}
-
 void initializeSharedSpecContext(
     IRSharedSpecContext*    sharedContext,
     Session*                session,
@@ -1352,20 +1351,6 @@ struct IRSpecializationState
     }
 };
 
-static bool _isPublicOrHLSLExported(IRInst* inst)
-{
-    for (auto decoration : inst->getDecorations())
-    {
-        const auto op = decoration->getOp();
-        if (op == kIROp_PublicDecoration ||
-            op == kIROp_HLSLExportDecoration)
-        {
-            return true;
-        }
-    }
-    return false;
-}
-
 LinkedIR linkIR(
     CodeGenContext* codeGenContext)
 {
@@ -1400,7 +1385,7 @@ LinkedIR linkIR(
 
     // We need to be able to look up IR definitions for any symbols in
     // modules that the program depends on (transitively). To
-    // accelerate lookup, we will create a symbol table for looking
+    // accelerate lookup, each module has an index for looking
     // up IR definitions by their mangled name.
     //
 
@@ -1418,18 +1403,18 @@ LinkedIR linkIR(
     }
     
     // Add any modules that were loaded as libraries
-    for (IRModule* irModule : irModules)
-    {
-        insertGlobalValueSymbols(sharedContext, irModule);
-    }
+    sharedContext->symbolModules.addRange(irModules);
 
-    // We will also insert the IR global symbols from the IR module
+    // We will also look up IR global symbols in the IR module
     // attached to the `TargetProgram`, since this module is
     // responsible for associating layout information to those
     // global symbols via decorations.
     //
     auto irModuleForLayout = targetProgram->getExistingIRModuleForLayout();
-    insertGlobalValueSymbols(sharedContext, irModuleForLayout);
+    if (irModuleForLayout)
+    {
+        sharedContext->symbolModules.add(irModuleForLayout);
+    }
 
     auto context = state->getContext();
 
@@ -1496,33 +1481,32 @@ LinkedIR linkIR(
     // `[bindExistentialSlots(...)]` works, so that they can be attached
     // to the relevant parameters and cloned via `cloneExtraDecorations`.
     // In the long run we do not want to *ever* iterate over all the
-    // instructions in all the input modules.
+    // instructions in all the input modules. (For now the symbol index
+    // of each module holds them, so at least they are only found once.)
     //
     
+    // Note: The indices are held, as they would be discarded if
+    // cloning were to change the original modules.
+    //
     for (IRModule* irModule : irModules)
     {
-        for (auto inst : irModule->getGlobalInsts())
+        RefPtr<IRModuleSymbolIndex> symbolIndex = irModule->getSymbolIndex();
+        for (auto bindInst : symbolIndex->m_bindGlobalGenericParams)
         {
-            auto bindInst = as<IRBindGlobalGenericParam>(inst);
-            if (!bindInst)
-                continue;
-
             cloneValue(context, bindInst);
         }
     }
 
     for (IRModule* irModule : irModules)
     {
-        for (auto inst : irModule->getGlobalInsts())
+        // Is it `public` or (HLSL) `export` clone
+        RefPtr<IRModuleSymbolIndex> symbolIndex = irModule->getSymbolIndex();
+        for (auto inst : symbolIndex->m_exportedValues)
         {
-            // Is it `public` or (HLSL) `export` clone
-            if (_isPublicOrHLSLExported(inst))
+            auto cloned = cloneValue(context, inst);
+            if (!cloned->findDecorationImpl(kIROp_KeepAliveDecoration))
             {
-                auto cloned = cloneValue(context, inst);
-                if (!cloned->findDecorationImpl(kIROp_KeepAliveDecoration))
-                {
-                    context->builder->addKeepAliveDecoration(cloned);
-                }
+                context->builder->addKeepAliveDecoration(cloned);
             }
         }
     }
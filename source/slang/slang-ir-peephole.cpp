@@ -11,6 +11,9 @@ struct PeepholeContext : InstPassBase
 
     bool changed = false;
 
+    // The shared builder used to create any new values. By default it is our own storage.
+    SharedIRBuilder* sharedBuilder = &sharedBuilderStorage;
+
     void processInst(IRInst* inst)
     {
         switch (inst->getOp())
@@ -33,14 +36,14 @@ struct PeepholeContext : InstPassBase
         case kIROp_IsResultError:
             if (inst->getOperand(0)->getOp() == kIROp_MakeResultError)
             {
-                IRBuilder builder(&sharedBuilderStorage);
+                IRBuilder builder(sharedBuilder);
                 inst->replaceUsesWith(builder.getBoolValue(true));
                 inst->removeAndDeallocate();
                 changed = true;
             }
             else if (inst->getOperand(0)->getOp() == kIROp_MakeResultValue)
             {
-                IRBuilder builder(&sharedBuilderStorage);
+                IRBuilder builder(sharedBuilder);
                 inst->replaceUsesWith(builder.getBoolValue(false));
                 inst->removeAndDeallocate();
                 changed = true;
@@ -88,7 +91,7 @@ struct PeepholeContext : InstPassBase
         case kIROp_CastPtrToBool:
             {
                 auto ptr = inst->getOperand(0);
-                IRBuilder builder(&sharedBuilderStorage);
+                IRBuilder builder(sharedBuilder);
                 builder.setInsertBefore(inst);
                 auto neq = builder.emitNeq(ptr, builder.getPtrValue(nullptr));
                 inst->replaceUsesWith(neq);
@@ -102,7 +105,7 @@ struct PeepholeContext : InstPassBase
                 auto actualType = isTypeInst->getValue()->getDataType();
                 if (isTypeEqual(actualType, (IRType*)isTypeInst->getTypeOperand()))
                 {
-                    IRBuilder builder(&sharedBuilderStorage);
+                    IRBuilder builder(sharedBuilder);
                     builder.setInsertBefore(inst);
                     auto trueVal = builder.getBoolValue(true);
                     inst->replaceUsesWith(trueVal);
@@ -159,7 +162,7 @@ struct PeepholeContext : InstPassBase
             {
                 if (inst->getOperand(0)->getOp() == kIROp_MakeOptionalValue)
                 {
-                    IRBuilder builder(&sharedBuilderStorage);
+                    IRBuilder builder(sharedBuilder);
                     builder.setInsertBefore(inst);
                     auto trueVal = builder.getBoolValue(true);
                     inst->replaceUsesWith(trueVal);
@@ -168,7 +171,7 @@ struct PeepholeContext : InstPassBase
                 }
                 else if (inst->getOperand(0)->getOp() == kIROp_MakeOptionalNone)
                 {
-                    IRBuilder builder(&sharedBuilderStorage);
+                    IRBuilder builder(sharedBuilder);
                     builder.setInsertBefore(inst);
                     auto falseVal = builder.getBoolValue(false);
                     inst->replaceUsesWith(falseVal);
@@ -184,14 +187,38 @@ struct PeepholeContext : InstPassBase
 
     bool processModule()
     {
-        SharedIRBuilder* sharedBuilder = &sharedBuilderStorage;
         sharedBuilder->init(module);
-        sharedBuilderStorage.deduplicateAndRebuildGlobalNumberingMap();
+        sharedBuilder->deduplicateAndRebuildGlobalNumberingMap();
 
         changed = false;
         processAllInsts([this](IRInst* inst) { processInst(inst); });
         return changed;
     }
+
+    bool processGlobalScope()
+    {
+        changed = false;
+        for (auto globalInst : module->getGlobalInsts())
+        {
+            if (as<IRGlobalValueWithCode>(globalInst))
+                continue;
+            processInstsUnder(globalInst, [this](IRInst* inst) { processInst(inst); });
+        }
+
+        // Removed values may still be in the numbering
+        if (changed)
+        {
+            sharedBuilder->deduplicateAndRebuildGlobalNumberingMap();
+        }
+        return changed;
+    }
+
+    bool processInstAndDescendents(IRInst* root)
+    {
+        changed = false;
+        processInstsUnder(root, [this](IRInst* inst) { processInst(inst); });
+        return changed;
+    }
 };
 
 bool peepholeOptimize(IRModule* module)
@@ -200,4 +227,18 @@ bool peepholeOptimize(IRModule* module)
     return context.processModule();
 }
 
+bool peepholeOptimizeGlobalScope(IRModule* module, SharedIRBuilder* sharedBuilder)
+{
+    PeepholeContext context = PeepholeContext(module);
+    context.sharedBuilder = sharedBuilder;
+    return context.processGlobalScope();
+}
+
+bool peepholeOptimize(IRInst* inst, SharedIRBuilder* sharedBuilder)
+{
+    PeepholeContext context = PeepholeContext(sharedBuilder->getModule());
+    context.sharedBuilder = sharedBuilder;
+    return context.processInstAndDescendents(inst);
+}
+
 } // namespace Slang
@@ -5,7 +5,19 @@ namespace Slang
 {
     struct IRModule;
     struct IRCall;
+    struct IRInst;
+    struct SharedIRBuilder;
 
         /// Apply peephole optimizations.
     bool peepholeOptimize(IRModule* module);
+
+        /// Apply peephole optimizations to the global scope of a module only,
+        /// without visiting the code of any function.
+        /// The global value numbering of `sharedBuilder` must be up to date, and is
+        /// rebuilt only if the global scope is changed.
+    bool peepholeOptimizeGlobalScope(IRModule* module, SharedIRBuilder* sharedBuilder);
+
+        /// Apply peephole optimizations to `inst` and its descendents only.
+        /// Any new values are created with `sharedBuilder`.
+    bool peepholeOptimize(IRInst* inst, SharedIRBuilder* sharedBuilder);
 }
@@ -14,8 +14,8 @@ namespace Slang {
 //
 struct SharedSCCPContext
 {
-    IRModule*       module;
-    SharedIRBuilder sharedBuilder;
+    IRModule*           module;
+    SharedIRBuilder*    sharedBuilder;
 };
 //
 // Next we have a context struct that will be applied for each function (or other
@@ -1634,10 +1634,12 @@ static bool applySparseConditionalConstantPropagationRec(
 bool applySparseConditionalConstantPropagation(
     IRModule*       module)
 {
+    SharedIRBuilder sharedBuilder(module);
+    sharedBuilder.deduplicateAndRebuildGlobalNumberingMap();
+
     SharedSCCPContext shared;
     shared.module = module;
-    shared.sharedBuilder.init(module);
-    shared.sharedBuilder.deduplicateAndRebuildGlobalNumberingMap();
+    shared.sharedBuilder = &sharedBuilder;
 
     // First we fold constants at global scope.
     SCCPContext globalContext;
@@ -1651,5 +1653,35 @@ bool applySparseConditionalConstantPropagation(
     return changed;
 }
 
+bool applySparseConditionalConstantPropagationForGlobalScope(
+    IRModule*       module,
+    SharedIRBuilder* sharedBuilder)
+{
+    SharedSCCPContext shared;
+    shared.module = module;
+    shared.sharedBuilder = sharedBuilder;
+
+    SCCPContext globalContext;
+    globalContext.shared = &shared;
+    globalContext.code = nullptr;
+    return globalContext.applyOnGlobalScope(module);
+}
+
+bool applySparseConditionalConstantPropagation(
+    IRGlobalValueWithCode*  code,
+    SharedIRBuilder*        sharedBuilder)
+{
+    SharedSCCPContext shared;
+    shared.module = sharedBuilder->getModule();
+    shared.sharedBuilder = sharedBuilder;
+
+    // Any value that is defined outside of `code` (such as at global scope) will be
+    // treated as potentially having any value, unless it is a literal.
+    SCCPContext globalContext;
+    globalContext.shared = &shared;
+    globalContext.code = nullptr;
+    return applySparseConditionalConstantPropagationRec(globalContext, code);
+}
+
 }
 
@@ -3,7 +3,9 @@
 
 namespace Slang
 {
+    struct IRGlobalValueWithCode;
     struct IRModule;
+    struct SharedIRBuilder;
 
         /// Apply Sparse Conditional Constant Propagation (SCCP) to a module.
         ///
@@ -15,5 +17,24 @@ namespace Slang
         /// Returns true if IR is changed.
     bool applySparseConditionalConstantPropagation(
         IRModule*       module);
+
+        /// Apply SCCP to the global scope of a module only, without visiting the code of any function.
+        ///
+        /// The global value numbering of `sharedBuilder` must be up to date, and is rebuilt
+        /// only if values are replaced.
+        /// Returns true if IR is changed.
+    bool applySparseConditionalConstantPropagationForGlobalScope(
+        IRModule*       module,
+        SharedIRBuilder* sharedBuilder);
+
+        /// Apply SCCP to `code` (and any code nested inside of it) only.
+        ///
+        /// Any new constants are created with `sharedBuilder`, which allows the
+        /// (costly to build) global value numbering to be shared when many
+        /// functions are processed one by one.
+        /// Returns true if IR is changed.
+    bool applySparseConditionalConstantPropagation(
+        IRGlobalValueWithCode*  code,
+        SharedIRBuilder*        sharedBuilder);
 }
 
@@ -66,6 +66,11 @@ bool processFunc(IRFunc* func)
     return changed;
 }
 
+bool simplifyCFG(IRFunc* func)
+{
+    return processFunc(func);
+}
+
 bool simplifyCFG(IRModule* module)
 {
     bool changed = false;
@@ -3,10 +3,15 @@
 
 namespace Slang
 {
+    struct IRFunc;
     struct IRModule;
 
         /// Simplifies control flow graph by merging basic blocks that
         /// forms a simple linear chain.
         /// Returns true if changed.
     bool simplifyCFG(IRModule* module);
+
+        /// Simplifies the control flow graph of `func` only.
+        /// Returns true if changed.
+    bool simplifyCFG(IRFunc* func);
 }
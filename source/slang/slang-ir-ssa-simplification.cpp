@@ -1,6 +1,7 @@
 // slang-ir-ssa-simplification.cpp
 #include "slang-ir-ssa-simplification.h"
 #include "slang-ir.h"
+#include "slang-ir-insts.h"
 #include "slang-ir-ssa.h"
 #include "slang-ir-sccp.h"
 #include "slang-ir-dce.h"
@@ -12,29 +13,100 @@ namespace Slang
 {
     struct IRModule;
 
+    // Run one round of the function-local simplifications over `code`.
+    // Returns true if `code` was changed.
+    static bool simplifyCode(IRModule* module, IRGlobalValueWithCode* code, SharedIRBuilder* sharedBuilder)
+    {
+        bool changed = false;
+        changed |= applySparseConditionalConstantPropagation(code, sharedBuilder);
+        changed |= peepholeOptimize(code, sharedBuilder);
+        if (auto func = as<IRFunc>(code))
+        {
+            changed |= simplifyCFG(func);
+        }
+
+        // Note: we disregard the `changed` state from dead code elimination pass, as
+        // with the rest of the passes in a round it is only cleaning up after them.
+        eliminateDeadCode(code);
+
+        switch (code->getOp())
+        {
+        case kIROp_Func:
+        case kIROp_GlobalVar:
+            changed |= constructSSA(module, code);
+            break;
+        default:
+            break;
+        }
+        return changed;
+    }
+
     // Run a combination of SSA, SCCP, SimplifyCFG, and DeadCodeElimination pass
     // until no more changes are possible.
+    //
+    // Other than the passes over the global scope, all of the simplifications are local
+    // to a single function (or other code-bearing value). So rather than sweeping the
+    // whole module on every iteration, we only revisit the code that was changed by
+    // the previous iteration. If something at global scope changes, that can change how
+    // any code simplifies, so then all of the code is revisited.
     void simplifyIR(IRModule* module)
     {
-        bool changed = true;
+        // Start by removing anything that is dead, so we don't spend time simplifying it.
+        eliminateDeadCode(module);
+
+        SharedIRBuilder sharedBuilder(module);
+
+        List<IRGlobalValueWithCode*> workList;
+        List<IRGlobalValueWithCode*> changedCode;
+        bool revisitAllCode = true;
+
         const int kMaxIterations = 8;
-        int iterationCounter = 0;
-        while (changed && iterationCounter < kMaxIterations)
+        for (int iterationCounter = 0; iterationCounter < kMaxIterations; ++iterationCounter)
         {
-            changed = false;
-            changed |= hoistConstants(module);
-            changed |= applySparseConditionalConstantPropagation(module);
-            changed |= peepholeOptimize(module);
-            changed |= simplifyCFG(module);
+            bool globalScopeChanged = hoistConstants(module);
 
-            // Note: we disregard the `changed` state from dead code elimination pass since
-            // SCCP pass could be generating temporarily evaluated constant values and never actually use them.
-            // DCE will always remove those nearly generated consts and always returns true here.
-            eliminateDeadCode(module);
+            // Rebuilding the global value numbering is costly, so it is only done once per
+            // iteration (hoisting and the previous iteration may have added values to the
+            // global scope that aren't numbered). The global passes only rebuild it again
+            // if they change anything.
+            sharedBuilder.deduplicateAndRebuildGlobalNumberingMap();
 
-            changed |= constructSSA(module);
+            globalScopeChanged |= applySparseConditionalConstantPropagationForGlobalScope(module, &sharedBuilder);
+            globalScopeChanged |= peepholeOptimizeGlobalScope(module, &sharedBuilder);
 
-            iterationCounter++;
+            if (globalScopeChanged || revisitAllCode)
+            {
+                revisitAllCode = false;
+                workList.clear();
+                for (auto inst : module->getGlobalInsts())
+                {
+                    if (auto code = as<IRGlobalValueWithCode>(inst))
+                    {
+                        if (code->getFirstBlock())
+                        {
+                            workList.add(code);
+                        }
+                    }
+                }
+            }
+
+            if (workList.getCount() == 0)
+            {
+                break;
+            }
+
+            changedCode.clear();
+            for (auto code : workList)
+            {
+                if (simplifyCode(module, code, &sharedBuilder))
+                {
+                    changedCode.add(code);
+                }
+            }
+            workList.swapWith(changedCode);
         }
+
+        // Simplification may have removed the last uses of functions, types, and so on.
+        eliminateDeadCode(module);
     }
 }
@@ -20,9 +20,7 @@ static void _findGetStringHashRec(IRInst* inst, List<IRGetStringHash*>& outInsts
 
 void findGlobalHashedStringLiterals(IRModule* module, StringSlicePool& pool)
 {
-    IRModuleInst* moduleInst = module->getModuleInst();
-
-    for(IRInst* child : moduleInst->getChildren())
+    for(IRInst* child : module->getSymbolIndex()->m_globalHashedStringLiterals)
     {
         if (IRGlobalHashedStringLiterals* hashedStringLits = as<IRGlobalHashedStringLiterals>(child))
         {
@@ -1,6 +1,7 @@
 // slang-ir.cpp
 #include "slang-ir.h"
 #include "slang-ir-insts.h"
+#include "slang-ir-frozen.h"
 
 #include "../core/slang-basic.h"
 
@@ -224,6 +225,9 @@ namespace Slang
 
     IRDecoration* IRInst::findDecorationImpl(IROp decorationOp)
     {
+        if ((m_decorationMask & getDecorationMaskBit(decorationOp)) == 0)
+            return nullptr;
+
         for(auto dd : getDecorations())
         {
             if(dd->getOp() == decorationOp)
@@ -1352,17 +1356,184 @@ namespace Slang
         size_t defaultSize = sizeof(IRInst) + (operandCount) * sizeof(IRUse);
         size_t totalSize = minSizeInBytes > defaultSize ? minSizeInBytes : defaultSize;
 
-        IRInst* inst = (IRInst*) m_memoryArena.allocateAndZero(totalSize);
+        // The size is rounded up so that the memory of any deallocated instruction of
+        // the same size class can be reused.
+        totalSize = (totalSize + kFreeListSizeGranularity - 1) & ~size_t(kFreeListSizeGranularity - 1);
+
+        IRInst* inst = nullptr;
+        const size_t sizeClass = totalSize / kFreeListSizeGranularity;
+        if (sizeClass < kFreeListCount && m_freeLists[sizeClass])
+        {
+            FreeBlock* block = m_freeLists[sizeClass];
+            m_freeLists[sizeClass] = block->next;
+            m_deallocatedInstsSize -= totalSize;
+            m_reusedInstCount++;
+
+            inst = (IRInst*)block;
+            ::memset(inst, 0, totalSize);
+        }
+        else
+        {
+            inst = (IRInst*) m_memoryArena.allocateAndZero(totalSize);
+        }
 
         // TODO: Is it actually important to run a constructor here?
         new(inst) IRInst();
 
         inst->operandCount = uint32_t(operandCount);
         inst->m_op = op;
+        inst->m_allocatedSize = uint32_t(totalSize);
 
         return inst;
     }
 
+    void IRModule::_deallocateInst(IRInst* inst)
+    {
+        SLANG_ASSERT(inst->m_allocatedSize);
+
+        m_deallocatedInsts.add(inst);
+        m_deallocatedInstsSize += inst->m_allocatedSize;
+    }
+
+    void IRModule::recycleDeallocatedInsts()
+    {
+        for (auto inst : m_deallocatedInsts)
+        {
+            // An instruction can be deallocated while something still uses it, as some uses are
+            // "weak" (such as by an IRSpecializationDictionaryItem). Such an instruction still has
+            // to look like the one it was, so its memory is only reclaimed by `compact`.
+            if (inst->firstUse)
+            {
+                continue;
+            }
+
+            // Large instructions are rare, so their memory is also only reclaimed by `compact`
+            const size_t size = inst->m_allocatedSize;
+            const size_t sizeClass = size / kFreeListSizeGranularity;
+            if (sizeClass < kFreeListCount)
+            {
+                FreeBlock* block = (FreeBlock*)inst;
+                block->next = m_freeLists[sizeClass];
+                m_freeLists[sizeClass] = block;
+            }
+        }
+        m_deallocatedInsts.clear();
+    }
+
+    bool IRModule::compact(Dictionary<IRInst*, IRInst*>& outRemap)
+    {
+        outRemap.Clear();
+
+        // Find all of the instructions in the module. They are visited depth first, such that
+        // the instructions of a function end up next to each other in memory.
+        List<IRInst*> insts;
+        {
+            List<IRInst*> stack;
+            stack.add(m_moduleInst);
+            while (stack.getCount())
+            {
+                IRInst* inst = stack.getLast();
+                stack.removeLast();
+                insts.add(inst);
+
+                for (IRInst* child = inst->getLastDecorationOrChild(); child; child = child->getPrevInst())
+                {
+                    stack.add(child);
+                }
+            }
+        }
+
+        // Copy them into the new arena
+        MemoryArena arena(kMemoryArenaBlockSize);
+        for (auto inst : insts)
+        {
+            const size_t size = inst->m_allocatedSize;
+            SLANG_ASSERT(size);
+
+            IRInst* newInst = (IRInst*)arena.allocate(size);
+            ::memcpy(newInst, inst, size);
+            outRemap.Add(inst, newInst);
+        }
+
+        auto remap = [&](IRInst* inst) -> IRInst*
+        {
+            return inst ? outRemap[inst].GetValue() : nullptr;
+        };
+
+        // Fix up the links between instructions, and the values used by them
+        for (auto inst : insts)
+        {
+            IRInst* newInst = remap(inst);
+
+            newInst->parent = remap(inst->parent);
+            newInst->next = remap(inst->next);
+            newInst->prev = remap(inst->prev);
+            newInst->m_decorationsAndChildren.first = remap(inst->m_decorationsAndChildren.first);
+            newInst->m_decorationsAndChildren.last = remap(inst->m_decorationsAndChildren.last);
+            newInst->firstUse = nullptr;
+
+            const Index useCount = Index(inst->operandCount) + 1;
+            IRUse* uses = &inst->typeUse;
+            IRUse* newUses = &newInst->typeUse;
+            for (Index i = 0; i < useCount; ++i)
+            {
+                IRInst* usedValue = uses[i].usedValue;
+                IRInst*const* newUsedValue = usedValue ? outRemap.TryGetValue(usedValue) : nullptr;
+                if (usedValue && !newUsedValue)
+                {
+                    // The value isn't part of the module, so the module can't be moved
+                    outRemap.Clear();
+                    return false;
+                }
+
+                IRUse& newUse = newUses[i];
+                newUse.usedValue = newUsedValue ? *newUsedValue : nullptr;
+                newUse.user = uses[i].user ? newInst : nullptr;
+                newUse.nextUse = nullptr;
+                newUse.prevLink = nullptr;
+            }
+        }
+
+        // Rebuild the lists of uses of each value, keeping them in the same order. Uses by
+        // instructions that aren't part of the module (and so aren't copied) are dropped.
+        for (auto inst : insts)
+        {
+            IRInst* newInst = remap(inst);
+
+            IRUse** link = &newInst->firstUse;
+            for (IRUse* use = inst->firstUse; use; use = use->nextUse)
+            {
+                IRInst* user = use->getUser();
+                IRInst*const* newUser = outRemap.TryGetValue(user);
+                if (!newUser)
+                {
+                    continue;
+                }
+
+                IRUse* newUse = &(*newUser)->typeUse + (use - &user->typeUse);
+
+                newUse->prevLink = link;
+                *link = newUse;
+                link = &newUse->nextUse;
+            }
+        }
+
+        m_moduleInst = static_cast<IRModuleInst*>(remap(m_moduleInst));
+
+        // Swap in the new arena. The old one (with all of the deallocated instructions) is freed on leaving scope.
+        m_memoryArena.swapWith(arena);
+
+        m_deallocatedInsts.clear();
+        for (auto& freeList : m_freeLists)
+        {
+            freeList = nullptr;
+        }
+        m_deallocatedInstsSize = 0;
+
+        _invalidateSymbolIndex();
+        return true;
+    }
+
         /// Return whichever of `left` or `right` represents the later point in a common parent
     static IRInst* pickLaterInstInSameParent(
         IRInst* left,
@@ -2074,7 +2245,8 @@ namespace Slang
             }
             case kIROp_VoidLit:
             {
-                const size_t instSize = prefixSize;
+                // Sized to hold the pointer value that is copied, even though it isn't used
+                const size_t instSize = prefixSize + sizeof(void*);
                 irValue = static_cast<IRConstant*>(
                     _createInst(instSize, keyInst.getFullType(), keyInst.getOp()));
                 irValue->value.ptrVal = keyInst.value.ptrVal;
@@ -2291,6 +2463,7 @@ namespace Slang
         inst->m_op = op;
         inst->typeUse.usedValue = type;
         inst->operandCount = (uint32_t) operandCount;
+        inst->m_allocatedSize = (uint32_t)keySize;
 
         // Don't link up as we may free (if we already have this key)
         {
@@ -2381,6 +2554,7 @@ namespace Slang
         inst->m_op = op;
         inst->typeUse.usedValue = type;
         inst->operandCount = (uint32_t)operandCount;
+        inst->m_allocatedSize = (uint32_t)keySize;
 
         // Don't link up as we may free (if we already have this key)
         {
@@ -3470,6 +3644,112 @@ namespace Slang
         return inst;
     }
 
+    ConstArrayView<IRInst*> IRModuleSymbolIndex::findValues(const UnownedStringSlice& name) const
+    {
+        if (m_frozenModule)
+        {
+            return m_frozenModule->thawValues(name);
+        }
+        if (const Range* range = m_nameToRange.TryGetValue(name))
+        {
+            return ConstArrayView<IRInst*>(m_namedValues.getBuffer() + range->start, range->count);
+        }
+        return ConstArrayView<IRInst*>();
+    }
+
+    void IRModuleSymbolIndex::init(IRModuleInst* moduleInst)
+    {
+        // Count the values with each name, so the values can be grouped by name
+        List<IRLinkageDecoration*> linkages;
+        for (auto inst : moduleInst->getChildren())
+        {
+            auto linkage = inst->findDecoration<IRLinkageDecoration>();
+            linkages.add(linkage);
+            if (linkage)
+            {
+                m_nameToRange.GetOrAddValue(linkage->getMangledName(), Range{ 0, 0 }).count++;
+            }
+        }
+
+        Index start = 0;
+        for (auto& pair : m_nameToRange)
+        {
+            pair.Value.start = start;
+            start += pair.Value.count;
+            pair.Value.count = 0;
+        }
+        m_namedValues.setCount(start);
+
+        Index instIndex = 0;
+        for (auto inst : moduleInst->getChildren())
+        {
+            if (auto linkage = linkages[instIndex++])
+            {
+                Range* range = m_nameToRange.TryGetValue(linkage->getMangledName());
+                m_namedValues[range->start + range->count++] = inst;
+            }
+
+            switch (inst->getOp())
+            {
+                case kIROp_BindGlobalGenericParam:
+                {
+                    m_bindGlobalGenericParams.add(inst);
+                    break;
+                }
+                case kIROp_GlobalHashedStringLiterals:
+                {
+                    m_globalHashedStringLiterals.add(inst);
+                    break;
+                }
+                default: break;
+            }
+
+            for (auto decoration : inst->getDecorations())
+            {
+                const auto op = decoration->getOp();
+                if (op == kIROp_PublicDecoration ||
+                    op == kIROp_HLSLExportDecoration)
+                {
+                    m_exportedValues.add(inst);
+                    break;
+                }
+            }
+        }
+    }
+
+    void IRModuleSymbolIndex::initFrozen(IRFrozenModule* frozenModule)
+    {
+        m_frozenModule = frozenModule;
+        frozenModule->initSymbolIndex(this);
+    }
+
+    IRModuleSymbolIndex* IRModule::getSymbolIndex()
+    {
+        if (!m_symbolIndex)
+        {
+            m_symbolIndex = new IRModuleSymbolIndex;
+            if (m_frozenModule)
+            {
+                m_symbolIndex->initFrozen(m_frozenModule);
+            }
+            else
+            {
+                m_symbolIndex->init(m_moduleInst);
+            }
+        }
+        return m_symbolIndex;
+    }
+
+    IRModule::IRModule(Session* session)
+        : m_session(session)
+        , m_memoryArena(kMemoryArenaBlockSize)
+    {
+    }
+
+    IRModule::~IRModule()
+    {
+    }
+
     RefPtr<IRModule> IRModule::create(Session* session)
     {
         RefPtr<IRModule> module = new IRModule(session);
@@ -5894,12 +6174,28 @@ namespace Slang
         insertAtStart(p);
     }
 
+    // Adding or removing a global instruction, or something in one (such as its linkage decoration), can change the symbol
+    // index of the module.
+    static void _invalidateSymbolIndexIfGlobal(IRInst* parent)
+    {
+        if (parent->getOp() != kIROp_Module)
+        {
+            parent = parent->getParent();
+            if (!parent || parent->getOp() != kIROp_Module)
+            {
+                return;
+            }
+        }
+        static_cast<IRModuleInst*>(parent)->module->_invalidateSymbolIndex();
+    }
+
     void IRInst::_insertAt(IRInst* inPrev, IRInst* inNext, IRInst* inParent)
     {
         // Make sure this instruction has been removed from any previous parent
         this->removeFromParent();
 
         SLANG_ASSERT(inParent);
+        _invalidateSymbolIndexIfGlobal(inParent);
         SLANG_ASSERT(!inPrev || (inPrev->getNextInst() == inNext) && (inPrev->getParent() == inParent));
         SLANG_ASSERT(!inNext || (inNext->getPrevInst() == inPrev) && (inNext->getParent() == inParent));
 
@@ -5924,6 +6220,11 @@ namespace Slang
         this->prev = inPrev;
         this->next = inNext;
         this->parent = inParent;
+
+        if (as<IRDecoration>(this))
+        {
+            inParent->m_decorationMask |= getDecorationMaskBit(getOp());
+        }
     }
 
     void IRInst::insertAfter(IRInst* other)
@@ -5981,6 +6282,8 @@ namespace Slang
         if(!oldParent)
             return;
 
+        _invalidateSymbolIndexIfGlobal(oldParent);
+
         auto pp = getPrevInst();
         auto nn = getNextInst();
 
@@ -6023,12 +6326,20 @@ namespace Slang
     // and then destroy it (it had better have no uses!)
     void IRInst::removeAndDeallocate()
     {
+        // The children are deallocated first, as they (and this) need to
+        // still be in the module to find where to return their memory.
+        IRModule* module = getModule();
+        removeAndDeallocateAllDecorationsAndChildren();
         removeFromParent();
         removeArguments();
-        removeAndDeallocateAllDecorationsAndChildren();
 
         // Run destructor to be sure...
         this->~IRInst();
+
+        if (module)
+        {
+            module->_deallocateInst(this);
+        }
     }
 
     void IRInst::removeAndDeallocateAllDecorationsAndChildren()
@@ -23,6 +23,7 @@ class   Layout;
 class   Type;
 class   Session;
 class   Name;
+class   IRFrozenModule;
 struct  IRBuilder;
 struct  IRFunc;
 struct  IRGlobalValueWithCode;
@@ -481,6 +482,34 @@ private:
     IRInst* m_inst = nullptr;
 };
 
+    /// Get the bit for the decoration `op` in `IRInst::m_decorationMask`.
+    ///
+    /// There are more decoration ops than bits, so several ops share each bit.
+SLANG_FORCE_INLINE uint64_t getDecorationMaskBit(IROp op)
+{
+    return uint64_t(1) << (((kIROpMeta_OpMask & op) - kIROp_FirstDecoration) & 63);
+}
+
+    /// Get the bits in `IRInst::m_decorationMask` for all of the decoration ops in the range [firstOp, lastOp]
+SLANG_FORCE_INLINE uint64_t getDecorationMaskBits(int firstOp, int lastOp)
+{
+    firstOp = firstOp < kIROp_FirstDecoration ? int(kIROp_FirstDecoration) : firstOp;
+    lastOp = lastOp > kIROp_LastDecoration ? int(kIROp_LastDecoration) : lastOp;
+    if (firstOp > lastOp)
+    {
+        return 0;
+    }
+    const int count = lastOp - firstOp + 1;
+    if (count >= 64)
+    {
+        return ~uint64_t(0);
+    }
+    // The bits for the range, rotated to the position of the first op
+    const uint64_t bits = (uint64_t(1) << count) - 1;
+    const int shift = (firstOp - kIROp_FirstDecoration) & 63;
+    return shift ? ((bits << shift) | (bits >> (64 - shift))) : bits;
+}
+
 // Every value in the IR is an instruction (even things
 // like literal values).
 //
@@ -508,6 +537,19 @@ struct IRInst
     // Source location information for this value, if any
     SourceLoc sourceLoc;
 
+    // The size in bytes of the memory allocated for this instruction,
+    // so that the memory can be reused once it is deallocated.
+    uint32_t m_allocatedSize = 0;
+
+    // A summary of the ops of the decorations attached to this instruction,
+    // with the bit `getDecorationMaskBit(op)` set for each of them. Most
+    // lookups are for a decoration that isn't there, and can return without
+    // looking at the decorations if its bit is clear.
+    //
+    // Bits are not cleared when a decoration is removed, so a set bit only
+    // means that a decoration with a matching op *may* be present.
+    uint64_t m_decorationMask = 0;
+
     // Each instruction can have zero or more "decorations"
     // attached to it. A decoration is a specialized kind
     // of instruction that either attaches metadata to,
@@ -757,6 +799,9 @@ SourceLoc const& getDiagnosticPos(IRInst* inst);
 template<typename T>
 T* IRInst::findDecoration()
 {
+    if ((m_decorationMask & getDecorationMaskBits(T::kFirstOp, T::kLastOp)) == 0)
+        return nullptr;
+
     for( auto decoration : getDecorations() )
     {
         if(auto match = as<T>(decoration))
@@ -809,8 +854,10 @@ typename IRFilteredInstList<T>::Iterator IRFilteredInstList<T>::end()
 
 // Types
 
-#define IR_LEAF_ISA(NAME) static bool isaImpl(IROp op) { return (kIROpMeta_OpMask & op) == kIROp_##NAME; }
-#define IR_PARENT_ISA(NAME) static bool isaImpl(IROp opIn) { const int op = (kIROpMeta_OpMask & opIn); return op >= kIROp_First##NAME && op <= kIROp_Last##NAME; }
+#define IR_LEAF_ISA(NAME) static bool isaImpl(IROp op) { return (kIROpMeta_OpMask & op) == kIROp_##NAME; } \
+    enum : int32_t { kFirstOp = kIROp_##NAME, kLastOp = kIROp_##NAME };
+#define IR_PARENT_ISA(NAME) static bool isaImpl(IROp opIn) { const int op = (kIROpMeta_OpMask & opIn); return op >= kIROp_First##NAME && op <= kIROp_Last##NAME; } \
+    enum : int32_t { kFirstOp = kIROp_First##NAME, kLastOp = kIROp_Last##NAME };
 
 #define SIMPLE_IR_TYPE(NAME, BASE) struct IR##NAME : IR##BASE { IR_LEAF_ISA(NAME) };
 #define SIMPLE_IR_PARENT_TYPE(NAME, BASE) struct IR##NAME : IR##BASE { IR_PARENT_ISA(NAME) };
@@ -1749,16 +1796,55 @@ struct IRModuleInst : IRInst
     IR_LEAF_ISA(Module)
 };
 
+    /// An index of the global values of an `IRModule` that linking needs to find.
+    ///
+    /// Linking looks up values by mangled name, so only has to touch what it pulls in, rather than
+    /// everything in every module that is linked against. A module is linked against many times (the
+    /// stdlib is linked against for every entry point and target), but doesn't change once created, so
+    /// the index only needs to be built once.
+struct IRModuleSymbolIndex : RefObject
+{
+        /// Get the global values with a linkage decoration with the mangled `name`, in module order
+    ConstArrayView<IRInst*> findValues(const UnownedStringSlice& name) const;
+
+        /// Global values that are `public` or (HLSL) `export`ed, which are always linked
+    List<IRInst*> m_exportedValues;
+        /// The `IRBindGlobalGenericParam` instructions, which are always linked
+    List<IRInst*> m_bindGlobalGenericParams;
+        /// The `IRGlobalHashedStringLiterals` instructions
+    List<IRInst*> m_globalHashedStringLiterals;
+
+        /// Build the index for the global instructions in `moduleInst`
+    void init(IRModuleInst* moduleInst);
+        /// Build the index for a frozen module. Values are looked up in, and thawed from, `frozenModule`.
+    void initFrozen(IRFrozenModule* frozenModule);
+
+protected:
+    struct Range
+    {
+        Index start;
+        Index count;
+    };
+
+    Dictionary<UnownedStringSlice, Range> m_nameToRange;    ///< Range in m_namedValues of values with a name
+    List<IRInst*> m_namedValues;                            ///< Values grouped by name
+    IRFrozenModule* m_frozenModule = nullptr;               ///< If set, names are looked up in the frozen module instead
+};
+
 struct IRModule : RefObject
 {
 public:
     enum 
     {
         kMemoryArenaBlockSize = 16 * 1024,           ///< Use 16k block size for memory arena
+        kFreeListSizeGranularity = sizeof(void*),   ///< Instruction allocations are a multiple of this size
+        kFreeListCount = 64,                        ///< Allocations of up to kFreeListCount * kFreeListSizeGranularity bytes are reused
     };
 
     static RefPtr<IRModule> create(Session* session);
 
+    ~IRModule();
+
     SLANG_FORCE_INLINE Session* getSession() const { return m_session; }
     SLANG_FORCE_INLINE IRModuleInst* getModuleInst() const { return m_moduleInst;  }
     SLANG_FORCE_INLINE MemoryArena& getMemoryArena() { return m_memoryArena; }
@@ -1799,15 +1885,61 @@ public:
         return (T*) _allocateInst(op, operandCount, sizeof(T));
     }
 
+        /// Called when `inst` (which must have been allocated from this module) has been destroyed.
+        ///
+        /// The memory isn't available for reuse until `recycleDeallocatedInsts` is called, as
+        /// passes commonly keep pointers to instructions they have removed (for example in a
+        /// dictionary), and a new instruction at the same address would be mistaken for the old one.
+        ///
+    void _deallocateInst(IRInst* inst);
+
+        /// Make the memory of the instructions deallocated since the last call available to new instructions.
+        ///
+        /// Must only be called when nothing refers to a deallocated instruction, such as between passes.
+        /// Instructions that are still used (through a "weak" reference), or are too large for the free
+        /// lists, are left for `compact` to release.
+    void recycleDeallocatedInsts();
+
+        /// Get the total size in bytes of deallocated instructions, whose memory is waiting to be reused or released by `compact`
+    size_t getDeallocatedInstsSize() const { return m_deallocatedInstsSize; }
+        /// Get the number of instructions that have been allocated with the memory of a deallocated instruction
+    Index getReusedInstCount() const { return m_reusedInstCount; }
+
+        /// Copy all of the instructions in the module into a new memory arena, and free the old one,
+        /// releasing the memory of any deallocated instructions.
+        ///
+        /// As every instruction moves, all pointers to them held outside of the module must be updated.
+        /// `outRemap` maps from each instruction to the one that replaces it.
+        ///
+        /// Returns false, leaving the module unchanged, if it can't be compacted because an instruction
+        /// uses a value that isn't in the module.
+    bool compact(Dictionary<IRInst*, IRInst*>& outRemap);
+
+        /// Get the index of the global values linking needs to find. Built if it hasn't been, or the module
+        /// has changed since.
+    IRModuleSymbolIndex* getSymbolIndex();
+
+        /// Get the frozen module that the instructions of this module are thawed from, or nullptr if it isn't frozen.
+        ///
+        /// Only the instructions that have been thawed so far are in a frozen module (see `IRFrozenModule`).
+    IRFrozenModule* getFrozenModule() const { return m_frozenModule; }
+
+        /// Discard the symbol index, because a global instruction (or one of its children or decorations)
+        /// has been added or removed.
+    void _invalidateSymbolIndex()
+    {
+        // The index of a frozen module is built from the frozen instructions, so doesn't change as they are thawed
+        if (m_symbolIndex && !m_frozenModule)
+        {
+            m_symbolIndex.setNull();
+        }
+    }
+
 private:
     IRModule() = delete;
 
         /// Ctor
-    IRModule(Session* session)
-        : m_session(session)
-        , m_memoryArena(kMemoryArenaBlockSize)
-    {
-    }
+    IRModule(Session* session);
 
         // The compilation session in use.
     Session*    m_session = nullptr;
@@ -1823,6 +1955,31 @@ private:
 
         /// The memory arena from which all IR instructions (and any associated state) in this module are allocated.
     MemoryArena m_memoryArena;
+
+        /// Built on demand by getSymbolIndex
+    RefPtr<IRModuleSymbolIndex> m_symbolIndex;
+
+        /// Set if the module is frozen
+    RefPtr<IRFrozenModule> m_frozenModule;
+
+    friend class IRFrozenModule;
+
+        /// A block of memory on a free list
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+        /// Instructions that have been deallocated, but are not yet on the free lists
+    List<IRInst*> m_deallocatedInsts;
+        /// For each size (in multiples of kFreeListSizeGranularity) a list of blocks that can be reused
+    FreeBlock* m_freeLists[kFreeListCount] = {};
+        /// The total size in bytes of deallocated instructions whose memory hasn't been reused. Includes
+        /// instructions that are never put on the free lists (because they are large, or are still used),
+        /// as `compact` releases their memory too.
+    size_t m_deallocatedInstsSize = 0;
+        /// The number of instructions allocated from the free lists
+    Index m_reusedInstCount = 0;
 };
 
 struct IRSpecializationDictionaryItem : public IRInst
@@ -435,7 +435,7 @@ SlangResult LanguageServer::hover(
     Index line, col;
     doc->zeroBasedUTF16LocToOneBasedUTF8Loc(args.position.line, args.position.character, line, col);
 
-    auto version = m_workspace->getCurrentVersion();
+    auto version = getCurrentWorkspaceVersion();
     Module* parsedModule = version->getOrLoadModule(canonicalPath);
     if (!parsedModule)
     {
@@ -556,7 +556,7 @@ SlangResult LanguageServer::gotoDefinition(
     Index line, col;
     doc->zeroBasedUTF16LocToOneBasedUTF8Loc(args.position.line, args.position.character, line, col);
 
-    auto version = m_workspace->getCurrentVersion();
+    auto version = getCurrentWorkspaceVersion();
     Module* parsedModule = version->getOrLoadModule(canonicalPath);
     if (!parsedModule)
     {
@@ -844,7 +844,7 @@ SlangResult LanguageServer::semanticTokens(
         return SLANG_OK;
     }
 
-    auto version = m_workspace->getCurrentVersion();
+    auto version = getCurrentWorkspaceVersion();
     Module* parsedModule = version->getOrLoadModule(canonicalPath);
     if (!parsedModule)
     {
@@ -884,7 +884,7 @@ SlangResult LanguageServer::signatureHelp(
     Index line, col;
     doc->zeroBasedUTF16LocToOneBasedUTF8Loc(args.position.line, args.position.character, line, col);
 
-    auto version = m_workspace->getCurrentVersion();
+    auto version = getCurrentWorkspaceVersion();
     Module* parsedModule = version->getOrLoadModule(canonicalPath);
     if (!parsedModule)
     {
@@ -1077,7 +1077,7 @@ SlangResult LanguageServer::documentSymbol(
         m_connection->sendResult(NullResponse::get(), responseId);
         return SLANG_OK;
     }
-    auto version = m_workspace->getCurrentVersion();
+    auto version = getCurrentWorkspaceVersion();
     Module* parsedModule = version->getOrLoadModule(canonicalPath);
     if (!parsedModule)
     {
@@ -1098,7 +1098,7 @@ SlangResult LanguageServer::inlayHint(const LanguageServerProtocol::InlayHintPar
         m_connection->sendResult(NullResponse::get(), responseId);
         return SLANG_OK;
     }
-    auto version = m_workspace->getCurrentVersion();
+    auto version = getCurrentWorkspaceVersion();
     Module* parsedModule = version->getOrLoadModule(canonicalPath);
     if (!parsedModule)
     {
@@ -1215,7 +1215,7 @@ void LanguageServer::publishDiagnostics()
     }
     m_lastDiagnosticUpdateTime = std::chrono::system_clock::now();
 
-    auto version = m_workspace->getCurrentVersion();
+    auto version = getCurrentWorkspaceVersion();
     // Send updates to clear diagnostics for files that no longer have any messages.
     List<String> filesToRemove;
     for (auto& file : m_lastPublishedDiagnostics)
@@ -1370,16 +1370,21 @@ void LanguageServer::updateTraceOptions(const JSONValue& value)
         String str;
         if (SLANG_SUCCEEDED(converter.convert(value, &str)))
         {
-            if (str == "messages")
-                m_traceOptions = TraceOptions::Messages;
-            else if (str == "verbose")
-                m_traceOptions = TraceOptions::Verbose;
-            else
-                m_traceOptions = TraceOptions::Off;
+            setTraceOptions(str);
         }
     }
 }
 
+void LanguageServer::setTraceOptions(const String& value)
+{
+    if (value == "messages")
+        m_traceOptions = TraceOptions::Messages;
+    else if (value == "verbose")
+        m_traceOptions = TraceOptions::Verbose;
+    else
+        m_traceOptions = TraceOptions::Off;
+}
+
 void LanguageServer::sendConfigRequest()
 {
     ConfigurationParams args;
@@ -1431,6 +1436,25 @@ void LanguageServer::logMessage(int type, String message)
     m_connection->sendCall(LanguageServerProtocol::LogMessageParams::methodName, &args);
 }
 
+WorkspaceVersion* LanguageServer::getCurrentWorkspaceVersion()
+{
+    auto version = m_workspace->getCurrentVersion();
+
+    // Report how much of the previous version's checked code a new version kept
+    if (m_traceOptions == TraceOptions::Verbose && version != m_lastTracedVersion)
+    {
+        m_lastTracedVersion = version;
+        if (version->linkageReuseCount > 0)
+        {
+            StringBuilder msgBuilder;
+            msgBuilder << "Workspace version reused " << version->keptModuleCount << " of "
+                       << version->previousModuleCount << " modules";
+            logMessage(3, msgBuilder.ProduceString());
+        }
+    }
+    return version;
+}
+
 SlangResult LanguageServer::tryGetMacroHoverInfo(
     WorkspaceVersion* version, DocumentVersion* doc, Index line, Index col, JSONValue responseId)
 {
@@ -1631,6 +1655,14 @@ SlangResult LanguageServer::queueJSONCall(JSONRPCCall call)
         SLANG_RETURN_ON_FAIL(m_connection->toNativeArgsOrSendError(call.params, &args, call.id));
         cmd.inlayHintArgs = args;
     }
+    else if (call.method == SetTraceParams::methodName)
+    {
+        SetTraceParams args;
+        SLANG_RETURN_ON_FAIL(m_connection->toNativeArgsOrSendError(call.params, &args, call.id));
+        // Takes effect straight away, so it applies to the commands that follow it.
+        setTraceOptions(args.value);
+        return SLANG_OK;
+    }
     else if (call.method == "$/cancelRequest")
     {
         CancelParams args;
@@ -99,6 +99,8 @@ public:
     Slang::InlayHintOptions m_inlayHintOptions;
     bool m_quit = false;
     List<LanguageServerProtocol::WorkspaceFolder> m_workspaceFolders;
+    // The last workspace version whose reuse of the previous version has been traced.
+    RefPtr<WorkspaceVersion> m_lastTracedVersion;
 
     SlangResult init(const LanguageServerProtocol::InitializeParams& args);
     SlangResult execute();
@@ -144,10 +146,13 @@ private:
     void updateFormattingOptions(const JSONValue& clangFormatLoc, const JSONValue& clangFormatStyle, const JSONValue& allowLineBreakOnType, const JSONValue& allowLineBreakInRange);
     void updateInlayHintOptions(const JSONValue& deducedTypes, const JSONValue& parameterNames);
     void updateTraceOptions(const JSONValue& value);
+    void setTraceOptions(const String& value);
 
     void sendConfigRequest();
     void registerCapability(const char* methodName);
     void logMessage(int type, String message);
+    // Get the current workspace version, creating it if needed.
+    WorkspaceVersion* getCurrentWorkspaceVersion();
 
     SlangResult tryGetMacroHoverInfo(
         WorkspaceVersion* version,
@@ -316,12 +316,7 @@ static SubtypeWitness* _makeSubtypeWitness(
 {
     if(subToMidWitness)
     {
-        TransitiveSubtypeWitness* transitiveWitness = astBuilder->create<TransitiveSubtypeWitness>();
-        transitiveWitness->subToMid = subToMidWitness;
-        transitiveWitness->midToSup = midtoSuperWitness;
-        transitiveWitness->sub = subType;
-        transitiveWitness->sup = superType;
-        return transitiveWitness;
+        return astBuilder->getTransitiveSubtypeWitness(subType, superType, subToMidWitness, midtoSuperWitness);
     }
     else
     {
@@ -336,10 +331,7 @@ static SubtypeWitness* _makeSubtypeWitness(
     Type*                       superType,
     DeclRef<TypeConstraintDecl> midToSuperConstraint)
 {
-    DeclaredSubtypeWitness* midToSuperWitness = astBuilder->create<DeclaredSubtypeWitness>();
-    midToSuperWitness->declRef = midToSuperConstraint;
-    midToSuperWitness->sub = subType;
-    midToSuperWitness->sup = superType;
+    DeclaredSubtypeWitness* midToSuperWitness = astBuilder->getDeclaredSubtypeWitness(subType, superType, midToSuperConstraint);
     return _makeSubtypeWitness(astBuilder, subType, subToMidWitness, superType, midToSuperWitness);
 }
 
@@ -353,10 +345,10 @@ static Type* _maybeSpecializeSuperType(
     {
         if (auto superInterfaceDeclRef = superDeclRefType->declRef.as<InterfaceDecl>())
         {
-            ThisTypeSubstitution* thisTypeSubst = astBuilder->create<ThisTypeSubstitution>();
-            thisTypeSubst->interfaceDecl = superInterfaceDeclRef.getDecl();
-            thisTypeSubst->witness = subIsSuperWitness;
-            thisTypeSubst->outer = superInterfaceDeclRef.substitutions.substitutions;
+            ThisTypeSubstitution* thisTypeSubst = astBuilder->getOrCreateThisTypeSubstitution(
+                superInterfaceDeclRef.getDecl(),
+                subIsSuperWitness,
+                superInterfaceDeclRef.substitutions.substitutions);
 
             auto specializedInterfaceDeclRef = DeclRef<Decl>(superInterfaceDeclRef.getDecl(), thisTypeSubst);
 
@@ -2594,9 +2594,7 @@ static Type* _findReplacementThisParamType(
 
     if (auto interfaceDeclRef = parentDeclRef.as<InterfaceDecl>())
     {
-        auto thisType = context->astBuilder->create<ThisType>();
-        thisType->interfaceDeclRef = interfaceDeclRef;
-        return thisType;
+        return context->astBuilder->getThisType(interfaceDeclRef);
     }
 
     return nullptr;
@@ -8659,6 +8657,8 @@ RefPtr<IRModule> generateIRForTranslationUnit(
     auto session = translationUnit->getSession();
     auto compileRequest = translationUnit->compileRequest;
 
+    CompileTraceScope traceScope(compileRequest->getLinkage()->getCompileTrace(), "frontend", "lowerToIR");
+
     SharedIRGenContext sharedContextStorage(
         session,
         translationUnit->compileRequest->getSink(),
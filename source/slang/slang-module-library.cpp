@@ -65,6 +65,7 @@ SlangResult loadModuleLibrary(const Byte* inBytes, size_t bytesCount, EndToEndCo
         options.sourceManager = linkage->getSourceManager();
         options.linkage = req->getLinkage();
         options.sink = req->getSink();
+        options.freezeIRModules = true;
 
         SLANG_RETURN_ON_FAIL(SerialContainerUtil::read(&riffContainer, options, containerData));
 
@@ -420,6 +420,24 @@ struct OptionsParser
         Slang::List<String> m_filenames;
     };
 
+        /// True if `linkage` holds exactly the targets in `rawTargets`, in the same order
+    static bool _hasTargets(Linkage* linkage, const List<RawTarget>& rawTargets)
+    {
+        const auto& targets = linkage->targets;
+        if (targets.getCount() != rawTargets.getCount())
+        {
+            return false;
+        }
+        for (Index i = 0; i < targets.getCount(); ++i)
+        {
+            if (targets[i]->getTarget() != rawTargets[i].format)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
     static SlangResult _compileReproDirectory(SlangSession* session, EndToEndCompileRequest* originalRequest, const String& dir, DiagnosticSink* sink)
     {
         auto stdOut = originalRequest->getWriter(WriterChannel::StdOutput);
@@ -521,6 +539,9 @@ struct OptionsParser
             "      c, cpp, c++, cxx, slang, glsl, hlsl, cu, cuda\n"
             "  -matrix-layout-column-major: Set the default matrix layout to column-major.\n"
             "  -matrix-layout-row-major: Set the default matrix layout to row-major.\n"
+            "  -module-cache <dir>: Save the modules that are imported in <dir>, and use\n"
+            "    them in place of compiling the source of a module when it hasn't changed.\n"
+            "    A module is also used from a <name>.slang-module next to its source.\n"
             "  -module-name <name>: Set the module name to use when compiling multiple\n"
             "    .slang source files into a single module.\n"
             "  -o <path>: Specify a path where generated output should be written.\n"
@@ -563,6 +584,11 @@ struct OptionsParser
             "\n"
             "  -capability <capability>[+<capability>...]: Add optional capabilities\n"
             "    to a code generation target. See Capabilities below.\n"
+            "  -codegen-threads <count>: Generate the code for targets and entry points on\n"
+            "    up to <count> threads (0 uses all hardware threads). Diagnostics for\n"
+            "    different entry points may then be output in any order.\n"
+            "  -compile-cache <dir>: Cache compiled target code in <dir>, and reuse it\n"
+            "    when identical code is compiled with identical options again.\n"
             "  -default-image-format-unknown: Set the format of R/W images with unspecified\n"
             "    format to 'unknown'. Otherwise try to guess the format.\n"
             "  -disable-dynamic-dispatch: Disables generating dynamic dispatch code.\n"
@@ -607,6 +633,8 @@ struct OptionsParser
             "\n"
             "Compiler debugging/instrumentation options:\n"
             "\n"
+            "  -compact-ir: Compact the IR at every opportunity, rather than only when\n"
+            "      most of its memory is unused.\n"
             "  -dump-ast: Dump the AST to a .slang-ast file next to the input.\n"
             "  -dump-intermediate-prefix <prefix>: File name prefix for -dump-intermediates \n"
             "      outputs, default is 'slang-dump-'\n"
@@ -629,6 +657,8 @@ struct OptionsParser
             "  -repro-file-system <name>\n"
             "  -serial-ir: Serialize the IR between front-end and back-end.\n"
             "  -skip-codegen: Skip the code generation phase.\n"
+            "  -trace-out <file>: Write a trace of where compilation time goes to <file>,\n"
+            "    in the Chrome trace format (viewable with chrome://tracing or Perfetto).\n"
             "  -validate-ir: Validate the IR between the phases.\n"
             "  -verbose-paths: Display more detailed paths in diagnostic output.\n"
             "  -verify-debug-serial-ir: Verify IR in the front-end.\n"
@@ -871,6 +901,26 @@ struct OptionsParser
                 {
                     requestImpl->getFrontEndReq()->m_irDumpOptions.flags |= IRDumpOptions::Flag::DumpDebugIds;
                 }
+                else if (argValue == "-trace-out")
+                {
+                    CommandLineArg traceOutputPath;
+                    SLANG_RETURN_ON_FAIL(reader.expectArg(traceOutputPath));
+                    requestImpl->m_traceOutputPath = traceOutputPath.value;
+                    requestImpl->setCompileTraceEnabled(true);
+                }
+                else if (argValue == "-codegen-threads")
+                {
+                    CommandLineArg threadCountArg;
+                    SLANG_RETURN_ON_FAIL(reader.expectArg(threadCountArg));
+
+                    Int threadCount = 0;
+                    if (SLANG_FAILED(StringUtil::parseInt(threadCountArg.value.getUnownedSlice(), threadCount)) || threadCount < 0)
+                    {
+                        sink->diagnose(threadCountArg.loc, MiscDiagnostics::invalidArgumentForOption, "-codegen-threads");
+                        return SLANG_FAIL;
+                    }
+                    requestImpl->m_codeGenThreadCount = Index(threadCount);
+                }
                 else if (argValue == "-dump-intermediate-prefix")
                 {
                     CommandLineArg prefix;
@@ -933,6 +983,12 @@ struct OptionsParser
 
                     compileRequest->setDefaultModuleName(moduleName.value.getBuffer());
                 }
+                else if (argValue == "-module-cache")
+                {
+                    CommandLineArg directory;
+                    SLANG_RETURN_ON_FAIL(reader.expectArg(directory));
+                    requestImpl->getLinkage()->m_moduleCacheDirectory = directory.value;
+                }
                 else if(argValue == "-load-repro")
                 {
                     CommandLineArg reproName;
@@ -1073,6 +1129,10 @@ struct OptionsParser
                 {
                     requestImpl->getFrontEndReq()->shouldValidateIR = true;
                 }
+                else if (argValue == "-compact-ir")
+                {
+                    requestImpl->getFrontEndReq()->shouldCompactIR = true;
+                }
                 else if(argValue == "-skip-codegen" )
                 {
                     requestImpl->m_shouldSkipCodegen = true;
@@ -1432,6 +1492,12 @@ struct OptionsParser
                 {
                     requestImpl->getLinkage()->m_obfuscateCode = true;
                 }
+                else if (argValue == "-compile-cache")
+                {
+                    CommandLineArg directory;
+                    SLANG_RETURN_ON_FAIL(reader.expectArg(directory));
+                    requestImpl->getLinkage()->setCompileCacheDirectory(directory.value);
+                }
                 else if (argValue == "-file-system")
                 {
                     CommandLineArg name;
@@ -1989,8 +2055,18 @@ struct OptionsParser
         // We now have enough information to go ahead and declare the targets
         // through the Slang API:
         //
+        // If the linkage is reused from an earlier request with the same options (as the compile server does),
+        // it already holds the targets, set up as they would be here, so they are used rather than added again.
+        const bool hasTargets = _hasTargets(requestImpl->getLinkage(), rawTargets);
+
         for(auto& rawTarget : rawTargets)
         {
+            if (hasTargets)
+            {
+                rawTarget.targetID = int(&rawTarget - rawTargets.getBuffer());
+                continue;
+            }
+
             int targetID = compileRequest->addCodeGenTarget(SlangCompileTarget(rawTarget.format));
             rawTarget.targetID = targetID;
 
@@ -0,0 +1,168 @@
+// slang-parallel-codegen.cpp
+#include "slang-parallel-codegen.h"
+
+#include "../core/slang-com-object.h"
+
+#include <atomic>
+#include <exception>
+#include <thread>
+
+namespace Slang {
+
+namespace { // anonymous
+
+// Forwards to another file system, holding a mutex for the duration of each call
+class LockingFileSystem : public ISlangFileSystemExt, public ComBaseObject
+{
+public:
+    SLANG_COM_BASE_IUNKNOWN_ALL
+
+    // ISlangCastable
+    virtual SLANG_NO_THROW void* SLANG_MCALL castAs(const Guid& guid) SLANG_OVERRIDE { return getInterface(guid); }
+
+    // ISlangFileSystem
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL loadFile(char const* path, ISlangBlob** outBlob) SLANG_OVERRIDE
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_fileSystem->loadFile(path, outBlob);
+    }
+
+    // ISlangFileSystemExt
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL getFileUniqueIdentity(const char* path, ISlangBlob** outUniqueIdentity) SLANG_OVERRIDE
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_fileSystem->getFileUniqueIdentity(path, outUniqueIdentity);
+    }
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL calcCombinedPath(SlangPathType fromPathType, const char* fromPath, const char* path, ISlangBlob** pathOut) SLANG_OVERRIDE
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_fileSystem->calcCombinedPath(fromPathType, fromPath, path, pathOut);
+    }
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL getPathType(const char* path, SlangPathType* outPathType) SLANG_OVERRIDE
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_fileSystem->getPathType(path, outPathType);
+    }
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL getSimplifiedPath(const char* path, ISlangBlob** outSimplifiedPath) SLANG_OVERRIDE
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_fileSystem->getSimplifiedPath(path, outSimplifiedPath);
+    }
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL getCanonicalPath(const char* path, ISlangBlob** outCanonicalPath) SLANG_OVERRIDE
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_fileSystem->getCanonicalPath(path, outCanonicalPath);
+    }
+    virtual SLANG_NO_THROW void SLANG_MCALL clearCache() SLANG_OVERRIDE
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_fileSystem->clearCache();
+    }
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL enumeratePathContents(const char* path, FileSystemContentsCallBack callback, void* userData) SLANG_OVERRIDE
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_fileSystem->enumeratePathContents(path, callback, userData);
+    }
+    virtual SLANG_NO_THROW OSPathKind SLANG_MCALL getOSPathKind() SLANG_OVERRIDE
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_fileSystem->getOSPathKind();
+    }
+
+    LockingFileSystem(ISlangFileSystemExt* fileSystem, std::mutex& mutex):
+        m_fileSystem(fileSystem),
+        m_mutex(mutex)
+    {
+    }
+
+protected:
+    void* getInterface(const Guid& guid)
+    {
+        if (guid == ISlangUnknown::getTypeGuid() ||
+            guid == ISlangCastable::getTypeGuid() ||
+            guid == ISlangFileSystem::getTypeGuid() ||
+            guid == ISlangFileSystemExt::getTypeGuid())
+        {
+            return static_cast<ISlangFileSystemExt*>(this);
+        }
+        return nullptr;
+    }
+
+    ComPtr<ISlangFileSystemExt> m_fileSystem;
+    std::mutex& m_mutex;
+};
+
+} // anonymous
+
+ISlangFileSystemExt* ParallelCodeGen::getLockingFileSystem(ISlangFileSystemExt* fileSystem)
+{
+    if (!fileSystem)
+    {
+        return nullptr;
+    }
+    if (!m_lockingFileSystem)
+    {
+        m_lockingFileSystem = new LockingFileSystem(fileSystem, m_mutex);
+    }
+    return m_lockingFileSystem;
+}
+
+void ParallelCodeGen::run(Index count, Index threadCount, const std::function<void(Index)>& func)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+    if (threadCount <= 0)
+    {
+        threadCount = Index(std::thread::hardware_concurrency());
+    }
+    threadCount = Math::Clamp(threadCount, Index(1), count);
+
+    std::atomic<Index> nextIndex(0);
+    std::exception_ptr exception;
+
+    auto work = [&]()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (!exception)
+        {
+            const Index index = nextIndex++;
+            if (index >= count)
+            {
+                break;
+            }
+
+            try
+            {
+                func(index);
+            }
+            catch (...)
+            {
+                // Only the first exception is kept
+                if (!exception)
+                {
+                    exception = std::current_exception();
+                }
+            }
+        }
+    };
+
+    List<std::thread> threads;
+    for (Index i = 1; i < threadCount; ++i)
+    {
+        threads.add(std::thread(work));
+    }
+    work();
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    if (exception)
+    {
+        std::rethrow_exception(exception);
+    }
+}
+
+} // namespace Slang
@@ -0,0 +1,68 @@
+// slang-parallel-codegen.h
+#ifndef SLANG_PARALLEL_CODEGEN_H
+#define SLANG_PARALLEL_CODEGEN_H
+
+#include "../core/slang-basic.h"
+#include "../../slang-com-ptr.h"
+
+#include <functional>
+#include <mutex>
+
+namespace Slang
+{
+
+/* Runs code generation work items (such as generating the code for an entry point on a target) on multiple threads.
+
+The compiler itself is not thread safe. Reference counts are not atomic, and many structures (layouts,
+the `TypeCheckingCache`, the `NamePool`, the `SourceManager` and so on) are lazily created and cached.
+So all of the work done within the compiler holds a single lock, which is only released whilst a downstream
+compiler (such as dxc, fxc, glslang or a C/C++ compiler) runs - which is typically where most of the time
+of code generation goes.
+
+A downstream compiler may still need to access the file system whilst unlocked (for example to find
+`#include`s), so it should be given the file system from `getLockingFileSystem`, which takes the lock
+for each call. */
+class ParallelCodeGen
+{
+public:
+        /// Releases the lock for the duration of the scope. Does nothing if `parallelCodeGen` is null.
+    struct UnlockScope
+    {
+        UnlockScope(ParallelCodeGen* parallelCodeGen):
+            m_parallelCodeGen(parallelCodeGen)
+        {
+            if (m_parallelCodeGen)
+            {
+                m_parallelCodeGen->m_mutex.unlock();
+            }
+        }
+        ~UnlockScope()
+        {
+            if (m_parallelCodeGen)
+            {
+                m_parallelCodeGen->m_mutex.lock();
+            }
+        }
+
+        ParallelCodeGen* m_parallelCodeGen;
+    };
+
+        /// Call `func` for each index in [0, count) using up to `threadCount` threads (including the calling thread).
+        /// If `threadCount` is 0, the number of hardware threads is used.
+        /// Each call is made whilst holding the lock, and calls are started in index order.
+        ///
+        /// If a call throws, no more calls are started, and the exception is rethrown on the calling thread
+        /// once all of the threads have finished.
+    void run(Index count, Index threadCount, const std::function<void(Index)>& func);
+
+        /// Get a file system that forwards to `fileSystem`, holding the lock for the duration of each call.
+    ISlangFileSystemExt* getLockingFileSystem(ISlangFileSystemExt* fileSystem);
+
+protected:
+    std::mutex m_mutex;
+    ComPtr<ISlangFileSystemExt> m_lockingFileSystem;
+};
+
+} // namespace Slang
+
+#endif
@@ -32,9 +32,156 @@ void PreprocessorHandler::handleEndOfTranslationUnit(Preprocessor* preprocessor)
     SLANG_UNUSED(preprocessor);
 }
 
-void PreprocessorHandler::handleFileDependency(String const& path)
+void PreprocessorHandler::handleFileDependency(SourceFile* sourceFile)
 {
-    SLANG_UNUSED(path);
+    SLANG_UNUSED(sourceFile);
+}
+
+//
+// PreprocessorTokenCache
+//
+
+static bool _isDirective(const List<Token>& tokens, Index index, const char* name)
+{
+    return tokens[index].type == TokenType::Pound &&
+        (tokens[index].flags & TokenFlag::AtStartOfLine) &&
+        tokens[index + 1].type == TokenType::Identifier &&
+        tokens[index + 1].getContent() == name;
+}
+
+    /// If all of the (non whitespace) `tokens` are within an `#ifndef X` ... `#endif`, returns `X`.
+    ///
+    /// When `X` is defined the preprocessor would skip everything in such a file, because
+    /// conditionals in disabled code are still matched up, but not evaluated.
+static Name* _findIncludeGuardName(const List<Token>& tokens)
+{
+    // The last token is always the end of file
+    const Index count = tokens.getCount();
+    Index index = 0;
+    while (tokens[index].type == TokenType::NewLine)
+    {
+        index++;
+    }
+
+    // Must start with `#ifndef X` on a line of its own
+    if (index + 3 >= count ||
+        !_isDirective(tokens, index, "ifndef") ||
+        tokens[index + 2].type != TokenType::Identifier ||
+        tokens[index + 3].type != TokenType::NewLine)
+    {
+        return nullptr;
+    }
+    Name* name = tokens[index + 2].getName();
+
+    Index depth = 1;
+    for (index += 4; index + 1 < count; ++index)
+    {
+        if (_isDirective(tokens, index, "if") || _isDirective(tokens, index, "ifdef") || _isDirective(tokens, index, "ifndef"))
+        {
+            depth++;
+        }
+        else if (_isDirective(tokens, index, "else") || _isDirective(tokens, index, "elif"))
+        {
+            // Something is included if the guard macro is defined
+            if (depth == 1)
+            {
+                return nullptr;
+            }
+        }
+        else if (_isDirective(tokens, index, "endif") && --depth == 0)
+        {
+            // Anything after the end of the `#endif` line would be included
+            while (tokens[index].type != TokenType::NewLine && tokens[index].type != TokenType::EndOfFile)
+            {
+                index++;
+            }
+            for (; index < count; ++index)
+            {
+                if (tokens[index].type != TokenType::NewLine && tokens[index].type != TokenType::EndOfFile)
+                {
+                    return nullptr;
+                }
+            }
+            return name;
+        }
+    }
+
+    // The `#ifndef` isn't closed
+    return nullptr;
+}
+
+PreprocessorTokenCache::Entry* PreprocessorTokenCache::getEntry(SourceView* sourceView)
+{
+    SourceFile* sourceFile = sourceView->getSourceFile();
+    ISlangBlob* contentBlob = sourceFile->getContentBlob();
+
+    const String identity = sourceFile->getPathInfo().getMostUniqueIdentity();
+    if (!contentBlob || identity.getLength() == 0)
+    {
+        return nullptr;
+    }
+
+    if (RefPtr<Entry>* entryPtr = m_entries.TryGetValue(identity))
+    {
+        Entry* entry = *entryPtr;
+        // The file may have been loaded again (for example by a different compile request), so may be a different blob
+        // with the same contents
+        if (entry->contentBlob == contentBlob ||
+            UnownedStringSlice((const char*)entry->contentBlob->getBufferPointer(), entry->contentBlob->getBufferSize()) == sourceFile->getContent())
+        {
+            if (entry->hasDiagnostics)
+            {
+                return nullptr;
+            }
+            hitCount++;
+            return entry;
+        }
+    }
+
+    RefPtr<Entry> entry = new Entry;
+    entry->contentBlob = contentBlob;
+
+    // Diagnostics are collected on a sink of our own, just to find if there are any
+    DiagnosticSink sink(sourceView->getSourceManager(), nullptr);
+
+    Lexer lexer;
+    lexer.initialize(sourceView, &sink, m_namePool, &entry->arena);
+
+    const SourceLoc startLoc = sourceView->getRange().begin;
+    for (;;)
+    {
+        Token token = lexer.lexToken();
+        switch (token.type)
+        {
+            case TokenType::WhiteSpace:
+            case TokenType::BlockComment:
+            case TokenType::LineComment:
+                continue;
+            default:
+                break;
+        }
+
+        token.loc = SourceLoc::fromRaw(token.loc.getRaw() - startLoc.getRaw());
+        entry->tokens.add(token);
+
+        if (token.type == TokenType::EndOfFile)
+        {
+            break;
+        }
+    }
+
+    if (sink.getErrorCount() || sink.outputBuffer.getLength())
+    {
+        entry->hasDiagnostics = true;
+        entry->tokens = List<Token>();
+    }
+    else
+    {
+        entry->includeGuardName = _findIncludeGuardName(entry->tokens);
+    }
+
+    m_entries[identity] = entry;
+    return entry->hasDiagnostics ? nullptr : entry.Ptr();
 }
 
 // In order to simplify the naming scheme, we will nest the implementaiton of the
@@ -548,6 +695,91 @@ private:
     Token m_lookaheadToken;
 };
 
+// When a file has been lexed before, its tokens can be played back from a `PreprocessorTokenCache`
+// instead. The cached tokens only need their locations (and any references to the file's content)
+// moving to where they are for this source view.
+
+    /// An input stream that plays back the tokens of a source file that were lexed previously
+struct CachedTokenInputStream : InputStream
+{
+    typedef InputStream Super;
+
+    CachedTokenInputStream(
+        Preprocessor*                   preprocessor,
+        SourceView*                     sourceView,
+        PreprocessorTokenCache::Entry*  entry)
+        : Super(preprocessor)
+        , m_entry(entry)
+        , m_startLoc(sourceView->getRange().begin)
+    {
+        ISlangBlob* cachedBlob = entry->contentBlob;
+        m_cachedContent = UnownedStringSlice((const char*)cachedBlob->getBufferPointer(), cachedBlob->getBufferSize());
+        m_content = sourceView->getContent();
+        m_memoryArena = sourceView->getSourceManager()->getMemoryArena();
+
+        m_lookaheadToken = _readTokenImpl();
+    }
+
+    Token readToken() SLANG_OVERRIDE
+    {
+        auto result = m_lookaheadToken;
+        m_lookaheadToken = _readTokenImpl();
+        return result;
+    }
+
+    Token peekToken() SLANG_OVERRIDE
+    {
+        return m_lookaheadToken;
+    }
+
+private:
+        /// Read the next cached token, bypassing lookahead. Keeps returning the end of file token once reached.
+    Token _readTokenImpl()
+    {
+        Token token = m_entry->tokens[m_index];
+        if (token.type != TokenType::EndOfFile)
+        {
+            m_index++;
+        }
+
+        token.loc = m_startLoc + Int(token.loc.getRaw());
+
+        // Tokens should only refer to memory that lives as long as the source view, as when lexed.
+        // So their content is either moved to the source view's content, or, if it needed escaped
+        // newlines removing, copied into the source manager's arena.
+        if ((token.flags & TokenFlag::Name) == 0 && token.charsCount)
+        {
+            const char* chars = token.charsNameUnion.chars;
+            if (chars >= m_cachedContent.begin() && chars < m_cachedContent.end())
+            {
+                token.charsNameUnion.chars = m_content.begin() + (chars - m_cachedContent.begin());
+            }
+            else
+            {
+                char* dst = (char*)m_memoryArena->allocateUnaligned(token.charsCount);
+                ::memcpy(dst, chars, token.charsCount);
+                token.charsNameUnion.chars = dst;
+            }
+        }
+        return token;
+    }
+
+    RefPtr<PreprocessorTokenCache::Entry> m_entry;
+    Index m_index = 0;
+
+        /// The location of the start of the source view
+    SourceLoc m_startLoc;
+
+        /// The content the tokens were lexed from, and the (identical) content of the source view
+    UnownedStringSlice m_cachedContent;
+    UnownedStringSlice m_content;
+
+    MemoryArena* m_memoryArena;
+
+        /// One token of lookahead
+    Token m_lookaheadToken;
+};
+
 // The remaining input stream cases deal with macro expansion, so it is
 // probalby a good idea to discuss how macros are represented by the
 // preprocessor as a first step.
@@ -909,9 +1141,11 @@ private:
     ///
 struct InputFile
 {
+        /// If `cachedTokens` is set the tokens are played back from it, otherwise the source is lexed
     InputFile(
-        Preprocessor*   preprocessor,
-        SourceView*     sourceView);
+        Preprocessor*                   preprocessor,
+        SourceView*                     sourceView,
+        PreprocessorTokenCache::Entry*  cachedTokens);
 
     ~InputFile();
 
@@ -943,7 +1177,10 @@ struct InputFile
         return m_expansionStream->readToken();
     }
 
-    Lexer* getLexer() { return m_lexerStream->getLexer(); }
+        /// Get the lexer, or null if the tokens are being played back from a cache
+    Lexer* getLexer() { return m_lexerStream ? m_lexerStream->getLexer() : nullptr; }
+
+    SourceView* getSourceView() { return m_sourceView; }
 
     ExpansionInputStream* getExpansionStream() { return m_expansionStream; }
 
@@ -965,10 +1202,13 @@ private:
         /// The inner-most preprocessor conditional active for this file.
     Conditional*        m_conditional = nullptr;
 
-        /// The lexer input stream that unexpanded tokens will be read from
-    LexerInputStream* m_lexerStream;
+        /// The source view of the file
+    SourceView* m_sourceView = nullptr;
 
-        /// An input stream that applies macro expansion to `m_lexerStream`
+        /// The lexer input stream that unexpanded tokens will be read from (null if they come from a cache)
+    LexerInputStream* m_lexerStream = nullptr;
+
+        /// An input stream that applies macro expansion to the unexpanded tokens
     ExpansionInputStream* m_expansionStream;
 };
 
@@ -1006,6 +1246,9 @@ struct Preprocessor
         /// Name pool to use when creating `Name`s from strings
     NamePool*                               namePool = nullptr;
 
+        /// Cache of the tokens lexed from source files
+    RefPtr<PreprocessorTokenCache>          tokenCache;
+
         /// File system to use when looking up files
     ISlangFileSystemExt*                    fileSystem = nullptr;
 
@@ -1102,13 +1345,24 @@ LexerInputStream::LexerInputStream(
 }
 
 InputFile::InputFile(
-    Preprocessor*   preprocessor,
-    SourceView*     sourceView)
+    Preprocessor*                   preprocessor,
+    SourceView*                     sourceView,
+    PreprocessorTokenCache::Entry*  cachedTokens)
 {
     m_preprocessor = preprocessor;
+    m_sourceView = sourceView;
 
-    m_lexerStream = new LexerInputStream(preprocessor, sourceView);
-    m_expansionStream = new ExpansionInputStream(preprocessor, m_lexerStream);
+    InputStream* baseStream;
+    if (cachedTokens)
+    {
+        baseStream = new CachedTokenInputStream(preprocessor, sourceView, cachedTokens);
+    }
+    else
+    {
+        m_lexerStream = new LexerInputStream(preprocessor, sourceView);
+        baseStream = m_lexerStream;
+    }
+    m_expansionStream = new ExpansionInputStream(preprocessor, baseStream);
 }
 
 InputFile::~InputFile()
@@ -1125,7 +1379,7 @@ InputFile::~InputFile()
         delete conditional;
     }
 
-    // Note: We only delete the expansion strema here because the lexer
+    // Note: We only delete the expansion strema here because the lexer (or cached token)
     // stream is being used as the "base" stream of the expansion stream,
     // and the expansion stream takes responsibility for deleting it.
     //
@@ -2437,13 +2691,20 @@ static void _setLexerDiagnosticSuppression(
     InputFile*  inputFile,
     bool        shouldSuppressDiagnostics)
 {
+    // Tokens played back from the cache were lexed without diagnostics
+    Lexer* lexer = inputFile->getLexer();
+    if (!lexer)
+    {
+        return;
+    }
+
     if(shouldSuppressDiagnostics)
     {
-        inputFile->getLexer()->m_lexerFlags |= kLexerFlag_SuppressDiagnostics;
+        lexer->m_lexerFlags |= kLexerFlag_SuppressDiagnostics;
     }
     else
     {
-        inputFile->getLexer()->m_lexerFlags &= ~kLexerFlag_SuppressDiagnostics;
+        lexer->m_lexerFlags &= ~kLexerFlag_SuppressDiagnostics;
     }
 }
 
@@ -2964,18 +3225,7 @@ static SlangResult readFile(
     // associated with the parent linkage.
     //
     auto fileSystemExt = context->m_preprocessor->fileSystem;
-    SLANG_RETURN_ON_FAIL(fileSystemExt->loadFile(path.getBuffer(), outBlob));
-
-    // If we are running the preprocessor as part of compiling a
-    // specific module, then we must keep track of the file we've
-    // read as yet another file that the module will depend on.
-    //
-    if( auto handler = context->m_preprocessor->handler )
-    {
-        handler->handleFileDependency(path);
-    }
-
-    return SLANG_OK;
+    return fileSystemExt->loadFile(path.getBuffer(), outBlob);
 }
 
 void Preprocessor::pushInputFile(InputFile* inputFile)
@@ -3060,10 +3310,32 @@ static void HandleIncludeDirective(PreprocessorDirectiveContext* context)
         sourceManager->addSourceFile(filePathInfo.uniqueIdentity, sourceFile);
     }
 
+    // If we are running the preprocessor as part of compiling a
+    // specific module, then we must keep track of the file we've
+    // included as yet another file that the module will depend on.
+    //
+    // This is done even if the file was loaded previously, since the
+    // module depends on its contents all the same.
+    //
+    if( auto handler = context->m_preprocessor->handler )
+    {
+        handler->handleFileDependency(sourceFile);
+    }
+
     // This is a new parse (even if it's a pre-existing source file), so create a new SourceView
     SourceView* sourceView = sourceManager->createSourceView(sourceFile, &filePathInfo, directiveLoc);
 
-    InputFile* inputFile = new InputFile(context->m_preprocessor, sourceView);
+    PreprocessorTokenCache::Entry* cachedTokens = context->m_preprocessor->tokenCache->getEntry(sourceView);
+
+    // If all of the file is inside an include guard whose macro is defined, including it would produce nothing
+    if (cachedTokens && cachedTokens->includeGuardName &&
+        LookupMacro(&context->m_preprocessor->globalEnv, cachedTokens->includeGuardName))
+    {
+        context->m_preprocessor->tokenCache->skippedIncludeCount++;
+        return;
+    }
+
+    InputFile* inputFile = new InputFile(context->m_preprocessor, sourceView, cachedTokens);
 
     context->m_preprocessor->pushInputFile(inputFile);
 }
@@ -3460,7 +3732,7 @@ static void _handleDefaultLineDirective(PreprocessorDirectiveContext* context)
 {
     SourceLoc directiveLoc = GetDirectiveLoc(context);
     auto inputStream = getInputFile(context);
-    auto sourceView = inputStream->getLexer()->m_sourceView;
+    auto sourceView = inputStream->getSourceView();
     sourceView->addDefaultLineDirective(directiveLoc);
 }
 
@@ -3532,7 +3804,7 @@ static void HandleLineDirective(PreprocessorDirectiveContext* context)
         return;
     }
 
-    auto sourceView = inputStream->getLexer()->m_sourceView;
+    auto sourceView = inputStream->getSourceView();
     sourceView->addLineDirective(directiveLoc, file, line);
 }
 
@@ -4003,6 +4275,7 @@ TokenList preprocessSource(
     desc.fileSystem     = linkage->getFileSystemExt();
     desc.namePool       = linkage->getNamePool();
     desc.sourceManager  = linkage->getSourceManager();
+    desc.tokenCache     = linkage->getPreprocessorTokenCache();
 
     if (linkage->isInLanguageServer())
     {
@@ -4024,6 +4297,9 @@ TokenList preprocessSource(
     preprocessor.fileSystem = desc.fileSystem;
     preprocessor.namePool = desc.namePool;
 
+    SLANG_ASSERT(!desc.tokenCache || desc.tokenCache->getNamePool() == desc.namePool);
+    preprocessor.tokenCache = desc.tokenCache ? desc.tokenCache : new PreprocessorTokenCache(desc.namePool);
+
     preprocessor.endOfFileToken.type = TokenType::EndOfFile;
     preprocessor.endOfFileToken.flags = TokenFlag::AtStartOfLine;
     preprocessor.contentAssistInfo = desc.contentAssistInfo;
@@ -4071,7 +4347,7 @@ TokenList preprocessSource(
         SourceView* sourceView = sourceManager->createSourceView(file, nullptr, SourceLoc::fromRaw(0));
 
         // create an initial input stream based on the provided buffer
-        InputFile* primaryInputFile = new InputFile(&preprocessor, sourceView);
+        InputFile* primaryInputFile = new InputFile(&preprocessor, sourceView, preprocessor.tokenCache->getEntry(sourceView));
         preprocessor.pushInputFile(primaryInputFile);
     }
 
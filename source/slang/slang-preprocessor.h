@@ -3,6 +3,8 @@
 #define SLANG_PREPROCESSOR_H_INCLUDED
 
 #include "../core/slang-basic.h"
+#include "../core/slang-memory-arena.h"
+#include "../../slang-com-ptr.h"
 
 #include "../compiler-core/slang-lexer.h"
 #include "../compiler-core/slang-include-system.h"
@@ -28,7 +30,57 @@ using preprocessor::Preprocessor;
 struct PreprocessorHandler
 {
     virtual void handleEndOfTranslationUnit(Preprocessor* preprocessor);
-    virtual void handleFileDependency(String const& path);
+    virtual void handleFileDependency(SourceFile* sourceFile);
+};
+
+    /// A cache of the tokens lexed from source files.
+    ///
+    /// A file that is preprocessed many times (such as a header that is included by many translation
+    /// units, or by many compile requests on the same `Linkage`) then only needs to be lexed once.
+    ///
+    /// The tokens hold `Name`s, so a cache must only be used with the `NamePool` it was created with.
+class PreprocessorTokenCache : public RefObject
+{
+public:
+        /// The tokens lexed from the contents of a source file
+    class Entry : public RefObject
+    {
+    public:
+            /// The tokens, excluding whitespace and comments, ending with an end of file token.
+            /// Locations are offsets from the start of the file. The content of any token that
+            /// isn't a name is within `contentBlob` or `arena`.
+        List<Token> tokens;
+            /// If all of the file is within an include guard (`#ifndef X` ... `#endif`) the name `X`, else null
+        Name* includeGuardName = nullptr;
+            /// If lexing produced diagnostics, the tokens aren't held, because the lexer needs to run
+            /// to report them (and whether they are reported depends on preprocessor conditionals)
+        bool hasDiagnostics = false;
+            /// The content that the tokens were lexed from
+        ComPtr<ISlangBlob> contentBlob;
+            /// Holds the content of tokens that needed escaped newlines removing
+        MemoryArena arena;
+
+        Entry() : arena(1024) {}
+    };
+
+        /// Get the tokens of the file viewed by `sourceView`, lexing it if needed.
+        /// Returns null if the tokens can't be cached.
+    Entry* getEntry(SourceView* sourceView);
+
+    NamePool* getNamePool() const { return m_namePool; }
+
+    PreprocessorTokenCache(NamePool* namePool) : m_namePool(namePool) {}
+
+        /// The number of times the tokens of a file were found in the cache, rather than lexed
+    Index hitCount = 0;
+        /// The number of `#include`s that were skipped, as the file's include guard macro was defined
+    Index skippedIncludeCount = 0;
+
+protected:
+        /// Entries keyed by the source file's most unique identity. There is at most one entry for an
+        /// identity, which is replaced if the contents change.
+    Dictionary<String, RefPtr<Entry>> m_entries;
+    NamePool* m_namePool;
 };
 
     /// Description of a preprocessor options/dependencies
@@ -57,6 +109,10 @@ struct PreprocessorDesc
 
         /// Optional: additional information for code assist.
     PreprocessorContentAssistInfo* contentAssistInfo = nullptr;
+
+        /// Optional: cache of lexed tokens, which must use the same `namePool`. If not set tokens are only
+        /// cached for the duration of preprocessing.
+    PreprocessorTokenCache* tokenCache = nullptr;
 };
 
     /// Take a source `file` and preprocess it into a list of tokens.
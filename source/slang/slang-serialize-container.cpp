@@ -9,6 +9,7 @@
 #include "slang-compiler.h"
 #include "slang-serialize-ast.h"
 #include "slang-serialize-ir.h"
+#include "slang-ir-frozen.h"
 #include "slang-serialize-source-loc.h"
 #include "slang-serialize-factory.h"
 
@@ -79,6 +80,12 @@ namespace Slang {
             // IR module
             dstModule.irModule = module->getIRModule();
             SLANG_ASSERT(dstModule.irModule);
+
+            // All of the IR of a frozen module is needed to write it
+            if (auto frozenModule = dstModule.irModule->getFrozenModule())
+            {
+                frozenModule->thawAll();
+            }
         }
 
         outData.modules.add(dstModule);
@@ -354,15 +361,17 @@ static List<ExtensionDecl*>& _getCandidateExtensionList(
             NodeBase* astRootNode = nullptr;
             RefPtr<IRModule> irModule;
 
+            RefPtr<IRSerialContainerModuleReader> irModuleReader;
+
             if (auto irChunk = as<RiffContainer::ListChunk>(chunk, IRSerialBinary::kIRModuleFourCc))
             {
-                IRSerialData serialData;
+                irModuleReader = new IRSerialContainerModuleReader(irChunk, containerCompressionType, options.session, sourceLocReader, options.lazyIRContainerScope, options.freezeIRModules);
 
-                SLANG_RETURN_ON_FAIL(IRSerialReader::readContainer(irChunk, containerCompressionType, &serialData));
-
-                // Read IR back from serialData
-                IRSerialReader reader;
-                SLANG_RETURN_ON_FAIL(reader.read(serialData, options.session, sourceLocReader, irModule));
+                if (!options.lazyIRContainerScope)
+                {
+                    SLANG_RETURN_ON_FAIL(irModuleReader->read(irModule));
+                    irModuleReader.setNull();
+                }
 
                 // Onto next chunk
                 chunk = chunk->m_next;
@@ -576,13 +585,14 @@ static List<ExtensionDecl*>& _getCandidateExtensionList(
                 chunk = chunk->m_next;
             }
 
-            if (astBuilder || irModule)
+            if (astBuilder || irModule || irModuleReader)
             {
                 SerialContainerData::Module module;
 
                 module.astBuilder = astBuilder;
                 module.astRootNode = astRootNode;
                 module.irModule = irModule;
+                module.irModuleReader = irModuleReader;
 
                 out.modules.add(module);
             }
@@ -51,6 +51,7 @@ struct SerialContainerData
     struct Module
     {
         RefPtr<IRModule> irModule;              ///< The IR for the module
+        RefPtr<IRSerialContainerModuleReader> irModuleReader;   ///< If set, the IR has not been read yet, and can be read with this
         RefPtr<ASTBuilder> astBuilder;          ///< The astBuilder that owns the astRootNode
         NodeBase* astRootNode = nullptr;        ///< The module decl
     };
@@ -92,6 +93,13 @@ struct SerialContainerUtil
         ASTBuilder* astBuilder = nullptr; // Optional. If not provided will create one in SerialContainerData.
         Linkage* linkage = nullptr;
         DiagnosticSink* sink = nullptr;
+            /// If set, IR modules are not read, and instead each module gets an `irModuleReader` to read it with later.
+            /// This object must keep the container (and any data its payloads reference) in scope, and will be
+            /// held until all of the IR modules have been read.
+        RefObject* lazyIRContainerScope = nullptr;
+            /// If set, IR modules are read as frozen (see `IRFrozenModule`), so only the instructions linking uses
+            /// are ever materialized. Such a module must only be linked against, and not modified.
+        bool freezeIRModules = false;
     };
 
         /// Add module to outData
@@ -252,6 +252,24 @@ SLANG_FORCE_INLINE int IRSerialData::getOperands(const Inst& inst, const InstInd
     }
 }
 
+/* Reads the IR module held in a container chunk, possibly some time after the container itself was read
+(see SerialContainerUtil::ReadOptions::lazyIRContainerScope) */
+class IRSerialContainerModuleReader : public RefObject
+{
+public:
+        /// Read the IR module
+    SlangResult read(RefPtr<IRModule>& outModule);
+
+    IRSerialContainerModuleReader(RiffContainer::ListChunk* irChunk, SerialCompressionType compressionType, Session* session, SerialSourceLocReader* sourceLocReader, RefObject* containerScope, bool freeze);
+
+protected:
+    RiffContainer::ListChunk* m_irChunk;                ///< The chunk holding the IR module
+    SerialCompressionType m_compressionType;
+    Session* m_session;
+    RefPtr<SerialSourceLocReader> m_sourceLocReader;
+    RefPtr<RefObject> m_containerScope;                 ///< Keeps the container (and anything it references) in scope
+    bool m_freeze;                                      ///< If set the module is read as frozen (see IRFrozenModule)
+};
 
 } // namespace Slang
 
@@ -5,6 +5,7 @@
 #include "../core/slang-byte-encode-util.h"
 
 #include "slang-ir-insts.h"
+#include "slang-ir-frozen.h"
 
 #include "../core/slang-math.h"
 
@@ -616,6 +617,31 @@ static Result _readInstArrayChunk(SerialCompressionType containerCompressionType
     return SLANG_OK;
 }
 
+IRSerialContainerModuleReader::IRSerialContainerModuleReader(RiffContainer::ListChunk* irChunk, SerialCompressionType compressionType, Session* session, SerialSourceLocReader* sourceLocReader, RefObject* containerScope, bool freeze):
+    m_irChunk(irChunk),
+    m_compressionType(compressionType),
+    m_session(session),
+    m_sourceLocReader(sourceLocReader),
+    m_containerScope(containerScope),
+    m_freeze(freeze)
+{
+}
+
+SlangResult IRSerialContainerModuleReader::read(RefPtr<IRModule>& outModule)
+{
+    IRSerialData serialData;
+    SLANG_RETURN_ON_FAIL(IRSerialReader::readContainer(m_irChunk, m_compressionType, &serialData));
+
+    if (m_freeze)
+    {
+        return IRFrozenModule::createModule(serialData, m_session, m_sourceLocReader, outModule);
+    }
+
+    // Read IR back from serialData
+    IRSerialReader reader;
+    return reader.read(serialData, m_session, m_sourceLocReader, outModule);
+}
+
 /* static */Result IRSerialReader::readContainer(RiffContainer::ListChunk* module, SerialCompressionType containerCompressionType, IRSerialData* outData)
 {
     typedef IRSerialBinary Bin;
@@ -676,6 +702,68 @@ static Result _readInstArrayChunk(SerialCompressionType containerCompressionType
     return SLANG_OK;
 }
 
+/* static */void IRSerialReader::calcSourceLocs(const IRSerialData& data, SerialSourceLocReader* sourceLocReader, List<SourceLoc>& outSourceLocs)
+{
+    outSourceLocs.clear();
+
+    const Index numInsts = data.m_insts.getCount();
+    const bool hasRuns = sourceLocReader && data.m_debugSourceLocRuns.getCount();
+
+    if (data.m_rawSourceLocs.getCount() == numInsts)
+    {
+        outSourceLocs.setCount(numInsts);
+
+        const Ser::RawSourceLoc* srcLocs = data.m_rawSourceLocs.begin();
+        for (Index i = 0; i < numInsts; ++i)
+        {
+            outSourceLocs[i].setRaw(Slang::SourceLoc::RawValue(srcLocs[i]));
+        }
+    }
+    else if (hasRuns)
+    {
+        outSourceLocs.setCount(numInsts);
+    }
+
+    // We now need to apply the runs
+    if (hasRuns)
+    {
+        List<IRSerialData::SourceLocRun> sourceRuns(data.m_debugSourceLocRuns);
+        // They are now in source location order
+        sourceRuns.sort();
+
+        // Just guess initially 0 for the source file that contains the initial run
+        SerialSourceLocData::SourceRange range = SerialSourceLocData::SourceRange::getInvalid();
+        int fix = 0;
+        
+        const Index numRuns = sourceRuns.getCount();
+        for (Index i = 0; i < numRuns; ++i)
+        {
+            const auto& run = sourceRuns[i];
+
+            // Work out the fixed source location
+            SourceLoc sourceLoc;
+            if (run.m_sourceLoc)
+            {
+                if (!range.contains(run.m_sourceLoc))
+                {
+                    fix = sourceLocReader->calcFixSourceLoc(run.m_sourceLoc, range);
+                }
+                sourceLoc = sourceLocReader->calcFixedLoc(run.m_sourceLoc, fix, range);
+            }
+
+            // Write to all the instructions
+            SLANG_ASSERT(Index(uint32_t(run.m_startInstIndex) + run.m_numInst) <= numInsts);
+            SourceLoc* dstLocs = outSourceLocs.getBuffer() + int(run.m_startInstIndex);
+
+            const int runSize = int(run.m_numInst);
+            for (int j = 0; j < runSize; ++j)
+            {
+                dstLocs[j] = sourceLoc;
+            }
+        }
+    }
+}
+
 Result IRSerialReader::read(const IRSerialData& data, Session* session, SerialSourceLocReader* sourceLocReader, RefPtr<IRModule>& outModule)
 {
     typedef Ser::Inst::PayloadType PayloadType;
@@ -912,53 +1000,13 @@ Result IRSerialReader::read(const IRSerialData& data, Session* session, SerialSo
     }
 
     // Re-add source locations, if they are defined
-    if (m_serialData->m_rawSourceLocs.getCount() == numInsts)
+    List<SourceLoc> sourceLocs;
+    calcSourceLocs(data, sourceLocReader, sourceLocs);
+    if (sourceLocs.getCount())
     {
-        const Ser::RawSourceLoc* srcLocs = m_serialData->m_rawSourceLocs.begin();
         for (Index i = 1; i < numInsts; ++i)
         {
-            IRInst* dstInst = insts[i];
-            
-            dstInst->sourceLoc.setRaw(Slang::SourceLoc::RawValue(srcLocs[i]));
-        }
-    }
-
-    // We now need to apply the runs
-    if (sourceLocReader && m_serialData->m_debugSourceLocRuns.getCount())
-    {
-        List<IRSerialData::SourceLocRun> sourceRuns(m_serialData->m_debugSourceLocRuns);
-        // They are now in source location order
-        sourceRuns.sort();
-
-        // Just guess initially 0 for the source file that contains the initial run
-        SerialSourceLocData::SourceRange range = SerialSourceLocData::SourceRange::getInvalid();
-        int fix = 0;
-        
-        const Index numRuns = sourceRuns.getCount();
-        for (Index i = 0; i < numRuns; ++i)
-        {
-            const auto& run = sourceRuns[i];
-
-            // Work out the fixed source location
-            SourceLoc sourceLoc;
-            if (run.m_sourceLoc)
-            {
-                if (!range.contains(run.m_sourceLoc))
-                {
-                    fix = sourceLocReader->calcFixSourceLoc(run.m_sourceLoc, range);
-                }
-                sourceLoc = sourceLocReader->calcFixedLoc(run.m_sourceLoc, fix, range);
-            }
-
-            // Write to all the instructions
-            SLANG_ASSERT(Index(uint32_t(run.m_startInstIndex) + run.m_numInst) <= insts.getCount());
-            IRInst** dstInsts = insts.getBuffer() + int(run.m_startInstIndex);
-
-            const int runSize = int(run.m_numInst);
-            for (int j = 0; j < runSize; ++j)
-            {
-                dstInsts[j]->sourceLoc = sourceLoc;
-            }
+            insts[i]->sourceLoc = sourceLocs[i];
         }
     }
 
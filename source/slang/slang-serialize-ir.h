@@ -74,6 +74,9 @@ struct IRSerialReader
         /// Read a module from serial data
     Result read(const IRSerialData& data, Session* session, SerialSourceLocReader* sourceLocReader, RefPtr<IRModule>& outModule);
 
+        /// Calculate the source location of each instruction in `data`. outSourceLocs is left empty if there are none.
+    static void calcSourceLocs(const IRSerialData& data, SerialSourceLocReader* sourceLocReader, List<SourceLoc>& outSourceLocs);
+
     IRSerialReader():
         m_serialData(nullptr),
         m_module(nullptr),
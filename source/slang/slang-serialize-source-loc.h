@@ -218,7 +218,7 @@ public:
     SourceManager* m_sourceManager;
     StringSlicePool m_stringSlicePool;             ///< Slices held just for debug usage
     SourceLoc::RawValue m_freeSourceLoc;           ///< Locations greater than this are free
-    Dictionary<SourceFile*, RefPtr<Source> > m_sourceFileMap;
+    OrderedDictionary<SourceFile*, RefPtr<Source> > m_sourceFileMap;  ///< Ordered so the source infos are written in a deterministic order
 };
 
 } // namespace Slang
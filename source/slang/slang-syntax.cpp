@@ -257,6 +257,10 @@ Index getFilterCountImpl(const ReflectClassInfo& clsInfo, MemberFilterStyle filt
         SubtypeWitness* subtypeWitness,
         Decl*           requirementKey)
     {
+        // Witness tables are filled in whilst checking, so a substitution that depends on this
+        // lookup can't be memoized (see `Val::substitute`).
+        astBuilder->m_witnessLookupCount++;
+
         if(auto declaredSubtypeWitness = as<DeclaredSubtypeWitness>(subtypeWitness))
         {
             if(auto inheritanceDeclRef = declaredSubtypeWitness->declRef.as<InheritanceDecl>())
@@ -442,7 +446,11 @@ Index getFilterCountImpl(const ReflectClassInfo& clsInfo, MemberFilterStyle filt
 
         if (auto builtinMod = declRef.getDecl()->findModifier<BuiltinTypeModifier>())
         {
-            auto type = astBuilder->create<BasicExpressionType>(builtinMod->tag);
+            ASTBuilder::NodeDesc desc;
+            desc.type = BasicExpressionType::kType;
+            desc.operands.add(declRef.decl);
+            desc.operands.add(declRef.substitutions.substitutions);
+            auto type = (BasicExpressionType*)astBuilder->_getOrCreateImpl(desc, [&]() { return astBuilder->create<BasicExpressionType>(builtinMod->tag); });
             type->declRef = declRef;
             return type;
         }
@@ -495,9 +503,17 @@ Index getFilterCountImpl(const ReflectClassInfo& clsInfo, MemberFilterStyle filt
             else if (magicMod->magicName == "TextureSampler")
             {
                 SLANG_ASSERT(subst && subst->getArgs().getCount() >= 1);
-                auto textureType = astBuilder->create<TextureSamplerType>(
-                    TextureFlavor(magicMod->tag),
-                    ExtractGenericArgType(subst->getArgs()[0]));
+                // Keyed on the decl-ref, as the flavor and element type don't include all of the generic arguments
+                ASTBuilder::NodeDesc desc;
+                desc.type = TextureSamplerType::kType;
+                desc.operands.add(declRef.decl);
+                desc.operands.add(declRef.substitutions.substitutions);
+                auto textureType = (TextureSamplerType*)astBuilder->_getOrCreateImpl(desc, [&]()
+                    {
+                        return astBuilder->create<TextureSamplerType>(
+                            TextureFlavor(magicMod->tag),
+                            ExtractGenericArgType(subst->getArgs()[0]));
+                    });
                 textureType->declRef = declRef;
                 return textureType;
             }
@@ -592,7 +608,11 @@ Index getFilterCountImpl(const ReflectClassInfo& clsInfo, MemberFilterStyle filt
                     SLANG_UNEXPECTED("unhandled type");
                 }
 
-                NodeBase* type = classInfo.createInstance(astBuilder);
+                ASTBuilder::NodeDesc desc;
+                desc.type = ASTNodeType(classInfo.classInfo->m_classId);
+                desc.operands.add(declRef.decl);
+                desc.operands.add(declRef.substitutions.substitutions);
+                NodeBase* type = astBuilder->_getOrCreateImpl(desc, [&]() { return classInfo.createInstance(astBuilder); });
                 if (!type)
                 {
                     SLANG_UNEXPECTED("constructor failure");
@@ -1032,19 +1052,14 @@ Index getFilterCountImpl(const ReflectClassInfo& clsInfo, MemberFilterStyle filt
         Type* elementType,
         IntVal*         elementCount)
     {
-        auto arrayType = astBuilder->create<ArrayExpressionType>();
-        arrayType->baseType = elementType;
-        arrayType->arrayLength = elementCount;
-        return arrayType;
+        return astBuilder->getArrayType(elementType, elementCount);
     }
 
     ArrayExpressionType* getArrayType(
         ASTBuilder* astBuilder,
         Type* elementType)
     {
-        auto arrayType = astBuilder->create<ArrayExpressionType>();
-        arrayType->baseType = elementType;
-        return arrayType;
+        return astBuilder->getArrayType(elementType, nullptr);
     }
 
     NamedExpressionType* getNamedType(
@@ -1061,10 +1076,7 @@ Index getFilterCountImpl(const ReflectClassInfo& clsInfo, MemberFilterStyle filt
         ASTBuilder*                     astBuilder,
         DeclRef<CallableDecl> const&    declRef)
     {
-        FuncType* funcType = astBuilder->create<FuncType>();
-
-        funcType->resultType = getResultType(astBuilder, declRef);
-        funcType->errorType = getErrorCodeType(astBuilder, declRef);
+        List<Type*> paramTypes;
         for (auto paramDeclRef : getParameters(declRef))
         {
             auto paramDecl = paramDeclRef.getDecl();
@@ -1084,10 +1096,13 @@ Index getFilterCountImpl(const ReflectClassInfo& clsInfo, MemberFilterStyle filt
                     paramType = astBuilder->getOutType(paramType);
                 }
             }
-            funcType->paramTypes.add(paramType);
+            paramTypes.add(paramType);
         }
 
-        return funcType;
+        return astBuilder->getFuncType(
+            paramTypes.getArrayView(),
+            getResultType(astBuilder, declRef),
+            getErrorCodeType(astBuilder, declRef));
     }
 
     GenericDeclRefType* getGenericDeclRefType(
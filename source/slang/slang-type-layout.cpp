@@ -2725,10 +2725,21 @@ static TypeLayoutResult _createTypeLayout(
     return _createTypeLayout(subContext, type);
 }
 
+    /// Note that the layout being computed for `context` depends on its program layout
+static void _noteProgramLayoutUse(TypeLayoutContext const& context)
+{
+    if (context.targetReq)
+    {
+        context.targetReq->getTypeLayoutCache()->m_programLayoutUseCount++;
+    }
+}
+
 Type* findGlobalGenericSpecializationArg(
     TypeLayoutContext const&    context,
     GlobalGenericParamDecl*     decl)
 {
+    _noteProgramLayoutUse(context);
+
     Val* arg = nullptr;
     context.programLayout->globalGenericArgs.TryGetValue(decl, arg);
     return as<Type>(arg);
@@ -3217,6 +3228,8 @@ static TypeLayoutResult _createTypeLayoutForGlobalGenericTypeParam(
     info.size = 0;
     info.kind = LayoutResourceKind::GenericResource;
 
+    _noteProgramLayoutUse(context);
+
     RefPtr<GenericParamTypeLayout> typeLayout = new GenericParamTypeLayout();
     // we should have already populated ProgramLayout::genericEntryPointParams list at this point,
     // so we can find the index of this generic param decl in the list
@@ -3238,7 +3251,8 @@ RefPtr<TypeLayout> createTypeLayoutForGlobalGenericTypeParam(
     return _createTypeLayoutForGlobalGenericTypeParam(context, type, globalGenericParamDecl).layout;
 }
 
-static TypeLayoutResult _createTypeLayout(
+    /// Create layout information for `type`, without consulting the `TypeLayoutCache`
+static TypeLayoutResult _createTypeLayoutImpl(
     TypeLayoutContext const&    context,
     Type*                       type)
 {
@@ -4312,6 +4326,60 @@ RefPtr<TypeLayout> getSimpleVaryingParameterTypeLayout(
         rules).layout;
 }
 
+static TypeLayoutResult _createTypeLayout(
+    TypeLayoutContext const&    context,
+    Type*                       type)
+{
+    // The specialization arguments are only known by address, so a layout that
+    // is given any can't be memoized.
+    //
+    if (context.specializationArgCount != 0 || !context.targetReq)
+    {
+        return _createTypeLayoutImpl(context, type);
+    }
+
+    auto targetCache = context.targetReq->getTypeLayoutCache();
+
+    TypeLayoutCache::Key key = { type, context.rules, context.matrixLayoutMode };
+    if (auto memoized = targetCache->tryGetLayout(key))
+    {
+        return *memoized;
+    }
+
+    TypeLayoutCache* programCache = nullptr;
+    if (auto programLayout = context.programLayout)
+    {
+        if (!programLayout->typeLayoutCache)
+        {
+            programLayout->typeLayoutCache = new TypeLayoutCache();
+        }
+        programCache = programLayout->typeLayoutCache;
+
+        if (auto memoized = programCache->tryGetLayout(key))
+        {
+            // Anything containing this layout also depends on the program layout
+            targetCache->m_programLayoutUseCount++;
+            return *memoized;
+        }
+    }
+
+    const Index programLayoutUseCount = targetCache->m_programLayoutUseCount;
+    TypeLayoutResult result = _createTypeLayoutImpl(context, type);
+
+    // A layout that didn't depend on the program layout is shared with reflection,
+    // and with other programs for the same target.
+    //
+    if (targetCache->m_programLayoutUseCount == programLayoutUseCount)
+    {
+        targetCache->addLayout(key, result);
+    }
+    else if (programCache)
+    {
+        programCache->addLayout(key, result);
+    }
+    return result;
+}
+
 RefPtr<TypeLayout> createTypeLayout(
     TypeLayoutContext const&    context,
     Type*                       type)
@@ -862,6 +862,10 @@ public:
         ///
     List<RefPtr<TypeLayout>> taggedUnionTypeLayouts;
 
+        /// Memoized layouts of types that involve global generic parameters, and so depend on this
+        /// program (layouts that don't are memoized for the target, see `TypeLayoutCache`).
+    RefPtr<TypeLayoutCache> typeLayoutCache;
+
         /// Holds all of the string literals that have been hashed
     StringSlicePool hashedStringLiteralPool;
 };
@@ -1112,6 +1116,48 @@ struct TypeLayoutResult
     {}
 };
 
+    /// Type layouts computed for a target, shared between every layout that contains them.
+    ///
+    /// The layout of a type depends on the layout rules and matrix layout mode it is laid
+    /// out with, and on the program layout only if it involves a global generic type parameter.
+    /// Layouts computed without specialization arguments are memoized (by the target, or by the
+    /// program layout if they depend on it), so a struct used in many places (as a field, array
+    /// element, buffer element or parameter) is laid out once.
+    ///
+    /// A memoized `TypeLayout` can be referenced by many other layouts, and must not be modified.
+class TypeLayoutCache : public RefObject
+{
+public:
+    struct Key
+    {
+        Type*               type;
+        LayoutRulesImpl*    rules;
+        MatrixLayoutMode    matrixLayoutMode;
+
+        bool operator==(Key const& that) const
+        {
+            return type == that.type && rules == that.rules && matrixLayoutMode == that.matrixLayoutMode;
+        }
+        HashCode getHashCode() const
+        {
+            return combineHash(Slang::getHashCode(type), Slang::getHashCode(rules), Slang::getHashCode(Int(matrixLayoutMode)));
+        }
+    };
+
+        /// Get the memoized layout for `key`, or nullptr if there isn't one.
+    TypeLayoutResult* tryGetLayout(Key const& key) { return m_layouts.TryGetValue(key); }
+
+        /// Memoize `result` as the layout for `key`
+    void addLayout(Key const& key, TypeLayoutResult const& result) { m_layouts[key] = result; }
+
+        /// Incremented whenever a layout uses the program layout (to find a global generic argument
+        /// or parameter), so a layout that didn't use it can be memoized for the target.
+    Index m_programLayoutUseCount = 0;
+
+protected:
+    Dictionary<Key, TypeLayoutResult> m_layouts;
+};
+
     /// Helper type for building `struct` type layouts
 struct StructTypeLayoutBuilder
 {
@@ -184,7 +184,12 @@ void Workspace::init(List<URI> rootDirURI, slang::IGlobalSession* globalSession)
     slangGlobalSession = globalSession;
 }
 
-void Workspace::invalidate() { currentVersion = nullptr; }
+void Workspace::invalidate()
+{
+    if (currentVersion)
+        previousVersion = currentVersion;
+    currentVersion = nullptr;
+}
 
 void WorkspaceVersion::parseDiagnostics(String compilerOutput)
 {
@@ -274,23 +279,24 @@ void WorkspaceVersion::parseDiagnostics(String compilerOutput)
     }
 }
 
-RefPtr<WorkspaceVersion> Workspace::createWorkspaceVersion()
+// The number of versions that can reuse the same linkage before a new one is created. Each reuse
+// leaves behind the source and modules it replaces, so the linkage is recreated from time to time
+// to bound how much is held.
+static const Index kMaxLinkageReuseCount = 64;
+
+RefPtr<WorkspaceVersion> Workspace::createWorkspaceVersion(
+    WorkspaceVersion* reuseVersion, ContentAssistCheckingMode checkingMode)
 {
     RefPtr<WorkspaceVersion> version = new WorkspaceVersion();
     version->workspace = this;
-    slang::SessionDesc desc = {};
-    desc.fileSystem = this;
-    desc.targetCount = 1;
-    slang::TargetDesc targetDesc = {};
-    targetDesc.profile = slangGlobalSession->findProfile("sm_6_6");
-    desc.targets = &targetDesc;
-    List<const char*> searchPathsRaw;
+
+    List<String> searchPaths;
     for (auto& path : additionalSearchPaths)
-        searchPathsRaw.add(path.getBuffer());
+        searchPaths.add(path);
     if (searchInWorkspace)
     {
         for (auto& path : workspaceSearchPaths)
-            searchPathsRaw.add(path.getBuffer());
+            searchPaths.add(path);
     }
     else
     {
@@ -299,9 +305,34 @@ RefPtr<WorkspaceVersion> Workspace::createWorkspaceVersion()
         {
             auto dir = Path::getParentDirectory(p.Key.getBuffer());
             if (set.Add(dir))
-                searchPathsRaw.add(dir.getBuffer());
+                searchPaths.add(dir);
         }
     }
+
+    StringBuilder settings;
+    for (auto& path : searchPaths)
+        settings << "path " << path << "\n";
+    for (auto& macro : predefinedMacros)
+        settings << "define " << macro.name << " " << macro.value << "\n";
+    version->linkageSettings = settings.ProduceString();
+
+    if (reuseVersion && reuseVersion->linkageSettings == version->linkageSettings &&
+        reuseVersion->linkageReuseCount < kMaxLinkageReuseCount)
+    {
+        version->reuseLinkage(reuseVersion, checkingMode != ContentAssistCheckingMode::Completion);
+        version->linkageReuseCount = reuseVersion->linkageReuseCount + 1;
+        return version;
+    }
+
+    slang::SessionDesc desc = {};
+    desc.fileSystem = this;
+    desc.targetCount = 1;
+    slang::TargetDesc targetDesc = {};
+    targetDesc.profile = slangGlobalSession->findProfile("sm_6_6");
+    desc.targets = &targetDesc;
+    List<const char*> searchPathsRaw;
+    for (auto& path : searchPaths)
+        searchPathsRaw.add(path.getBuffer());
     desc.searchPaths = searchPathsRaw.getBuffer();
     desc.searchPathCount = searchPathsRaw.getCount();
 
@@ -319,7 +350,7 @@ RefPtr<WorkspaceVersion> Workspace::createWorkspaceVersion()
     ComPtr<slang::ISession> session;
     slangGlobalSession->createSession(desc, session.writeRef());
     version->linkage = static_cast<Linkage*>(session.get());
-    version->linkage->contentAssistInfo.checkingMode = ContentAssistCheckingMode::General;
+    version->linkage->contentAssistInfo.checkingMode = checkingMode;
     return version;
 }
 
@@ -338,14 +369,16 @@ SlangResult Workspace::loadFile(const char* path, ISlangBlob** outBlob)
 WorkspaceVersion* Workspace::getCurrentVersion()
 {
     if (!currentVersion)
-        currentVersion = createWorkspaceVersion();
+    {
+        currentVersion = createWorkspaceVersion(previousVersion, ContentAssistCheckingMode::General);
+        previousVersion = nullptr;
+    }
     return currentVersion.Ptr();
 }
 WorkspaceVersion* Workspace::createVersionForCompletion()
 {
-    currentCompletionVersion = createWorkspaceVersion();
-    currentCompletionVersion->linkage->contentAssistInfo.checkingMode =
-        ContentAssistCheckingMode::Completion;
+    currentCompletionVersion = createWorkspaceVersion(
+        currentCompletionVersion, ContentAssistCheckingMode::Completion);
     return currentCompletionVersion.Ptr();
 }
 
@@ -517,6 +550,7 @@ Module* WorkspaceVersion::getOrLoadModule(String path)
     if (parsedModule)
     {
         modules[path] = static_cast<Module*>(parsedModule);
+        moduleSourceTexts[path] = (*doc)->getText();
     }
     if (diagnosticBlob)
     {
@@ -529,6 +563,144 @@ Module* WorkspaceVersion::getOrLoadModule(String path)
     return static_cast<Module*>(parsedModule);
 }
 
+void WorkspaceVersion::reuseLinkage(WorkspaceVersion* previousVersion, bool keepOpenedModules)
+{
+    linkage = previousVersion->linkage;
+    auto sourceManager = linkage->getSourceManager();
+
+    // Find the files whose content is not what it was when they were loaded.
+    HashSet<SourceFile*> changedFiles;
+    for (auto sourceFile : sourceManager->getSourceFiles())
+    {
+        auto& pathInfo = sourceFile->getPathInfo();
+        if (!pathInfo.hasFileFoundPath())
+            continue;
+        ComPtr<ISlangBlob> blob;
+        if (SLANG_FAILED(workspace->loadFile(pathInfo.foundPath.getBuffer(), blob.writeRef())) ||
+            StringUtil::getSlice(blob) != sourceFile->getContent())
+        {
+            changedFiles.Add(sourceFile);
+        }
+    }
+
+    // Find the modules whose own source has changed.
+    List<Module*> previousModules;
+    for (auto& loadedModule : linkage->loadedModulesList)
+        previousModules.add(loadedModule);
+    HashSet<Module*> changedModules;
+    for (auto& pair : previousVersion->modules)
+    {
+        previousModules.add(pair.Value);
+        auto doc = workspace->openedDocuments.TryGetValue(pair.Key);
+        auto text = previousVersion->moduleSourceTexts.TryGetValue(pair.Key);
+        if (!keepOpenedModules || !doc || !text || (*doc)->getText() != *text)
+            changedModules.Add(pair.Value);
+    }
+    for (auto module : previousModules)
+    {
+        for (auto sourceFile : module->getSourceFileDependencyList())
+        {
+            if (changedFiles.Contains(sourceFile))
+            {
+                changedModules.Add(module);
+                break;
+            }
+        }
+    }
+
+    // A module has to be checked again if anything it (transitively) imports has changed. The
+    // dependency list of a module holds everything it imports, and the module itself.
+    HashSet<Module*> removedModules;
+    HashSet<SourceFile*> removedFiles = changedFiles;
+    for (auto module : previousModules)
+    {
+        for (auto dependency : module->getModuleDependencyList())
+        {
+            if (changedModules.Contains(dependency))
+            {
+                removedModules.Add(module);
+                for (auto sourceFile : module->getSourceFileDependencyList())
+                    removedFiles.Add(sourceFile);
+                break;
+            }
+        }
+    }
+    HashSet<Module*> distinctPreviousModules;
+    for (auto module : previousModules)
+        distinctPreviousModules.Add(module);
+    previousModuleCount = distinctPreviousModules.Count();
+    keptModuleCount = previousModuleCount - removedModules.Count();
+
+    retiredModules = previousVersion->retiredModules;
+    for (auto module : removedModules)
+        retiredModules.add(module);
+    linkage->removeLoadedModules(removedModules);
+
+    // The file system caches what it has read, so files that have changed would not be read again.
+    linkage->getFileSystemExt()->clearCache();
+
+    // Carry the modules that are kept forward into this version.
+    HashSet<String> removedPaths;
+    for (auto& pair : previousVersion->modules)
+    {
+        if (removedModules.Contains(pair.Value))
+        {
+            removedPaths.Add(pair.Key);
+            continue;
+        }
+        modules[pair.Key] = pair.Value;
+        moduleSourceTexts[pair.Key] = previousVersion->moduleSourceTexts[pair.Key].GetValue();
+        RefPtr<ASTMarkup> astMarkup;
+        if (previousVersion->markupASTs.TryGetValue(pair.Value->getModuleDecl(), astMarkup))
+            markupASTs[pair.Value->getModuleDecl()] = astMarkup;
+    }
+    for (auto sourceFile : removedFiles)
+    {
+        String canonicalPath;
+        if (SLANG_SUCCEEDED(Path::getCanonical(sourceFile->getPathInfo().foundPath, canonicalPath)))
+            removedPaths.Add(canonicalPath);
+    }
+    for (auto& pair : previousVersion->diagnostics)
+    {
+        if (!removedPaths.Contains(pair.Key))
+            diagnostics[pair.Key] = pair.Value;
+    }
+
+    // Remove what the preprocessor found in the files that will be read again, so that it
+    // isn't duplicated when they are.
+    auto isRemovedLoc = [&](SourceLoc loc)
+    {
+        auto sourceView = sourceManager->findSourceViewRecursively(loc);
+        if (!sourceView)
+            return false;
+        auto sourceFile = sourceView->getSourceFile();
+        return removedFiles.Contains(sourceFile) ||
+               removedPaths.Contains(sourceFile->getPathInfo().foundPath);
+    };
+    auto& preprocessorInfo = linkage->contentAssistInfo.preprocessorInfo;
+    List<MacroDefinitionContentAssistInfo> macroDefinitionsToKeep;
+    for (auto& def : preprocessorInfo.macroDefinitions)
+    {
+        if (!isRemovedLoc(def.loc))
+            macroDefinitionsToKeep.add(def);
+    }
+    preprocessorInfo.macroDefinitions.swapWith(macroDefinitionsToKeep);
+    List<MacroInvocationContentAssistInfo> macroInvocationsToKeep;
+    for (auto& invocation : preprocessorInfo.macroInvocations)
+    {
+        if (!isRemovedLoc(invocation.loc))
+            macroInvocationsToKeep.add(invocation);
+    }
+    preprocessorInfo.macroInvocations.swapWith(macroInvocationsToKeep);
+    List<FileIncludeContentAssistInfo> fileIncludesToKeep;
+    for (auto& include : preprocessorInfo.fileIncludes)
+    {
+        if (!isRemovedLoc(include.loc))
+            fileIncludesToKeep.add(include);
+    }
+    preprocessorInfo.fileIncludes.swapWith(fileIncludesToKeep);
+}
+
 MacroDefinitionContentAssistInfo* WorkspaceVersion::tryGetMacroDefinition(UnownedStringSlice name)
 {
     if (macroDefinitions.Count() == 0)
@@ -110,16 +110,35 @@ namespace Slang
     {
     private:
         Dictionary<String, Module*> modules;
+        // The text of the opened document each of `modules` was loaded from.
+        Dictionary<String, String> moduleSourceTexts;
+        // Modules removed from `linkage` by this or earlier versions. They are kept alive for as long
+        // as the linkage is used, as it may still hold things that refer to them.
+        List<RefPtr<Module>> retiredModules;
         Dictionary<ModuleDecl*, RefPtr<ASTMarkup>> markupASTs;
         Dictionary<Name*, MacroDefinitionContentAssistInfo*> macroDefinitions;
         void parseDiagnostics(String compilerOutput);
     public:
         Workspace* workspace;
         RefPtr<Linkage> linkage;
+        // The search paths and macros `linkage` was created with.
+        String linkageSettings;
+        // The number of versions before this one that used the same `linkage`.
+        Index linkageReuseCount = 0;
+        // If `linkage` was reused, the number of modules the previous version had, and how many of
+        // them were kept.
+        Index previousModuleCount = 0;
+        Index keptModuleCount = 0;
         Dictionary<String, DocumentDiagnostics> diagnostics;
         ASTMarkup* getOrCreateMarkupAST(ModuleDecl* module);
         Module* getOrLoadModule(String path);
         MacroDefinitionContentAssistInfo* tryGetMacroDefinition(UnownedStringSlice name);
+
+        // Use the linkage of `previousVersion`, keeping the modules (and their diagnostics) whose
+        // source, and the source of everything they import, is unchanged. Everything else is
+        // removed from the linkage, so it is loaded and checked again when it is next needed.
+        // If `keepOpenedModules` is false, the modules for the opened documents are always removed.
+        void reuseLinkage(WorkspaceVersion* previousVersion, bool keepOpenedModules);
     };
 
     struct OwnedPreprocessorMacroDefinition
@@ -134,7 +153,10 @@ namespace Slang
     private:
         RefPtr<WorkspaceVersion> currentVersion;
         RefPtr<WorkspaceVersion> currentCompletionVersion;
-        RefPtr<WorkspaceVersion> createWorkspaceVersion();
+        // The last version to be invalidated, that the next version can reuse unchanged modules from.
+        RefPtr<WorkspaceVersion> previousVersion;
+        RefPtr<WorkspaceVersion> createWorkspaceVersion(
+            WorkspaceVersion* reuseVersion, ContentAssistCheckingMode checkingMode);
     public:
         List<String> rootDirectories;
         List<String> additionalSearchPaths;
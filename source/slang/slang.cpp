@@ -25,6 +25,7 @@
 #include "slang-type-layout.h"
 
 #include "slang-options.h"
+#include "slang-parallel-codegen.h"
 
 #include "slang-repro.h"
 
@@ -141,6 +142,8 @@ void Session::init()
 
     m_sharedLibraryLoader = DefaultSharedLibraryLoader::getSingleton();
     
+    m_sharedTypeCheckingCache = new SharedTypeCheckingCache;
+
     // Set up shared AST builder
     m_sharedASTBuilder = new SharedASTBuilder;
     m_sharedASTBuilder->init(this);
@@ -413,23 +416,35 @@ SlangResult Session::saveStdLib(SlangArchiveType archiveType, ISlangBlob** outBl
     return SLANG_OK;
 }
 
+namespace { // anonymous
+
+// A RiffContainer read in place from a blob
+class BlobRiffContainer : public RefObject
+{
+public:
+    ComPtr<ISlangBlob> m_blob;
+    RiffContainer m_container;
+};
+
+} // anonymous
+
 SlangResult Session::_readBuiltinModule(ISlangFileSystem* fileSystem, Scope* scope, String moduleName)
 {
     // Get the name of the module
     StringBuilder moduleFilename;
     moduleFilename << moduleName << ".slang-module";
 
-    RiffContainer riffContainer;
+    // The container references the blob rather than copying from it where it can. Both are kept in
+    // scope until the IR of the module has been read, which is only done when the IR is first used
+    // (see Module::getIRModule) - most compilations only ever use a small part of the standard library.
+    RefPtr<BlobRiffContainer> blobContainer = new BlobRiffContainer;
     {
         // Load it
-        ComPtr<ISlangBlob> blob;
+        ComPtr<ISlangBlob>& blob = blobContainer->m_blob;
         SLANG_RETURN_ON_FAIL(fileSystem->loadFile(moduleFilename.getBuffer(), blob.writeRef()));
 
-        // Set up a stream
-        MemoryStreamBase stream(FileAccess::Read, blob->getBufferPointer(), blob->getBufferSize());
-
         // Load the riff container
-        SLANG_RETURN_ON_FAIL(RiffUtil::read(&stream, riffContainer));
+        SLANG_RETURN_ON_FAIL(RiffUtil::readInPlace(blob->getBufferPointer(), blob->getBufferSize(), blobContainer->m_container));
     }
     
     // Load up the module
@@ -449,11 +464,13 @@ SlangResult Session::_readBuiltinModule(ISlangFileSystem* fileSystem, Scope* sco
     options.sharedASTBuilder = linkage->getASTBuilder()->getSharedASTBuilder();
     options.sourceManager = sourceManger;
     options.linkage = linkage;
+    options.lazyIRContainerScope = blobContainer;
+    options.freezeIRModules = true;
 
     // Hmm - don't have a suitable sink yet, so attempt to just not have one
     options.sink = nullptr;
 
-    SLANG_RETURN_ON_FAIL(SerialContainerUtil::read(&riffContainer, options, containerData));
+    SLANG_RETURN_ON_FAIL(SerialContainerUtil::read(&blobContainer->m_container, options, containerData));
 
     for (auto& srcModule : containerData.modules)
     {
@@ -474,6 +491,7 @@ SlangResult Session::_readBuiltinModule(ISlangFileSystem* fileSystem, Scope* sco
         }
 
         module->setIRModule(srcModule.irModule);
+        module->setIRModuleReader(srcModule.irModuleReader);
 
         // Put in the loaded module map
         linkage->mapNameToLoadedModules.Add(sessionNamePool->getName(moduleName), module);
@@ -559,9 +577,11 @@ static T makeFromSizeVersioned(const uint8_t* src)
 }
 
 SLANG_NO_THROW SlangResult SLANG_MCALL Session::createSession(
-    slang::SessionDesc const&  desc,
+    slang::SessionDesc const&  inDesc,
     slang::ISession**          outSession)
 {
+    const auto desc = makeFromSizeVersioned<slang::SessionDesc>(reinterpret_cast<const uint8_t*>(&inDesc));
+
     RefPtr<ASTBuilder> astBuilder(new ASTBuilder(m_sharedASTBuilder, "Session::astBuilder"));
     RefPtr<Linkage> linkage = new Linkage(this, astBuilder, getBuiltinLinkage());
 
@@ -601,6 +621,16 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Session::createSession(
     {
         linkage->setFileSystem(desc.fileSystem);
     }
+
+    if (desc.compileCacheDirectory)
+    {
+        linkage->setCompileCacheDirectory(desc.compileCacheDirectory);
+    }
+
+    if (desc.moduleCacheDirectory)
+    {
+        linkage->m_moduleCacheDirectory = desc.moduleCacheDirectory;
+    }
     *outSession = asExternal(linkage.detach());
     return SLANG_OK;
 }
@@ -950,16 +980,31 @@ TypeCheckingCache* Linkage::getTypeCheckingCache()
     if (!m_typeCheckingCache)
     {
         m_typeCheckingCache = new TypeCheckingCache();
+        m_typeCheckingCache->sharedEntries = m_session->getSharedTypeCheckingCache()->getEntries();
     }
     return m_typeCheckingCache;
 }
 
 void Linkage::destroyTypeCheckingCache()
 {
+    // Pass on what can be used by other linkages. Only done if the session is retained,
+    // because otherwise it (and the shared cache) may already have been destroyed.
+    if (m_retainedSession)
+    {
+        shareTypeCheckingCacheEntries();
+    }
     delete m_typeCheckingCache;
     m_typeCheckingCache = nullptr;
 }
 
+void Linkage::shareTypeCheckingCacheEntries()
+{
+    if (m_typeCheckingCache)
+    {
+        m_session->getSharedTypeCheckingCache()->addEntries(m_typeCheckingCache);
+    }
+}
+
 SLANG_NO_THROW slang::IGlobalSession* SLANG_MCALL Linkage::getGlobalSession()
 {
     return asExternal(getSessionImpl());
@@ -1321,9 +1366,110 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Linkage::createCompileRequest(
     return SLANG_OK;
 }
 
+SLANG_NO_THROW SlangResult SLANG_MCALL Linkage::getTargetHostCallables(
+    slang::IComponentType* const*   componentTypes,
+    SlangInt                        componentTypeCount,
+    SlangInt                        targetIndex,
+    SlangInt                        threadCount,
+    ISlangSharedLibrary**           outSharedLibraries,
+    ISlangBlob**                    outDiagnostics)
+{
+    if(targetIndex < 0 || targetIndex >= targets.getCount() || componentTypeCount < 0 || threadCount < 0)
+        return SLANG_E_INVALID_ARG;
+    auto target = targets[targetIndex];
+
+    // Each work item is the whole program of a component type, so that all of its
+    // entry points are compiled with one invocation of the downstream compiler.
+    // Component types that appear more than once are only compiled once.
+    List<TargetProgram*> targetPrograms;
+    List<Index> workItemIndices;
+    {
+        Dictionary<TargetProgram*, Index> targetProgramToIndex;
+        for (Index i = 0; i < Index(componentTypeCount); ++i)
+        {
+            outSharedLibraries[i] = nullptr;
+
+            auto targetProgram = asInternal(componentTypes[i])->getTargetProgram(target);
+
+            Index workItemIndex = targetPrograms.getCount();
+            if (Index* existingIndex = targetProgramToIndex.TryGetValueOrAdd(targetProgram, workItemIndex))
+            {
+                workItemIndex = *existingIndex;
+            }
+            else
+            {
+                targetPrograms.add(targetProgram);
+            }
+            workItemIndices.add(workItemIndex);
+        }
+    }
+
+    DiagnosticSink sink(getSourceManager(), Lexer::sourceLocationLexer);
+
+    List<IArtifact*> artifacts;
+    artifacts.setCount(targetPrograms.getCount());
+
+    if (threadCount == 1 || targetPrograms.getCount() <= 1)
+    {
+        for (Index i = 0; i < targetPrograms.getCount(); ++i)
+        {
+            artifacts[i] = targetPrograms[i]->getOrCreateWholeProgramResult(&sink);
+        }
+    }
+    else
+    {
+        ParallelCodeGen parallelCodeGen;
+
+        // The lock is only released whilst a downstream compiler runs, so
+        // the compilers for up to `threadCount` work items run concurrently.
+        SLANG_ASSERT(m_parallelCodeGen == nullptr);
+        m_parallelCodeGen = &parallelCodeGen;
+
+        try
+        {
+            parallelCodeGen.run(targetPrograms.getCount(), Index(threadCount), [&](Index index)
+            {
+                artifacts[index] = targetPrograms[index]->getOrCreateWholeProgramResult(&sink);
+            });
+        }
+        catch (...)
+        {
+            m_parallelCodeGen = nullptr;
+            throw;
+        }
+
+        m_parallelCodeGen = nullptr;
+    }
+
+    sink.getBlobIfNeeded(outDiagnostics);
+
+    SlangResult result = SLANG_OK;
+    for (Index i = 0; i < Index(componentTypeCount); ++i)
+    {
+        IArtifact* artifact = artifacts[workItemIndices[i]];
+        SlangResult res = artifact
+            ? artifact->loadSharedLibrary(ArtifactKeep::Yes, &outSharedLibraries[i])
+            : SLANG_FAIL;
+        if (SLANG_FAILED(res) && SLANG_SUCCEEDED(result))
+        {
+            result = res;
+        }
+    }
+    return result;
+}
+
 SlangResult Linkage::addSearchPath(
     char const* path)
 {
+    // A path that is already searched would never find anything the first didn't, so isn't added again
+    // (so a linkage that has the same options applied to it for each compile request doesn't keep growing)
+    for (const auto& searchDirectory : searchDirectories.searchDirectories)
+    {
+        if (searchDirectory.path == path)
+        {
+            return SLANG_OK;
+        }
+    }
     searchDirectories.searchDirectories.add(Slang::SearchDirectory(path));
     return SLANG_OK;
 }
@@ -1471,6 +1617,15 @@ TypeLayout* TargetRequest::getTypeLayout(Type* type)
     return result.Ptr();
 }
 
+TypeLayoutCache* TargetRequest::getTypeLayoutCache()
+{
+    if (!m_typeLayoutCache)
+    {
+        m_typeLayoutCache = new TypeLayoutCache();
+    }
+    return m_typeLayoutCache;
+}
+
 //
 // TranslationUnitRequest
 //
@@ -1615,16 +1770,7 @@ void TranslationUnitRequest::_addSourceFile(SourceFile* sourceFile)
 {
     m_sourceFiles.add(sourceFile);
 
-    // We want to record that the compiled module has a dependency
-    // on the path of the source file, but we also need to account
-    // for cases where the user added a source string/blob without
-    // an associated path and/or wasn't from a file.
-
-    auto pathInfo = sourceFile->getPathInfo();
-    if (pathInfo.hasFileFoundPath())
-    {
-        getModule()->addFilePathDependency(pathInfo.foundPath);
-    }
+    getModule()->addFileDependency(sourceFile);
 }
 
 List<SourceFile*> const& TranslationUnitRequest::getSourceFiles() 
@@ -1828,9 +1974,9 @@ protected:
     // by applications to decide when they need to "hot reload"
     // their shader code.
     //
-    void handleFileDependency(String const& path) SLANG_OVERRIDE
+    void handleFileDependency(SourceFile* sourceFile) SLANG_OVERRIDE
     {
-        m_module->addFilePathDependency(path);
+        m_module->addFileDependency(sourceFile);
     }
 
     // The second task that this handler deals with is detecting
@@ -2075,42 +2221,23 @@ static void _outputIncludes(const List<SourceFile*>& sourceFiles, SourceManager*
     }
 }
 
-void FrontEndCompileRequest::parseTranslationUnit(
-    TranslationUnitRequest* translationUnit)
+// Get the preprocessor definitions that the source of a translation unit is preprocessed with
+static void _calcCombinedPreprocessorDefinitions(
+    Dictionary<String, String> const&   linkageDefinitions,
+    Dictionary<String, String> const&   requestDefinitions,
+    Dictionary<String, String> const&   translationUnitDefinitions,
+    SourceLanguage                      sourceLanguage,
+    Dictionary<String, String>&         outDefinitions)
 {
-    auto linkage = getLinkage();
-
-    // TODO(JS): NOTE! Here we are using the searchDirectories on the linkage. This is because
-    // currently the API only allows the setting search paths on linkage.
-    // 
-    // Here we should probably be using the searchDirectories on the FrontEndCompileRequest.
-    // If searchDirectories.parent pointed to the one in the Linkage would mean linkage paths
-    // would be checked too (after those on the FrontEndCompileRequest). 
-    IncludeSystem includeSystem(&linkage->searchDirectories, linkage->getFileSystemExt(), linkage->getSourceManager());
-
-    Scope* languageScope = nullptr;
-    switch (translationUnit->sourceLanguage)
-    {
-    case SourceLanguage::HLSL:
-        languageScope = getSession()->hlslLanguageScope;
-        break;
-
-    case SourceLanguage::Slang:
-    default:
-        languageScope = getSession()->slangLanguageScope;
-        break;
-    }
-
     // TODO(JS):
     // Note! that a adding a define twice will cause an exception in debug builds
     // that may be desirable or not...
-    Dictionary<String, String> combinedPreprocessorDefinitions;
-    for(auto& def : getLinkage()->preprocessorDefinitions)
-        combinedPreprocessorDefinitions.Add(def.Key, def.Value);
-    for(auto& def : preprocessorDefinitions)
-        combinedPreprocessorDefinitions.Add(def.Key, def.Value);
-    for(auto& def : translationUnit->preprocessorDefinitions)
-        combinedPreprocessorDefinitions.Add(def.Key, def.Value);
+    for(auto& def : linkageDefinitions)
+        outDefinitions.Add(def.Key, def.Value);
+    for(auto& def : requestDefinitions)
+        outDefinitions.Add(def.Key, def.Value);
+    for(auto& def : translationUnitDefinitions)
+        outDefinitions.Add(def.Key, def.Value);
 
     // Define standard macros, if not already defined. This style assumes using `#if __SOME_VAR` style, as in
     // 
@@ -2123,29 +2250,84 @@ void FrontEndCompileRequest::parseTranslationUnit(
     // Of course this means using #ifndef/#ifdef/defined() is probably not appropraite with thes variables.
     {
         // Used to identify level of HLSL language compatibility
-        combinedPreprocessorDefinitions.AddIfNotExists("__HLSL_VERSION", "2020");
+        outDefinitions.AddIfNotExists("__HLSL_VERSION", "2020");
 
         // Indicates this is being compiled by the slang *compiler*
-        combinedPreprocessorDefinitions.AddIfNotExists("__SLANG_COMPILER__", "1");
+        outDefinitions.AddIfNotExists("__SLANG_COMPILER__", "1");
 
         // Set macro depending on source type
-        switch (translationUnit->sourceLanguage)
+        switch (sourceLanguage)
         {
             case SourceLanguage::HLSL:
                 // Used to indicate compiled as HLSL language
-                combinedPreprocessorDefinitions.AddIfNotExists("__HLSL__", "1");
+                outDefinitions.AddIfNotExists("__HLSL__", "1");
                 break;
             case SourceLanguage::Slang:
                 // Used to indicate compiled as Slang language
-                combinedPreprocessorDefinitions.AddIfNotExists("__SLANG__", "1");
+                outDefinitions.AddIfNotExists("__SLANG__", "1");
                 break;
             default: break;
         }
 
         // If not set, define as 0.
-        combinedPreprocessorDefinitions.AddIfNotExists("__HLSL__", "0");
-        combinedPreprocessorDefinitions.AddIfNotExists("__SLANG__", "0");
+        outDefinitions.AddIfNotExists("__HLSL__", "0");
+        outDefinitions.AddIfNotExists("__SLANG__", "0");
     }
+}
+
+// Append a line for each of the definitions, sorted so that the result doesn't depend on the order of the dictionary
+static void _appendPreprocessorDefinitions(Dictionary<String, String> const& definitions, StringBuilder& out)
+{
+    List<String> names;
+    for (auto& definition : definitions)
+    {
+        names.add(definition.Key);
+    }
+    names.sort();
+
+    for (auto& name : names)
+    {
+        String value;
+        definitions.TryGetValue(name, value);
+        out << "#define " << name << " " << value << "\n";
+    }
+}
+
+void FrontEndCompileRequest::parseTranslationUnit(
+    TranslationUnitRequest* translationUnit)
+{
+    auto linkage = getLinkage();
+
+    CompileTraceScope traceScope(linkage->getCompileTrace(), "frontend", getUnownedStringSliceText(translationUnit->moduleName));
+
+    // TODO(JS): NOTE! Here we are using the searchDirectories on the linkage. This is because
+    // currently the API only allows the setting search paths on linkage.
+    // 
+    // Here we should probably be using the searchDirectories on the FrontEndCompileRequest.
+    // If searchDirectories.parent pointed to the one in the Linkage would mean linkage paths
+    // would be checked too (after those on the FrontEndCompileRequest). 
+    IncludeSystem includeSystem(&linkage->searchDirectories, linkage->getFileSystemExt(), linkage->getSourceManager());
+
+    Scope* languageScope = nullptr;
+    switch (translationUnit->sourceLanguage)
+    {
+    case SourceLanguage::HLSL:
+        languageScope = getSession()->hlslLanguageScope;
+        break;
+
+    case SourceLanguage::Slang:
+    default:
+        languageScope = getSession()->slangLanguageScope;
+        break;
+    }
+
+    Dictionary<String, String> combinedPreprocessorDefinitions;
+    _calcCombinedPreprocessorDefinitions(
+        getLinkage()->preprocessorDefinitions,
+        preprocessorDefinitions,
+        translationUnit->preprocessorDefinitions,
+        translationUnit->sourceLanguage,
+        combinedPreprocessorDefinitions);
 
     auto module = translationUnit->getModule();
 
@@ -2182,15 +2364,28 @@ void FrontEndCompileRequest::parseTranslationUnit(
     //
     FrontEndPreprocessorHandler preprocessorHandler(module, astBuilder, getSink());
 
+    module->addPreprocessorDefinitionsDependency(combinedPreprocessorDefinitions);
+
     for (auto sourceFile : translationUnit->getSourceFiles())
     {
-        auto tokens = preprocessSource(
-            sourceFile,
-            getSink(),
-            &includeSystem,
-            combinedPreprocessorDefinitions,
-            getLinkage(),
-            &preprocessorHandler);
+        TokenList tokens;
+        {
+            CompileTraceScope preprocessTraceScope(linkage->getCompileTrace(), "frontend", "preprocess");
+            PreprocessorTokenCache* tokenCache = linkage->getPreprocessorTokenCache();
+            const Index hitCountBefore = tokenCache->hitCount;
+            const Index skippedIncludeCountBefore = tokenCache->skippedIncludeCount;
+
+            tokens = preprocessSource(
+                sourceFile,
+                getSink(),
+                &includeSystem,
+                combinedPreprocessorDefinitions,
+                getLinkage(),
+                &preprocessorHandler);
+
+            preprocessTraceScope.addArg("tokenCacheHits", tokenCache->hitCount - hitCountBefore);
+            preprocessTraceScope.addArg("includeGuardSkips", tokenCache->skippedIncludeCount - skippedIncludeCountBefore);
+        }
 
         if (outputIncludes)
         {
@@ -2207,12 +2402,15 @@ void FrontEndCompileRequest::parseTranslationUnit(
             return;
         }
 
-        parseSourceFile(
-            astBuilder,
-            translationUnit,
-            tokens,
-            getSink(),
-            languageScope);
+        {
+            CompileTraceScope parseTraceScope(linkage->getCompileTrace(), "frontend", "parse");
+            parseSourceFile(
+                astBuilder,
+                translationUnit,
+                tokens,
+                getSink(),
+                languageScope);
+        }
 
         // Let's try dumping
 
@@ -2267,7 +2465,14 @@ void FrontEndCompileRequest::checkAllTranslationUnits()
     // apply the semantic checking logic.
     for( auto& translationUnit : translationUnits )
     {
-        checkTranslationUnit(translationUnit.Ptr(), loadedModules);
+        {
+            CompileTraceScope traceScope(getLinkage()->getCompileTrace(), "frontend", "check");
+            const Index sharedHitCountBefore = getLinkage()->getTypeCheckingCache()->sharedHitCount;
+
+            checkTranslationUnit(translationUnit.Ptr(), loadedModules);
+
+            traceScope.addArg("sharedTypeCheckingCacheHits", getLinkage()->getTypeCheckingCache()->sharedHitCount - sharedHitCountBefore);
+        }
 
         // Add the checked module to list of loadedModules so that they can be
         // discovered by `findOrImportModule` when processing future `import` decls.
@@ -2277,7 +2482,14 @@ void FrontEndCompileRequest::checkAllTranslationUnits()
         // this scenario with a recursive style checking.
         loadedModules.Add(translationUnit->moduleName, translationUnit->getModule());
     }
-    checkEntryPoints();
+    {
+        CompileTraceScope traceScope(getLinkage()->getCompileTrace(), "frontend", "checkEntryPoints");
+        checkEntryPoints();
+    }
+
+    // Other linkages of the session (including ones that exist at the same time as this one) can
+    // use what was found when checking, without waiting for this linkage to be destroyed
+    getLinkage()->shareTypeCheckingCacheEntries();
 }
 
 void FrontEndCompileRequest::generateIR()
@@ -2985,6 +3197,40 @@ bool Linkage::isBeingImported(Module* module)
     return false;
 }
 
+void Linkage::removeLoadedModules(HashSet<Module*> const& modules)
+{
+    List<RefPtr<LoadedModule>> keptModules;
+    for (auto& loadedModule : loadedModulesList)
+    {
+        if (!modules.Contains(loadedModule))
+        {
+            keptModules.add(loadedModule);
+        }
+    }
+    loadedModulesList.swapWith(keptModules);
+
+    // A null entry records that the import failed
+    for (const auto& pair : mapNameToLoadedModules)
+    {
+        if (!pair.Value || modules.Contains(pair.Value))
+        {
+            mapNameToLoadedModules.Remove(pair.Key);
+        }
+    }
+    for (const auto& pair : mapPathToLoadedModule)
+    {
+        if (!pair.Value || modules.Contains(pair.Value))
+        {
+            mapPathToLoadedModule.Remove(pair.Key);
+        }
+    }
+
+    // The caches can hold types and declarations from the removed modules
+    destroyTypeCheckingCache();
+    m_containerTypes.Clear();
+    contentAssistInfo.completionSuggestions.clear();
+}
+
 RefPtr<Module> Linkage::findOrImportModule(
     Name*               name,
     SourceLoc const&    loc,
@@ -3082,15 +3328,429 @@ RefPtr<Module> Linkage::findOrImportModule(
         return nullptr;
     }
 
+    // A serialized module (that is valid for the current source and options)
+    // avoids parsing and checking the module from scratch.
+    if (!isInLanguageServer())
+    {
+        if (auto serializedModule = _findSerializedModule(name, filePathInfo, fileContents, loc, sink, loadedModules))
+        {
+            return serializedModule;
+        }
+    }
+
     // We've found a file that we can load for the given module, so
     // go ahead and perform the module-load action
-    return loadModule(
+    RefPtr<Module> module = loadModule(
         name,
         filePathInfo,
         fileContents,
         loc,
         sink,
         loadedModules);
+
+    if (module && m_moduleCacheDirectory.getLength() && !isInLanguageServer())
+    {
+        // Failing to write the cache doesn't make the import fail
+        _saveSerializedModule(module, filePathInfo);
+    }
+
+    return module;
+}
+
+namespace { // anonymous
+
+// A serialized module, as found by `Linkage::_findSerializedModule`, is a list of the following chunks
+// together with the container of the module (see `SerialContainerUtil`)
+struct SerializedModuleBinary
+{
+    static const FourCC kSerializedModuleFourCc = SLANG_FOUR_CC('S', 'L', 's', 'm');
+
+        /// The key the module is validated with (see `Linkage::_calcSerializedModuleKey`)
+    static const FourCC kKeyFourCc = SLANG_FOUR_CC('S', 'L', 's', 'k');
+        /// The paths of the source files of the module, separated by new lines
+    static const FourCC kSourceFilesFourCc = SLANG_FOUR_CC('S', 'L', 's', 'f');
+        /// The names of the modules the module imports (directly or indirectly), separated by new lines
+    static const FourCC kImportsFourCc = SLANG_FOUR_CC('S', 'L', 's', 'i');
+        /// The source digest of the module (see `Module::getSourceDigest`)
+    static const FourCC kSourceDigestFourCc = SLANG_FOUR_CC('S', 'L', 's', 'd');
+};
+
+} // anonymous
+
+static SlangResult _findSerializedModuleString(RiffContainer::ListChunk* listChunk, FourCC fourCC, UnownedStringSlice& outString)
+{
+    auto dataChunk = as<RiffContainer::DataChunk>(listChunk->findContained(fourCC));
+    if (!dataChunk)
+    {
+        return SLANG_FAIL;
+    }
+    // An empty string is written as a chunk without any data
+    RiffContainer::Data* data = dataChunk->m_dataList;
+    if (!data)
+    {
+        outString = UnownedStringSlice();
+        return SLANG_OK;
+    }
+    if (data->m_next)
+    {
+        return SLANG_FAIL;
+    }
+    outString = UnownedStringSlice((const char*)data->getPayload(), data->getSize());
+    return SLANG_OK;
+}
+
+static void _writeSerializedModuleString(RiffContainer* container, FourCC fourCC, const UnownedStringSlice& string)
+{
+    RiffContainer::ScopeChunk scope(container, RiffContainer::Chunk::Kind::Data, fourCC);
+    // The chunk is written even if the string is empty (for example if nothing is imported), but the container
+    // can't write empty data
+    if (string.getLength())
+    {
+        container->write(string.begin(), size_t(string.getLength()));
+    }
+}
+
+bool Linkage::_calcSerializedModuleKey(
+    List<KeyValuePair<String, UnownedStringSlice>> const&   sourceFiles,
+    List<Module*> const&                                    importedModules,
+    StringBuilder&                                          outKey)
+{
+    outKey << "version " << getBuildTagString() << "\n";
+
+    outKey << "linkage " << int(defaultMatrixLayoutMode)
+        << " " << int(debugInfoLevel)
+        << " " << int(optimizationLevel)
+        << " " << int(m_obfuscateCode)
+        << " " << int(m_useFalcorCustomSharedKeywordSemantics) << "\n";
+
+    // The definitions the source of an imported module is preprocessed with (see `loadModule`)
+    {
+        Dictionary<String, String> definitions;
+        _calcCombinedPreprocessorDefinitions(
+            preprocessorDefinitions,
+            Dictionary<String, String>(),
+            Dictionary<String, String>(),
+            SourceLanguage::Slang,
+            definitions);
+        _appendPreprocessorDefinitions(definitions, outKey);
+    }
+
+    for (const auto& sourceFile : sourceFiles)
+    {
+        const UnownedStringSlice content = sourceFile.Value;
+        outKey << "file " << sourceFile.Key << " " << content.getLength() << " ";
+        outKey.append(uint64_t(getStableHashCode64(content.begin(), size_t(content.getLength()))), 16);
+        outKey << "\n";
+    }
+
+    // An imported module is identified by its source. The module it was imported from
+    // must have been built against exactly the same source for the serialized AST and IR to be valid.
+    for (auto importedModule : importedModules)
+    {
+        const auto sourceDigest = importedModule->getSourceDigest();
+        if (sourceDigest.getLength() == 0)
+        {
+            return false;
+        }
+        outKey << "import " << getText(importedModule->getModuleDecl()->getName()) << "\n" << sourceDigest;
+    }
+    return true;
+}
+
+RefPtr<Module> Linkage::_findSerializedModule(
+    Name*                           name,
+    const PathInfo&                 filePathInfo,
+    ISlangBlob*                     fileContentsBlob,
+    SourceLoc const&                loc,
+    DiagnosticSink*                 sink,
+    const LoadedModuleDictionary*   loadedModules)
+{
+    if (!filePathInfo.hasFileFoundPath())
+    {
+        return nullptr;
+    }
+
+    // The serialized module is looked for next to the source, and then in the cache directory
+    const String serializedPath = Path::replaceExt(filePathInfo.foundPath, "slang-module");
+
+    ComPtr<ISlangBlob> blob;
+    if (SLANG_SUCCEEDED(getFileSystemExt()->loadFile(serializedPath.getBuffer(), blob.writeRef())))
+    {
+        if (auto module = _readSerializedModule(name, filePathInfo, fileContentsBlob, blob, loc, sink, loadedModules))
+        {
+            return module;
+        }
+    }
+
+    if (m_moduleCacheDirectory.getLength())
+    {
+        const String cachePath = _getModuleCachePath(filePathInfo);
+        if (SLANG_SUCCEEDED(OSFileSystem::getExtSingleton()->loadFile(cachePath.getBuffer(), blob.writeRef())))
+        {
+            return _readSerializedModule(name, filePathInfo, fileContentsBlob, blob, loc, sink, loadedModules);
+        }
+    }
+
+    return nullptr;
+}
+
+RefPtr<Module> Linkage::_readSerializedModule(
+    Name*                           name,
+    const PathInfo&                 filePathInfo,
+    ISlangBlob*                     fileContentsBlob,
+    ISlangBlob*                     serializedModuleBlob,
+    SourceLoc const&                loc,
+    DiagnosticSink*                 sink,
+    const LoadedModuleDictionary*   loadedModules)
+{
+    // The container references the blob, and both are kept in scope until the IR of the module has been read
+    RefPtr<BlobRiffContainer> blobContainer = new BlobRiffContainer;
+    blobContainer->m_blob = serializedModuleBlob;
+    ISlangBlob* blob = serializedModuleBlob;
+
+    if (SLANG_FAILED(RiffUtil::readInPlace(blob->getBufferPointer(), blob->getBufferSize(), blobContainer->m_container)))
+    {
+        return nullptr;
+    }
+
+    // A serialized module that wasn't written by `_saveSerializedModule` (for example the output of `-o foo.slang-module`)
+    // can't be validated, so isn't used
+    RiffContainer::ListChunk* listChunk = blobContainer->m_container.getRoot()->findListRec(SerializedModuleBinary::kSerializedModuleFourCc);
+    UnownedStringSlice storedKey, sourceFilesText, importsText, sourceDigest;
+    if (!listChunk ||
+        SLANG_FAILED(_findSerializedModuleString(listChunk, SerializedModuleBinary::kKeyFourCc, storedKey)) ||
+        SLANG_FAILED(_findSerializedModuleString(listChunk, SerializedModuleBinary::kSourceFilesFourCc, sourceFilesText)) ||
+        SLANG_FAILED(_findSerializedModuleString(listChunk, SerializedModuleBinary::kImportsFourCc, importsText)) ||
+        SLANG_FAILED(_findSerializedModuleString(listChunk, SerializedModuleBinary::kSourceDigestFourCc, sourceDigest)))
+    {
+        return nullptr;
+    }
+
+    // Load the current contents of each of the source files. The first is always the source of the module itself.
+    List<UnownedStringSlice> sourcePaths;
+    StringUtil::split(sourceFilesText, '\n', sourcePaths);
+    if (sourcePaths.getCount() && sourcePaths.getLast().getLength() == 0)
+    {
+        sourcePaths.removeLast();
+    }
+    if (sourcePaths.getCount() == 0 || sourcePaths[0] != filePathInfo.foundPath.getUnownedSlice())
+    {
+        return nullptr;
+    }
+
+    List<ComPtr<ISlangBlob>> sourceBlobs;
+    List<KeyValuePair<String, UnownedStringSlice>> sourceFiles;
+    for (Index i = 0; i < sourcePaths.getCount(); ++i)
+    {
+        ComPtr<ISlangBlob> sourceBlob;
+        if (i == 0)
+        {
+            sourceBlob = fileContentsBlob;
+        }
+        else if (SLANG_FAILED(getFileSystemExt()->loadFile(String(sourcePaths[i]).getBuffer(), sourceBlob.writeRef())))
+        {
+            return nullptr;
+        }
+        sourceBlobs.add(sourceBlob);
+        sourceFiles.add(KeyValuePair<String, UnownedStringSlice>(sourcePaths[i], StringUtil::getSlice(sourceBlob)));
+    }
+
+    // The source is checked before importing anything, so that a stale serialized module can't cause modules
+    // that the current source doesn't import to be imported
+    {
+        StringBuilder key;
+        _calcSerializedModuleKey(sourceFiles, List<Module*>(), key);
+        if (!storedKey.startsWith(key.getUnownedSlice()))
+        {
+            return nullptr;
+        }
+    }
+
+    // The source is unchanged, so it imports the same modules, which can now be imported
+    List<UnownedStringSlice> importNames;
+    StringUtil::split(importsText, '\n', importNames);
+
+    List<Module*> importedModules;
+    for (const auto& importName : importNames)
+    {
+        if (importName.getLength() == 0)
+        {
+            continue;
+        }
+        RefPtr<Module> importedModule = findOrImportModule(getNamePool()->getName(importName), loc, sink, loadedModules);
+        if (!importedModule)
+        {
+            return nullptr;
+        }
+        importedModules.add(importedModule);
+    }
+
+    {
+        StringBuilder key;
+        if (!_calcSerializedModuleKey(sourceFiles, importedModules, key) || key.getUnownedSlice() != storedKey)
+        {
+            return nullptr;
+        }
+    }
+
+    // Read the AST and IR. The IR is only read when it is first used.
+    SerialContainerData containerData;
+
+    SerialContainerUtil::ReadOptions options;
+    options.namePool = getNamePool();
+    options.session = getSessionImpl();
+    options.sharedASTBuilder = getASTBuilder()->getSharedASTBuilder();
+    options.sourceManager = getSourceManager();
+    options.linkage = this;
+    options.sink = sink;
+    options.lazyIRContainerScope = blobContainer;
+    options.freezeIRModules = true;
+
+    if (SLANG_FAILED(SerialContainerUtil::read(&blobContainer->m_container, options, containerData)) ||
+        containerData.modules.getCount() != 1)
+    {
+        return nullptr;
+    }
+
+    auto& srcModule = containerData.modules[0];
+    ModuleDecl* moduleDecl = as<ModuleDecl>(srcModule.astRootNode);
+    if (!moduleDecl || !(srcModule.irModule || srcModule.irModuleReader))
+    {
+        return nullptr;
+    }
+
+    RefPtr<Module> module(new Module(this, srcModule.astBuilder));
+
+    // Set the module back reference on the decl
+    moduleDecl->module = module;
+    module->setModuleDecl(moduleDecl);
+
+    module->setIRModule(srcModule.irModule);
+    module->setIRModuleReader(srcModule.irModuleReader);
+
+    // Record the same dependencies as if the module was compiled from source
+    for (auto importedModule : importedModules)
+    {
+        module->addModuleDependency(importedModule);
+    }
+    for (const auto& sourceFile : sourceFiles)
+    {
+        module->addFilePathDependency(sourceFile.Key);
+    }
+    module->setSourceDigest(sourceDigest);
+
+    // The global shader parameters and requirements (the modules it imports, which must be linked with it)
+    // are found as they are when the module is checked
+    module->_collectShaderParams();
+
+    mapPathToLoadedModule.Add(filePathInfo.getMostUniqueIdentity(), module);
+    mapNameToLoadedModules.Add(name, module);
+    loadedModulesList.add(module);
+
+    return module;
+}
+
+SlangResult Linkage::_saveSerializedModule(
+    Module*                         module,
+    const PathInfo&                 filePathInfo)
+{
+    // The IR isn't produced if there were errors
+    if (!module->getIRModule() || !filePathInfo.hasFileFoundPath())
+    {
+        return SLANG_FAIL;
+    }
+
+    // The source of the module itself comes first, and then the files it `#include`s
+    List<KeyValuePair<String, UnownedStringSlice>> sourceFiles;
+    sourceFiles.add(KeyValuePair<String, UnownedStringSlice>(filePathInfo.foundPath, UnownedStringSlice()));
+    for (auto sourceFile : module->getSourceFileDependencyList())
+    {
+        const String& foundPath = sourceFile->getPathInfo().foundPath;
+        if (foundPath == filePathInfo.foundPath)
+        {
+            sourceFiles[0].Value = sourceFile->getContent();
+        }
+        else
+        {
+            sourceFiles.add(KeyValuePair<String, UnownedStringSlice>(foundPath, sourceFile->getContent()));
+        }
+    }
+
+    List<Module*> importedModules;
+    for (auto importedModule : module->getModuleDependencyList())
+    {
+        // The standard library is identified by the version
+        if (importedModule != module && importedModule->getLinkage() != getSessionImpl()->getBuiltinLinkage())
+        {
+            importedModules.add(importedModule);
+        }
+    }
+
+    StringBuilder key;
+    if (!_calcSerializedModuleKey(sourceFiles, importedModules, key))
+    {
+        return SLANG_FAIL;
+    }
+
+    StringBuilder sourceFilesText;
+    for (const auto& sourceFile : sourceFiles)
+    {
+        sourceFilesText << sourceFile.Key << "\n";
+    }
+    StringBuilder importsText;
+    for (auto importedModule : importedModules)
+    {
+        importsText << getText(importedModule->getModuleDecl()->getName()) << "\n";
+    }
+
+    RiffContainer container;
+    {
+        RiffContainer::ScopeChunk scope(&container, RiffContainer::Chunk::Kind::List, SerializedModuleBinary::kSerializedModuleFourCc);
+
+        _writeSerializedModuleString(&container, SerializedModuleBinary::kKeyFourCc, key.getUnownedSlice());
+        _writeSerializedModuleString(&container, SerializedModuleBinary::kSourceFilesFourCc, sourceFilesText.getUnownedSlice());
+        _writeSerializedModuleString(&container, SerializedModuleBinary::kImportsFourCc, importsText.getUnownedSlice());
+        _writeSerializedModuleString(&container, SerializedModuleBinary::kSourceDigestFourCc, module->getSourceDigest());
+
+        SerialContainerUtil::WriteOptions options;
+        options.compressionType = serialCompressionType;
+        options.optionFlags |= SerialOptionFlag::SourceLocation;
+        options.sourceManager = getSourceManager();
+
+        SerialContainerData data;
+        SLANG_RETURN_ON_FAIL(SerialContainerUtil::addModuleToData(module, options, data));
+        SLANG_RETURN_ON_FAIL(SerialContainerUtil::write(data, options, &container));
+    }
+
+    OwnedMemoryStream stream(FileAccess::Write);
+    SLANG_RETURN_ON_FAIL(RiffUtil::write(container.getRoot(), true, &stream));
+    auto contents = stream.getContents();
+
+    SlangPathType pathType;
+    if (SLANG_FAILED(Path::getPathType(m_moduleCacheDirectory, &pathType)))
+    {
+        Path::createDirectory(m_moduleCacheDirectory);
+    }
+
+    // Another process reading the same directory never sees a partially written module, and a module
+    // that was saved before is replaced.
+    return File::writeAllBytesAtomically(_getModuleCachePath(filePathInfo), contents.getBuffer(), size_t(contents.getCount()));
+}
+
+String Linkage::_getModuleCachePath(const PathInfo& filePathInfo)
+{
+    String canonicalPath;
+    if (SLANG_FAILED(Path::getCanonical(filePathInfo.foundPath, canonicalPath)))
+    {
+        canonicalPath = filePathInfo.foundPath;
+    }
+    const HashCode64 pathHash = getStableHashCode64(canonicalPath.getBuffer(), size_t(canonicalPath.getLength()));
+
+    StringBuilder fileName;
+    fileName << Path::getFileNameWithoutExt(filePathInfo.foundPath) << "-";
+    fileName.append(uint64_t(pathHash), 16);
+    fileName << ".slang-module";
+    return Path::combine(m_moduleCacheDirectory, fileName);
 }
 
 //
@@ -3192,11 +3852,75 @@ void Module::addFilePathDependency(String const& path)
     m_filePathDependencyList.addDependency(path);
 }
 
+void Module::addFileDependency(SourceFile* sourceFile)
+{
+    // We want to record that the compiled module has a dependency
+    // on the path of the source file, but we also need to account
+    // for cases where the user added a source string/blob without
+    // an associated path and/or wasn't from a file.
+
+    auto pathInfo = sourceFile->getPathInfo();
+    if (pathInfo.hasFileFoundPath())
+    {
+        addFilePathDependency(pathInfo.foundPath);
+
+        if (m_sourceFileDependencyList.indexOf(sourceFile) < 0)
+        {
+            m_sourceFileDependencyList.add(sourceFile);
+        }
+    }
+
+    // The digest identifies the source independently of where it came from,
+    // so it is also meaningful for source that has no path.
+    const auto content = sourceFile->getContent();
+    m_sourceDigest << pathInfo.getName() << " " << content.getLength() << " ";
+    m_sourceDigest.append(uint64_t(getStableHashCode64(content.begin(), size_t(content.getLength()))), 16);
+    m_sourceDigest << "\n";
+}
+
+void Module::addPreprocessorDefinitionsDependency(Dictionary<String, String> const& definitions)
+{
+    _appendPreprocessorDefinitions(definitions, m_sourceDigest);
+}
+
 void Module::setModuleDecl(ModuleDecl* moduleDecl)
 {
     m_moduleDecl = moduleDecl;
 }
 
+SlangResult Module::readIRModule(DiagnosticSink* sink)
+{
+    if (m_hasIRModuleReader)
+    {
+        std::lock_guard<std::mutex> lock(m_irModuleReaderMutex);
+
+        // Another thread may have read the IR while we were waiting
+        if (m_irModuleReader)
+        {
+            // Only a single attempt is made, and the reader (and so the data it holds in scope) is released
+            RefPtr<IRSerialContainerModuleReader> reader = m_irModuleReader;
+            m_irModuleReader.setNull();
+
+            if (SLANG_FAILED(reader->read(m_irModule)))
+            {
+                m_irModule.setNull();
+                m_irModuleReadFailed = true;
+            }
+            m_hasIRModuleReader = false;
+        }
+    }
+
+    if (m_irModuleReadFailed)
+    {
+        if (sink && m_moduleDecl)
+        {
+            sink->diagnose(m_moduleDecl, Diagnostics::unableToReadModuleIR, m_moduleDecl->getName());
+        }
+        return SLANG_FAIL;
+    }
+    return SLANG_OK;
+}
+
 RefPtr<EntryPoint> Module::findEntryPointByName(UnownedStringSlice const& name)
 {
     // TODO: We should consider having this function be expanded to be able
@@ -3402,6 +4126,30 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getEntryPointHostCallable(
     return artifact->loadSharedLibrary(ArtifactKeep::Yes, outSharedLibrary);
 }
 
+SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getTargetHostCallable(
+    SlangInt                targetIndex,
+    ISlangSharedLibrary**   outSharedLibrary,
+    slang::IBlob**          outDiagnostics)
+{
+    auto linkage = getLinkage();
+    if(targetIndex < 0 || targetIndex >= linkage->targets.getCount())
+        return SLANG_E_INVALID_ARG;
+    auto target = linkage->targets[targetIndex];
+
+    auto targetProgram = getTargetProgram(target);
+
+    // All of the entry points are emitted into a single source, and compiled with
+    // a single invocation of the downstream compiler.
+    DiagnosticSink sink(linkage->getSourceManager(), Lexer::sourceLocationLexer);
+    IArtifact* artifact = targetProgram->getOrCreateWholeProgramResult(&sink);
+    sink.getBlobIfNeeded(outDiagnostics);
+
+    if(artifact == nullptr)
+        return SLANG_FAIL;
+
+    return artifact->loadSharedLibrary(ArtifactKeep::Yes, outSharedLibrary);
+}
+
 RefPtr<ComponentType> ComponentType::specialize(
     SpecializationArg const*    inSpecializationArgs,
     SlangInt                    specializationArgCount,
@@ -4334,6 +5082,11 @@ void Linkage::setFileSystem(ISlangFileSystem* inFileSystem)
     getSourceManager()->setFileSystemExt(m_fileSystemExt);
 }
 
+void Linkage::setCompileCacheDirectory(String const& directory)
+{
+    m_compileCache = directory.getLength() ? new ArtifactDiskCache(directory) : nullptr;
+}
+
 void Linkage::setRequireCacheFileSystem(bool requireCacheFileSystem)
 {
     if (requireCacheFileSystem == m_requireCacheFileSystem)
@@ -4429,6 +5182,10 @@ Session::~Session()
 {
     // destroy modules next
     stdlibModules = decltype(stdlibModules)();
+
+    // Any linkage that adds to the shared cache retains the session, so they must all be gone by now.
+    // (The builtin linkage doesn't retain the session, and doesn't add to it.)
+    delete m_sharedTypeCheckingCache;
 }
 
 }
@@ -4594,6 +5351,34 @@ void EndToEndCompileRequest::setDiagnosticFlags(SlangDiagnosticFlags flags)
     getSink()->setFlags(sinkFlags);
 }
 
+void EndToEndCompileRequest::setCompileTraceEnabled(bool enable)
+{
+    auto linkage = getLinkage();
+    if (!enable)
+    {
+        linkage->m_compileTrace.setNull();
+    }
+    else if (!linkage->m_compileTrace)
+    {
+        linkage->m_compileTrace = new CompileTrace;
+    }
+}
+
+SlangResult EndToEndCompileRequest::getCompileTrace(ISlangBlob** outTrace)
+{
+    auto trace = getLinkage()->getCompileTrace();
+    if (!trace)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    StringBuilder buf;
+    trace->writeChromeTrace(buf);
+
+    *outTrace = StringBlob::moveCreate(buf).detach();
+    return SLANG_OK;
+}
+
 SlangResult EndToEndCompileRequest::addTargetCapability(SlangInt targetIndex, SlangCapabilityID capability)
 {
     auto& targets = getLinkage()->targets;
@@ -4921,6 +5706,17 @@ SlangResult EndToEndCompileRequest::EndToEndCompileRequest::compile()
         }
     }
 
+    // Trace output handling
+    if (m_traceOutputPath.getLength())
+    {
+        ComPtr<ISlangBlob> traceBlob;
+        if (SLANG_FAILED(getCompileTrace(traceBlob.writeRef())) ||
+            SLANG_FAILED(File::writeAllBytes(m_traceOutputPath, traceBlob->getBufferPointer(), traceBlob->getBufferSize())))
+        {
+            getSink()->diagnose(SourceLoc(), Diagnostics::cannotWriteOutputFile, m_traceOutputPath);
+        }
+    }
+
     return res;
 }
 
@@ -6,6 +6,10 @@ SLANG_API void spSetCommandLineCompilerMode(SlangCompileRequest* request);
 
 #include "../core/slang-io.h"
 #include "../core/slang-test-tool-util.h"
+#include "../core/slang-writer.h"
+
+#include "../compiler-core/slang-json-rpc-connection.h"
+#include "../compiler-core/slang-compile-server-protocol.h"
 
 using namespace Slang;
 
@@ -26,8 +30,12 @@ static void _diagnosticCallback(
     stdError.flush();
 }
 
-static SlangResult _compile(SlangCompileRequest* compileRequest, int argc, const char*const* argv)
+static SlangResult _compile(SlangCompileRequest* compileRequest, StdWriters* stdWriters, int argc, const char*const* argv)
 {
+    // Output that isn't written to a file goes to the std writers, which are not the console when run as a compile server
+    spSetWriter(compileRequest, SLANG_WRITER_CHANNEL_STD_OUTPUT, stdWriters->getWriter(SLANG_WRITER_CHANNEL_STD_OUTPUT));
+    spSetWriter(compileRequest, SLANG_WRITER_CHANNEL_STD_ERROR, stdWriters->getWriter(SLANG_WRITER_CHANNEL_STD_ERROR));
+
     spSetDiagnosticCallback(compileRequest, &_diagnosticCallback, nullptr);
     spSetCommandLineCompilerMode(compileRequest);
 
@@ -90,17 +98,326 @@ SLANG_TEST_TOOL_API SlangResult innerMain(StdWriters* stdWriters, slang::IGlobal
 
     SlangCompileRequest* compileRequest = spCreateCompileRequest(session);
     compileRequest->addSearchPath(Path::getParentDirectory(Path::getExecutablePath()).getBuffer());
-    SlangResult res = _compile(compileRequest, argc, argv);
+    SlangResult res = _compile(compileRequest, stdWriters, argc, argv);
     // Now that we are done, clean up after ourselves
     spDestroyCompileRequest(compileRequest);
 
     return res;
 }
 
+namespace { // anonymous
+
+/* When slangc is run with `-compile-server` as its first argument, it stays running and compiles the command lines sent
+to it as JSON-RPC calls on stdin (see CompileServerProtocol), returning what would have been output as the result.
+
+The global session is created once, so the stdlib is only loaded once, and the type checking results for the stdlib
+are shared between compilations. If the server is given `-module-cache <dir>`, compilations that don't specify a module
+cache use that directory, so imported modules whose source hasn't changed are read from there rather than compiled
+again.
+
+Compilations with the same options (that is the same arguments, other than the source files and outputs) are made on the
+same linkage, so the modules they import are only loaded once, and the preprocessor reuses the tokens of the files they
+include. A linkage doesn't notice files changing, so one is only reused while none of the files that were compiled
+on it have changed, otherwise a new one is created. */
+class CompileServer
+{
+public:
+    SlangResult init(int argc, const char*const* argv);
+
+        /// Execute the server, until it is told to quit or the connection is closed
+    SlangResult execute();
+
+protected:
+        /// A linkage kept for compilations with the same options
+    struct ReusableLinkage : public RefObject
+    {
+        ComPtr<slang::ISession> m_session;
+        Dictionary<String, HashCode64> m_fileHashes;    ///< Hash of the contents of each file compiled on the linkage
+    };
+
+    SlangResult _executeSingle();
+    SlangResult _compile(const JSONRPCCall& call);
+
+        /// Compile `argv` on the linkage for its options, or a new one if there isn't one that can be reused
+    SlangResult _compileOnLinkage(const String& linkageKey, StdWriters* stdWriters, int argc, const char*const* argv, bool& outReusedLinkage);
+
+        /// Get the key for the linkage to compile `args` on. Returns false if the compilation should have a linkage to itself.
+    static bool _getLinkageKey(const List<String>& args, String& outKey);
+        /// True if none of the files compiled on `linkage` have changed
+    static bool _isUpToDate(ReusableLinkage* linkage);
+    static HashCode64 _getFileHash(const String& path, bool& outExists);
+
+    bool m_quit = false;
+
+    String m_exePath;
+    String m_moduleCacheDirectory;                  ///< Used by compilations that don't specify a module cache
+
+    ComPtr<slang::IGlobalSession> m_session;        ///< Shared by all of the compilations
+    Dictionary<String, RefPtr<ReusableLinkage>> m_linkages;    ///< Linkages keyed by the options of the compilations on them
+    RefPtr<JSONRPCConnection> m_connection;
+};
+
+SlangResult CompileServer::init(int argc, const char*const* argv)
+{
+    m_exePath = argv[0];
+
+    // Arguments after `-compile-server`
+    for (int i = 2; i < argc; ++i)
+    {
+        const UnownedStringSlice arg(argv[i]);
+        if (arg == "-module-cache" && i + 1 < argc)
+        {
+            m_moduleCacheDirectory = argv[++i];
+        }
+        else
+        {
+            StdWriters::getError().print("error: unknown compile server option '%s'\n", argv[i]);
+            return SLANG_FAIL;
+        }
+    }
+
+    SLANG_RETURN_ON_FAIL(slang_createGlobalSession(SLANG_API_VERSION, m_session.writeRef()));
+    TestToolUtil::setSessionDefaultPreludeFromExePath(m_exePath.getBuffer(), m_session);
+
+    m_connection = new JSONRPCConnection;
+    SLANG_RETURN_ON_FAIL(m_connection->initWithStdStreams());
+    return SLANG_OK;
+}
+
+SlangResult CompileServer::_executeSingle()
+{
+    // Block waiting for content (or error/closed)
+    SLANG_RETURN_ON_FAIL(m_connection->waitForResult());
+
+    if (!m_connection->hasMessage())
+    {
+        return SLANG_OK;
+    }
+
+    if (m_connection->getMessageType() != JSONRPCMessageType::Call)
+    {
+        return m_connection->sendError(JSONRPC::ErrorCode::InvalidRequest, m_connection->getCurrentMessageId());
+    }
+
+    JSONRPCCall call;
+    SLANG_RETURN_ON_FAIL(m_connection->getRPCOrSendError(&call));
+
+    if (call.method == CompileServerProtocol::QuitArgs::g_methodName)
+    {
+        m_quit = true;
+
+        // Reply, so the client knows the call was received before the server exits
+        CompileServerProtocol::QuitResult result;
+        return m_connection->sendResult(&result, call.id);
+    }
+    else if (call.method == CompileServerProtocol::CompileArgs::g_methodName)
+    {
+        return _compile(call);
+    }
+    return m_connection->sendError(JSONRPC::ErrorCode::MethodNotFound, call.id);
+}
+
+SlangResult CompileServer::_compile(const JSONRPCCall& call)
+{
+    auto id = m_connection->getPersistentValue(call.id);
+
+    CompileServerProtocol::CompileArgs args;
+    SLANG_RETURN_ON_FAIL(m_connection->toNativeArgsOrSendError(call.params, &args, id));
+
+    List<const char*> toolArgs;
+    toolArgs.add(m_exePath.getBuffer());
+    bool hasModuleCache = false;
+    for (const auto& arg : args.args)
+    {
+        toolArgs.add(arg.getBuffer());
+        hasModuleCache = hasModuleCache || arg == "-module-cache";
+    }
+    if (m_moduleCacheDirectory.getLength() && !hasModuleCache)
+    {
+        toolArgs.add("-module-cache");
+        toolArgs.add(m_moduleCacheDirectory.getBuffer());
+    }
+
+    StdWriters stdWriters;
+    StringBuilder stdOut;
+    StringBuilder stdError;
+
+    // Make writer/s act as if they are the console.
+    RefPtr<StringWriter> stdOutWriter(new StringWriter(&stdOut, WriterFlag::IsConsole));
+    RefPtr<StringWriter> stdErrorWriter(new StringWriter(&stdError, WriterFlag::IsConsole));
+
+    stdWriters.setWriter(SLANG_WRITER_CHANNEL_STD_ERROR, stdErrorWriter);
+    stdWriters.setWriter(SLANG_WRITER_CHANNEL_STD_OUTPUT, stdOutWriter);
+
+    // Compiling replaces the singleton, which has to be restored as stdWriters is about to go out of scope
+    StdWriters* prevStdWriters = StdWriters::getSingleton();
+    String linkageKey;
+    bool reusedLinkage = false;
+    const SlangResult res = _getLinkageKey(args.args, linkageKey) ?
+        _compileOnLinkage(linkageKey, &stdWriters, int(toolArgs.getCount()), toolArgs.getBuffer(), reusedLinkage) :
+        innerMain(&stdWriters, m_session, int(toolArgs.getCount()), toolArgs.getBuffer());
+    StdWriters::setSingleton(prevStdWriters);
+
+    CompileServerProtocol::CompileResult result;
+    result.result = res;
+    result.stdOut = stdOut;
+    result.stdError = stdError;
+    result.returnCode = int32_t(TestToolUtil::getReturnCode(res));
+    result.reusedLinkage = reusedLinkage;
+    return m_connection->sendResult(&result, id);
+}
+
+SlangResult CompileServer::_compileOnLinkage(const String& linkageKey, StdWriters* stdWriters, int argc, const char*const* argv, bool& outReusedLinkage)
+{
+    StdWriters::setSingleton(stdWriters);
+
+    RefPtr<ReusableLinkage> linkage;
+    if (auto found = m_linkages.TryGetValue(linkageKey))
+    {
+        linkage = *found;
+    }
+    if (linkage && !_isUpToDate(linkage))
+    {
+        linkage.setNull();
+        m_linkages.Remove(linkageKey);
+    }
+
+    outReusedLinkage = linkage != nullptr;
+
+    ComPtr<slang::ICompileRequest> compileRequest;
+    if (linkage)
+    {
+        SLANG_RETURN_ON_FAIL(linkage->m_session->createCompileRequest(compileRequest.writeRef()));
+    }
+    else
+    {
+        SLANG_RETURN_ON_FAIL(m_session->createCompileRequest(compileRequest.writeRef()));
+    }
+    compileRequest->addSearchPath(Path::getParentDirectory(Path::getExecutablePath()).getBuffer());
+
+    const SlangResult res = ::_compile(compileRequest, stdWriters, argc, argv);
+    if (SLANG_FAILED(res))
+    {
+        // What a failed compilation left in the linkage isn't known, so it isn't used again
+        m_linkages.Remove(linkageKey);
+        return res;
+    }
+
+    if (!linkage)
+    {
+        linkage = new ReusableLinkage;
+        SLANG_RETURN_ON_FAIL(compileRequest->getSession(linkage->m_session.writeRef()));
+        m_linkages.Add(linkageKey, linkage);
+    }
+
+    // Record the contents of the files as they were when they were compiled, so that the linkage isn't
+    // used again if they change
+    const int dependencyCount = compileRequest->getDependencyFileCount();
+    for (int i = 0; i < dependencyCount; ++i)
+    {
+        const String path = compileRequest->getDependencyFilePath(i);
+        if (!linkage->m_fileHashes.ContainsKey(path))
+        {
+            bool exists = false;
+            const HashCode64 hash = _getFileHash(path, exists);
+            if (exists)
+            {
+                linkage->m_fileHashes.Add(path, hash);
+            }
+        }
+    }
+
+    return res;
+}
+
+/* static */bool CompileServer::_getLinkageKey(const List<String>& args, String& outKey)
+{
+    StringBuilder key;
+    for (Index i = 0; i < args.getCount(); ++i)
+    {
+        const String& arg = args[i];
+
+        // Options that add to the state of the linkage each time they are applied, or replace it
+        if (arg.startsWith("-X") || arg == "-r" || arg.startsWith("-load-repro") ||
+            arg == "-load-stdlib" || arg == "-compile-stdlib")
+        {
+            return false;
+        }
+
+        // The outputs and source files aren't part of the options
+        if (arg == "-o")
+        {
+            ++i;
+            continue;
+        }
+        if (!arg.startsWith("-"))
+        {
+            const String ext = Path::getPathExt(arg);
+            if (ext == "slang" || ext == "hlsl" || ext == "fx" || ext == "glsl")
+            {
+                continue;
+            }
+        }
+
+        key << arg << "\n";
+    }
+
+    outKey = key.ProduceString();
+    return true;
+}
+
+/* static */HashCode64 CompileServer::_getFileHash(const String& path, bool& outExists)
+{
+    List<unsigned char> contents;
+    outExists = SLANG_SUCCEEDED(File::readAllBytes(path, contents));
+    return outExists ? getStableHashCode64((const char*)contents.getBuffer(), size_t(contents.getCount())) : 0;
+}
+
+/* static */bool CompileServer::_isUpToDate(ReusableLinkage* linkage)
+{
+    for (const auto& pair : linkage->m_fileHashes)
+    {
+        bool exists = false;
+        const HashCode64 hash = _getFileHash(pair.Key, exists);
+        if (!exists || hash != pair.Value)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+SlangResult CompileServer::execute()
+{
+    while (m_connection->isActive() && !m_quit)
+    {
+        // Failure doesn't make the execution terminate
+        _executeSingle();
+    }
+    return SLANG_OK;
+}
+
+} // anonymous
+
+static SlangResult _runCompileServer(int argc, const char*const* argv)
+{
+    CompileServer server;
+    SLANG_RETURN_ON_FAIL(server.init(argc, argv));
+    return server.execute();
+}
+
 int MAIN(int argc, char** argv)
 {
     auto stdWriters = StdWriters::initDefaultSingleton();
-    SlangResult res = innerMain(stdWriters, nullptr, argc, argv);
+    SlangResult res;
+    if (argc > 1 && UnownedStringSlice(argv[1]) == "-compile-server")
+    {
+        res = _runCompileServer(argc, argv);
+    }
+    else
+    {
+        res = innerMain(stdWriters, nullptr, argc, argv);
+    }
     return (int)TestToolUtil::getReturnCode(res);
 }
 
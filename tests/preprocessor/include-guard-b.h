@@ -0,0 +1,14 @@
+// include-guard-b.h
+
+// Used by the `include-guard.slang` test
+//
+// Has an `#else`, so isn't an include guard, as something
+// is included even if the macro is defined
+
+#ifndef INCLUDE_GUARD_B_H
+#define INCLUDE_GUARD_B_H
+#define B_COUNT 1
+#else
+#undef B_COUNT
+#define B_COUNT 2
+#endif
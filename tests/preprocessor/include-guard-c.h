@@ -0,0 +1,11 @@
+// include-guard-c.h
+
+// Used by the `include-guard.slang` test
+//
+// Has a definition after the `#endif`, so isn't an include guard
+
+#ifndef INCLUDE_GUARD_C_H
+#define INCLUDE_GUARD_C_H
+#endif
+
+#define C_INCLUDED 1
@@ -0,0 +1,177 @@
+#include "tools/unit-test/slang-unit-test.h"
+
+#include "slang-gfx.h"
+#include "gfx-test-util.h"
+#include "tools/gfx-util/shader-cursor.h"
+#include "source/core/slang-basic.h"
+
+using namespace gfx;
+
+namespace gfx_test
+{
+        /// Apply an `AddTransformer` with `c` to the numbers in `numbersBuffer` using `pipelineState`
+    static void dispatchAddTransformer(
+        IDevice* device,
+        ITransientResourceHeap* transientHeap,
+        IPipelineState* pipelineState,
+        slang::TypeReflection* addTransformerType,
+        float c,
+        IBufferResource* numbersBuffer)
+    {
+        ComPtr<IResourceView> bufferView;
+        IResourceView::Desc viewDesc = {};
+        viewDesc.type = IResourceView::Type::UnorderedAccess;
+        viewDesc.format = Format::Unknown;
+        GFX_CHECK_CALL_ABORT(
+            device->createBufferView(numbersBuffer, nullptr, viewDesc, bufferView.writeRef()));
+
+        ComPtr<IShaderObject> transformer;
+        GFX_CHECK_CALL_ABORT(device->createShaderObject(
+            addTransformerType, ShaderObjectContainerType::None, transformer.writeRef()));
+        ShaderCursor(transformer).getPath("c").setData(&c, sizeof(float));
+
+        ICommandQueue::Desc queueDesc = { ICommandQueue::QueueType::Graphics };
+        auto queue = device->createCommandQueue(queueDesc);
+
+        auto commandBuffer = transientHeap->createCommandBuffer();
+        auto encoder = commandBuffer->encodeComputeCommands();
+
+        auto rootObject = encoder->bindPipeline(pipelineState);
+
+        ShaderCursor entryPointCursor(rootObject->getEntryPoint(0));
+        entryPointCursor.getPath("buffer").setResource(bufferView);
+        entryPointCursor.getPath("transformer").setObject(transformer);
+
+        encoder->dispatchCompute(1, 1, 1);
+        encoder->endEncoding();
+        commandBuffer->close();
+        queue->executeCommandBuffer(commandBuffer);
+        queue->waitOnHost();
+    }
+
+    static ComPtr<IBufferResource> createNumbersBuffer(IDevice* device)
+    {
+        float initialData[] = { 0.0f, 1.0f, 2.0f, 3.0f };
+        IBufferResource::Desc bufferDesc = {};
+        bufferDesc.sizeInBytes = sizeof(initialData);
+        bufferDesc.format = gfx::Format::Unknown;
+        bufferDesc.elementSize = sizeof(float);
+        bufferDesc.allowedStates = ResourceStateSet(
+            ResourceState::ShaderResource,
+            ResourceState::UnorderedAccess,
+            ResourceState::CopyDestination,
+            ResourceState::CopySource);
+        bufferDesc.defaultState = ResourceState::UnorderedAccess;
+        bufferDesc.memoryType = MemoryType::DeviceLocal;
+
+        ComPtr<IBufferResource> numbersBuffer;
+        GFX_CHECK_CALL_ABORT(device->createBufferResource(
+            bufferDesc,
+            (void*)initialData,
+            numbersBuffer.writeRef()));
+        return numbersBuffer;
+    }
+
+    // Tests a pipeline that is specialized in the background, using a fallback that uses dynamic dispatch until the
+    // specialization is ready, and that the specializations created can be recorded and prewarmed.
+    void asyncPipelineSpecializationTestImpl(IDevice* device, UnitTestContext* context)
+    {
+        Slang::ComPtr<ITransientResourceHeap> transientHeap;
+        ITransientResourceHeap::Desc transientHeapDesc = {};
+        transientHeapDesc.constantBufferSize = 4096;
+        GFX_CHECK_CALL_ABORT(
+            device->createTransientResourceHeap(transientHeapDesc, transientHeap.writeRef()));
+
+        ComPtr<slang::ISession> slangSession;
+        GFX_CHECK_CALL_ABORT(device->getSlangSession(slangSession.writeRef()));
+
+        ComPtr<slang::IBlob> diagnosticsBlob;
+        slang::IModule* module = slangSession->loadModule("compute-smoke", diagnosticsBlob.writeRef());
+        diagnoseIfNeeded(diagnosticsBlob);
+        SLANG_CHECK_ABORT(module != nullptr);
+
+        ComPtr<slang::IEntryPoint> entryPoint;
+        GFX_CHECK_CALL_ABORT(module->findEntryPointByName("computeMain", entryPoint.writeRef()));
+
+        slang::IComponentType* componentTypes[] = { module, entryPoint };
+        ComPtr<slang::IComponentType> composedProgram;
+        GFX_CHECK_CALL_ABORT(slangSession->createCompositeComponentType(
+            componentTypes, 2, composedProgram.writeRef(), diagnosticsBlob.writeRef()));
+        diagnoseIfNeeded(diagnosticsBlob);
+
+        slang::TypeReflection* addTransformerType = composedProgram->getLayout()->findTypeByName("AddTransformer");
+        SLANG_CHECK_ABORT(addTransformerType != nullptr);
+
+        // The fallback uses dynamic dispatch for `transformer`, so has the same parameter layout
+        ComPtr<slang::IComponentType> dynamicProgram;
+        slang::SpecializationArg dynamicArg = slang::SpecializationArg::fromType(slangSession->getDynamicType());
+        GFX_CHECK_CALL_ABORT(composedProgram->specialize(
+            &dynamicArg, 1, dynamicProgram.writeRef(), diagnosticsBlob.writeRef()));
+        diagnoseIfNeeded(diagnosticsBlob);
+
+        IShaderProgram::Desc programDesc = {};
+        programDesc.slangGlobalScope = dynamicProgram.get();
+        ComPtr<IShaderProgram> fallbackProgram = device->createProgram(programDesc);
+        SLANG_CHECK_ABORT(fallbackProgram != nullptr);
+
+        programDesc.slangGlobalScope = composedProgram.get();
+        ComPtr<IShaderProgram> shaderProgram = device->createProgram(programDesc);
+        SLANG_CHECK_ABORT(shaderProgram != nullptr);
+
+        ComputePipelineStateDesc fallbackPipelineDesc = {};
+        fallbackPipelineDesc.program = fallbackProgram.get();
+        ComPtr<IPipelineState> fallbackPipelineState;
+        GFX_CHECK_CALL_ABORT(
+            device->createComputePipelineState(fallbackPipelineDesc, fallbackPipelineState.writeRef()));
+
+        ComputePipelineStateDesc pipelineDesc = {};
+        pipelineDesc.program = shaderProgram.get();
+        pipelineDesc.specializationFallback = fallbackPipelineState;
+        ComPtr<IPipelineState> pipelineState;
+        GFX_CHECK_CALL_ABORT(
+            device->createComputePipelineState(pipelineDesc, pipelineState.writeRef()));
+
+        // The first dispatch queues the specialization, and (unless it is already done) uses the fallback. The second
+        // uses the specialization if it is ready by then. Both must produce the same results.
+        ComPtr<IBufferResource> firstBuffer = createNumbersBuffer(device);
+        dispatchAddTransformer(device, transientHeap, pipelineState, addTransformerType, 1.0f, firstBuffer);
+        compareComputeResult(device, firstBuffer, Slang::makeArray<float>(11.0f, 12.0f, 13.0f, 14.0f));
+
+        ComPtr<IBufferResource> secondBuffer = createNumbersBuffer(device);
+        dispatchAddTransformer(device, transientHeap, pipelineState, addTransformerType, 2.0f, secondBuffer);
+        compareComputeResult(device, secondBuffer, Slang::makeArray<float>(12.0f, 13.0f, 14.0f, 15.0f));
+
+        // The specialization for `AddTransformer` is recorded, whether or not it has been created yet
+        ComPtr<ISlangBlob> keys;
+        GFX_CHECK_CALL_ABORT(device->getSpecializedPipelineKeys(pipelineState, keys.writeRef()));
+        const Slang::UnownedStringSlice keysText((const char*)keys->getBufferPointer(), keys->getBufferSize());
+        SLANG_CHECK(keysText.trim() == Slang::toSlice("AddTransformer"));
+
+        // Prewarming another pipeline with the keys creates the same specializations for it
+        pipelineDesc.specializationFallback = nullptr;
+        ComPtr<IPipelineState> prewarmedPipelineState;
+        GFX_CHECK_CALL_ABORT(
+            device->createComputePipelineState(pipelineDesc, prewarmedPipelineState.writeRef()));
+        GFX_CHECK_CALL_ABORT(device->prewarmSpecializedPipelines(prewarmedPipelineState, keys));
+
+        ComPtr<ISlangBlob> prewarmedKeys;
+        GFX_CHECK_CALL_ABORT(device->getSpecializedPipelineKeys(prewarmedPipelineState, prewarmedKeys.writeRef()));
+        const Slang::UnownedStringSlice prewarmedKeysText((const char*)prewarmedKeys->getBufferPointer(), prewarmedKeys->getBufferSize());
+        SLANG_CHECK(prewarmedKeysText == keysText);
+
+        // Without a fallback, the dispatch waits for the prewarmed specialization
+        ComPtr<IBufferResource> prewarmedBuffer = createNumbersBuffer(device);
+        dispatchAddTransformer(device, transientHeap, prewarmedPipelineState, addTransformerType, 3.0f, prewarmedBuffer);
+        compareComputeResult(device, prewarmedBuffer, Slang::makeArray<float>(13.0f, 14.0f, 15.0f, 16.0f));
+    }
+
+    SLANG_UNIT_TEST(asyncPipelineSpecializationD3D12)
+    {
+        runTestImpl(asyncPipelineSpecializationTestImpl, unitTestContext, Slang::RenderApiFlag::D3D12, true);
+    }
+
+    SLANG_UNIT_TEST(asyncPipelineSpecializationVulkan)
+    {
+        runTestImpl(asyncPipelineSpecializationTestImpl, unitTestContext, Slang::RenderApiFlag::Vulkan, true);
+    }
+}
@@ -8,7 +8,7 @@
 namespace gfx_test
 {
         /// Helper function for print out diagnostic messages output by Slang compiler.
-    void diagnoseIfNeeded(ISlangWriter* diagnosticWriter, slang::IBlob* diagnosticsBlob);
+    void diagnoseIfNeeded(slang::IBlob* diagnosticsBlob);
 
         /// Loads a compute shader module and produces a `gfx::IShaderProgram`.
     Slang::Result loadComputeProgram(
@@ -69,20 +69,21 @@ namespace gfx_test
         return compareComputeResult(device, buffer, 0, expectedBuffer.getBuffer(), bufferSize);
     }
     
-    Slang::ComPtr<gfx::IDevice> createTestingDevice(UnitTestContext* context, Slang::RenderApiFlag::Enum api);
+        /// Create a device for `api`. If `asyncPipelineSpecialization` is set, pipelines are specialized in the background.
+    Slang::ComPtr<gfx::IDevice> createTestingDevice(UnitTestContext* context, Slang::RenderApiFlag::Enum api, bool asyncPipelineSpecialization = false);
 
     void initializeRenderDoc();
     void renderDocBeginFrame();
     void renderDocEndFrame();
 
     template<typename ImplFunc>
-    void runTestImpl(const ImplFunc& f, UnitTestContext* context, Slang::RenderApiFlag::Enum api)
+    void runTestImpl(const ImplFunc& f, UnitTestContext* context, Slang::RenderApiFlag::Enum api, bool asyncPipelineSpecialization = false)
     {
         if ((api & context->enabledApis) == 0)
         {
             SLANG_IGNORE_TEST
         }
-        auto device = createTestingDevice(context, api);
+        auto device = createTestingDevice(context, api, asyncPipelineSpecialization);
         if (!device)
         {
             SLANG_IGNORE_TEST
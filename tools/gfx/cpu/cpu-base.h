@@ -25,6 +25,7 @@ namespace cpu
     class ResourceViewImpl;
     class BufferResourceViewImpl;
     class TextureResourceViewImpl;
+    class SamplerStateImpl;
     class ShaderObjectLayoutImpl;
     class EntryPointLayoutImpl;
     class RootShaderObjectLayoutImpl;
@@ -7,9 +7,11 @@
 #include "cpu-pipeline-state.h"
 #include "cpu-query.h"
 #include "cpu-resource-views.h"
+#include "cpu-sampler.h"
 #include "cpu-shader-object.h"
 #include "cpu-shader-program.h"
 #include "cpu-texture.h"
+#include "cpu-thread-pool.h"
 
 namespace gfx
 {
@@ -33,6 +35,8 @@ namespace cpu
 
         SLANG_RETURN_ON_FAIL(RendererBase::initialize(desc));
 
+        m_threadPool = new WorkStealingThreadPool(desc.cpuWorkerThreadCount);
+
         // Initialize DeviceInfo
         {
             m_info.deviceType = DeviceType::CPU;
@@ -152,6 +156,7 @@ namespace cpu
         IShaderProgram** outProgram,
         ISlangBlob** outDiagnosticBlob)
     {
+        std::lock_guard<std::recursive_mutex> slangLock(m_slangMutex);
         RefPtr<ShaderProgramImpl> cpuProgram = new ShaderProgramImpl();
         cpuProgram->init(desc);
         auto slangGlobalScope = cpuProgram->linkedProgram;
@@ -203,8 +208,8 @@ namespace cpu
     SLANG_NO_THROW Result SLANG_MCALL
         DeviceImpl::createSamplerState(ISamplerState::Desc const& desc, ISamplerState** outSampler)
     {
-        SLANG_UNUSED(desc);
-        *outSampler = nullptr;
+        RefPtr<SamplerStateImpl> samplerImpl = new SamplerStateImpl(desc);
+        returnComPtr(outSampler, samplerImpl);
         return SLANG_OK;
     }
 
@@ -248,10 +253,16 @@ namespace cpu
 
         auto entryPointObject = m_currentRootObject->getEntryPoint(entryPointIndex);
 
+        // All of the entry points of the program are compiled into one shared library, with a
+        // single invocation of the downstream compiler, and the result is cached on the program.
         ComPtr<ISlangSharedLibrary> sharedLibrary;
         ComPtr<ISlangBlob> diagnostics;
-        auto compileResult = program->slangGlobalScope->getEntryPointHostCallable(
-            entryPointIndex, targetIndex, sharedLibrary.writeRef(), diagnostics.writeRef());
+        SlangResult compileResult;
+        {
+            std::lock_guard<std::recursive_mutex> slangLock(m_slangMutex);
+            compileResult = program->slangGlobalScope->getTargetHostCallable(
+                targetIndex, sharedLibrary.writeRef(), diagnostics.writeRef());
+        }
         if (diagnostics)
         {
             getDebugCallback()->handleMessage(
@@ -263,17 +274,67 @@ namespace cpu
 
         auto func = (slang_prelude::ComputeFunc)sharedLibrary->findSymbolAddressByName(entryPointName);
 
-        slang_prelude::ComputeVaryingInput varyingInput;
-        varyingInput.startGroupID.x = 0;
-        varyingInput.startGroupID.y = 0;
-        varyingInput.startGroupID.z = 0;
-        varyingInput.endGroupID.x = x;
-        varyingInput.endGroupID.y = y;
-        varyingInput.endGroupID.z = z;
+        if (x <= 0 || y <= 0 || z <= 0)
+        {
+            return;
+        }
 
         auto globalParamsData = m_currentRootObject->getDataBuffer();
         auto entryPointParamsData = entryPointObject->getDataBuffer();
-        func(&varyingInput, entryPointParamsData, globalParamsData);
+
+        // Split the group grid into tiles that are executed in parallel by the thread pool.
+        // Tiles are formed by splitting along z first, then y and then x, so that each tile covers
+        // a contiguous run of groups along x where possible.
+        ComputeTiling tiling;
+        tiling.func = func;
+        tiling.entryPointParams = entryPointParamsData;
+        tiling.globalParams = globalParamsData;
+        tiling.groupCount[0] = x;
+        tiling.groupCount[1] = y;
+        tiling.groupCount[2] = z;
+
+        const Index targetTileCount = m_threadPool->getParticipantCount() > 1
+            ? m_threadPool->getParticipantCount() * kTilesPerThread
+            : 1;
+
+        Index remainingTileCount = targetTileCount;
+        for (int axis = 2; axis >= 0; --axis)
+        {
+            const Index axisTileCount = Math::Max(Index(1), Math::Min(Index(tiling.groupCount[axis]), remainingTileCount));
+            tiling.tileCount[axis] = int(axisTileCount);
+            remainingTileCount = (remainingTileCount + axisTileCount - 1) / axisTileCount;
+        }
+
+        const Index taskCount = Index(tiling.tileCount[0]) * tiling.tileCount[1] * tiling.tileCount[2];
+        m_threadPool->parallelFor(taskCount, &_executeComputeTile, &tiling);
+    }
+
+    /* static */void DeviceImpl::_executeComputeTile(void* context, Index tileIndex)
+    {
+        const ComputeTiling& tiling = *(const ComputeTiling*)context;
+
+        uint32_t startGroupID[3];
+        uint32_t endGroupID[3];
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            const Index axisTileCount = tiling.tileCount[axis];
+            const Index axisTileIndex = tileIndex % axisTileCount;
+            tileIndex /= axisTileCount;
+
+            const Index axisGroupCount = tiling.groupCount[axis];
+            startGroupID[axis] = uint32_t((axisGroupCount * axisTileIndex) / axisTileCount);
+            endGroupID[axis] = uint32_t((axisGroupCount * (axisTileIndex + 1)) / axisTileCount);
+        }
+
+        slang_prelude::ComputeVaryingInput varyingInput;
+        varyingInput.startGroupID.x = startGroupID[0];
+        varyingInput.startGroupID.y = startGroupID[1];
+        varyingInput.startGroupID.z = startGroupID[2];
+        varyingInput.endGroupID.x = endGroupID[0];
+        varyingInput.endGroupID.y = endGroupID[1];
+        varyingInput.endGroupID.z = endGroupID[2];
+
+        tiling.func(&varyingInput, tiling.entryPointParams, tiling.globalParams);
     }
 
     void DeviceImpl::copyBuffer(
@@ -4,6 +4,7 @@
 
 #include "cpu-pipeline-state.h"
 #include "cpu-shader-object.h"
+#include "cpu-thread-pool.h"
 
 namespace gfx
 {
@@ -76,9 +77,25 @@ public:
     virtual void unmap(IBufferResource* buffer, size_t offsetWritten, size_t sizeWritten) override;
 
 private:
+        /// The number of tiles a dispatch is split into per thread, so work stealing can even out imbalance.
+    static const Index kTilesPerThread = 8;
+
+        /// Describes how the group grid of a dispatch is split into tiles.
+    struct ComputeTiling
+    {
+        slang_prelude::ComputeFunc func;
+        void* entryPointParams;
+        void* globalParams;
+        int groupCount[3];
+        int tileCount[3];
+    };
+
+    static void _executeComputeTile(void* context, Index tileIndex);
+
     RefPtr<PipelineStateImpl> m_currentPipeline = nullptr;
     RefPtr<RootShaderObjectImpl> m_currentRootObject = nullptr;
     DeviceInfo m_info;
+    RefPtr<WorkStealingThreadPool> m_threadPool;
 
     virtual void setPipelineState(IPipelineState* state) override;
 
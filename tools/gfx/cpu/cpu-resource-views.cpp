@@ -1,6 +1,11 @@
 // cpu-resource-views.cpp
 #include "cpu-resource-views.h"
 
+#include "cpu-sampler.h"
+
+#include <float.h>
+#include <math.h>
+
 namespace gfx
 {
 using namespace Slang;
@@ -49,6 +54,359 @@ void TextureResourceViewImpl::Load(const int32_t* texelCoords, void* outData, si
     m_texture->m_formatInfo->unpackFunc(texelPtr, outData, dataSize);
 }
 
+// The sampler used when none is bound. This matches the nearest-neighbor
+// sampling that was done before samplers were supported.
+static gfx::ISamplerState::Desc _makeDefaultSamplerDesc()
+{
+    gfx::ISamplerState::Desc desc;
+    desc.minFilter = TextureFilteringMode::Point;
+    desc.magFilter = TextureFilteringMode::Point;
+    desc.mipFilter = TextureFilteringMode::Point;
+    desc.addressU = TextureAddressingMode::ClampToEdge;
+    desc.addressV = TextureAddressingMode::ClampToEdge;
+    desc.addressW = TextureAddressingMode::ClampToEdge;
+    return desc;
+}
+static const gfx::ISamplerState::Desc kDefaultSamplerDesc = _makeDefaultSamplerDesc();
+
+/// The parts of a sample that don't depend on the location, such that a
+/// batch of samples only has to work them out once.
+struct CPUSampleState
+{
+    TextureResourceImpl* texture;
+    gfx::ISamplerState::Desc const* samplerDesc;
+    CPUTextureFormatInfo const* formatInfo;
+    TextureAddressingMode addressModes[TextureResourceImpl::kMaxRank];
+    int32_t rank;
+    int32_t baseCoordCount;
+    int32_t levelCount;
+    int32_t layerCount;         ///< For a cube map each layer is 6 array elements
+    bool isArray;
+    bool isCube;
+};
+
+/// A location to sample, as normalized coordinates into an array element.
+struct CPUSampleLocation
+{
+    float coords[TextureResourceImpl::kMaxRank];
+    int32_t arrayElement;
+    float cubeMajorAxis;        ///< The magnitude of the major axis of a cube map direction
+};
+
+static void _initSampleState(TextureResourceImpl* texture, slang_prelude::SamplerState samplerState, CPUSampleState& outState)
+{
+    auto& desc = texture->_getDesc();
+    auto samplerImpl = static_cast<SamplerStateImpl*>(samplerState.state);
+
+    outState.texture = texture;
+    outState.samplerDesc = samplerImpl ? &samplerImpl->m_desc : &kDefaultSamplerDesc;
+    outState.formatInfo = texture->m_formatInfo;
+    outState.rank = texture->m_baseShape->rank;
+    outState.baseCoordCount = texture->m_baseShape->baseCoordCount;
+    outState.levelCount = int32_t(texture->m_mipLevels.getCount());
+    outState.isCube = desc.type == ITextureResource::Type::TextureCube;
+    outState.isArray = desc.arraySize != 0;
+    outState.layerCount = texture->m_effectiveArrayElementCount / texture->m_baseShape->implicitArrayElementCount;
+
+    // Filtering doesn't cross the edges of cube map faces, so they are always clamped.
+    auto samplerDesc = outState.samplerDesc;
+    outState.addressModes[0] = outState.isCube ? TextureAddressingMode::ClampToEdge : samplerDesc->addressU;
+    outState.addressModes[1] = outState.isCube ? TextureAddressingMode::ClampToEdge : samplerDesc->addressV;
+    outState.addressModes[2] = samplerDesc->addressW;
+}
+
+static SLANG_FORCE_INLINE int32_t _floorToInt(float value)
+{
+    // Clamp such that the conversion is defined for large values and NaN.
+    const float kLimit = float(1 << 24);
+    if (!(value > -kLimit)) value = -kLimit;
+    if (value > kLimit) value = kLimit;
+    return int32_t(floorf(value));
+}
+
+/// Apply an addressing mode to a texel coordinate. Returns -1 if the border color should be used.
+static SLANG_FORCE_INLINE int32_t _applyAddressingMode(TextureAddressingMode mode, int32_t coord, int32_t extent)
+{
+    if (uint32_t(coord) < uint32_t(extent))
+        return coord;
+
+    switch (mode)
+    {
+    case TextureAddressingMode::Wrap:
+        coord %= extent;
+        return (coord < 0) ? coord + extent : coord;
+    case TextureAddressingMode::ClampToBorder:
+        return -1;
+    case TextureAddressingMode::MirrorRepeat:
+        {
+            const int32_t period = extent * 2;
+            coord %= period;
+            if (coord < 0) coord += period;
+            return (coord < extent) ? coord : period - 1 - coord;
+        }
+    case TextureAddressingMode::MirrorOnce:
+        if (coord < 0) coord = -coord - 1;
+        return (coord < extent) ? coord : extent - 1;
+    case TextureAddressingMode::ClampToEdge:
+    default:
+        return (coord < 0) ? 0 : extent - 1;
+    }
+}
+
+static void _resolveLocation(CPUSampleState const& state, const float* coords, CPUSampleLocation& outLocation)
+{
+    int32_t face = 0;
+    outLocation.cubeMajorAxis = 1.0f;
+
+    if (state.isCube)
+    {
+        // Select the face from the major axis of the direction, using the
+        // same orientation for each face as D3D.
+        const float x = coords[0], y = coords[1], z = coords[2];
+        const float ax = fabsf(x), ay = fabsf(y), az = fabsf(z);
+
+        float majorAxis, s, t;
+        if (ax >= ay && ax >= az)
+        {
+            face = (x >= 0.0f) ? 0 : 1;
+            majorAxis = ax;
+            s = (x >= 0.0f) ? -z : z;
+            t = -y;
+        }
+        else if (ay >= az)
+        {
+            face = (y >= 0.0f) ? 2 : 3;
+            majorAxis = ay;
+            s = x;
+            t = (y >= 0.0f) ? z : -z;
+        }
+        else
+        {
+            face = (z >= 0.0f) ? 4 : 5;
+            majorAxis = az;
+            s = (z >= 0.0f) ? x : -x;
+            t = -y;
+        }
+
+        const float scale = (majorAxis > 0.0f) ? 0.5f / majorAxis : 0.0f;
+        outLocation.coords[0] = s * scale + 0.5f;
+        outLocation.coords[1] = t * scale + 0.5f;
+        outLocation.coords[2] = 0.0f;
+        outLocation.cubeMajorAxis = majorAxis;
+    }
+    else
+    {
+        for (int32_t axis = 0; axis < TextureResourceImpl::kMaxRank; ++axis)
+        {
+            outLocation.coords[axis] = (axis < state.rank) ? coords[axis] : 0.0f;
+        }
+    }
+
+    int32_t layer = 0;
+    if (state.isArray)
+    {
+        layer = _floorToInt(coords[state.baseCoordCount] + 0.5f);
+        if (layer >= state.layerCount) layer = state.layerCount - 1;
+        if (layer < 0) layer = 0;
+    }
+    outLocation.arrayElement = state.isCube ? layer * 6 + face : layer;
+}
+
+/// Filter the texels of a single mip level around a location.
+static void _filterLevel(
+    CPUSampleState const& state,
+    int32_t levelIndex,
+    CPUSampleLocation const& location,
+    TextureFilteringMode filter,
+    float* outTexel)
+{
+    const int32_t kMaxRank = TextureResourceImpl::kMaxRank;
+    const int32_t kMaxTapCount = 1 << kMaxRank;
+
+    auto texture = state.texture;
+    auto& level = texture->m_mipLevels[levelIndex];
+    auto samplerDesc = state.samplerDesc;
+
+    // Work out the texels, and their weights, along each axis
+    int32_t texelCoords[kMaxRank][2] = {};
+    float axisWeights[kMaxRank][2] = { { 1.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 0.0f } };
+    int32_t axisTapCounts[kMaxRank] = { 1, 1, 1 };
+
+    for (int32_t axis = 0; axis < state.rank; ++axis)
+    {
+        const int32_t extent = level.extents[axis];
+        const TextureAddressingMode mode = state.addressModes[axis];
+        float coord = location.coords[axis] * extent;
+
+        if (filter == TextureFilteringMode::Linear)
+        {
+            coord -= 0.5f;
+            const int32_t integerCoord = _floorToInt(coord);
+            const float weight = coord - floorf(coord);
+
+            texelCoords[axis][0] = _applyAddressingMode(mode, integerCoord, extent);
+            texelCoords[axis][1] = _applyAddressingMode(mode, integerCoord + 1, extent);
+            axisWeights[axis][0] = 1.0f - weight;
+            axisWeights[axis][1] = weight;
+            axisTapCounts[axis] = 2;
+        }
+        else
+        {
+            texelCoords[axis][0] = _applyAddressingMode(mode, _floorToInt(coord), extent);
+        }
+    }
+
+    // Find the texels to fetch. Texels with a zero weight are skipped, so that
+    // sampling at a texel center only fetches that texel.
+    void const* texels[kMaxTapCount];
+    float tapWeights[kMaxTapCount];
+    int32_t tapCount = 0;
+    float borderWeight = 0.0f;
+
+    auto data = (char const*)texture->m_data;
+    for (int32_t k = 0; k < axisTapCounts[2]; ++k)
+    {
+        for (int32_t j = 0; j < axisTapCounts[1]; ++j)
+        {
+            for (int32_t i = 0; i < axisTapCounts[0]; ++i)
+            {
+                const float weight = axisWeights[0][i] * axisWeights[1][j] * axisWeights[2][k];
+                if (weight <= 0.0f)
+                    continue;
+
+                const int32_t x = texelCoords[0][i];
+                const int32_t y = texelCoords[1][j];
+                const int32_t z = texelCoords[2][k];
+                if ((x | y | z) < 0)
+                {
+                    borderWeight += weight;
+                    continue;
+                }
+
+                texels[tapCount] = data + texture->getTexelOffset(level, x, y, z, location.arrayElement);
+                tapWeights[tapCount] = weight;
+                tapCount++;
+            }
+        }
+    }
+
+    float fetched[kMaxTapCount * 4];
+    state.formatInfo->fetchFunc(texels, tapCount, fetched);
+
+    switch (samplerDesc->reductionOp)
+    {
+    case TextureReductionOp::Minimum:
+    case TextureReductionOp::Maximum:
+        {
+            const bool isMin = samplerDesc->reductionOp == TextureReductionOp::Minimum;
+            for (int32_t c = 0; c < 4; ++c)
+            {
+                float value = (borderWeight > 0.0f) ? samplerDesc->borderColor[c] : fetched[c];
+                for (int32_t t = 0; t < tapCount; ++t)
+                {
+                    const float tapValue = fetched[t * 4 + c];
+                    value = isMin ? Math::Min(value, tapValue) : Math::Max(value, tapValue);
+                }
+                outTexel[c] = value;
+            }
+            break;
+        }
+    default:
+        {
+            for (int32_t c = 0; c < 4; ++c)
+            {
+                float value = borderWeight * samplerDesc->borderColor[c];
+                for (int32_t t = 0; t < tapCount; ++t)
+                {
+                    value += tapWeights[t] * fetched[t * 4 + c];
+                }
+                outTexel[c] = value;
+            }
+            break;
+        }
+    }
+}
+
+/// Sample a location at a level of detail, filtering between mip levels if the sampler requires it.
+static void _sampleLod(CPUSampleState const& state, CPUSampleLocation const& location, float lod, float* outTexel)
+{
+    auto samplerDesc = state.samplerDesc;
+
+    if (lod < samplerDesc->minLOD) lod = samplerDesc->minLOD;
+    if (lod > samplerDesc->maxLOD) lod = samplerDesc->maxLOD;
+
+    // The texture is magnified at level 0 or lower
+    const TextureFilteringMode filter = (lod > 0.0f) ? samplerDesc->minFilter : samplerDesc->magFilter;
+
+    const float maxLevel = float(state.levelCount - 1);
+    if (!(lod > 0.0f)) lod = 0.0f;
+    if (lod > maxLevel) lod = maxLevel;
+
+    if (samplerDesc->mipFilter == TextureFilteringMode::Point)
+    {
+        _filterLevel(state, int32_t(lod + 0.5f), location, filter, outTexel);
+        return;
+    }
+
+    const int32_t levelIndex = int32_t(lod);
+    const float weight = lod - float(levelIndex);
+
+    _filterLevel(state, levelIndex, location, filter, outTexel);
+    if (weight > 0.0f && levelIndex + 1 < state.levelCount)
+    {
+        float nextTexel[4];
+        _filterLevel(state, levelIndex + 1, location, filter, nextTexel);
+        for (int32_t c = 0; c < 4; ++c)
+        {
+            outTexel[c] += (nextTexel[c] - outTexel[c]) * weight;
+        }
+    }
+}
+
+/// Read the texel nearest to a location, for formats that can't be filtered.
+static void _loadNearest(CPUSampleState const& state, CPUSampleLocation const& location, float lod, void* outData, size_t dataSize)
+{
+    auto texture = state.texture;
+
+    int32_t levelIndex = _floorToInt(lod + 0.5f);
+    if (levelIndex >= state.levelCount) levelIndex = state.levelCount - 1;
+    if (levelIndex < 0) levelIndex = 0;
+
+    auto& level = texture->m_mipLevels[levelIndex];
+
+    int32_t texelCoords[TextureResourceImpl::kMaxRank] = {};
+    for (int32_t axis = 0; axis < state.rank; ++axis)
+    {
+        const int32_t extent = level.extents[axis];
+        texelCoords[axis] = _applyAddressingMode(state.addressModes[axis], _floorToInt(location.coords[axis] * extent), extent);
+        if (texelCoords[axis] < 0)
+        {
+            memset(outData, 0, dataSize);
+            return;
+        }
+    }
+
+    auto texelPtr = (char const*)texture->m_data +
+        texture->getTexelOffset(level, texelCoords[0], texelCoords[1], texelCoords[2], location.arrayElement);
+    state.formatInfo->unpackFunc(texelPtr, outData, dataSize);
+}
+
+static SLANG_FORCE_INLINE void _sampleLevel(CPUSampleState const& state, const float* coords, float level, void* outData, size_t dataSize)
+{
+    CPUSampleLocation location;
+    _resolveLocation(state, coords, location);
+
+    if (!state.formatInfo->fetchFunc)
+    {
+        _loadNearest(state, location, level, outData, dataSize);
+        return;
+    }
+
+    float texel[4];
+    _sampleLod(state, location, level, texel);
+    memcpy(outData, texel, Math::Min(dataSize, sizeof(texel)));
+}
+
 void TextureResourceViewImpl::Sample(
     slang_prelude::SamplerState samplerState,
     const float* coords,
@@ -70,52 +428,125 @@ void TextureResourceViewImpl::SampleLevel(
     void* outData,
     size_t dataSize)
 {
-    TextureResourceImpl* texture = m_texture;
-    auto baseShape = texture->m_baseShape;
-    auto& desc = texture->_getDesc();
-    int32_t rank = baseShape->rank;
-    int32_t baseCoordCount = baseShape->baseCoordCount;
+    CPUSampleState state;
+    _initSampleState(m_texture, samplerState, state);
 
-    int32_t integerMipLevel = int32_t(level + 0.5f);
-    if (integerMipLevel >= desc.numMipLevels) integerMipLevel = desc.numMipLevels - 1;
-    if (integerMipLevel < 0) integerMipLevel = 0;
+    _sampleLevel(state, coords, level, outData, dataSize);
+}
 
-    auto& mipLevelInfo = texture->m_mipLevels[integerMipLevel];
+void TextureResourceViewImpl::SampleGrad(
+    slang_prelude::SamplerState samplerState,
+    const float* coords,
+    const float* gradX,
+    const float* gradY,
+    void* outData,
+    size_t dataSize)
+{
+    CPUSampleState state;
+    _initSampleState(m_texture, samplerState, state);
 
-    bool isArray = (desc.arraySize != 0) || (desc.type == ITextureResource::Type::TextureCube);
-    int32_t effectiveArrayElementCount = texture->m_effectiveArrayElementCount;
-    int32_t coordIndex = baseCoordCount;
-    int32_t elementIndex = 0;
-    if (isArray)
-    {
-        elementIndex = int32_t(coords[coordIndex++] + 0.5f);
-    }
-    if (elementIndex >= effectiveArrayElementCount) elementIndex = effectiveArrayElementCount - 1;
-    if (elementIndex < 0) elementIndex = 0;
+    auto samplerDesc = state.samplerDesc;
 
-    // Note: for now we are just going to do nearest-neighbor sampling
-    //
-    int64_t texelOffset = mipLevelInfo.offset;
-    texelOffset += elementIndex * mipLevelInfo.strides[3];
-    for (int32_t axis = 0; axis < rank; ++axis)
+    CPUSampleLocation location;
+    _resolveLocation(state, coords, location);
+
+    // Find the length of the gradients in texels of the most detailed level.
+    // For a cube map the gradients are of the direction, and are projected
+    // onto the face by the major axis.
+    auto& baseLevel = m_texture->m_mipLevels[0];
+    const int32_t gradCount = state.isCube ? 3 : state.rank;
+    const float cubeScale = state.isCube ? 0.5f / Math::Max(location.cubeMajorAxis, 1e-6f) : 1.0f;
+
+    float lengthXSquared = 0.0f;
+    float lengthYSquared = 0.0f;
+    for (int32_t axis = 0; axis < gradCount; ++axis)
     {
-        int32_t extent = mipLevelInfo.extents[axis];
+        const float scale = float(baseLevel.extents[state.isCube ? 0 : axis]) * cubeScale;
+        const float x = gradX[axis] * scale;
+        const float y = gradY[axis] * scale;
+        lengthXSquared += x * x;
+        lengthYSquared += y * y;
+    }
+    const float lengthX = sqrtf(lengthXSquared);
+    const float lengthY = sqrtf(lengthYSquared);
 
-        float coord = coords[axis];
+    const float majorLength = Math::Max(lengthX, lengthY);
+    const float minorLength = Math::Min(lengthX, lengthY);
 
-        // TODO: deal with wrap/clamp/repeat if `coord < 0` or `coord > 1`
+    // Anisotropic filtering takes several samples along the major axis of the
+    // footprint, each at the level of detail of the minor axis (limited by the
+    // maximum anisotropy).
+    int32_t sampleCount = 1;
+    if (samplerDesc->maxAnisotropy > 1 && !state.isCube && minorLength > 0.0f)
+    {
+        const float ratio = Math::Min(majorLength / minorLength, float(samplerDesc->maxAnisotropy));
+        sampleCount = int32_t(ceilf(ratio));
+    }
 
-        int32_t integerCoord = int32_t(coord * (extent - 1) + 0.5f);
+    float lod = (majorLength > 0.0f) ? log2f(majorLength / float(sampleCount)) : -FLT_MAX;
+    lod += samplerDesc->mipLODBias;
 
-        if (integerCoord >= extent) integerCoord = extent - 1;
-        if (integerCoord < 0) integerCoord = 0;
+    if (!state.formatInfo->fetchFunc)
+    {
+        _loadNearest(state, location, lod, outData, dataSize);
+        return;
+    }
 
-        texelOffset += integerCoord * mipLevelInfo.strides[axis];
+    float texel[4];
+    if (sampleCount == 1)
+    {
+        _sampleLod(state, location, lod, texel);
+    }
+    else
+    {
+        const float* majorGrad = (lengthX >= lengthY) ? gradX : gradY;
+
+        float sum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        for (int32_t i = 0; i < sampleCount; ++i)
+        {
+            const float offset = (i + 0.5f) / sampleCount - 0.5f;
+
+            CPUSampleLocation sampleLocation = location;
+            for (int32_t axis = 0; axis < state.rank; ++axis)
+            {
+                sampleLocation.coords[axis] += majorGrad[axis] * offset;
+            }
+
+            float sampleTexel[4];
+            _sampleLod(state, sampleLocation, lod, sampleTexel);
+            for (int32_t c = 0; c < 4; ++c)
+            {
+                sum[c] += sampleTexel[c];
+            }
+        }
+        for (int32_t c = 0; c < 4; ++c)
+        {
+            texel[c] = sum[c] / sampleCount;
+        }
     }
+    memcpy(outData, texel, Math::Min(dataSize, sizeof(texel)));
+}
+
+void TextureResourceViewImpl::SampleLevelBatch(
+    slang_prelude::SamplerState samplerState,
+    const float* coords,
+    const float* levels,
+    size_t count,
+    void* outData,
+    size_t dataSize)
+{
+    CPUSampleState state;
+    _initSampleState(m_texture, samplerState, state);
 
-    auto texelPtr = (char const*)texture->m_data + texelOffset;
+    const int32_t coordCount = state.baseCoordCount + (state.isArray ? 1 : 0);
 
-    m_texture->m_formatInfo->unpackFunc(texelPtr, outData, dataSize);
+    char* out = (char*)outData;
+    for (size_t i = 0; i < count; ++i)
+    {
+        _sampleLevel(state, coords, levels ? levels[i] : 0.0f, out, dataSize);
+        coords += coordCount;
+        out += dataSize;
+    }
 }
 
 void* TextureResourceViewImpl::refAt(const uint32_t* texelCoords)
@@ -158,18 +589,17 @@ void* TextureResourceViewImpl::_getTexelPtr(int32_t const* texelCoords)
 
     auto& mipLevelInfo = texture->m_mipLevels[mipLevel];
 
-    int64_t texelOffset = mipLevelInfo.offset;
-    texelOffset += elementIndex * mipLevelInfo.strides[3];
+    int32_t coords[TextureResourceImpl::kMaxRank] = {};
     for (int32_t axis = 0; axis < rank; ++axis)
     {
         int32_t coord = texelCoords[axis];
         if (coord >= mipLevelInfo.extents[axis]) coord = mipLevelInfo.extents[axis] - 1;
         if (coord < 0) coord = 0;
 
-        texelOffset += texelCoords[axis] * mipLevelInfo.strides[axis];
+        coords[axis] = coord;
     }
 
-    return (char*)texture->m_data + texelOffset;
+    return (char*)texture->m_data + texture->getTexelOffset(mipLevelInfo, coords[0], coords[1], coords[2], elementIndex);
 }
 
 } // namespace cpu
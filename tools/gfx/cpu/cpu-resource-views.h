@@ -66,6 +66,10 @@ public:
 
     void SampleLevel(slang_prelude::SamplerState samplerState, const float* coords, float level, void* outData, size_t dataSize) SLANG_OVERRIDE;
 
+    void SampleGrad(slang_prelude::SamplerState samplerState, const float* coords, const float* gradX, const float* gradY, void* outData, size_t dataSize) SLANG_OVERRIDE;
+
+    void SampleLevelBatch(slang_prelude::SamplerState samplerState, const float* coords, const float* levels, size_t count, void* outData, size_t dataSize) SLANG_OVERRIDE;
+
     //
     // IRWTexture interface
     //
@@ -0,0 +1,23 @@
+// cpu-sampler.h
+#pragma once
+#include "cpu-base.h"
+
+namespace gfx
+{
+using namespace Slang;
+
+namespace cpu
+{
+
+class SamplerStateImpl : public SamplerStateBase, public slang_prelude::ISamplerState
+{
+public:
+    SamplerStateImpl(gfx::ISamplerState::Desc const& desc)
+        : m_desc(desc)
+    {}
+
+    gfx::ISamplerState::Desc m_desc;
+};
+
+} // namespace cpu
+} // namespace gfx
@@ -3,6 +3,7 @@
 
 #include "cpu-buffer.h"
 #include "cpu-resource-views.h"
+#include "cpu-sampler.h"
 #include "cpu-shader-object-layout.h"
 
 namespace gfx
@@ -85,6 +86,7 @@ Result ShaderObjectImpl::init(IDevice* device, ShaderObjectLayoutImpl* typeLayou
     // and not just the number of resource/sub-object ranges.
     //
     m_resources.setCount(typeLayout->getResourceCount());
+    m_samplers.setCount(typeLayout->getResourceCount());
     m_objects.setCount(typeLayout->getSubObjectCount());
 
     for (auto subObjectRange : getLayout()->subObjectRanges)
@@ -233,9 +235,22 @@ SLANG_NO_THROW Result SLANG_MCALL
 SLANG_NO_THROW Result SLANG_MCALL
     ShaderObjectImpl::setSampler(ShaderOffset const& offset, ISamplerState* sampler)
 {
-    SLANG_UNUSED(sampler);
-    SLANG_UNUSED(offset);
-    return SLANG_OK;
+    auto layout = getLayout();
+
+    auto bindingRangeIndex = offset.bindingRangeIndex;
+    SLANG_ASSERT(bindingRangeIndex >= 0);
+    SLANG_ASSERT(bindingRangeIndex < layout->m_bindingRanges.getCount());
+
+    auto& bindingRange = layout->m_bindingRanges[bindingRangeIndex];
+    auto samplerIndex = bindingRange.baseIndex + offset.bindingArrayIndex;
+
+    auto samplerImpl = static_cast<SamplerStateImpl*>(sampler);
+    m_samplers[samplerIndex] = samplerImpl;
+
+    // The generated code sees a `SamplerState`, which holds a pointer to the
+    // prelude interface that the texture views interpret when sampling.
+    slang_prelude::ISamplerState* samplerObj = samplerImpl;
+    return setData(offset, &samplerObj, sizeof(samplerObj));
 }
 
 SLANG_NO_THROW Result SLANG_MCALL ShaderObjectImpl::setCombinedTextureSampler(
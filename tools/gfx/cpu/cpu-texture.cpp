@@ -14,27 +14,29 @@ static CPUTextureBaseShapeInfo const* _getBaseShapeInfo(ITextureResource::Type b
 }
 
 template<int N>
-void _unpackFloatTexel(void const* texelData, void* outData, size_t outSize)
+void _decodeFloatTexel(void const* texelData, float* outTexel)
 {
     auto input = (float const*)texelData;
 
-    float temp[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+    outTexel[0] = 0.0f;
+    outTexel[1] = 0.0f;
+    outTexel[2] = 0.0f;
+    outTexel[3] = 1.0f;
     for (int i = 0; i < N; ++i)
-        temp[i] = input[i];
-
-    memcpy(outData, temp, outSize);
+        outTexel[i] = input[i];
 }
 
 template<int N>
-void _unpackFloat16Texel(void const* texelData, void* outData, size_t outSize)
+void _decodeFloat16Texel(void const* texelData, float* outTexel)
 {
     auto input = (int16_t const*)texelData;
 
-    float temp[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+    outTexel[0] = 0.0f;
+    outTexel[1] = 0.0f;
+    outTexel[2] = 0.0f;
+    outTexel[3] = 1.0f;
     for (int i = 0; i < N; ++i)
-        temp[i] = HalfToFloat(input[i]);
-
-    memcpy(outData, temp, outSize);
+        outTexel[i] = HalfToFloat(input[i]);
 }
 
 static inline float _unpackUnorm8Value(uint8_t value)
@@ -43,30 +45,46 @@ static inline float _unpackUnorm8Value(uint8_t value)
 }
 
 template<int N>
-void _unpackUnorm8Texel(void const* texelData, void* outData, size_t outSize)
+void _decodeUnorm8Texel(void const* texelData, float* outTexel)
 {
     auto input = (uint8_t const*)texelData;
 
-    float temp[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+    outTexel[0] = 0.0f;
+    outTexel[1] = 0.0f;
+    outTexel[2] = 0.0f;
+    outTexel[3] = 1.0f;
     for (int i = 0; i < N; ++i)
-        temp[i] = _unpackUnorm8Value(input[i]);
-
-    memcpy(outData, temp, outSize);
+        outTexel[i] = _unpackUnorm8Value(input[i]);
 }
 
-void _unpackUnormBGRA8Texel(void const* texelData, void* outData, size_t outSize)
+void _decodeUnormBGRA8Texel(void const* texelData, float* outTexel)
 {
     auto input = (uint8_t const*)texelData;
 
+    outTexel[0] = _unpackUnorm8Value(input[2]);
+    outTexel[1] = _unpackUnorm8Value(input[1]);
+    outTexel[2] = _unpackUnorm8Value(input[0]);
+    outTexel[3] = _unpackUnorm8Value(input[3]);
+}
+
+template<CPUTextureDecodeFunc DECODE>
+void _unpackTexel(void const* texelData, void* outData, size_t outSize)
+{
     float temp[4];
-    temp[0] = _unpackUnorm8Value(input[2]);
-    temp[1] = _unpackUnorm8Value(input[1]);
-    temp[2] = _unpackUnorm8Value(input[0]);
-    temp[3] = _unpackUnorm8Value(input[3]);
+    DECODE(texelData, temp);
 
     memcpy(outData, temp, outSize);
 }
 
+template<CPUTextureDecodeFunc DECODE>
+void _fetchTexels(void const* const* texels, int32_t count, float* outTexels)
+{
+    // The decode is inlined here, so there is a single indirect call
+    // for all of the texels used by a filter.
+    for (int32_t i = 0; i < count; ++i)
+        DECODE(texels[i], outTexels + i * 4);
+}
+
 template<int N>
 void _unpackUInt16Texel(void const* texelData, void* outData, size_t outSize)
 {
@@ -142,6 +160,11 @@ Result TextureResourceImpl::init(ITextureResource::SubresourceData const* initDa
     for(int32_t axis = rank; axis < kMaxRank; ++axis)
         extents[axis] = 1;
 
+    // 1D textures and buffers are stored linearly.
+    const int32_t tileShift = (rank >= 2) ? kTileShift : 0;
+    const int32_t tileSize = 1 << tileShift;
+    m_tileShift = tileShift;
+
     int32_t levelCount = desc.numMipLevels;
 
     m_mipLevels.setCount(levelCount);
@@ -158,16 +181,16 @@ Result TextureResourceImpl::init(ITextureResource::SubresourceData const* initDa
             level.extents[axis] = extent;
         }
 
-        level.strides[0] = texelSize;
-        for( int32_t axis = 1; axis < kMaxRank+1; ++axis)
-        {
-            level.strides[axis] = level.strides[axis-1]*level.extents[axis-1];
-        }
+        // Rows and columns are padded to a whole number of tiles.
+        int64_t tileCountX = (level.extents[0] + tileSize - 1) >> tileShift;
+        int64_t tileCountY = (level.extents[1] + tileSize - 1) >> tileShift;
+
+        level.strides[0] = int64_t(texelSize) << (tileShift * 2);
+        level.strides[1] = level.strides[0] * tileCountX;
+        level.strides[2] = level.strides[1] * tileCountY;
+        level.strides[3] = level.strides[2] * level.extents[2];
 
-        int64_t levelDataSize = texelSize;
-        levelDataSize *= effectiveArrayElementCount;
-        for( int32_t axis = 0; axis < rank; ++axis)
-            levelDataSize *= int64_t(level.extents[axis]);
+        int64_t levelDataSize = level.strides[3] * effectiveArrayElementCount;
 
         level.offset = totalDataSize;
         totalDataSize += levelDataSize;
@@ -185,40 +208,37 @@ Result TextureResourceImpl::init(ITextureResource::SubresourceData const* initDa
             {
                 int32_t subResourceIndex = subResourceCounter++;
 
-                auto dstRowStride = m_mipLevels[mipLevel].strides[1];
-                auto dstLayerStride = m_mipLevels[mipLevel].strides[2];
-                auto dstArrayStride = m_mipLevels[mipLevel].strides[3];
+                auto& level = m_mipLevels[mipLevel];
 
-                auto textureRowSize = m_mipLevels[mipLevel].extents[0]*texelSize;
-
-                auto rowCount = m_mipLevels[mipLevel].extents[1];
-                auto depthLayerCount = m_mipLevels[mipLevel].extents[2];
+                auto width = level.extents[0];
+                auto rowCount = level.extents[1];
+                auto depthLayerCount = level.extents[2];
 
                 auto& srcImage = initData[subResourceIndex];
                 ptrdiff_t srcRowStride = ptrdiff_t(srcImage.strideY);
                 ptrdiff_t srcLayerStride = ptrdiff_t(srcImage.strideZ);
 
-                char* dstLevel = (char*)textureData + m_mipLevels[mipLevel].offset;
-                char* dstImage = dstLevel + dstArrayStride*arrayElementIndex;
-
                 const char* srcLayer = (const char*) srcImage.data;
-                char* dstLayer = dstImage;
 
                 for(int32_t depthLayer = 0; depthLayer < depthLayerCount; ++depthLayer)
                 {
                     const char* srcRow = srcLayer;
-                    char* dstRow = dstLayer;
 
                     for(int32_t row = 0; row < rowCount; ++row)
                     {
-                        memcpy(dstRow, srcRow, textureRowSize);
+                        // Copy the row a tile width at a time, as the texels
+                        // of a row are only contiguous within a tile.
+                        for(int32_t x = 0; x < width; x += tileSize)
+                        {
+                            int32_t runLength = Math::Min(tileSize, width - x);
+                            int64_t dstOffset = getTexelOffset(level, x, row, depthLayer, arrayElementIndex);
+                            memcpy((char*)textureData + dstOffset, srcRow + x * texelSize, runLength * texelSize);
+                        }
 
                         srcRow += srcRowStride;
-                        dstRow += dstRowStride;
                     }
 
                     srcLayer += srcLayerStride;
-                    dstLayer += dstLayerStride;
                 }
             }
         }
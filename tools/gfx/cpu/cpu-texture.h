@@ -30,23 +30,35 @@ static CPUTextureBaseShapeInfo const* _getBaseShapeInfo(ITextureResource::Type b
 
 typedef void (*CPUTextureUnpackFunc)(void const* texelData, void* outData, size_t outSize);
 
+    /// Decodes `count` texels to 4 floats each, for filtering.
+typedef void (*CPUTextureFetchFunc)(void const* const* texels, int32_t count, float* outTexels);
+
 struct CPUTextureFormatInfo
 {
     CPUTextureUnpackFunc unpackFunc;
+    CPUTextureFetchFunc fetchFunc;      ///< nullptr if the format can't be filtered
 };
 
+typedef void (*CPUTextureDecodeFunc)(void const* texelData, float* outTexel);
+
 template<int N>
-void _unpackFloatTexel(void const* texelData, void* outData, size_t outSize);
+void _decodeFloatTexel(void const* texelData, float* outTexel);
 
 template<int N>
-void _unpackFloat16Texel(void const* texelData, void* outData, size_t outSize);
+void _decodeFloat16Texel(void const* texelData, float* outTexel);
 
 static inline float _unpackUnorm8Value(uint8_t value);
 
 template<int N>
-void _unpackUnorm8Texel(void const* texelData, void* outData, size_t outSize);
+void _decodeUnorm8Texel(void const* texelData, float* outTexel);
+
+void _decodeUnormBGRA8Texel(void const* texelData, float* outTexel);
+
+template<CPUTextureDecodeFunc DECODE>
+void _unpackTexel(void const* texelData, void* outData, size_t outSize);
 
-void _unpackUnormBGRA8Texel(void const* texelData, void* outData, size_t outSize);
+template<CPUTextureDecodeFunc DECODE>
+void _fetchTexels(void const* const* texels, int32_t count, float* outTexels);
 
 template<int N>
 void _unpackUInt16Texel(void const* texelData, void* outData, size_t outSize);
@@ -60,27 +72,34 @@ struct CPUFormatInfoMap
     {
         memset(m_infos, 0, sizeof(m_infos));
 
-        set(Format::R32G32B32A32_FLOAT, &_unpackFloatTexel<4>);
-        set(Format::R32G32B32_FLOAT, &_unpackFloatTexel<3>);
+        setDecode<&_decodeFloatTexel<4>>(Format::R32G32B32A32_FLOAT);
+        setDecode<&_decodeFloatTexel<3>>(Format::R32G32B32_FLOAT);
 
-        set(Format::R32G32_FLOAT, &_unpackFloatTexel<2>);
-        set(Format::R32_FLOAT, &_unpackFloatTexel<1>);
+        setDecode<&_decodeFloatTexel<2>>(Format::R32G32_FLOAT);
+        setDecode<&_decodeFloatTexel<1>>(Format::R32_FLOAT);
 
-        set(Format::R16G16B16A16_FLOAT, &_unpackFloat16Texel<4>);
-        set(Format::R16G16_FLOAT, &_unpackFloat16Texel<2>);
-        set(Format::R16_FLOAT, &_unpackFloat16Texel<1>);
+        setDecode<&_decodeFloat16Texel<4>>(Format::R16G16B16A16_FLOAT);
+        setDecode<&_decodeFloat16Texel<2>>(Format::R16G16_FLOAT);
+        setDecode<&_decodeFloat16Texel<1>>(Format::R16_FLOAT);
 
-        set(Format::R8G8B8A8_UNORM, &_unpackUnorm8Texel<4>);
-        set(Format::B8G8R8A8_UNORM, &_unpackUnormBGRA8Texel);
+        setDecode<&_decodeUnorm8Texel<4>>(Format::R8G8B8A8_UNORM);
+        setDecode<&_decodeUnormBGRA8Texel>(Format::B8G8R8A8_UNORM);
         set(Format::R16_UINT, &_unpackUInt16Texel<1>);
         set(Format::R32_UINT, &_unpackUInt32Texel<1>);
-        set(Format::D32_FLOAT, &_unpackFloatTexel<1>);
+        setDecode<&_decodeFloatTexel<1>>(Format::D32_FLOAT);
     }
 
-    void set(Format format, CPUTextureUnpackFunc func)
+    void set(Format format, CPUTextureUnpackFunc func, CPUTextureFetchFunc fetchFunc = nullptr)
     {
         auto& info = m_infos[Index(format)];
         info.unpackFunc = func;
+        info.fetchFunc = fetchFunc;
+    }
+        /// Set a format that decodes to floats, and so can be filtered
+    template<CPUTextureDecodeFunc DECODE>
+    void setDecode(Format format)
+    {
+        set(format, &_unpackTexel<DECODE>, &_fetchTexels<DECODE>);
     }
     SLANG_FORCE_INLINE const CPUTextureFormatInfo& get(Format format) const { return m_infos[Index(format)]; }
 
@@ -97,9 +116,13 @@ static CPUTextureFormatInfo const* _getFormatInfo(Format format)
 
 class TextureResourceImpl : public TextureResource
 {
+public:
     enum { kMaxRank = 3 };
 
-public:
+        /// Textures with 2 or more dimensions are stored as tiles of (1 << kTileShift) texels
+        /// square, so that the texels used when filtering are usually close in memory.
+    enum { kTileShift = 2 };
+
     TextureResourceImpl(const TextureResource::Desc& desc)
         : TextureResource(desc)
     {}
@@ -115,15 +138,30 @@ public:
     CPUTextureFormatInfo const* m_formatInfo;
     int32_t m_effectiveArrayElementCount = 0;
     uint32_t m_texelSize = 0;
+    int32_t m_tileShift = 0;
 
     struct MipLevel
     {
         int32_t extents[kMaxRank];
+            /// Strides in bytes between tiles along a row, rows of tiles, depth slices and array elements.
+            /// A tile is a single texel if the texture isn't tiled.
         int64_t strides[kMaxRank+1];
         int64_t offset;
     };
     List<MipLevel>  m_mipLevels;
     void*           m_data = nullptr;
+
+        /// Get the offset in bytes of a texel from the start of `m_data`. The coordinates must be in range.
+    SLANG_FORCE_INLINE int64_t getTexelOffset(MipLevel const& level, int32_t x, int32_t y, int32_t z, int32_t arrayElement) const
+    {
+        const int32_t tileShift = m_tileShift;
+        const int32_t tileMask = (1 << tileShift) - 1;
+
+        int64_t offset = level.offset + arrayElement * level.strides[3] + z * level.strides[2];
+        offset += (y >> tileShift) * level.strides[1] + (x >> tileShift) * level.strides[0];
+        offset += int64_t(((y & tileMask) << tileShift) + (x & tileMask)) * m_texelSize;
+        return offset;
+    }
 };
 
 } // namespace cpu
@@ -0,0 +1,182 @@
+// cpu-thread-pool.cpp
+#include "cpu-thread-pool.h"
+
+namespace gfx
+{
+using namespace Slang;
+
+namespace cpu
+{
+
+WorkStealingThreadPool::WorkStealingThreadPool(Index threadCount)
+{
+    if (threadCount <= 0)
+    {
+        threadCount = Index(std::thread::hardware_concurrency());
+    }
+    threadCount = (threadCount > 0) ? threadCount : 1;
+
+    for (Index i = 0; i < threadCount; ++i)
+    {
+        m_participants.add(new Participant);
+    }
+
+    // Participant 0 is the thread that calls parallelFor, so only the others need a thread.
+    for (Index i = 1; i < threadCount; ++i)
+    {
+        m_participants[i]->thread = std::thread(&WorkStealingThreadPool::_workerThreadMain, this, i);
+    }
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isShuttingDown = true;
+    }
+    m_wakeCondition.notify_all();
+
+    for (auto& participant : m_participants)
+    {
+        if (participant->thread.joinable())
+        {
+            participant->thread.join();
+        }
+    }
+}
+
+bool WorkStealingThreadPool::_popTask(Index participantIndex, Index& outTaskIndex)
+{
+    Participant* participant = m_participants[participantIndex];
+
+    std::lock_guard<std::mutex> lock(participant->mutex);
+    if (participant->begin >= participant->end)
+    {
+        return false;
+    }
+    outTaskIndex = participant->begin++;
+    return true;
+}
+
+bool WorkStealingThreadPool::_stealTask(Index participantIndex, Index& outTaskIndex)
+{
+    const Index participantCount = m_participants.getCount();
+
+    for (Index i = 1; i < participantCount; ++i)
+    {
+        Participant* victim = m_participants[(participantIndex + i) % participantCount];
+
+        Index stolenBegin;
+        Index stolenEnd;
+        {
+            std::lock_guard<std::mutex> lock(victim->mutex);
+            const Index remaining = victim->end - victim->begin;
+            if (remaining <= 0)
+            {
+                continue;
+            }
+            // Take the back half (rounded up), so a single remaining task can be stolen too.
+            stolenEnd = victim->end;
+            stolenBegin = stolenEnd - (remaining + 1) / 2;
+            victim->end = stolenBegin;
+        }
+
+        // Run the first stolen task directly, and make the rest available in our own range
+        // (where they can in turn be stolen by others).
+        outTaskIndex = stolenBegin;
+        if (stolenEnd - stolenBegin > 1)
+        {
+            Participant* participant = m_participants[participantIndex];
+            std::lock_guard<std::mutex> lock(participant->mutex);
+            participant->begin = stolenBegin + 1;
+            participant->end = stolenEnd;
+        }
+        return true;
+    }
+    return false;
+}
+
+void WorkStealingThreadPool::_runTasks(Index participantIndex)
+{
+    Index taskIndex;
+    while (_popTask(participantIndex, taskIndex) || _stealTask(participantIndex, taskIndex))
+    {
+        m_func(m_context, taskIndex);
+    }
+}
+
+void WorkStealingThreadPool::_workerThreadMain(Index participantIndex)
+{
+    uint64_t seenGeneration = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeCondition.wait(lock, [&]() { return m_isShuttingDown || m_generation != seenGeneration; });
+            if (m_isShuttingDown)
+            {
+                return;
+            }
+            seenGeneration = m_generation;
+        }
+
+        _runTasks(participantIndex);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (--m_busyWorkerCount == 0)
+            {
+                m_idleCondition.notify_all();
+            }
+        }
+    }
+}
+
+void WorkStealingThreadPool::parallelFor(Index taskCount, TaskFunc func, void* context)
+{
+    if (taskCount <= 0)
+    {
+        return;
+    }
+
+    const Index participantCount = m_participants.getCount();
+    if (participantCount == 1 || taskCount == 1)
+    {
+        for (Index i = 0; i < taskCount; ++i)
+        {
+            func(context, i);
+        }
+        return;
+    }
+
+    // All workers are idle at this point, so the ranges and job can be set up without contention.
+    // Each participant starts with a contiguous slice of the tasks.
+    for (Index i = 0; i < participantCount; ++i)
+    {
+        Participant* participant = m_participants[i];
+        std::lock_guard<std::mutex> lock(participant->mutex);
+        participant->begin = (taskCount * i) / participantCount;
+        participant->end = (taskCount * (i + 1)) / participantCount;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_func = func;
+        m_context = context;
+        m_busyWorkerCount = participantCount - 1;
+        m_generation++;
+    }
+    m_wakeCondition.notify_all();
+
+    _runTasks(0);
+
+    // Wait until every worker has run out of work. Only then is it safe to return, as the
+    // workers may still be reading the job state.
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idleCondition.wait(lock, [&]() { return m_busyWorkerCount == 0; });
+    m_func = nullptr;
+    m_context = nullptr;
+}
+
+} // namespace cpu
+} // namespace gfx
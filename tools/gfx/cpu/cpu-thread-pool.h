@@ -0,0 +1,72 @@
+// cpu-thread-pool.h
+#pragma once
+#include "cpu-base.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace gfx
+{
+using namespace Slang;
+
+namespace cpu
+{
+
+/// A persistent pool of worker threads used to execute fork/join style parallel loops.
+///
+/// Each participant (the workers and the thread calling `parallelFor`) owns a contiguous
+/// range of task indices. A participant consumes tasks from the front of its own range, and
+/// when that is exhausted it steals the back half of the range of another participant. This keeps
+/// neighbouring tasks on the same thread while still balancing uneven workloads.
+class WorkStealingThreadPool : public RefObject
+{
+public:
+    typedef void (*TaskFunc)(void* context, Index taskIndex);
+
+        /// Executes `func(context, taskIndex)` for every taskIndex in [0, taskCount).
+        /// The calling thread takes part in the work, and the call returns once all tasks completed.
+        /// Must not be called concurrently or recursively from within a task.
+    void parallelFor(Index taskCount, TaskFunc func, void* context);
+
+        /// The number of threads that execute tasks, including the thread calling `parallelFor`.
+    Index getParticipantCount() const { return m_participants.getCount(); }
+
+        /// Create a pool where `threadCount` threads (including the caller) execute tasks.
+        /// If threadCount is <= 0, the number of hardware threads is used.
+    explicit WorkStealingThreadPool(Index threadCount);
+    ~WorkStealingThreadPool();
+
+protected:
+    struct Participant : public RefObject
+    {
+        std::mutex mutex;
+            /// The range [begin, end) of task indices yet to be executed by this participant.
+        Index begin = 0;
+        Index end = 0;
+            /// Not joinable for participant 0, which is the thread calling `parallelFor`.
+        std::thread thread;
+    };
+
+    bool _popTask(Index participantIndex, Index& outTaskIndex);
+    bool _stealTask(Index participantIndex, Index& outTaskIndex);
+    void _runTasks(Index participantIndex);
+    void _workerThreadMain(Index participantIndex);
+
+    List<RefPtr<Participant>> m_participants;
+
+    // The state below is protected by m_mutex
+    std::mutex m_mutex;
+    std::condition_variable m_wakeCondition;
+    std::condition_variable m_idleCondition;
+    uint64_t m_generation = 0;
+    Index m_busyWorkerCount = 0;
+    bool m_isShuttingDown = false;
+
+    // The job currently being executed. Only written while all workers are idle.
+    TaskFunc m_func = nullptr;
+    void* m_context = nullptr;
+};
+
+} // namespace cpu
+} // namespace gfx
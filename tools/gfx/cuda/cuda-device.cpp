@@ -146,7 +146,10 @@ SLANG_NO_THROW SlangResult SLANG_MCALL DeviceImpl::initialize(const Desc& desc)
         "sm_5_1",
         makeArray(slang::PreprocessorMacroDesc{ "__CUDA_COMPUTE__", "1" }).getView()));
 
-    SLANG_RETURN_ON_FAIL(RendererBase::initialize(desc));
+    // The CUDA context is only current on this thread, so pipelines can't be created on a background thread
+    Desc rendererDesc = desc;
+    rendererDesc.asyncPipelineSpecialization = false;
+    SLANG_RETURN_ON_FAIL(RendererBase::initialize(rendererDesc));
 
     SLANG_RETURN_ON_FAIL(_initCuda(reportType));
 
@@ -898,6 +901,7 @@ SLANG_NO_THROW Result SLANG_MCALL DeviceImpl::createProgram(
     IShaderProgram** outProgram,
     ISlangBlob** outDiagnosticBlob)
 {
+    std::lock_guard<std::recursive_mutex> slangLock(m_slangMutex);
     // If this is a specializable program, we just keep a reference to the slang program and
     // don't actually create any kernels. This program will be specialized later when we know
     // the shader object bindings.
@@ -1208,6 +1208,7 @@ void DeviceImpl::drawIndexedInstanced(
 Result DeviceImpl::createProgram(
     const IShaderProgram::Desc& desc, IShaderProgram** outProgram, ISlangBlob** outDiagnosticBlob)
 {
+    std::lock_guard<std::recursive_mutex> slangLock(m_slangMutex);
     SLANG_ASSERT(desc.slangGlobalScope);
 
     if (desc.slangGlobalScope->getSpecializationParamCount() != 0)
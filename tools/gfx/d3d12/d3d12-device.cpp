@@ -1774,6 +1774,7 @@ Result DeviceImpl::readBufferResource(
 Result DeviceImpl::createProgram(
     const IShaderProgram::Desc& desc, IShaderProgram** outProgram, ISlangBlob** outDiagnosticBlob)
 {
+    std::lock_guard<std::recursive_mutex> slangLock(m_slangMutex);
     RefPtr<ShaderProgramImpl> shaderProgram = new ShaderProgramImpl();
     shaderProgram->init(desc);
     ComPtr<ID3DBlob> d3dDiagnosticBlob;
@@ -47,6 +47,10 @@ Result PipelineStateImpl::ensureAPIPipelineStateCreated()
     if (m_pipelineState)
         return SLANG_OK;
 
+    std::lock_guard<std::recursive_mutex> slangLock(m_device->m_slangMutex);
+    if (m_pipelineState)
+        return SLANG_OK;
+
     auto programImpl = static_cast<ShaderProgramImpl*>(m_program.Ptr());
     if (programImpl->m_shaders.getCount() == 0)
     {
@@ -320,6 +324,10 @@ Result RayTracingPipelineStateImpl::ensureAPIPipelineStateCreated()
     if (m_stateObject)
         return SLANG_OK;
 
+    std::lock_guard<std::recursive_mutex> slangLock(m_device->m_slangMutex);
+    if (m_stateObject)
+        return SLANG_OK;
+
     auto program = static_cast<ShaderProgramImpl*>(m_program.Ptr());
     auto slangGlobalScope = program->linkedProgram;
     auto programLayout = slangGlobalScope->getLayout();
@@ -487,6 +487,7 @@ Result DebugDevice::createGraphicsPipelineState(
         desc.framebufferLayout
             ? static_cast<DebugFramebufferLayout*>(desc.framebufferLayout)->baseObject
             : nullptr;
+    innerDesc.specializationFallback = getInnerObj(desc.specializationFallback);
     RefPtr<DebugPipelineState> outObject = new DebugPipelineState();
     auto result =
         baseObject->createGraphicsPipelineState(innerDesc, outObject->baseObject.writeRef());
@@ -504,6 +505,7 @@ Result DebugDevice::createComputePipelineState(
 
     ComputePipelineStateDesc innerDesc = desc;
     innerDesc.program = static_cast<DebugShaderProgram*>(desc.program)->baseObject;
+    innerDesc.specializationFallback = getInnerObj(desc.specializationFallback);
 
     RefPtr<DebugPipelineState> outObject = new DebugPipelineState();
     auto result =
@@ -610,5 +612,17 @@ Result DebugDevice::createShaderTable(const IShaderTable::Desc& desc, IShaderTab
     return SLANG_OK;
 }
 
+Result DebugDevice::prewarmSpecializedPipelines(IPipelineState* pipeline, ISlangBlob* keys)
+{
+    SLANG_GFX_API_FUNC;
+    return baseObject->prewarmSpecializedPipelines(getInnerObj(pipeline), keys);
+}
+
+Result DebugDevice::getSpecializedPipelineKeys(IPipelineState* pipeline, ISlangBlob** outKeys)
+{
+    SLANG_GFX_API_FUNC;
+    return baseObject->getSpecializedPipelineKeys(getInnerObj(pipeline), outKeys);
+}
+
 } // namespace debug
 } // namespace gfx
@@ -143,6 +143,10 @@ public:
     virtual SLANG_NO_THROW Result SLANG_MCALL getTextureRowAlignment(size_t* outAlignment) override;
     virtual SLANG_NO_THROW Result SLANG_MCALL
         createShaderTable(const IShaderTable::Desc& desc, IShaderTable** outTable) override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL
+        prewarmSpecializedPipelines(IPipelineState* pipeline, ISlangBlob* keys) override;
+    virtual SLANG_NO_THROW Result SLANG_MCALL
+        getSpecializedPipelineKeys(IPipelineState* pipeline, ISlangBlob** outKeys) override;
 };
 
 } // namespace debug
@@ -1995,7 +1995,10 @@ SLANG_NO_THROW Result SLANG_MCALL GLDevice::initialize(const Desc& desc)
         makeArray(
             slang::PreprocessorMacroDesc{ "__GL__", "1" }).getView()));
 
-    SLANG_RETURN_ON_FAIL(RendererBase::initialize(desc));
+    // The GL context is only current on this thread, so pipelines can't be created on a background thread
+    Desc rendererDesc = desc;
+    rendererDesc.asyncPipelineSpecialization = false;
+    SLANG_RETURN_ON_FAIL(RendererBase::initialize(rendererDesc));
 
     // Initialize DeviceInfo
     {
@@ -2775,6 +2778,7 @@ void GLDevice::dispatchCompute(int x, int y, int z)
 Result GLDevice::createProgram(
     const IShaderProgram::Desc& desc, IShaderProgram** outProgram, ISlangBlob** outDiagnosticBlob)
 {
+    std::lock_guard<std::recursive_mutex> slangLock(m_slangMutex);
     if (desc.slangGlobalScope->getSpecializationParamCount() != 0)
     {
         // For a specializable program, we don't invoke any actual slang compilation yet.
@@ -2,6 +2,7 @@
 #include "mutable-shader-object.h"
 #include "core/slang-io.h"
 #include "core/slang-token-reader.h"
+#include "core/slang-string-util.h"
 
 using namespace Slang;
 
@@ -322,6 +323,11 @@ void PipelineStateBase::initializeBase(const PipelineStateDesc& inDesc)
     {
         inputLayout = static_cast<InputLayoutBase*>(inDesc.graphics.inputLayout);
         framebufferLayout = static_cast<FramebufferLayoutBase*>(inDesc.graphics.framebufferLayout);
+        specializationFallback = static_cast<PipelineStateBase*>(inDesc.graphics.specializationFallback);
+    }
+    else if (inDesc.type == PipelineType::Compute)
+    {
+        specializationFallback = static_cast<PipelineStateBase*>(inDesc.compute.specializationFallback);
     }
 }
 
@@ -340,6 +346,12 @@ SLANG_NO_THROW Result SLANG_MCALL RendererBase::initialize(const Desc& desc)
             GfxGUID::IID_IPipelineCreationAPIDispatcher,
             (void**)m_pipelineCreationAPIDispatcher.writeRef());
     }
+    shaderCache.slangMutex = &m_slangMutex;
+    m_asyncPipelineSpecialization = desc.asyncPipelineSpecialization;
+    if (m_asyncPipelineSpecialization)
+    {
+        m_specializationThread = std::thread([this]() { _specializationThreadMain(); });
+    }
     return SLANG_OK;
 }
 
@@ -471,6 +483,7 @@ Result RendererBase::createProgram2(
     IShaderProgram** outProgram,
     ISlangBlob** outDiagnostic)
 {
+    std::lock_guard<std::recursive_mutex> slangLock(m_slangMutex);
     auto slangSession = slangContext.session.get();
 
     SLANG_RELEASE_ASSERT(desc.sourceType == ShaderModuleSourceType::SlangSourceFile);
@@ -616,6 +629,7 @@ Result RendererBase::getShaderObjectLayout(
     ShaderObjectContainerType container,
     ShaderObjectLayoutBase** outLayout)
 {
+    std::lock_guard<std::recursive_mutex> slangLock(m_slangMutex);
     switch (container)
     {
     case ShaderObjectContainerType::StructuredBuffer:
@@ -635,6 +649,7 @@ Result RendererBase::getShaderObjectLayout(
 Result RendererBase::getShaderObjectLayout(
     slang::TypeLayoutReflection* typeLayout, ShaderObjectLayoutBase** outLayout)
 {
+    std::lock_guard<std::recursive_mutex> slangLock(m_slangMutex);
     RefPtr<ShaderObjectLayoutBase> shaderObjectLayout;
     if (!m_shaderObjectLayoutCache.TryGetValue(typeLayout, shaderObjectLayout))
     {
@@ -649,6 +664,12 @@ Result RendererBase::getShaderObjectLayout(
 
 ShaderComponentID ShaderCache::getComponentId(slang::TypeReflection* type)
 {
+    std::unique_lock<std::recursive_mutex> slangLock;
+    if (slangMutex)
+    {
+        slangLock = std::unique_lock<std::recursive_mutex>(*slangMutex);
+    }
+
     ComponentKey key;
     key.typeName = UnownedStringSlice(type->getName());
     switch (type->getKind())
@@ -697,6 +718,7 @@ ShaderComponentID ShaderCache::getComponentId(UnownedStringSlice name)
 
 ShaderComponentID ShaderCache::getComponentId(ComponentKey key)
 {
+    std::lock_guard<std::mutex> lock(mutex);
     ShaderComponentID componentId = 0;
     if (componentIds.TryGetValue(key, componentId))
         return componentId;
@@ -706,14 +728,32 @@ ShaderComponentID ShaderCache::getComponentId(ComponentKey key)
     owningTypeKey.specializationArgs.addRange(key.specializationArgs);
     ShaderComponentID resultId = static_cast<ShaderComponentID>(componentIds.Count());
     componentIds[owningTypeKey] = resultId;
+    componentNames.add(owningTypeKey.typeName);
     return resultId;
 }
 
+String ShaderCache::getComponentName(ShaderComponentID id)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return id < (ShaderComponentID)componentNames.getCount() ? componentNames[id] : String();
+}
+
 void ShaderCache::addSpecializedPipeline(PipelineKey key, Slang::RefPtr<PipelineStateBase> specializedPipeline)
 {
+    std::lock_guard<std::mutex> lock(mutex);
     specializedPipelines[key] = specializedPipeline;
 }
 
+void ShaderCache::getSpecializedPipelineKeys(PipelineStateBase* pipeline, List<PipelineKey>& outKeys)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& entry : specializedPipelines)
+    {
+        if (entry.Key.pipeline == pipeline)
+            outKeys.add(entry.Key);
+    }
+}
+
 void ShaderObjectLayoutBase::initBase(RendererBase* renderer, slang::TypeLayoutReflection* elementTypeLayout)
 {
     m_renderer = renderer;
@@ -741,6 +781,7 @@ Result ShaderObjectBase::_getSpecializedShaderObjectType(ExtendedShaderObjectTyp
     }
     else
     {
+        std::lock_guard<std::recursive_mutex> slangLock(getRenderer()->m_slangMutex);
         shaderObjectType.slangType = getRenderer()->slangContext.session->specializeType(
             _getElementTypeLayout()->getType(),
             specializationArgs.components.getArrayView().getBuffer(), specializationArgs.getCount());
@@ -952,7 +993,6 @@ Result RendererBase::maybeSpecializePipeline(
 {
     outNewPipeline = static_cast<PipelineStateBase*>(currentPipeline);
     
-    auto pipelineType = currentPipeline->desc.type;
     if (currentPipeline->unspecializedPipelineState)
         currentPipeline = currentPipeline->unspecializedPipelineState;
     // If the currently bound pipeline is specializable, we need to specialize it based on bound shader objects.
@@ -967,84 +1007,321 @@ Result RendererBase::maybeSpecializePipeline(
         pipelineKey.specializationArgs.addRange(specializationArgs.componentIDs);
         pipelineKey.updateHash();
 
-        RefPtr<PipelineStateBase> specializedPipelineState = shaderCache.getSpecializedPipelineState(pipelineKey);
-        // Try to find specialized pipeline from shader cache.
+        RefPtr<PipelineStateBase> specializedPipelineState;
+        RefPtr<PendingPipelineSpecialization> pending;
+        SLANG_RETURN_ON_FAIL(getOrQueueSpecializedPipeline(
+            pipelineKey, currentPipeline, specializationArgs, specializedPipelineState, &pending));
+
+        // If the specialization is being created in the background, use the fallback
+        // pipeline until it is ready, or wait for it if there is no fallback.
         if (!specializedPipelineState)
         {
-            auto unspecializedProgram = static_cast<ShaderProgramBase*>(pipelineType == PipelineType::Compute
-                ? currentPipeline->desc.compute.program
-                : currentPipeline->desc.graphics.program);
-            auto unspecializedProgramLayout = unspecializedProgram->linkedProgram->getLayout();
-
-            ComPtr<slang::IComponentType> specializedComponentType;
-            ComPtr<slang::IBlob> diagnosticBlob;
-            auto compileRs = unspecializedProgram->linkedProgram->specialize(
-                specializationArgs.components.getArrayView().getBuffer(),
-                specializationArgs.getCount(),
-                specializedComponentType.writeRef(),
-                diagnosticBlob.writeRef());
-            if (diagnosticBlob)
+            if (currentPipeline->specializationFallback)
             {
-                getDebugCallback()->handleMessage(
-                    compileRs == SLANG_OK ? DebugMessageType::Warning : DebugMessageType::Error,
-                    DebugMessageSource::Slang,
-                    (char*)diagnosticBlob->getBufferPointer());
+                outNewPipeline = currentPipeline->specializationFallback;
+                return SLANG_OK;
             }
-            SLANG_RETURN_ON_FAIL(compileRs);
+            SLANG_RETURN_ON_FAIL(waitForSpecializedPipeline(pending, specializedPipelineState));
+        }
+        outNewPipeline = specializedPipelineState;
+    }
+    return SLANG_OK;
+}
 
-            // Now create the specialized shader program using compiled binaries.
-            ComPtr<IShaderProgram> specializedProgram;
-            IShaderProgram::Desc specializedProgramDesc = unspecializedProgram->desc;
-            specializedProgramDesc.slangGlobalScope = specializedComponentType;
+Result RendererBase::createSpecializedPipeline(
+    PipelineKey const& key,
+    PipelineStateBase* unspecializedPipeline,
+    ExtendedShaderObjectTypeList const& args,
+    RefPtr<PipelineStateBase>& outPipeline)
+{
+    std::lock_guard<std::recursive_mutex> slangLock(m_slangMutex);
 
-            if (specializedProgramDesc.linkingStyle == IShaderProgram::LinkingStyle::SingleProgram)
-            {
-                // When linking style is GraphicsCompute, the specialized global scope already contains
-                // entry-points, so we do not need to supply them again when creating the specialized
-                // pipeline.
-                specializedProgramDesc.entryPointCount = 0;
-            }
-            SLANG_RETURN_ON_FAIL(createProgram(specializedProgramDesc, specializedProgram.writeRef()));
+    auto pipelineType = unspecializedPipeline->desc.type;
+    auto unspecializedProgram = static_cast<ShaderProgramBase*>(pipelineType == PipelineType::Compute
+        ? unspecializedPipeline->desc.compute.program
+        : unspecializedPipeline->desc.graphics.program);
 
-            // Create specialized pipeline state.
-            ComPtr<IPipelineState> specializedPipelineComPtr;
-            switch (pipelineType)
-            {
-            case PipelineType::Compute:
+    ComPtr<slang::IComponentType> specializedComponentType;
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto compileRs = unspecializedProgram->linkedProgram->specialize(
+        args.components.getArrayView().getBuffer(),
+        args.getCount(),
+        specializedComponentType.writeRef(),
+        diagnosticBlob.writeRef());
+    if (diagnosticBlob)
+    {
+        getDebugCallback()->handleMessage(
+            compileRs == SLANG_OK ? DebugMessageType::Warning : DebugMessageType::Error,
+            DebugMessageSource::Slang,
+            (char*)diagnosticBlob->getBufferPointer());
+    }
+    SLANG_RETURN_ON_FAIL(compileRs);
+
+    // Now create the specialized shader program using compiled binaries.
+    ComPtr<IShaderProgram> specializedProgram;
+    IShaderProgram::Desc specializedProgramDesc = unspecializedProgram->desc;
+    specializedProgramDesc.slangGlobalScope = specializedComponentType;
+
+    if (specializedProgramDesc.linkingStyle == IShaderProgram::LinkingStyle::SingleProgram)
+    {
+        // When linking style is GraphicsCompute, the specialized global scope already contains
+        // entry-points, so we do not need to supply them again when creating the specialized
+        // pipeline.
+        specializedProgramDesc.entryPointCount = 0;
+    }
+    SLANG_RETURN_ON_FAIL(createProgram(specializedProgramDesc, specializedProgram.writeRef()));
+
+    // Create specialized pipeline state.
+    ComPtr<IPipelineState> specializedPipelineComPtr;
+    switch (pipelineType)
+    {
+    case PipelineType::Compute:
+    {
+        auto pipelineDesc = unspecializedPipeline->desc.compute;
+        pipelineDesc.program = specializedProgram;
+        pipelineDesc.specializationFallback = nullptr;
+        SLANG_RETURN_ON_FAIL(
+            createComputePipelineState(pipelineDesc, specializedPipelineComPtr.writeRef()));
+        break;
+    }
+    case PipelineType::Graphics:
+    {
+        auto pipelineDesc = unspecializedPipeline->desc.graphics;
+        pipelineDesc.program = static_cast<ShaderProgramBase*>(specializedProgram.get());
+        pipelineDesc.specializationFallback = nullptr;
+        SLANG_RETURN_ON_FAIL(createGraphicsPipelineState(
+            pipelineDesc, specializedPipelineComPtr.writeRef()));
+        break;
+    }
+    case PipelineType::RayTracing:
+    {
+        auto pipelineDesc = unspecializedPipeline->desc.rayTracing;
+        pipelineDesc.program = static_cast<ShaderProgramBase*>(specializedProgram.get());
+        SLANG_RETURN_ON_FAIL(createRayTracingPipelineState(
+            pipelineDesc.get(), specializedPipelineComPtr.writeRef()));
+        break;
+    }
+    default:
+        break;
+    }
+    RefPtr<PipelineStateBase> specializedPipelineState =
+        static_cast<PipelineStateBase*>(specializedPipelineComPtr.get());
+    specializedPipelineState->unspecializedPipelineState = unspecializedPipeline;
+
+    // Compile the kernels and create the API pipeline now, rather than when the pipeline
+    // is first bound, so that this is done on the background thread for an async specialization.
+    SLANG_RETURN_ON_FAIL(specializedPipelineState->ensureAPIPipelineStateCreated());
+
+    shaderCache.addSpecializedPipeline(key, specializedPipelineState);
+    outPipeline = specializedPipelineState;
+    return SLANG_OK;
+}
+
+Result RendererBase::getOrQueueSpecializedPipeline(
+    PipelineKey const& key,
+    PipelineStateBase* unspecializedPipeline,
+    ExtendedShaderObjectTypeList const& args,
+    RefPtr<PipelineStateBase>& outPipeline,
+    RefPtr<PendingPipelineSpecialization>* outPending)
+{
+    // Try to find specialized pipeline from shader cache.
+    outPipeline = shaderCache.getSpecializedPipelineState(key);
+    if (outPipeline)
+        return SLANG_OK;
+
+    if (!m_asyncPipelineSpecialization)
+        return createSpecializedPipeline(key, unspecializedPipeline, args, outPipeline);
+
+    std::lock_guard<std::mutex> lock(m_specializationMutex);
+
+    RefPtr<PendingPipelineSpecialization> pending;
+    if (!m_pendingSpecializations.TryGetValue(key, pending))
+    {
+        // The specialization may have been completed since the cache was checked.
+        outPipeline = shaderCache.getSpecializedPipelineState(key);
+        if (outPipeline)
+            return SLANG_OK;
+
+        pending = new PendingPipelineSpecialization();
+        pending->key = key;
+        pending->unspecializedPipeline = unspecializedPipeline;
+        pending->specializationArgs = args;
+        m_pendingSpecializations.Add(key, pending);
+        m_specializationQueue.add(pending);
+        m_specializationCondition.notify_all();
+    }
+    if (outPending)
+        *outPending = pending;
+    return SLANG_OK;
+}
+
+Result RendererBase::waitForSpecializedPipeline(
+    PendingPipelineSpecialization* pending,
+    RefPtr<PipelineStateBase>& outPipeline)
+{
+    {
+        std::unique_lock<std::mutex> lock(m_specializationMutex);
+        if (pending->state == PendingPipelineSpecialization::State::Queued)
+        {
+            // Rather than waiting for the specializations ahead of it in the queue,
+            // create it on this thread.
+            m_specializationQueue.remove(pending);
+            pending->state = PendingPipelineSpecialization::State::Creating;
+            lock.unlock();
+            _createPendingSpecializedPipeline(pending);
+        }
+        else
+        {
+            m_specializationCondition.wait(lock, [&]()
             {
-                auto pipelineDesc = currentPipeline->desc.compute;
-                pipelineDesc.program = specializedProgram;
-                SLANG_RETURN_ON_FAIL(
-                    createComputePipelineState(pipelineDesc, specializedPipelineComPtr.writeRef()));
-                break;
-            }
-            case PipelineType::Graphics:
+                return pending->state == PendingPipelineSpecialization::State::Done;
+            });
+        }
+    }
+    outPipeline = pending->specializedPipeline;
+    return pending->result;
+}
+
+void RendererBase::_createPendingSpecializedPipeline(PendingPipelineSpecialization* pending)
+{
+    RefPtr<PipelineStateBase> specializedPipeline;
+    Result result = createSpecializedPipeline(
+        pending->key, pending->unspecializedPipeline, pending->specializationArgs, specializedPipeline);
+
+    std::lock_guard<std::mutex> lock(m_specializationMutex);
+    pending->result = result;
+    pending->specializedPipeline = specializedPipeline;
+    pending->state = PendingPipelineSpecialization::State::Done;
+    m_pendingSpecializations.Remove(pending->key);
+    m_specializationCondition.notify_all();
+}
+
+void RendererBase::_specializationThreadMain()
+{
+    for (;;)
+    {
+        RefPtr<PendingPipelineSpecialization> pending;
+        {
+            std::unique_lock<std::mutex> lock(m_specializationMutex);
+            m_specializationCondition.wait(lock, [&]()
             {
-                auto pipelineDesc = currentPipeline->desc.graphics;
-                pipelineDesc.program = static_cast<ShaderProgramBase*>(specializedProgram.get());
-                SLANG_RETURN_ON_FAIL(createGraphicsPipelineState(
-                    pipelineDesc, specializedPipelineComPtr.writeRef()));
-                break;
-            }
-            case PipelineType::RayTracing:
+                return m_stopSpecializationThread || m_specializationQueue.getCount() != 0;
+            });
+            if (m_stopSpecializationThread)
+                return;
+
+            // Specializations are created in the order they were first needed
+            pending = m_specializationQueue[0];
+            m_specializationQueue.removeAt(0);
+            pending->state = PendingPipelineSpecialization::State::Creating;
+        }
+        _createPendingSpecializedPipeline(pending);
+    }
+}
+
+void RendererBase::_stopSpecializationThread()
+{
+    if (!m_specializationThread.joinable())
+        return;
+    {
+        std::lock_guard<std::mutex> lock(m_specializationMutex);
+        m_stopSpecializationThread = true;
+        m_specializationQueue.clear();
+        m_specializationCondition.notify_all();
+    }
+    m_specializationThread.join();
+}
+
+Result RendererBase::prewarmSpecializedPipelines(IPipelineState* pipeline, ISlangBlob* keys)
+{
+    auto pipelineBase = static_cast<PipelineStateBase*>(pipeline);
+    if (pipelineBase->unspecializedPipelineState)
+        pipelineBase = pipelineBase->unspecializedPipelineState;
+    if (!pipelineBase->isSpecializable)
+        return SLANG_OK;
+
+    auto program = pipelineBase->desc.getProgram();
+
+    // Each line holds a key, which is the names of the types of the specialization arguments separated by ';'.
+    UnownedStringSlice text((const char*)keys->getBufferPointer(), keys->getBufferSize());
+    List<UnownedStringSlice> lines;
+    StringUtil::calcLines(text, lines);
+
+    List<UnownedStringSlice> names;
+    for (auto line : lines)
+    {
+        line = line.trim();
+        if (line.getLength() == 0)
+            continue;
+
+        names.clear();
+        StringUtil::split(line, ';', names);
+
+        ExtendedShaderObjectTypeList args;
+        {
+            std::lock_guard<std::recursive_mutex> slangLock(m_slangMutex);
+            for (auto name : names)
             {
-                auto pipelineDesc = currentPipeline->desc.rayTracing;
-                pipelineDesc.program = static_cast<ShaderProgramBase*>(specializedProgram.get());
-                SLANG_RETURN_ON_FAIL(createRayTracingPipelineState(
-                    pipelineDesc.get(), specializedPipelineComPtr.writeRef()));
-                break;
-            }
-            default:
-                break;
+                auto type = program->findTypeByName(String(name).getBuffer());
+                if (!type)
+                    break;
+                ExtendedShaderObjectType arg;
+                arg.slangType = type;
+                arg.componentID = shaderCache.getComponentId(type);
+                args.add(arg);
             }
-            specializedPipelineState =
-                static_cast<PipelineStateBase*>(specializedPipelineComPtr.get());
-            specializedPipelineState->unspecializedPipelineState = currentPipeline;
-            shaderCache.addSpecializedPipeline(pipelineKey, specializedPipelineState);
         }
-        auto specializedPipelineStateBase = static_cast<PipelineStateBase*>(specializedPipelineState.Ptr());
-        outNewPipeline = specializedPipelineStateBase;
+        if (args.getCount() != names.getCount())
+        {
+            // The shader code may have changed since the keys were stored
+            getDebugCallback()->handleMessage(
+                DebugMessageType::Warning,
+                DebugMessageSource::Layer,
+                (String("Skipping pipeline specialization with unknown types: ") + line).getBuffer());
+            continue;
+        }
+
+        PipelineKey key;
+        key.pipeline = pipelineBase;
+        key.specializationArgs.addRange(args.componentIDs);
+        key.updateHash();
+
+        RefPtr<PipelineStateBase> specializedPipeline;
+        SLANG_RETURN_ON_FAIL(getOrQueueSpecializedPipeline(key, pipelineBase, args, specializedPipeline));
+    }
+    return SLANG_OK;
+}
+
+Result RendererBase::getSpecializedPipelineKeys(IPipelineState* pipeline, ISlangBlob** outKeys)
+{
+    auto pipelineBase = static_cast<PipelineStateBase*>(pipeline);
+    if (pipelineBase->unspecializedPipelineState)
+        pipelineBase = pipelineBase->unspecializedPipelineState;
+
+    List<PipelineKey> keys;
+    shaderCache.getSpecializedPipelineKeys(pipelineBase, keys);
+    {
+        std::lock_guard<std::mutex> lock(m_specializationMutex);
+        for (auto& entry : m_pendingSpecializations)
+        {
+            if (entry.Key.pipeline == pipelineBase)
+                keys.add(entry.Key);
+        }
+    }
+
+    StringBuilder builder;
+    for (auto& key : keys)
+    {
+        for (Index i = 0; i < key.specializationArgs.getCount(); ++i)
+        {
+            if (i != 0)
+                builder.appendChar(';');
+            builder.append(shaderCache.getComponentName(key.specializationArgs[i]));
+        }
+        builder.appendChar('\n');
     }
+    auto keysBlob = StringBlob::moveCreate(builder);
+    returnComPtr(outKeys, keysBlob);
     return SLANG_OK;
 }
 
@@ -7,6 +7,10 @@
 
 #include "resource-desc-utils.h"
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 namespace gfx
 {
 
@@ -1018,6 +1022,10 @@ public:
     // If null, this pipeline is either an unspecialized pipeline.
     Slang::RefPtr<PipelineStateBase> unspecializedPipelineState = nullptr;
 
+    // The pipeline used in place of a specialization of this pipeline whilst it is being
+    // created in the background. See `IDevice::Desc::asyncPipelineSpecialization`.
+    Slang::RefPtr<PipelineStateBase> specializationFallback = nullptr;
+
     // Indicates whether this is a specializable pipeline. A specializable
     // pipeline cannot be used directly and must be specialized first.
     bool isSpecializable = false;
@@ -1107,6 +1115,9 @@ struct OwningComponentKey
 };
 
 // A cache from specialization keys to a specialized `ShaderKernel`.
+//
+// The cache is thread safe, as pipelines may be specialized on a background thread
+// (see `IDevice::Desc::asyncPipelineSpecialization`).
 class ShaderCache : public Slang::RefObject
 {
 public:
@@ -1114,8 +1125,12 @@ public:
     ShaderComponentID getComponentId(Slang::UnownedStringSlice name);
     ShaderComponentID getComponentId(ComponentKey key);
 
+    // Get the name of the type of a component, as used by `getComponentId`.
+    Slang::String getComponentName(ShaderComponentID id);
+
     Slang::RefPtr<PipelineStateBase> getSpecializedPipelineState(PipelineKey programKey)
     {
+        std::lock_guard<std::mutex> lock(mutex);
         Slang::RefPtr<PipelineStateBase> result;
         if (specializedPipelines.TryGetValue(programKey, result))
             return result;
@@ -1124,17 +1139,47 @@ public:
     void addSpecializedPipeline(
         PipelineKey key,
         Slang::RefPtr<PipelineStateBase> specializedPipeline);
+    // Get the keys of the specializations of `pipeline` in the cache.
+    void getSpecializedPipelineKeys(
+        PipelineStateBase* pipeline,
+        Slang::List<PipelineKey>& outKeys);
     void free()
     {
+        std::lock_guard<std::mutex> lock(mutex);
         specializedPipelines = decltype(specializedPipelines)();
         componentIds = decltype(componentIds)();
+        componentNames = decltype(componentNames)();
     }
 
+    // Held whilst `getComponentId` uses the reflection API (see `RendererBase::m_slangMutex`)
+    std::recursive_mutex* slangMutex = nullptr;
+
 protected:
+    std::mutex mutex;
     Slang::OrderedDictionary<OwningComponentKey, ShaderComponentID> componentIds;
+    Slang::List<Slang::String> componentNames;
     Slang::OrderedDictionary<PipelineKey, Slang::RefPtr<PipelineStateBase>> specializedPipelines;
 };
 
+// A specialization of a pipeline that is being created on the background thread of a device.
+struct PendingPipelineSpecialization : public Slang::RefObject
+{
+    enum class State
+    {
+        Queued,
+        Creating,
+        Done,
+    };
+
+    PipelineKey key;
+    Slang::RefPtr<PipelineStateBase> unspecializedPipeline;
+    ExtendedShaderObjectTypeList specializationArgs;
+
+    State state = State::Queued;
+    Result result = SLANG_OK;
+    Slang::RefPtr<PipelineStateBase> specializedPipeline;
+};
+
 class TransientResourceHeapBase : public ITransientResourceHeap, public Slang::ComObject
 {
 public:
@@ -1307,6 +1352,12 @@ public:
     // Provides a default implementation that returns SLANG_E_NOT_AVAILABLE.
     virtual SLANG_NO_THROW Result SLANG_MCALL getTextureRowAlignment(size_t* outAlignment) override;
 
+    virtual SLANG_NO_THROW Result SLANG_MCALL prewarmSpecializedPipelines(
+        IPipelineState* pipeline, ISlangBlob* keys) override;
+
+    virtual SLANG_NO_THROW Result SLANG_MCALL getSpecializedPipelineKeys(
+        IPipelineState* pipeline, ISlangBlob** outKeys) override;
+
     Result getShaderObjectLayout(
         slang::TypeReflection*      type,
         ShaderObjectContainerType   container,
@@ -1317,6 +1368,8 @@ public:
         ShaderObjectLayoutBase** outLayout);
 
 public:
+    ~RendererBase() { _stopSpecializationThread(); }
+
     ExtendedShaderObjectTypeList specializationArgs;
     // Given current pipeline and root shader object binding, generate and bind a specialized pipeline if necessary.
     // The newly specialized pipeline is held alive by the pipeline cache so users of `outNewPipeline` do not
@@ -1326,6 +1379,29 @@ public:
         ShaderObjectBase* rootObject,
         Slang::RefPtr<PipelineStateBase>& outNewPipeline);
 
+    // Create the specialization of `unspecializedPipeline` for `args`, and add it to the shader cache.
+    Result createSpecializedPipeline(
+        PipelineKey const& key,
+        PipelineStateBase* unspecializedPipeline,
+        ExtendedShaderObjectTypeList const& args,
+        Slang::RefPtr<PipelineStateBase>& outPipeline);
+
+    // Get the specialization for `key`, creating it if `Desc::asyncPipelineSpecialization` isn't set,
+    // or queuing it to be created on the background thread if it is.
+    // `outPipeline` is null if the specialization is queued.
+    Result getOrQueueSpecializedPipeline(
+        PipelineKey const& key,
+        PipelineStateBase* unspecializedPipeline,
+        ExtendedShaderObjectTypeList const& args,
+        Slang::RefPtr<PipelineStateBase>& outPipeline,
+        Slang::RefPtr<PendingPipelineSpecialization>* outPending = nullptr);
+
+    // Wait for `pending` to be created. If it hasn't been started on the background thread,
+    // it is created on the calling thread.
+    Result waitForSpecializedPipeline(
+        PendingPipelineSpecialization* pending,
+        Slang::RefPtr<PipelineStateBase>& outPipeline);
+
 
     virtual Result createShaderObjectLayout(
         slang::TypeLayoutReflection* typeLayout,
@@ -1341,13 +1417,33 @@ public:
 
 protected:
     virtual SLANG_NO_THROW SlangResult SLANG_MCALL initialize(const Desc& desc);
+
+    virtual void comFree() override { _stopSpecializationThread(); }
+
+    void _specializationThreadMain();
+    void _stopSpecializationThread();
+    void _createPendingSpecializedPipeline(PendingPipelineSpecialization* pending);
 protected:
     Slang::List<Slang::String> m_features;
 
+    bool m_asyncPipelineSpecialization = false;
+
+    // The queue of specializations for the background thread, guarded by `m_specializationMutex`
+    std::thread m_specializationThread;
+    std::mutex m_specializationMutex;
+    std::condition_variable m_specializationCondition;
+    Slang::List<Slang::RefPtr<PendingPipelineSpecialization>> m_specializationQueue;
+    Slang::Dictionary<PipelineKey, Slang::RefPtr<PendingPipelineSpecialization>> m_pendingSpecializations;
+    bool m_stopSpecializationThread = false;
+
 public:
     SlangContext slangContext;
     ShaderCache shaderCache;
 
+    // Held whilst using `slangContext`, as Slang sessions aren't thread safe, and pipelines may
+    // be specialized on a background thread.
+    std::recursive_mutex m_slangMutex;
+
     Slang::Dictionary<slang::TypeLayoutReflection*, Slang::RefPtr<ShaderObjectLayoutBase>> m_shaderObjectLayoutCache;
     Slang::ComPtr<IPipelineCreationAPIDispatcher> m_pipelineCreationAPIDispatcher;
 };
@@ -1397,6 +1493,7 @@ void ShaderObjectBaseImpl<TShaderObjectImpl, TShaderObjectLayoutImpl, TShaderObj
             if (m_structuredBufferSpecializationArgs[i].componentID !=
                 specializationArgs[i].componentID)
             {
+                std::lock_guard<std::recursive_mutex> slangLock(device->m_slangMutex);
                 auto dynamicType = device->slangContext.session->getDynamicType();
                 m_structuredBufferSpecializationArgs.componentIDs[i] =
                     device->shaderCache.getComponentId(dynamicType);
@@ -1528,6 +1625,7 @@ Result ShaderObjectBaseImpl<TShaderObjectImpl, TShaderObjectLayoutImpl, TShaderO
                 {
                     if (args[i + oldArgsCount].componentID != typeArgs[i].componentID)
                     {
+                        std::lock_guard<std::recursive_mutex> slangLock(device->m_slangMutex);
                         auto dynamicType = device->slangContext.session->getDynamicType();
                         args.componentIDs[i + oldArgsCount] =
                             device->shaderCache.getComponentId(dynamicType);
@@ -31,6 +31,7 @@ namespace gfx
             macros.addRange(desc.preprocessorMacros, desc.preprocessorMacroCount);
             macros.addRange(additionalMacros.getBuffer(), additionalMacros.getCount());
             slangSessionDesc.preprocessorMacros = macros.getBuffer();
+            slangSessionDesc.compileCacheDirectory = desc.compileCacheDirectory;
             slang::TargetDesc targetDesc = {};
             targetDesc.format = compileTarget;
             auto targetProfile = desc.targetProfile;
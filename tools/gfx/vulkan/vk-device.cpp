@@ -1930,6 +1930,7 @@ Result DeviceImpl::createInputLayout(IInputLayout::Desc const& desc, IInputLayou
 Result DeviceImpl::createProgram(
     const IShaderProgram::Desc& desc, IShaderProgram** outProgram, ISlangBlob** outDiagnosticBlob)
 {
+    std::lock_guard<std::recursive_mutex> slangLock(m_slangMutex);
     RefPtr<ShaderProgramImpl> shaderProgram = new ShaderProgramImpl(this);
     shaderProgram->init(desc);
 
@@ -2000,7 +2001,11 @@ Result DeviceImpl::createGraphicsPipelineState(
     RefPtr<PipelineStateImpl> pipelineStateImpl = new PipelineStateImpl(this);
     pipelineStateImpl->init(desc);
     pipelineStateImpl->establishStrongDeviceReference();
-    m_deviceObjectsWithPotentialBackReferences.add(pipelineStateImpl);
+    {
+        // Pipelines may also be created on the pipeline specialization thread.
+        std::lock_guard<std::recursive_mutex> slangLock(m_slangMutex);
+        m_deviceObjectsWithPotentialBackReferences.add(pipelineStateImpl);
+    }
     returnComPtr(outState, pipelineStateImpl);
 
     return SLANG_OK;
@@ -2012,7 +2017,11 @@ Result DeviceImpl::createComputePipelineState(
     ComputePipelineStateDesc desc = inDesc;
     RefPtr<PipelineStateImpl> pipelineStateImpl = new PipelineStateImpl(this);
     pipelineStateImpl->init(desc);
-    m_deviceObjectsWithPotentialBackReferences.add(pipelineStateImpl);
+    {
+        // Pipelines may also be created on the pipeline specialization thread.
+        std::lock_guard<std::recursive_mutex> slangLock(m_slangMutex);
+        m_deviceObjectsWithPotentialBackReferences.add(pipelineStateImpl);
+    }
     pipelineStateImpl->establishStrongDeviceReference();
     returnComPtr(outState, pipelineStateImpl);
     return SLANG_OK;
@@ -2023,7 +2032,11 @@ Result DeviceImpl::createRayTracingPipelineState(
 {
     RefPtr<RayTracingPipelineStateImpl> pipelineStateImpl = new RayTracingPipelineStateImpl(this);
     pipelineStateImpl->init(desc);
-    m_deviceObjectsWithPotentialBackReferences.add(pipelineStateImpl);
+    {
+        // Pipelines may also be created on the pipeline specialization thread.
+        std::lock_guard<std::recursive_mutex> slangLock(m_slangMutex);
+        m_deviceObjectsWithPotentialBackReferences.add(pipelineStateImpl);
+    }
     pipelineStateImpl->establishStrongDeviceReference();
     returnComPtr(outState, pipelineStateImpl);
     return SLANG_OK;
@@ -300,6 +300,10 @@ Result PipelineStateImpl::ensureAPIPipelineStateCreated()
     if (m_pipeline)
         return SLANG_OK;
 
+    std::lock_guard<std::recursive_mutex> slangLock(m_device->m_slangMutex);
+    if (m_pipeline)
+        return SLANG_OK;
+
     switch (desc.type)
     {
     case PipelineType::Compute:
@@ -438,6 +442,10 @@ Result RayTracingPipelineStateImpl::ensureAPIPipelineStateCreated()
     if (m_pipeline)
         return SLANG_OK;
 
+    std::lock_guard<std::recursive_mutex> slangLock(m_device->m_slangMutex);
+    if (m_pipeline)
+        return SLANG_OK;
+
     switch (desc.type)
     {
     case PipelineType::RayTracing:
@@ -139,6 +139,60 @@ namespace renderer_test
             {
                 val->samplerDesc.isCompareSampler = true;
             }
+            else if (word == "filter")
+            {
+                parser.Read("=");
+                auto filterWord = parser.ReadWord();
+                if (filterWord == "point")
+                    val->samplerDesc.filteringMode = TextureFilteringMode::Point;
+                else if (filterWord == "linear")
+                    val->samplerDesc.filteringMode = TextureFilteringMode::Linear;
+                else
+                    return SLANG_FAIL;
+            }
+            else if (word == "address")
+            {
+                parser.Read("=");
+                auto addressWord = parser.ReadWord();
+                if (addressWord == "wrap")
+                    val->samplerDesc.addressingMode = TextureAddressingMode::Wrap;
+                else if (addressWord == "clamp")
+                    val->samplerDesc.addressingMode = TextureAddressingMode::ClampToEdge;
+                else if (addressWord == "border")
+                    val->samplerDesc.addressingMode = TextureAddressingMode::ClampToBorder;
+                else if (addressWord == "mirror")
+                    val->samplerDesc.addressingMode = TextureAddressingMode::MirrorRepeat;
+                else if (addressWord == "mirrorOnce")
+                    val->samplerDesc.addressingMode = TextureAddressingMode::MirrorOnce;
+                else
+                    return SLANG_FAIL;
+            }
+            else if (word == "borderColor")
+            {
+                parser.Read("=");
+                parser.Read("[");
+                for (auto& component : val->samplerDesc.borderColor)
+                {
+                    component = parser.ReadFloat();
+                }
+                parser.Read("]");
+            }
+            else if (word == "reduction")
+            {
+                parser.Read("=");
+                auto reductionWord = parser.ReadWord();
+                if (reductionWord == "min")
+                    val->samplerDesc.reductionOp = TextureReductionOp::Minimum;
+                else if (reductionWord == "max")
+                    val->samplerDesc.reductionOp = TextureReductionOp::Maximum;
+                else
+                    return SLANG_FAIL;
+            }
+            else if (word == "maxAnisotropy")
+            {
+                parser.Read("=");
+                val->samplerDesc.maxAnisotropy = uint32_t(parser.ReadInt());
+            }
             else
             {
                 return SLANG_FAIL;
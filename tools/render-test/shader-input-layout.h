@@ -63,6 +63,11 @@ struct InputBufferDesc
 struct InputSamplerDesc
 {
     bool isCompareSampler = false;
+    TextureFilteringMode filteringMode = TextureFilteringMode::Linear;     ///< Used for min, mag and mip filtering
+    TextureAddressingMode addressingMode = TextureAddressingMode::Wrap;     ///< Used for all axes
+    TextureReductionOp reductionOp = TextureReductionOp::Average;          ///< Ignored for a compare sampler
+    float borderColor[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+    uint32_t maxAnisotropy = 1;
 };
 
 struct TextureData
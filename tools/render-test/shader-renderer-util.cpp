@@ -131,6 +131,18 @@ using Slang::Result;
 static ISamplerState::Desc _calcSamplerDesc(const InputSamplerDesc& srcDesc)
 {
     ISamplerState::Desc dstDesc;
+    dstDesc.minFilter = srcDesc.filteringMode;
+    dstDesc.magFilter = srcDesc.filteringMode;
+    dstDesc.mipFilter = srcDesc.filteringMode;
+    dstDesc.addressU = srcDesc.addressingMode;
+    dstDesc.addressV = srcDesc.addressingMode;
+    dstDesc.addressW = srcDesc.addressingMode;
+    dstDesc.reductionOp = srcDesc.reductionOp;
+    for (Index i = 0; i < SLANG_COUNT_OF(dstDesc.borderColor); ++i)
+    {
+        dstDesc.borderColor[i] = srcDesc.borderColor[i];
+    }
+    dstDesc.maxAnisotropy = srcDesc.maxAnisotropy;
     if (srcDesc.isCompareSampler)
     {
         dstDesc.reductionOp = TextureReductionOp::Comparison;
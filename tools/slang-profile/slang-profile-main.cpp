@@ -3,7 +3,7 @@
 #include "../../source/core/slang-io.h"
 #include "../../source/core/slang-std-writers.h"
 
-#include "../../source/core/slang-process-util.h"
+#include "../../source/core/slang-process.h"
 
 #include "../../slang-com-helper.h"
 
@@ -11,13 +11,76 @@
 
 using namespace Slang;
 
+static void _printTime(const char* name, uint64_t startTick, uint64_t endTick, Int count)
+{
+    const double seconds = double(endTick - startTick) / Process::getClockFrequency();
+    printf("%s: total %f s, %f s per iteration (%d iterations)\n", name, seconds, seconds / double(count), int(count));
+}
+
+// Time compiling with the `slangc` style command line `args`, `count` times with the same global session.
+// The time to create the session (and load the stdlib) isn't included.
+//
+// Useful for comparing the compile time of a build against a build without a change, for example:
+//
+// slang-profile -repeat 16 tests/compute/simple.slang -target hlsl -entry computeMain -stage compute
+static SlangResult _timeCompile(Int count, const List<const char*>& args)
+{
+    ComPtr<slang::IGlobalSession> slangSession;
+    slangSession.attach(spCreateSession(nullptr));
+
+    const auto startTick = Process::getClockTick();
+
+    for (Int i = 0; i < count; ++i)
+    {
+        SlangCompileRequest* request = spCreateCompileRequest(slangSession);
+
+        SlangResult res = spProcessCommandLineArguments(request, args.getBuffer(), int(args.getCount()));
+        if (SLANG_SUCCEEDED(res))
+        {
+            res = spCompile(request);
+        }
+        if (SLANG_FAILED(res))
+        {
+            fprintf(stderr, "%s", spGetDiagnosticOutput(request));
+        }
+
+        spDestroyCompileRequest(request);
+        SLANG_RETURN_ON_FAIL(res);
+    }
+
+    const auto endTick = Process::getClockTick();
+
+    _printTime("Compile", startTick, endTick, count);
+    return SLANG_OK;
+}
+
 SlangResult innerMain(int argc, char** argv)
 {
     auto stdWriters = StdWriters::initDefaultSingleton();
 
+    Int repeatCount = 8;
+    List<const char*> compileArgs;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "-repeat") == 0 && i + 1 < argc)
+        {
+            repeatCount = Int(atoi(argv[++i]));
+        }
+        else
+        {
+            compileArgs.add(argv[i]);
+        }
+    }
+
+    // If there is a command line, time compiling it
+    if (compileArgs.getCount())
+    {
+        return _timeCompile(repeatCount, compileArgs);
+    }
+
     // Time the creation of the session
     {
-        const auto startTick = ProcessUtil::getClockTick();
+        const auto startTick = Process::getClockTick();
 
         for (Int i = 0; i < 32; ++i)
         {
@@ -25,9 +88,9 @@ SlangResult innerMain(int argc, char** argv)
             slangSession.attach(spCreateSession(nullptr));
         }
 
-        const auto endTick = ProcessUtil::getClockTick();
+        const auto endTick = Process::getClockTick();
 
-        printf("Ticks %f\n", double(endTick - startTick) / ProcessUtil::getClockFrequency());
+        printf("Ticks %f\n", double(endTick - startTick) / Process::getClockFrequency());
         return SLANG_OK;
     }
 
@@ -35,6 +35,7 @@
 #include "../../source/compiler-core/slang-downstream-compiler.h"
 #include "../../source/compiler-core/slang-nvrtc-compiler.h"
 #include "../../source/compiler-core/slang-language-server-protocol.h"
+#include "../../source/compiler-core/slang-compile-server-protocol.h"
 
 #include "../../source/compiler-core/slang-artifact-associated-impl.h"
 
@@ -1524,6 +1525,15 @@ TestResult runLanguageServerTest(TestContext* context, TestInput& input)
         return TestResult::Fail;
     }
 
+    // Tracing is only enabled for tests that check the server's log messages, as the server is shared by all tests
+    const bool hasLogChecks = testFileContent.getUnownedSlice().indexOf(UnownedStringSlice("//LOG:")) != -1;
+    if (hasLogChecks)
+    {
+        LanguageServerProtocol::SetTraceParams traceParams;
+        traceParams.value = "verbose";
+        connection->sendCall(LanguageServerProtocol::SetTraceParams::methodName, &traceParams);
+    }
+
     LanguageServerProtocol::DidOpenTextDocumentParams openDocParams;
     openDocParams.textDocument.version = 0;
     openDocParams.textDocument.uri = URI::fromLocalFilePath(fullPath.getUnownedSlice()).uri;
@@ -1534,6 +1544,10 @@ TestResult runLanguageServerTest(TestContext* context, TestInput& input)
         JSONValue::makeInt(1));
     List<LanguageServerProtocol::PublishDiagnosticsParams> diagnostics;
     bool diagnosticsReceived = false;
+    // The log messages received since the last document was opened
+    List<String> logMessages;
+    // The other documents opened by the test, which are closed at the end
+    List<String> openedDocUris;
     auto waitForNonDiagnosticResponse = [&]() -> SlangResult
     {
         repeat:
@@ -1552,6 +1566,15 @@ TestResult runLanguageServerTest(TestContext* context, TestInput& input)
                 diagnostics.add(arg);
                 goto repeat;
             }
+            if (call.method == LanguageServerProtocol::LogMessageParams::methodName)
+            {
+                // A log message is a notification, so what it logs is in its params
+                LanguageServerProtocol::LogMessageParams arg;
+                if (SLANG_FAILED(connection->toNativeArgsOrSendError(call.params, &arg, call.id)))
+                    return SLANG_FAIL;
+                logMessages.add(arg.message);
+                goto repeat;
+            }
         }
         return SLANG_OK;
     };
@@ -1683,6 +1706,46 @@ TestResult runLanguageServerTest(TestContext* context, TestInput& input)
                 actualOutputSB << "\ncontent:\n" << hover.contents.value << "\n";
             }
         }
+        else if (line.startsWith("//OPEN:"))
+        {
+            // Open the file next to the test with the first name, with the contents of the file with the second
+            // name. Opened documents take the place of the files on disk, so this is like editing the file.
+            auto arg = line.tail(UnownedStringSlice("//OPEN:").getLength()).trim();
+            List<UnownedStringSlice> names;
+            StringUtil::split(arg, ',', names);
+            if (names.getCount() != 2)
+                return TestResult::Fail;
+
+            const String directory = Path::getParentDirectory(fullPath);
+            String docText;
+            if (SLANG_FAILED(File::readAllText(Path::combine(directory, String(names[1].trim())), docText)))
+                return TestResult::Fail;
+
+            String docPath;
+            Path::getCanonical(Path::combine(directory, String(names[0].trim())), docPath);
+
+            LanguageServerProtocol::DidOpenTextDocumentParams params;
+            params.textDocument.version = 0;
+            params.textDocument.uri = URI::fromLocalFilePath(docPath.getUnownedSlice()).uri;
+            params.textDocument.text = docText;
+            connection->sendCall(
+                LanguageServerProtocol::DidOpenTextDocumentParams::methodName,
+                &params,
+                JSONValue::makeInt(callId++));
+            openedDocUris.add(params.textDocument.uri);
+            logMessages.clear();
+        }
+        else if (line.startsWith("//LOG:"))
+        {
+            // Output the log messages received since the last document was opened that contain the text
+            auto arg = line.tail(UnownedStringSlice("//LOG:").getLength()).trim();
+            actualOutputSB << "--------\n";
+            for (auto& message : logMessages)
+            {
+                if (message.getUnownedSlice().indexOf(arg) != -1)
+                    actualOutputSB << message << "\n";
+            }
+        }
         else if (line.startsWith("//DIAGNOSTICS"))
         {
             if (!diagnosticsReceived)
@@ -1702,12 +1765,27 @@ TestResult runLanguageServerTest(TestContext* context, TestInput& input)
             }
         }
     }
+    for (auto& uri : openedDocUris)
+    {
+        LanguageServerProtocol::DidCloseTextDocumentParams closeParams;
+        closeParams.textDocument.uri = uri;
+        connection->sendCall(
+            LanguageServerProtocol::DidCloseTextDocumentParams::methodName,
+            &closeParams,
+            JSONValue::makeInt(1));
+    }
     LanguageServerProtocol::DidCloseTextDocumentParams closeDocParams;
     closeDocParams.textDocument.uri = URI::fromLocalFilePath(fullPath.getUnownedSlice()).uri;
     connection->sendCall(
         LanguageServerProtocol::DidCloseTextDocumentParams::methodName,
         &closeDocParams,
         JSONValue::makeInt(1));
+    if (hasLogChecks)
+    {
+        LanguageServerProtocol::SetTraceParams traceParams;
+        traceParams.value = "off";
+        connection->sendCall(LanguageServerProtocol::SetTraceParams::methodName, &traceParams);
+    }
 
     auto outputStem = input.outputStem;
     String expectedOutputPath = outputStem + ".expected.txt";
@@ -1773,6 +1851,125 @@ TestResult runLanguageServerTest(TestContext* context, TestInput& input)
     return result;
 }
 
+    /// Send a `compile` call with `args` to the compile server on `connection`, and wait for its result
+static SlangResult _compileWithServer(JSONRPCConnection* connection, const List<String>& args, Int id, CompileServerProtocol::CompileResult& outResult)
+{
+    CompileServerProtocol::CompileArgs compileArgs;
+    compileArgs.args = args;
+    SLANG_RETURN_ON_FAIL(connection->sendCall(CompileServerProtocol::CompileArgs::g_methodName, &compileArgs, JSONValue::makeInt(id)));
+    SLANG_RETURN_ON_FAIL(connection->waitForResult(-1));
+    return connection->getMessage(&outResult);
+}
+
+static void _appendCompileResult(const char* name, const CompileServerProtocol::CompileResult& result, StringBuilder& out)
+{
+    out << name << ": returnCode " << result.returnCode << ", reusedLinkage " << (result.reusedLinkage ? "true" : "false") << "\n";
+    if (result.returnCode != 0)
+    {
+        out << result.stdError;
+    }
+}
+
+// Runs slangc as a compile server, and compiles the test file with the test's options on it twice, then a copy of the
+// test file before and after the copy is changed. Outputs which of the compilations were made on the linkage of an
+// earlier one, which should be all of them other than the first, and the one after the change.
+TestResult runCompileServerTest(TestContext* context, TestInput& input)
+{
+    if (context->isCollectingRequirements())
+    {
+        return TestResult::Pass;
+    }
+
+    RefPtr<Process> process;
+    {
+        CommandLine cmdLine;
+        cmdLine.setExecutableLocation(ExecutableLocation(context->exeDirectoryPath, "slangc"));
+        cmdLine.addArg("-compile-server");
+        if (SLANG_FAILED(Process::create(cmdLine, 0, process)))
+        {
+            return TestResult::Fail;
+        }
+    }
+
+    RefPtr<JSONRPCConnection> connection = new JSONRPCConnection;
+    {
+        Stream* writeStream = process->getStream(StdStreamType::In);
+        RefPtr<BufferedReadStream> readStream(new BufferedReadStream(process->getStream(StdStreamType::Out)));
+        RefPtr<HTTPPacketConnection> packetConnection = new HTTPPacketConnection(readStream, writeStream);
+        if (SLANG_FAILED(connection->init(packetConnection, JSONRPCConnection::CallStyle::Object, process)))
+        {
+            return TestResult::Fail;
+        }
+    }
+
+    String testFileContent;
+    if (SLANG_FAILED(File::readAllText(input.filePath, testFileContent)))
+    {
+        return TestResult::Fail;
+    }
+
+    auto outputStem = input.outputStem;
+    const String copyPath = outputStem + ".copy.slang";
+
+    List<String> args;
+    args.add(input.filePath);
+    args.addRange(input.testOptions->args);
+
+    List<String> copyArgs(args);
+    copyArgs[0] = copyPath;
+
+    StringBuilder actualOutputSB;
+    {
+        CompileServerProtocol::CompileResult first, second, copy, editedCopy;
+        if (SLANG_FAILED(_compileWithServer(connection, args, 0, first)) ||
+            SLANG_FAILED(_compileWithServer(connection, args, 1, second)))
+        {
+            return TestResult::Fail;
+        }
+        _appendCompileResult("compile", first, actualOutputSB);
+        _appendCompileResult("compile again", second, actualOutputSB);
+        actualOutputSB << "same output: " << (second.stdOut == first.stdOut ? "true" : "false") << "\n";
+
+        File::writeAllText(copyPath, testFileContent);
+        const SlangResult copyRes = _compileWithServer(connection, copyArgs, 2, copy);
+
+        File::writeAllText(copyPath, testFileContent + "\n// edited\n");
+        const SlangResult editedCopyRes = _compileWithServer(connection, copyArgs, 3, editedCopy);
+
+        File::remove(copyPath);
+        if (SLANG_FAILED(copyRes) || SLANG_FAILED(editedCopyRes))
+        {
+            return TestResult::Fail;
+        }
+        _appendCompileResult("compile copy", copy, actualOutputSB);
+        _appendCompileResult("compile edited copy", editedCopy, actualOutputSB);
+    }
+
+    // The server replies to `quit` before exiting
+    if (SLANG_FAILED(connection->sendCall(CompileServerProtocol::QuitArgs::g_methodName, JSONValue::makeInt(4))) ||
+        SLANG_FAILED(connection->waitForResult(-1)))
+    {
+        return TestResult::Fail;
+    }
+    actualOutputSB << "quit: " << (connection->getMessageType() == JSONRPCMessageType::Result ? "result" : "no result") << "\n";
+    process->waitForTermination(-1);
+    actualOutputSB << "exited: " << (process->isTerminated() ? "true" : "false") << "\n";
+    connection->disconnect();
+
+    String expectedOutput;
+    Slang::File::readAllText(outputStem + ".expected.txt", expectedOutput);
+    expectedOutput = expectedOutput.trim();
+
+    String actualOutput = actualOutputSB.ProduceString().trim();
+    if (!StringUtil::areLinesEqual(actualOutput.getUnownedSlice(), expectedOutput.getUnownedSlice()))
+    {
+        Slang::File::writeAllText(outputStem + ".actual", actualOutput);
+        context->getTestReporter()->dumpOutputDifference(expectedOutput, actualOutput);
+        return TestResult::Fail;
+    }
+    return TestResult::Pass;
+}
+
 TestResult runSimpleTest(TestContext* context, TestInput& input)
 {
     // need to execute the stand-alone Slang compiler on the file, and compare its output to what we expect
@@ -3426,6 +3623,7 @@ static const TestCommandInfo s_testCommandInfos[] =
     { "COMPILE",                                &runCompile,                                0 },
     { "DOC",                                    &runDocTest,                                0 },
     { "LANG_SERVER",                            &runLanguageServerTest,                     0},
+    { "COMPILE_SERVER",                         &runCompileServerTest,                      0},
     { "EXECUTABLE",                             &runExecutableTest,                         RenderApiFlag::CPU}
 };
 
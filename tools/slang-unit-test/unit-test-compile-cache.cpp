@@ -0,0 +1,276 @@
+// unit-test-compile-cache.cpp
+
+#include "../../slang.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "../../slang-com-ptr.h"
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-blob.h"
+
+using namespace Slang;
+
+namespace { // anonymous
+
+struct CacheEntryCounter : public Path::Visitor
+{
+    void accept(Path::Type type, const UnownedStringSlice& filename) SLANG_OVERRIDE
+    {
+        if (type == Path::Type::File && filename.endsWith(toSlice(".slang-cache")))
+        {
+            count++;
+        }
+    }
+    Index count = 0;
+};
+
+} // anonymous
+
+static Index _countCacheEntries(const String& directory)
+{
+    CacheEntryCounter counter;
+    Path::find(directory, nullptr, &counter);
+    return counter.count;
+}
+
+static void _removeCacheEntries(const String& directory)
+{
+    struct Remover : public Path::Visitor
+    {
+        void accept(Path::Type type, const UnownedStringSlice& filename) SLANG_OVERRIDE
+        {
+            if (type == Path::Type::File)
+            {
+                File::remove(Path::combine(directory, filename));
+            }
+        }
+        String directory;
+    };
+    Remover remover;
+    remover.directory = directory;
+    Path::find(directory, nullptr, &remover);
+}
+
+static String _compileWithCache(slang::IGlobalSession* globalSession, const char* cacheDirectory, const char* source, const char* defineValue)
+{
+    slang::TargetDesc targetDesc;
+    targetDesc.format = SLANG_HLSL;
+
+    slang::PreprocessorMacroDesc macro = { "VALUE", defineValue };
+
+    slang::SessionDesc sessionDesc;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.targetCount = 1;
+    sessionDesc.preprocessorMacros = &macro;
+    sessionDesc.preprocessorMacroCount = 1;
+    sessionDesc.compileCacheDirectory = cacheDirectory;
+
+    ComPtr<slang::ISession> session;
+    if (SLANG_FAILED(globalSession->createSession(sessionDesc, session.writeRef())))
+    {
+        return String();
+    }
+
+    ComPtr<ISlangBlob> sourceBlob = StringBlob::create(String(source));
+    slang::IModule* module = session->loadModuleFromSource("compileCacheTest", "compile-cache-test.slang", sourceBlob);
+    if (!module)
+    {
+        return String();
+    }
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    if (SLANG_FAILED(module->findEntryPointByName("computeMain", entryPoint.writeRef())))
+    {
+        return String();
+    }
+
+    slang::IComponentType* components[] = { module, entryPoint };
+    ComPtr<slang::IComponentType> program;
+    if (SLANG_FAILED(session->createCompositeComponentType(components, 2, program.writeRef())))
+    {
+        return String();
+    }
+
+    ComPtr<ISlangBlob> code;
+    if (SLANG_FAILED(program->getEntryPointCode(0, 0, code.writeRef())))
+    {
+        return String();
+    }
+    return String(UnownedStringSlice((const char*)code->getBufferPointer(), code->getBufferSize()));
+}
+
+static String _compileRequestWithCache(slang::IGlobalSession* globalSession, const char* cacheDirectory, const char* source, const char* extraArg)
+{
+    ComPtr<slang::ICompileRequest> request;
+    if (SLANG_FAILED(globalSession->createCompileRequest(request.writeRef())))
+    {
+        return String();
+    }
+
+    List<const char*> args;
+    args.addRange({ "-target", "hlsl", "-DVALUE=1", "-compile-cache", cacheDirectory });
+    if (extraArg)
+    {
+        args.add(extraArg);
+    }
+    if (SLANG_FAILED(request->processCommandLineArguments(args.getBuffer(), int(args.getCount()))))
+    {
+        return String();
+    }
+
+    const int translationUnitIndex = request->addTranslationUnit(SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    request->addTranslationUnitSourceString(translationUnitIndex, "compile-cache-test.slang", source);
+    request->addEntryPoint(translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    if (SLANG_FAILED(request->compile()))
+    {
+        return String();
+    }
+
+    // The result isn't checked, as getEntryPointCodeBlob doesn't return SLANG_OK on success
+    ComPtr<ISlangBlob> code;
+    request->getEntryPointCodeBlob(0, 0, code.writeRef());
+    if (!code)
+    {
+        return String();
+    }
+    return String(UnownedStringSlice((const char*)code->getBufferPointer(), code->getBufferSize()));
+}
+
+    /// Change the code stored in the only entry of the cache, such that code that was loaded from
+    /// the cache can be told apart from code that was compiled. Replaces the last character of the
+    /// last occurrence of `text` (which is in the code, as that follows the key) with 'X'.
+static bool _markCachedCode(const String& directory, const char* text)
+{
+    struct Finder : public Path::Visitor
+    {
+        void accept(Path::Type type, const UnownedStringSlice& filename) SLANG_OVERRIDE
+        {
+            if (type == Path::Type::File && filename.endsWith(toSlice(".slang-cache")))
+            {
+                path = Path::combine(directory, filename);
+            }
+        }
+        String directory;
+        String path;
+    };
+    Finder finder;
+    finder.directory = directory;
+    Path::find(directory, nullptr, &finder);
+
+    List<unsigned char> contents;
+    if (finder.path.getLength() == 0 || SLANG_FAILED(File::readAllBytes(finder.path, contents)))
+    {
+        return false;
+    }
+
+    const UnownedStringSlice contentsSlice((const char*)contents.getBuffer(), size_t(contents.getCount()));
+    const UnownedStringSlice textSlice(text);
+
+    Index found = -1;
+    for (Index i = 0; i + textSlice.getLength() <= contentsSlice.getLength(); ++i)
+    {
+        if (UnownedStringSlice(contentsSlice.begin() + i, textSlice.getLength()) == textSlice)
+        {
+            found = i;
+        }
+    }
+    if (found < 0)
+    {
+        return false;
+    }
+
+    contents[found + textSlice.getLength() - 1] = 'X';
+    return SLANG_SUCCEEDED(File::writeAllBytes(finder.path, contents.getBuffer(), size_t(contents.getCount())));
+}
+
+// Test that compiled target code is stored in, and reused from, the compile cache directory.
+SLANG_UNIT_TEST(compileCache)
+{
+    const char* source = R"(
+        [shader("compute")]
+        [numthreads(4,1,1)]
+        void computeMain(
+            uint3 sv_dispatchThreadID : SV_DispatchThreadID,
+            uniform RWStructuredBuffer<int> buffer)
+        {
+            buffer[sv_dispatchThreadID.x] = VALUE;
+        })";
+
+    const char* cacheDirectory = "slang-unit-test-compile-cache";
+    Path::createDirectory(cacheDirectory);
+    _removeCacheEntries(cacheDirectory);
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef())));
+
+    // The first compilation stores the code
+    const String code = _compileWithCache(globalSession, cacheDirectory, source, "1");
+    SLANG_CHECK(code.getLength() != 0);
+    SLANG_CHECK(_countCacheEntries(cacheDirectory) == 1);
+
+    // Compiling identical code with identical options in a new session finds the entry.
+    // The stored code is marked first, so the code returned must be the stored code.
+    SLANG_CHECK(code.indexOf(toSlice("computeMain")) >= 0);
+    SLANG_CHECK_ABORT(_markCachedCode(cacheDirectory, "computeMain"));
+
+    const String cachedCode = _compileWithCache(globalSession, cacheDirectory, source, "1");
+    SLANG_CHECK(cachedCode.getLength() == code.getLength());
+    SLANG_CHECK(cachedCode != code && cachedCode.indexOf(toSlice("computeMaiX")) >= 0);
+    SLANG_CHECK(_countCacheEntries(cacheDirectory) == 1);
+
+    // A different definition must not use the cached code
+    const String otherCode = _compileWithCache(globalSession, cacheDirectory, source, "2");
+    SLANG_CHECK(otherCode.getLength() != 0 && otherCode != code);
+    SLANG_CHECK(_countCacheEntries(cacheDirectory) == 2);
+
+    _removeCacheEntries(cacheDirectory);
+    Path::remove(cacheDirectory);
+}
+
+// Test that options of a compile request that change the generated code are part of the cache key.
+SLANG_UNIT_TEST(compileCacheRequestOptions)
+{
+    const char* source = R"(
+        [shader("compute")]
+        [numthreads(4,1,1)]
+        void computeMain(
+            uint3 sv_dispatchThreadID : SV_DispatchThreadID,
+            uniform RWStructuredBuffer<int> buffer)
+        {
+            buffer[sv_dispatchThreadID.x] = VALUE;
+        })";
+
+    const char* cacheDirectory = "slang-unit-test-compile-cache-options";
+    Path::createDirectory(cacheDirectory);
+    _removeCacheEntries(cacheDirectory);
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef())));
+
+    const String code = _compileRequestWithCache(globalSession, cacheDirectory, source, nullptr);
+    SLANG_CHECK(code.getLength() != 0);
+    SLANG_CHECK(_countCacheEntries(cacheDirectory) == 1);
+
+    // The same request is a hit
+    SLANG_CHECK_ABORT(_markCachedCode(cacheDirectory, "computeMain"));
+    const String cachedCode = _compileRequestWithCache(globalSession, cacheDirectory, source, nullptr);
+    SLANG_CHECK(cachedCode.indexOf(toSlice("computeMaiX")) >= 0);
+    SLANG_CHECK(_countCacheEntries(cacheDirectory) == 1);
+
+    // Each of these options must miss, and so store a new entry
+    const char* const options[] = { "-default-image-format-unknown", "-disable-specialization", "-disable-dynamic-dispatch" };
+    Index expectedCount = 1;
+    for (auto option : options)
+    {
+        const String optionCode = _compileRequestWithCache(globalSession, cacheDirectory, source, option);
+        SLANG_CHECK(optionCode.getLength() != 0);
+        SLANG_CHECK(optionCode.indexOf(toSlice("computeMaiX")) < 0);
+        SLANG_CHECK(_countCacheEntries(cacheDirectory) == ++expectedCount);
+    }
+
+    _removeCacheEntries(cacheDirectory);
+    Path::remove(cacheDirectory);
+}
@@ -0,0 +1,64 @@
+// unit-test-compile-trace.cpp
+
+#include "../../slang.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "../../slang-com-ptr.h"
+#include "../../source/core/slang-string.h"
+
+using namespace Slang;
+
+// Test that a compile trace records the frontend and IR pass events of a compilation.
+SLANG_UNIT_TEST(compileTrace)
+{
+    const char* source = R"(
+        [shader("compute")]
+        [numthreads(4,1,1)]
+        void computeMain(
+            uint3 sv_dispatchThreadID : SV_DispatchThreadID,
+            uniform RWStructuredBuffer<int> buffer)
+        {
+            buffer[sv_dispatchThreadID.x] = 1;
+        })";
+
+    auto session = spCreateSession();
+    auto request = spCreateCompileRequest(session);
+
+    // Without a trace being enabled there is nothing to get
+    {
+        Slang::ComPtr<ISlangBlob> traceBlob;
+        SLANG_CHECK(SLANG_FAILED(spGetCompileTrace(request, traceBlob.writeRef())));
+    }
+
+    spSetCompileTraceEnabled(request, true);
+
+    spAddCodeGenTarget(request, SLANG_HLSL);
+    int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "traceUnit");
+    spAddTranslationUnitSourceString(request, translationUnitIndex, "traceFile", source);
+    spAddEntryPoint(request, translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    SLANG_CHECK(spCompile(request) == SLANG_OK);
+
+    Slang::ComPtr<ISlangBlob> traceBlob;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(spGetCompileTrace(request, traceBlob.writeRef())));
+
+    const UnownedStringSlice trace((const char*)traceBlob->getBufferPointer(), traceBlob->getBufferSize());
+
+    SLANG_CHECK(trace.startsWith(toSlice("{\"traceEvents\":[")));
+    SLANG_CHECK(trace.indexOf(toSlice("\"name\":\"parse\"")) >= 0);
+    SLANG_CHECK(trace.indexOf(toSlice("\"name\":\"lowerToIR\"")) >= 0);
+    SLANG_CHECK(trace.indexOf(toSlice("\"cat\":\"ir-pass\"")) >= 0);
+    SLANG_CHECK(trace.indexOf(toSlice("\"instCountBefore\":")) >= 0);
+    SLANG_CHECK(trace.indexOf(toSlice("\"instCountAfter\":")) >= 0);
+
+    // Target specific passes are traced too
+    SLANG_CHECK(trace.indexOf(toSlice("\"name\":\"collectEntryPointUniformParams\"")) >= 0);
+    SLANG_CHECK(trace.indexOf(toSlice("\"name\":\"wrapStructuredBuffersOfMatrices\"")) >= 0);
+    SLANG_CHECK(trace.indexOf(toSlice("\"name\":\"collectMetadata\"")) >= 0);
+
+    spDestroyCompileRequest(request);
+    spDestroySession(session);
+}
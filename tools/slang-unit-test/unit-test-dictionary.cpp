@@ -0,0 +1,359 @@
+// unit-test-dictionary.cpp
+
+#include "source/core/slang-basic.h"
+#include "source/core/slang-random-generator.h"
+#include "source/core/slang-platform.h"
+#include "tools/unit-test/slang-unit-test.h"
+
+#include <chrono>
+#include <stdio.h>
+
+using namespace Slang;
+
+namespace { // anonymous
+
+// The linear probing hash table that `Dictionary` used previously, with a separate bit set marking
+// empty/deleted slots. Only here so the benchmark can compare against it.
+template <typename TKey, typename TValue>
+class LinearProbeDictionary
+{
+public:
+    void add(const TKey& key, const TValue& value)
+    {
+        _rehashIfNeeded();
+        const FindResult result = _find(key);
+        SLANG_ASSERT(result.objectPos < 0 && result.insertPos >= 0);
+        m_slots[result.insertPos] = KeyValuePair<TKey, TValue>(key, value);
+        _setMarks(result.insertPos, true, false);
+        m_count++;
+    }
+    TValue* tryGetValue(const TKey& key) const
+    {
+        if (m_bucketSizeMinusOne < 0)
+        {
+            return nullptr;
+        }
+        const FindResult result = _find(key);
+        return result.objectPos >= 0 ? &m_slots[result.objectPos].Value : nullptr;
+    }
+    void remove(const TKey& key)
+    {
+        if (m_count == 0)
+        {
+            return;
+        }
+        const FindResult result = _find(key);
+        if (result.objectPos >= 0)
+        {
+            _setMarks(result.objectPos, true, true);
+            m_count--;
+        }
+    }
+    int getCount() const { return m_count; }
+
+    LinearProbeDictionary() {}
+    ~LinearProbeDictionary() { delete[] m_slots; }
+
+protected:
+    struct FindResult
+    {
+        int objectPos;
+        int insertPos;
+    };
+
+    bool _isEmpty(int pos) const { return !m_marks.contains(pos << 1); }
+    bool _isDeleted(int pos) const { return m_marks.contains((pos << 1) + 1); }
+    void _setMarks(int pos, bool isFull, bool isDeleted)
+    {
+        if (isFull) m_marks.add(pos << 1); else m_marks.remove(pos << 1);
+        if (isDeleted) m_marks.add((pos << 1) + 1); else m_marks.remove((pos << 1) + 1);
+    }
+
+    FindResult _find(const TKey& key) const
+    {
+        const unsigned int hash = (unsigned int)getHashCode(const_cast<TKey&>(key));
+        int hashPos = int((hash * 2654435761u) % (unsigned int)(m_bucketSizeMinusOne));
+        int insertPos = -1;
+        for (int numProbes = 0; numProbes <= m_bucketSizeMinusOne; ++numProbes)
+        {
+            if (_isEmpty(hashPos))
+            {
+                return FindResult{ -1, insertPos < 0 ? hashPos : insertPos };
+            }
+            else if (_isDeleted(hashPos))
+            {
+                insertPos = insertPos < 0 ? hashPos : insertPos;
+            }
+            else if (m_slots[hashPos].Key == key)
+            {
+                return FindResult{ hashPos, -1 };
+            }
+            hashPos = (hashPos + 1) & m_bucketSizeMinusOne;
+        }
+        return FindResult{ -1, insertPos };
+    }
+
+    void _rehashIfNeeded()
+    {
+        if (m_bucketSizeMinusOne >= 0 && m_count < int(MaxLoadFactor * m_bucketSizeMinusOne))
+        {
+            return;
+        }
+
+        const int newSize = m_bucketSizeMinusOne < 0 ? 16 : (m_bucketSizeMinusOne + 1) * 2;
+
+        KeyValuePair<TKey, TValue>* oldSlots = m_slots;
+        UIntSet oldMarks = _Move(m_marks);
+        const int oldSize = m_bucketSizeMinusOne + 1;
+
+        m_slots = new KeyValuePair<TKey, TValue>[newSize];
+        m_bucketSizeMinusOne = newSize - 1;
+        m_marks.resizeAndClear(newSize * 2);
+        m_count = 0;
+
+        for (int i = 0; i < oldSize; ++i)
+        {
+            if (oldMarks.contains(i << 1) && !oldMarks.contains((i << 1) + 1))
+            {
+                add(oldSlots[i].Key, oldSlots[i].Value);
+            }
+        }
+        delete[] oldSlots;
+    }
+
+    int m_bucketSizeMinusOne = -1;
+    int m_count = 0;
+    UIntSet m_marks;
+    KeyValuePair<TKey, TValue>* m_slots = nullptr;
+};
+
+// Adapts Dictionary to the same interface as LinearProbeDictionary
+template <typename TKey, typename TValue>
+class DictionaryAdapter
+{
+public:
+    void add(const TKey& key, const TValue& value) { m_dict.Add(key, value); }
+    TValue* tryGetValue(const TKey& key) const { return m_dict.TryGetValue(key); }
+    void remove(const TKey& key) { m_dict.Remove(key); }
+    Index getCount() const { return m_dict.Count(); }
+
+    Dictionary<TKey, TValue> m_dict;
+};
+
+struct BenchmarkResult
+{
+    double seconds;
+    int64_t checkSum;           ///< So the work can't be optimized away, and both tables can be checked to agree
+};
+
+// Adds all of the keys, looks each up (and a key that isn't present), and then removes half of them and looks them all up again
+template <typename DICT, typename TKey>
+BenchmarkResult _runBenchmark(const List<TKey>& keys, const List<TKey>& missingKeys, Index repeatCount)
+{
+    typedef std::chrono::steady_clock Clock;
+    const auto startTime = Clock::now();
+
+    int64_t checkSum = 0;
+    for (Index repeat = 0; repeat < repeatCount; ++repeat)
+    {
+        DICT dict;
+        for (Index i = 0; i < keys.getCount(); ++i)
+        {
+            dict.add(keys[i], int(i));
+        }
+        for (Index i = 0; i < keys.getCount(); ++i)
+        {
+            if (int* value = dict.tryGetValue(keys[i]))
+            {
+                checkSum += *value;
+            }
+            checkSum += dict.tryGetValue(missingKeys[i]) ? 1 : 0;
+        }
+        for (Index i = 0; i < keys.getCount(); i += 2)
+        {
+            dict.remove(keys[i]);
+        }
+        for (Index i = 0; i < keys.getCount(); ++i)
+        {
+            checkSum += dict.tryGetValue(keys[i]) ? 1 : 0;
+        }
+        checkSum += dict.getCount();
+    }
+
+    BenchmarkResult result;
+    result.seconds = std::chrono::duration<double>(Clock::now() - startTime).count();
+    result.checkSum = checkSum;
+    return result;
+}
+
+template <typename TKey>
+void _compare(const char* name, const List<TKey>& keys, const List<TKey>& missingKeys, Index repeatCount)
+{
+    const BenchmarkResult linearProbe = _runBenchmark<LinearProbeDictionary<TKey, int>>(keys, missingKeys, repeatCount);
+    const BenchmarkResult dictionary = _runBenchmark<DictionaryAdapter<TKey, int>>(keys, missingKeys, repeatCount);
+
+    // Both must have done the same thing
+    SLANG_CHECK(linearProbe.checkSum == dictionary.checkSum);
+
+    char buf[256];
+    sprintf(buf, "dictionary benchmark %s (%d keys): linear probe %.2fms, Dictionary %.2fms\n",
+        name, int(keys.getCount()), linearProbe.seconds * 1000.0, dictionary.seconds * 1000.0);
+    getTestReporter()->message(TestMessageType::Info, buf);
+}
+
+} // anonymous
+
+SLANG_UNIT_TEST(dictionary)
+{
+    // Check against a simple (slow) reference, with a mix of adds, sets, removes and lookups
+    {
+        RefPtr<RandomGenerator> rand = RandomGenerator::create(0x1234);
+
+        Dictionary<int, int> dict;
+        List<int> reference;
+        const int keyRange = 600;
+        reference.setCount(keyRange);
+        for (auto& value : reference)
+        {
+            value = -1;
+        }
+        Index referenceCount = 0;
+
+        for (int i = 0; i < 20000; ++i)
+        {
+            const int key = rand->nextInt32InRange(0, keyRange);
+            switch (rand->nextInt32InRange(0, 4))
+            {
+                case 0:
+                {
+                    dict.Remove(key);
+                    referenceCount -= Index(reference[key] >= 0);
+                    reference[key] = -1;
+                    break;
+                }
+                case 1:
+                {
+                    const bool added = dict.AddIfNotExists(key, i);
+                    SLANG_CHECK(added == (reference[key] < 0));
+                    if (added)
+                    {
+                        referenceCount++;
+                        reference[key] = i;
+                    }
+                    break;
+                }
+                case 2:
+                {
+                    referenceCount += Index(reference[key] < 0);
+                    dict[key] = i;
+                    reference[key] = i;
+                    break;
+                }
+                default:
+                {
+                    int* value = dict.TryGetValue(key);
+                    SLANG_CHECK((value != nullptr) == (reference[key] >= 0));
+                    SLANG_CHECK(value == nullptr || *value == reference[key]);
+                    break;
+                }
+            }
+        }
+        SLANG_CHECK(dict.Count() == referenceCount);
+
+        Index iteratedCount = 0;
+        for (const auto& pair : dict)
+        {
+            SLANG_CHECK(reference[pair.Key] == pair.Value);
+            iteratedCount++;
+        }
+        SLANG_CHECK(iteratedCount == referenceCount);
+
+        // Copies should hold the same
+        Dictionary<int, int> copy(dict);
+        SLANG_CHECK(copy.Count() == referenceCount);
+        for (const auto& pair : dict)
+        {
+            SLANG_CHECK(copy[pair.Key].GetValue() == pair.Value);
+        }
+
+        dict.Clear();
+        SLANG_CHECK(dict.Count() == 0 && dict.begin() == dict.end());
+        SLANG_CHECK(copy.Count() == referenceCount);
+    }
+
+    // Keys that need destruction, removal whilst iterating
+    {
+        Dictionary<String, String> dict;
+        for (int i = 0; i < 1000; ++i)
+        {
+            dict.Add(String(i), String(i * 2));
+        }
+        for (const auto& pair : dict)
+        {
+            if (StringToInt(pair.Key) & 1)
+            {
+                dict.Remove(pair.Key);
+            }
+        }
+        SLANG_CHECK(dict.Count() == 500);
+        SLANG_CHECK(dict.ContainsKey(String(10)) && !dict.ContainsKey(String(11)));
+        SLANG_CHECK(dict[String(10)].GetValue() == "20");
+    }
+}
+
+// The benchmark takes a while, and its timings are only of interest when working on Dictionary, so it
+// is only run if the SLANG_RUN_BENCHMARKS environment variable is set, for example with
+//
+// SLANG_RUN_BENCHMARKS=1 slang-test slang-unit-test-tool/dictionaryBenchmark.internal
+SLANG_UNIT_TEST(dictionaryBenchmark)
+{
+    {
+        StringBuilder runBenchmarks;
+        if (SLANG_FAILED(PlatformUtil::getEnvironmentVariable(UnownedStringSlice("SLANG_RUN_BENCHMARKS"), runBenchmarks)) ||
+            runBenchmarks.getLength() == 0)
+        {
+            SLANG_IGNORE_TEST
+        }
+    }
+
+    RefPtr<RandomGenerator> rand = RandomGenerator::create(0x5678);
+
+    const Index keyCount = 20000;
+    const Index repeatCount = 4;
+
+    // Integers
+    {
+        List<int> keys, missingKeys;
+        for (Index i = 0; i < keyCount; ++i)
+        {
+            keys.add(int(i * 2));
+            missingKeys.add(int(i * 2 + 1));
+        }
+        _compare("int", keys, missingKeys, repeatCount);
+    }
+
+    // Pointers (as are used for most of the compiler's maps)
+    {
+        List<int> storage;
+        storage.setCount(keyCount * 2);
+
+        List<int*> keys, missingKeys;
+        for (Index i = 0; i < keyCount; ++i)
+        {
+            keys.add(&storage[i * 2]);
+            missingKeys.add(&storage[i * 2 + 1]);
+        }
+        _compare("pointer", keys, missingKeys, repeatCount);
+    }
+
+    // Strings
+    {
+        List<String> keys, missingKeys;
+        for (Index i = 0; i < keyCount; ++i)
+        {
+            keys.add(String("key") + String(rand->nextInt32()) + String(i));
+            missingKeys.add(String("missing") + String(i));
+        }
+        _compare("String", keys, missingKeys, repeatCount);
+    }
+}
@@ -0,0 +1,134 @@
+// unit-test-host-callable-batch.cpp
+
+#include "../../slang.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "../../slang-com-ptr.h"
+#include "../../source/core/slang-blob.h"
+
+using namespace Slang;
+
+static bool _hasHostCallableCompiler(slang::IGlobalSession* globalSession)
+{
+    const SlangPassThrough compilers[] =
+    {
+        SLANG_PASS_THROUGH_LLVM,
+        SLANG_PASS_THROUGH_VISUAL_STUDIO,
+        SLANG_PASS_THROUGH_GCC,
+        SLANG_PASS_THROUGH_CLANG,
+    };
+    for (auto compiler : compilers)
+    {
+        if (SLANG_SUCCEEDED(globalSession->checkPassThroughSupport(compiler)))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static SlangResult _createProgram(slang::ISession* session, slang::IModule* module, const char* const* entryPointNames, Index entryPointCount, ComPtr<slang::IComponentType>& outProgram)
+{
+    List<ComPtr<slang::IEntryPoint>> entryPoints;
+    List<slang::IComponentType*> components;
+    components.add(module);
+    for (Index i = 0; i < entryPointCount; ++i)
+    {
+        ComPtr<slang::IEntryPoint> entryPoint;
+        SLANG_RETURN_ON_FAIL(module->findEntryPointByName(entryPointNames[i], entryPoint.writeRef()));
+        components.add(entryPoint);
+        entryPoints.add(entryPoint);
+    }
+    return session->createCompositeComponentType(components.getBuffer(), components.getCount(), outProgram.writeRef());
+}
+
+// Test compiling all of the entry points of a program into a single shared library, and compiling
+// several programs concurrently.
+SLANG_UNIT_TEST(hostCallableBatch)
+{
+#if SLANG_PTR_IS_32 && !SLANG_MICROSOFT_FAMILY
+    // See comHostCallable - 32 bit binaries can't generally be built on these targets
+    return;
+#endif
+
+    const char* source = R"(
+        [shader("compute")]
+        [numthreads(4,1,1)]
+        void computeA(
+            uint3 sv_dispatchThreadID : SV_DispatchThreadID,
+            uniform RWStructuredBuffer<int> buffer)
+        {
+            buffer[sv_dispatchThreadID.x] = 1;
+        }
+
+        [shader("compute")]
+        [numthreads(4,1,1)]
+        void computeB(
+            uint3 sv_dispatchThreadID : SV_DispatchThreadID,
+            uniform RWStructuredBuffer<int> buffer)
+        {
+            buffer[sv_dispatchThreadID.x] = 2;
+        })";
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef())));
+
+    if (!_hasHostCallableCompiler(globalSession))
+    {
+        return;
+    }
+
+    slang::TargetDesc targetDesc;
+    targetDesc.format = SLANG_SHADER_HOST_CALLABLE;
+
+    slang::SessionDesc sessionDesc;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.targetCount = 1;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(globalSession->createSession(sessionDesc, session.writeRef())));
+
+    ComPtr<ISlangBlob> sourceBlob = StringBlob::create(String(source));
+    slang::IModule* module = session->loadModuleFromSource("hostCallableBatchTest", "host-callable-batch-test.slang", sourceBlob);
+    SLANG_CHECK_ABORT(module);
+
+    const char* entryPointNames[] = { "computeA", "computeB" };
+
+    // Both entry points in one shared library
+    {
+        ComPtr<slang::IComponentType> program;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_createProgram(session, module, entryPointNames, 2, program)));
+
+        ComPtr<ISlangSharedLibrary> sharedLibrary;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(program->getTargetHostCallable(0, sharedLibrary.writeRef())));
+
+        SLANG_CHECK(sharedLibrary->findSymbolAddressByName("computeA") != nullptr);
+        SLANG_CHECK(sharedLibrary->findSymbolAddressByName("computeB") != nullptr);
+    }
+
+    // A batch of programs compiled concurrently, with a program appearing twice
+    {
+        ComPtr<slang::IComponentType> programA;
+        ComPtr<slang::IComponentType> programB;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_createProgram(session, module, entryPointNames + 0, 1, programA)));
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_createProgram(session, module, entryPointNames + 1, 1, programB)));
+
+        slang::IComponentType* programs[] = { programA, programB, programA };
+        ISlangSharedLibrary* libraries[3] = {};
+        const SlangResult res = session->getTargetHostCallables(programs, 3, 0, 2, libraries);
+
+        ComPtr<ISlangSharedLibrary> sharedLibraries[3];
+        for (Index i = 0; i < 3; ++i)
+        {
+            sharedLibraries[i].attach(libraries[i]);
+        }
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(res));
+
+        SLANG_CHECK(sharedLibraries[0]->findSymbolAddressByName("computeA") != nullptr);
+        SLANG_CHECK(sharedLibraries[1]->findSymbolAddressByName("computeB") != nullptr);
+        SLANG_CHECK(sharedLibraries[2]->findSymbolAddressByName("computeA") != nullptr);
+    }
+}
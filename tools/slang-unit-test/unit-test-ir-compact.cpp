@@ -0,0 +1,127 @@
+// unit-test-ir-compact.cpp
+
+#include "../../slang.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "../../slang-com-ptr.h"
+#include "../../source/core/slang-string.h"
+#include "../../source/core/slang-string-util.h"
+
+using namespace Slang;
+
+    /// Compile `source` to HLSL with the `extraArgs`, producing the code and the compile trace.
+static SlangResult _compile(slang::IGlobalSession* globalSession, const char* source, const char* const* extraArgs, Index extraArgCount, String& outCode, String& outTrace)
+{
+    ComPtr<slang::ICompileRequest> request;
+    SLANG_RETURN_ON_FAIL(globalSession->createCompileRequest(request.writeRef()));
+
+    List<const char*> args;
+    args.addRange({ "-target", "hlsl" });
+    args.addRange(extraArgs, extraArgCount);
+    SLANG_RETURN_ON_FAIL(request->processCommandLineArguments(args.getBuffer(), int(args.getCount())));
+
+    spSetCompileTraceEnabled(request, true);
+
+    const int translationUnitIndex = request->addTranslationUnit(SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    request->addTranslationUnitSourceString(translationUnitIndex, "ir-compact.slang", source);
+    request->addEntryPoint(translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    SLANG_RETURN_ON_FAIL(request->compile());
+
+    // The result isn't checked, as getEntryPointCodeBlob doesn't return SLANG_OK on success
+    ComPtr<ISlangBlob> code;
+    request->getEntryPointCodeBlob(0, 0, code.writeRef());
+    if (!code)
+    {
+        return SLANG_FAIL;
+    }
+    outCode = String(UnownedStringSlice((const char*)code->getBufferPointer(), code->getBufferSize()));
+
+    ComPtr<ISlangBlob> trace;
+    SLANG_RETURN_ON_FAIL(spGetCompileTrace(request, trace.writeRef()));
+    outTrace = String(UnownedStringSlice((const char*)trace->getBufferPointer(), trace->getBufferSize()));
+    return SLANG_OK;
+}
+
+    /// Get the total of all of the values of the integer arg `name` in `trace`
+static Int _sumTraceArg(const UnownedStringSlice& trace, const UnownedStringSlice& name)
+{
+    StringBuilder pattern;
+    pattern << "\"" << name << "\":";
+
+    Int total = 0;
+    for (Index index = trace.indexOf(pattern.getUnownedSlice()); index >= 0; )
+    {
+        Index pos = index + pattern.getLength();
+        total += StringUtil::parseIntAndAdvancePos(trace, pos);
+
+        const Index next = trace.tail(pos).indexOf(pattern.getUnownedSlice());
+        index = next >= 0 ? pos + next : -1;
+    }
+    return total;
+}
+
+// Test that compacting the IR and reusing the memory of removed instructions doesn't change the code produced.
+// Specializing the generics removes the unspecialized code, so there is memory to reuse.
+SLANG_UNIT_TEST(irCompact)
+{
+    const char* source = R"(
+        interface IOp
+        {
+            int apply(int value);
+        }
+
+        struct AddOp : IOp
+        {
+            int amount;
+            int apply(int value) { return value + amount; }
+        }
+
+        struct MulOp : IOp
+        {
+            int scale;
+            float unused;
+            int apply(int value) { return value * scale; }
+        }
+
+        int applyAll<T : IOp>(T op, int value, int count)
+        {
+            int result = value;
+            for (int i = 0; i < count; ++i)
+            {
+                result = op.apply(result);
+            }
+            return result;
+        }
+
+        RWStructuredBuffer<int> buffer;
+
+        [numthreads(4, 1, 1)]
+        void computeMain(uint3 tid : SV_DispatchThreadID)
+        {
+            AddOp add = { 3 };
+            MulOp mul = { 2, 0.0f };
+            buffer[tid.x] = applyAll(add, int(tid.x), 2) + applyAll(mul, int(tid.x), 3);
+        }
+        )";
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef())));
+
+    String code, trace;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compile(globalSession, source, nullptr, 0, code, trace)));
+
+    // Compact at every opportunity
+    const char* const compactArgs[] = { "-compact-ir" };
+    String compactCode, compactTrace;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compile(globalSession, source, compactArgs, SLANG_COUNT_OF(compactArgs), compactCode, compactTrace)));
+
+    SLANG_CHECK(compactCode == code);
+
+    // The module was compacted, and (without compacting) the memory of removed instructions was reused by passes
+    SLANG_CHECK(compactTrace.getUnownedSlice().indexOf(toSlice("\"name\":\"compact\"")) >= 0);
+    SLANG_CHECK(_sumTraceArg(trace.getUnownedSlice(), toSlice("reusedInstCount")) > 0);
+}
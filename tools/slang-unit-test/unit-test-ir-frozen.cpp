@@ -0,0 +1,164 @@
+// unit-test-ir-frozen.cpp
+
+#include "../../slang.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "../../slang-com-ptr.h"
+#include "../../source/core/slang-string.h"
+#include "../../source/core/slang-riff.h"
+#include "../../source/core/slang-archive-file-system.h"
+
+using namespace Slang;
+
+static const char kFrozenTestSource[] = R"(
+    RWStructuredBuffer<float> buffer;
+
+    [numthreads(4, 1, 1)]
+    void computeMain(uint3 tid : SV_DispatchThreadID)
+    {
+        float value = buffer[tid.x];
+        float3 v = normalize(float3(value, sin(value), 1.0f));
+        buffer[tid.x] = max(dot(v, v), clamp(value, 0.0f, 1.0f)) + asfloat(countbits(tid.x));
+    }
+    )";
+
+    /// Compile kFrozenTestSource to HLSL with `globalSession`
+static SlangResult _compile(slang::IGlobalSession* globalSession, String& outCode)
+{
+    ComPtr<slang::ICompileRequest> request;
+    SLANG_RETURN_ON_FAIL(globalSession->createCompileRequest(request.writeRef()));
+
+    const char* args[] = { "-target", "hlsl" };
+    SLANG_RETURN_ON_FAIL(request->processCommandLineArguments(args, int(SLANG_COUNT_OF(args))));
+
+    const int translationUnitIndex = request->addTranslationUnit(SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    request->addTranslationUnitSourceString(translationUnitIndex, "ir-frozen.slang", kFrozenTestSource);
+    request->addEntryPoint(translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    SLANG_RETURN_ON_FAIL(request->compile());
+
+    // The result isn't checked, as getEntryPointCodeBlob doesn't return SLANG_OK on success
+    ComPtr<ISlangBlob> code;
+    request->getEntryPointCodeBlob(0, 0, code.writeRef());
+    if (!code)
+    {
+        return SLANG_FAIL;
+    }
+    outCode = String(UnownedStringSlice((const char*)code->getBufferPointer(), code->getBufferSize()));
+    return SLANG_OK;
+}
+
+    /// Create a global session with the serialized stdlib in `stdLib`, which is loaded frozen
+static SlangResult _createSession(ISlangBlob* stdLib, ComPtr<slang::IGlobalSession>& outSession)
+{
+    SLANG_RETURN_ON_FAIL(slang_createGlobalSessionWithoutStdLib(SLANG_API_VERSION, outSession.writeRef()));
+    return outSession->loadStdLib(stdLib->getBufferPointer(), stdLib->getBufferSize());
+}
+
+    /// The RIFF list type that holds a serialized IR module (IRSerialBinary::kIRModuleFourCc)
+static const FourCC kIRModuleFourCc = SLANG_FOUR_CC('S', 'i', 'm', 'd');
+
+static SlangResult _addIRModuleHash(RiffContainer::Chunk* chunk, void* data)
+{
+    auto dataChunk = as<RiffContainer::DataChunk>(chunk);
+    if (!dataChunk)
+    {
+        return SLANG_OK;
+    }
+    for (auto parent = chunk->m_parent; parent; parent = parent->m_parent)
+    {
+        if (parent->getSubType() == kIRModuleFourCc)
+        {
+            ((List<RiffHashCode>*)data)->add(dataChunk->calcHash());
+            break;
+        }
+    }
+    return SLANG_OK;
+}
+
+static void _addPath(SlangPathType pathType, const char* name, void* userData)
+{
+    if (pathType == SLANG_PATH_TYPE_FILE)
+    {
+        ((List<String>*)userData)->add(name);
+    }
+}
+
+    /// Get the hash of each chunk of the IR modules in the serialized `stdLib`, in order.
+    /// Only the IR is compared, as type checking adds to the stdlib AST, so that is written out differently.
+static SlangResult _getIRModuleHashes(ISlangBlob* stdLib, List<RiffHashCode>& outHashes)
+{
+    ComPtr<ISlangFileSystemExt> fileSystem;
+    SLANG_RETURN_ON_FAIL(loadArchiveFileSystem(stdLib->getBufferPointer(), stdLib->getBufferSize(), fileSystem));
+
+    // The order the files are enumerated in is unspecified
+    List<String> paths;
+    SLANG_RETURN_ON_FAIL(fileSystem->enumeratePathContents(".", &_addPath, &paths));
+    paths.sort();
+
+    for (const auto& path : paths)
+    {
+        ComPtr<ISlangBlob> contents;
+        SLANG_RETURN_ON_FAIL(fileSystem->loadFile(path.getBuffer(), contents.writeRef()));
+
+        RiffContainer container;
+        SLANG_RETURN_ON_FAIL(RiffUtil::readInPlace(contents->getBufferPointer(), contents->getBufferSize(), container));
+        SLANG_RETURN_ON_FAIL(container.getRoot()->visitPreOrder(&_addIRModuleHash, &outHashes));
+    }
+    return SLANG_OK;
+}
+
+// Test that serialized IR modules that are loaded in the frozen form can be linked from (thawing parts of them),
+// and written out again (thawing all of them), and that what is written out doesn't depend on what was thawed first.
+SLANG_UNIT_TEST(irFrozenModule)
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef())));
+
+    String code;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compile(globalSession, code)));
+
+    // RIFF, as unlike zip it doesn't hold anything that varies between writes
+    ComPtr<ISlangBlob> stdLib;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(globalSession->saveStdLib(SLANG_ARCHIVE_TYPE_RIFF, stdLib.writeRef())));
+
+    // Write out the frozen stdlib without thawing anything first
+    ComPtr<ISlangBlob> roundTripStdLib;
+    {
+        ComPtr<slang::IGlobalSession> session;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_createSession(stdLib, session)));
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(session->saveStdLib(SLANG_ARCHIVE_TYPE_RIFF, roundTripStdLib.writeRef())));
+    }
+
+    // Write it out after linking thawed some of it
+    ComPtr<ISlangBlob> linkedStdLib;
+    {
+        ComPtr<slang::IGlobalSession> session;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_createSession(stdLib, session)));
+
+        String frozenCode;
+        SLANG_CHECK(SLANG_SUCCEEDED(_compile(session, frozenCode)));
+        SLANG_CHECK(frozenCode == code);
+
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(session->saveStdLib(SLANG_ARCHIVE_TYPE_RIFF, linkedStdLib.writeRef())));
+    }
+
+    // The global values are written in the order they were read, whatever order they were thawed in
+    List<RiffHashCode> roundTripHashes, linkedHashes;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_getIRModuleHashes(roundTripStdLib, roundTripHashes)));
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_getIRModuleHashes(linkedStdLib, linkedHashes)));
+    SLANG_CHECK(roundTripHashes.getCount() > 0 && roundTripHashes == linkedHashes);
+
+    // The round tripped stdlib produces the same code
+    {
+        ComPtr<slang::IGlobalSession> session;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_createSession(roundTripStdLib, session)));
+
+        String roundTripCode;
+        SLANG_CHECK(SLANG_SUCCEEDED(_compile(session, roundTripCode)));
+        SLANG_CHECK(roundTripCode == code);
+    }
+}
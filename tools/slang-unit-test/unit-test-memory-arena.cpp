@@ -262,6 +262,29 @@ SLANG_UNIT_TEST(memoryArena)
             }
         }
     }
+    {
+        // Swapping moves all of the allocations
+        MemoryArena arena(1024);
+        MemoryArena otherArena(256);
+
+        uint8_t* mem = (uint8_t*)arena.allocate(100);
+        ::memset(mem, 0x5a, 100);
+        uint8_t* largeMem = (uint8_t*)arena.allocate(4000);
+        ::memset(largeMem, 0xa5, 4000);
+
+        arena.swapWith(otherArena);
+
+        SLANG_CHECK(arena.getBlockPayloadSize() == 256 && otherArena.getBlockPayloadSize() == 1024);
+        SLANG_CHECK(!arena.isValid(mem, 100) && otherArena.isValid(mem, 100));
+        SLANG_CHECK(otherArena.isValid(largeMem, 4000));
+        SLANG_CHECK(hasValue(mem, 100, 0x5a) && hasValue(largeMem, 4000, 0xa5));
+
+        // Both can still be used
+        SLANG_CHECK(arena.allocate(300) && otherArena.allocate(300));
+
+        otherArena.reset();
+        SLANG_CHECK(!otherArena.isValid(mem, 100));
+    }
     {
         // Do lots of allocations and test out rewind
         
@@ -0,0 +1,230 @@
+// unit-test-module-cache.cpp
+
+#include "../../slang.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "../../slang-com-ptr.h"
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-blob.h"
+
+using namespace Slang;
+
+namespace { // anonymous
+
+struct SerializedModuleCounter : public Path::Visitor
+{
+    void accept(Path::Type type, const UnownedStringSlice& filename) SLANG_OVERRIDE
+    {
+        if (type == Path::Type::File && filename.endsWith(toSlice(".slang-module")))
+        {
+            count++;
+        }
+    }
+    Index count = 0;
+};
+
+struct SerializedModuleFinder : public Path::Visitor
+{
+    void accept(Path::Type type, const UnownedStringSlice& filename) SLANG_OVERRIDE
+    {
+        if (type == Path::Type::File && filename.startsWith(prefix.getUnownedSlice()) && filename.endsWith(toSlice(".slang-module")))
+        {
+            paths.add(Path::combine(directory, filename));
+        }
+    }
+    String directory;
+    String prefix;
+    List<String> paths;
+};
+
+struct FileRemover : public Path::Visitor
+{
+    void accept(Path::Type type, const UnownedStringSlice& filename) SLANG_OVERRIDE
+    {
+        if (type == Path::Type::File)
+        {
+            File::remove(Path::combine(directory, filename));
+        }
+    }
+    String directory;
+};
+
+} // anonymous
+
+static Index _countSerializedModules(const String& directory)
+{
+    SerializedModuleCounter counter;
+    Path::find(directory, nullptr, &counter);
+    return counter.count;
+}
+
+    /// Read the contents of the only serialized module in `directory` whose name starts with `prefix`
+static SlangResult _readSerializedModule(const String& directory, const char* prefix, List<unsigned char>& outContents)
+{
+    SerializedModuleFinder finder;
+    finder.directory = directory;
+    finder.prefix = prefix;
+    Path::find(directory, nullptr, &finder);
+    if (finder.paths.getCount() != 1)
+    {
+        return SLANG_FAIL;
+    }
+    return File::readAllBytes(finder.paths[0], outContents);
+}
+
+static void _removeFiles(const String& directory)
+{
+    FileRemover remover;
+    remover.directory = directory;
+    Path::find(directory, nullptr, &remover);
+}
+
+    /// Compile a shader that imports the modules in `sourceDirectory`, returning the code produced.
+    /// `outDiagnostics` is set to the diagnostics produced loading the modules, which include the `#warning`s
+    /// of the modules that were compiled from source.
+static String _compileWithModuleCache(slang::IGlobalSession* globalSession, const char* sourceDirectory, const char* cacheDirectory, String& outDiagnostics)
+{
+    outDiagnostics = String();
+
+    const char* source = R"(
+        import module_cache_b;
+
+        [shader("compute")]
+        [numthreads(4,1,1)]
+        void computeMain(
+            uint3 sv_dispatchThreadID : SV_DispatchThreadID,
+            uniform RWStructuredBuffer<int> buffer)
+        {
+            buffer[sv_dispatchThreadID.x] = getB(int(sv_dispatchThreadID.x));
+        })";
+
+    slang::TargetDesc targetDesc;
+    targetDesc.format = SLANG_HLSL;
+
+    slang::SessionDesc sessionDesc;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.targetCount = 1;
+    sessionDesc.searchPaths = &sourceDirectory;
+    sessionDesc.searchPathCount = 1;
+    sessionDesc.moduleCacheDirectory = cacheDirectory;
+
+    ComPtr<slang::ISession> session;
+    if (SLANG_FAILED(globalSession->createSession(sessionDesc, session.writeRef())))
+    {
+        return String();
+    }
+
+    ComPtr<ISlangBlob> sourceBlob = StringBlob::create(String(source));
+    ComPtr<ISlangBlob> diagnostics;
+    slang::IModule* module = session->loadModuleFromSource("moduleCacheTest", "module-cache-test.slang", sourceBlob, diagnostics.writeRef());
+    if (diagnostics)
+    {
+        outDiagnostics = String(UnownedStringSlice((const char*)diagnostics->getBufferPointer(), diagnostics->getBufferSize()));
+    }
+    if (!module)
+    {
+        return String();
+    }
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    if (SLANG_FAILED(module->findEntryPointByName("computeMain", entryPoint.writeRef())))
+    {
+        return String();
+    }
+
+    slang::IComponentType* components[] = { module, entryPoint };
+    ComPtr<slang::IComponentType> program;
+    if (SLANG_FAILED(session->createCompositeComponentType(components, 2, program.writeRef())))
+    {
+        return String();
+    }
+
+    // Linking adds the imported modules, so the code includes their functions
+    ComPtr<slang::IComponentType> linkedProgram;
+    if (SLANG_FAILED(program->link(linkedProgram.writeRef())))
+    {
+        return String();
+    }
+
+    ComPtr<ISlangBlob> code;
+    if (SLANG_FAILED(linkedProgram->getEntryPointCode(0, 0, code.writeRef())))
+    {
+        return String();
+    }
+    return String(UnownedStringSlice((const char*)code->getBufferPointer(), code->getBufferSize()));
+}
+
+static bool _wasCompiledFromSource(const String& diagnostics, const char* moduleName)
+{
+    StringBuilder message;
+    message << "compiling " << moduleName;
+    return diagnostics.indexOf(message.getUnownedSlice()) >= 0;
+}
+
+// Test that imported modules are serialized into the module cache directory, used from it when their source
+// is unchanged, and not used when the source (or the source of a module they import) has changed.
+// Each module has a `#warning`, which is only diagnosed if the module is compiled from source.
+SLANG_UNIT_TEST(moduleCache)
+{
+    const char* sourceDirectory = "slang-unit-test-module-cache-source";
+    const char* cacheDirectory = "slang-unit-test-module-cache";
+    Path::createDirectory(sourceDirectory);
+    Path::createDirectory(cacheDirectory);
+    _removeFiles(sourceDirectory);
+    _removeFiles(cacheDirectory);
+
+    const String headerPath = Path::combine(sourceDirectory, "module-cache-a.h");
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::writeAllText(headerPath, "#define A_SCALE 3\n")));
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::writeAllText(Path::combine(sourceDirectory, "module-cache-a.slang"),
+        "#warning compiling module_cache_a\n"
+        "#include \"module-cache-a.h\"\n"
+        "struct Thing { int value; int scaled() { return value * A_SCALE; } };\n"
+        "int getA(int value) { Thing thing; thing.value = value; return thing.scaled(); }\n")));
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::writeAllText(Path::combine(sourceDirectory, "module-cache-b.slang"),
+        "#warning compiling module_cache_b\n"
+        "import module_cache_a;\n"
+        "int getB(int value) { return getA(value) + 1; }\n")));
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef())));
+
+    // The first compilation compiles the imported modules from source, and saves them
+    String diagnostics;
+    const String code = _compileWithModuleCache(globalSession, sourceDirectory, cacheDirectory, diagnostics);
+    SLANG_CHECK(code.getLength() != 0);
+    SLANG_CHECK(_wasCompiledFromSource(diagnostics, "module_cache_a") && _wasCompiledFromSource(diagnostics, "module_cache_b"));
+    SLANG_CHECK(_countSerializedModules(cacheDirectory) == 2);
+
+    List<unsigned char> savedA;
+    SLANG_CHECK(SLANG_SUCCEEDED(_readSerializedModule(cacheDirectory, "module-cache-a", savedA)));
+
+    // A new session uses the saved modules, which must produce the same code
+    const String cachedCode = _compileWithModuleCache(globalSession, sourceDirectory, cacheDirectory, diagnostics);
+    SLANG_CHECK(cachedCode == code);
+    SLANG_CHECK(!_wasCompiledFromSource(diagnostics, "module_cache_a") && !_wasCompiledFromSource(diagnostics, "module_cache_b"));
+
+    // Changing a file included by a module indirectly imported must not use the saved modules
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::writeAllText(headerPath, "#define A_SCALE 5\n")));
+    const String changedCode = _compileWithModuleCache(globalSession, sourceDirectory, cacheDirectory, diagnostics);
+    SLANG_CHECK(changedCode.getLength() != 0 && changedCode != code);
+    SLANG_CHECK(_wasCompiledFromSource(diagnostics, "module_cache_a") && _wasCompiledFromSource(diagnostics, "module_cache_b"));
+
+    // The modules saved again replace those saved before
+    SLANG_CHECK(_countSerializedModules(cacheDirectory) == 2);
+    List<unsigned char> changedSavedA;
+    SLANG_CHECK(SLANG_SUCCEEDED(_readSerializedModule(cacheDirectory, "module-cache-a", changedSavedA)));
+    SLANG_CHECK(changedSavedA != savedA);
+
+    // And are used for the changed source
+    const String changedCachedCode = _compileWithModuleCache(globalSession, sourceDirectory, cacheDirectory, diagnostics);
+    SLANG_CHECK(changedCachedCode == changedCode);
+    SLANG_CHECK(!_wasCompiledFromSource(diagnostics, "module_cache_a") && !_wasCompiledFromSource(diagnostics, "module_cache_b"));
+
+    _removeFiles(sourceDirectory);
+    _removeFiles(cacheDirectory);
+    Path::remove(sourceDirectory);
+    Path::remove(cacheDirectory);
+}
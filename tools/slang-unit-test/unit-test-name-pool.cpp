@@ -0,0 +1,81 @@
+// unit-test-name-pool.cpp
+
+#include "../../source/compiler-core/slang-name.h"
+
+#include "tools/unit-test/slang-unit-test.h"
+
+#include <thread>
+
+using namespace Slang;
+
+SLANG_UNIT_TEST(namePool)
+{
+    RootNamePool rootNamePool;
+    NamePool namePool;
+    namePool.setRootNamePool(&rootNamePool);
+
+    // Names are unique for their text, however the text is passed
+    {
+        Name* name = namePool.getName(UnownedStringSlice("hello"));
+        SLANG_CHECK(name && name->text == "hello");
+        SLANG_CHECK(namePool.getName(String("hello")) == name);
+        SLANG_CHECK(namePool.getName("hello") == name);
+        SLANG_CHECK(namePool.tryGetName(UnownedStringSlice("hello")) == name);
+
+        // A slice that isn't terminated at the end of the name
+        const char text[] = "hello world";
+        SLANG_CHECK(namePool.getName(UnownedStringSlice(text, 5)) == name);
+
+        SLANG_CHECK(namePool.tryGetName(UnownedStringSlice("world")) == nullptr);
+        SLANG_CHECK(namePool.getName("world") != name);
+        SLANG_CHECK(namePool.getName("") != nullptr);
+    }
+
+    // Enough names to make the tables grow
+    {
+        List<Name*> names;
+        for (Index i = 0; i < 10000; ++i)
+        {
+            names.add(namePool.getName(String("name") + String(i)));
+        }
+        for (Index i = 0; i < 10000; ++i)
+        {
+            SLANG_CHECK(namePool.tryGetName(String("name") + String(i)) == names[i]);
+        }
+        SLANG_CHECK(rootNamePool.getCount() == 10000 + 3);
+    }
+
+    // Threads sharing a root pool get the same names
+    {
+        RootNamePool sharedRootNamePool;
+
+        const Index kThreadCount = 4;
+        const Index kNameCount = 2000;
+
+        List<Name*> threadNames[kThreadCount];
+        List<std::thread> threads;
+        for (Index t = 0; t < kThreadCount; ++t)
+        {
+            List<Name*>* outNames = &threadNames[t];
+            threads.add(std::thread([&sharedRootNamePool, outNames]()
+            {
+                NamePool threadNamePool;
+                threadNamePool.setRootNamePool(&sharedRootNamePool);
+                for (Index i = 0; i < kNameCount; ++i)
+                {
+                    outNames->add(threadNamePool.getName(String("shared") + String(i)));
+                }
+            }));
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        SLANG_CHECK(sharedRootNamePool.getCount() == kNameCount);
+        for (Index t = 1; t < kThreadCount; ++t)
+        {
+            SLANG_CHECK(threadNames[t] == threadNames[0]);
+        }
+    }
+}
@@ -0,0 +1,110 @@
+// unit-test-parallel-codegen.cpp
+
+#include "../../slang.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "../../slang-com-ptr.h"
+#include "../../source/core/slang-string.h"
+#include "../../source/core/slang-list.h"
+
+using namespace Slang;
+
+static const char* const kEntryPointNames[] = { "computeA", "computeB", "computeC", "computeD", "computeE", "computeF" };
+static const char* const kTargetNames[] = { "hlsl", "glsl", "cpp" };
+
+    /// Compile all the entry points for all the targets, generating code on `threadCount` threads.
+    /// The code is output in `outCode`, in entry point order for each target in turn.
+static SlangResult _compileEntryPoints(slang::IGlobalSession* globalSession, const char* threadCount, List<String>& outCode)
+{
+    const char* source = R"(
+        RWStructuredBuffer<int> buffer;
+
+        int calc(int value, int scale)
+        {
+            int result = value;
+            for (int i = 0; i < scale; ++i)
+            {
+                result = result * 3 + i;
+            }
+            return result;
+        }
+
+        [numthreads(4,1,1)] void computeA(uint3 tid : SV_DispatchThreadID) { buffer[tid.x] = calc(int(tid.x), 1); }
+        [numthreads(4,1,1)] void computeB(uint3 tid : SV_DispatchThreadID) { buffer[tid.x] = calc(int(tid.x), 2) + 1; }
+        [numthreads(8,1,1)] void computeC(uint3 tid : SV_DispatchThreadID) { buffer[tid.x] = calc(int(tid.y), 3) * 2; }
+        [numthreads(8,1,1)] void computeD(uint3 tid : SV_DispatchThreadID) { buffer[tid.x] = int(tid.x) - calc(4, 4); }
+        [numthreads(2,2,1)] void computeE(uint3 tid : SV_DispatchThreadID) { buffer[tid.x + tid.y] = calc(int(tid.y), 5); }
+        [numthreads(1,1,1)] void computeF(uint3 tid : SV_DispatchThreadID) { buffer[0] = 7; }
+        )";
+
+    ComPtr<slang::ICompileRequest> request;
+    SLANG_RETURN_ON_FAIL(globalSession->createCompileRequest(request.writeRef()));
+
+    List<const char*> args;
+    for (auto targetName : kTargetNames)
+    {
+        args.add("-target");
+        args.add(targetName);
+    }
+    args.addRange({ "-codegen-threads", threadCount });
+    SLANG_RETURN_ON_FAIL(request->processCommandLineArguments(args.getBuffer(), int(args.getCount())));
+
+    const int translationUnitIndex = request->addTranslationUnit(SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    request->addTranslationUnitSourceString(translationUnitIndex, "parallel-codegen.slang", source);
+    for (auto entryPointName : kEntryPointNames)
+    {
+        request->addEntryPoint(translationUnitIndex, entryPointName, SLANG_STAGE_COMPUTE);
+    }
+
+    SLANG_RETURN_ON_FAIL(request->compile());
+
+    for (Index targetIndex = 0; targetIndex < SLANG_COUNT_OF(kTargetNames); ++targetIndex)
+    {
+        for (Index entryPointIndex = 0; entryPointIndex < SLANG_COUNT_OF(kEntryPointNames); ++entryPointIndex)
+        {
+            // The result isn't checked, as getEntryPointCodeBlob doesn't return SLANG_OK on success
+            ComPtr<ISlangBlob> code;
+            request->getEntryPointCodeBlob(int(entryPointIndex), int(targetIndex), code.writeRef());
+            if (!code)
+            {
+                return SLANG_FAIL;
+            }
+            outCode.add(String(UnownedStringSlice((const char*)code->getBufferPointer(), code->getBufferSize())));
+        }
+    }
+    return SLANG_OK;
+}
+
+// Test that generating code on multiple threads produces the same code as doing so on one thread
+SLANG_UNIT_TEST(parallelCodeGen)
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef())));
+
+    List<String> serialCode;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compileEntryPoints(globalSession, "1", serialCode)));
+    SLANG_CHECK_ABORT(serialCode.getCount() == SLANG_COUNT_OF(kTargetNames) * SLANG_COUNT_OF(kEntryPointNames));
+
+    // Each entry point of a target has different code
+    const Index entryPointCount = SLANG_COUNT_OF(kEntryPointNames);
+    for (Index i = 0; i < serialCode.getCount(); ++i)
+    {
+        SLANG_CHECK(serialCode[i].getLength() != 0);
+        for (Index j = i + 1; j < serialCode.getCount() && j / entryPointCount == i / entryPointCount; ++j)
+        {
+            SLANG_CHECK(serialCode[i] != serialCode[j]);
+        }
+    }
+
+    // Compile several times, as any problem is likely to depend on timing. "0" uses all hardware threads.
+    const char* const threadCounts[] = { "2", "4", "0", "4" };
+    for (auto threadCount : threadCounts)
+    {
+        List<String> parallelCode;
+        SLANG_CHECK(SLANG_SUCCEEDED(_compileEntryPoints(globalSession, threadCount, parallelCode)));
+        SLANG_CHECK(parallelCode == serialCode);
+    }
+}
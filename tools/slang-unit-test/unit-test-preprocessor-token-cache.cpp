@@ -0,0 +1,148 @@
+// unit-test-preprocessor-token-cache.cpp
+
+#include "../../slang.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "../../slang-com-ptr.h"
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-string.h"
+#include "../../source/core/slang-string-util.h"
+
+using namespace Slang;
+
+    /// Get the total of all of the values of the integer arg `name` in `trace`
+static Int _sumTraceArg(const UnownedStringSlice& trace, const UnownedStringSlice& name)
+{
+    StringBuilder pattern;
+    pattern << "\"" << name << "\":";
+
+    Int total = 0;
+    for (Index index = trace.indexOf(pattern.getUnownedSlice()); index >= 0; )
+    {
+        Index pos = index + pattern.getLength();
+        total += StringUtil::parseIntAndAdvancePos(trace, pos);
+
+        const Index next = trace.tail(pos).indexOf(pattern.getUnownedSlice());
+        index = next >= 0 ? pos + next : -1;
+    }
+    return total;
+}
+
+    /// Compile `source` with a new compile request on `session`, producing the code, and how many files the
+    /// preprocessor found in the token cache and how many includes it skipped because of include guards.
+static SlangResult _compile(slang::ISession* session, const char* source, String& outCode, Int& outTokenCacheHits, Int& outIncludeGuardSkips)
+{
+    ComPtr<slang::ICompileRequest> request;
+    SLANG_RETURN_ON_FAIL(session->createCompileRequest(request.writeRef()));
+
+    // The trace is held by the session's linkage, so start a new one for this request
+    spSetCompileTraceEnabled(request, false);
+    spSetCompileTraceEnabled(request, true);
+
+    const int translationUnitIndex = request->addTranslationUnit(SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    request->addTranslationUnitSourceString(translationUnitIndex, "preprocessor-token-cache.slang", source);
+    request->addEntryPoint(translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    SLANG_RETURN_ON_FAIL(request->compile());
+
+    // The result isn't checked, as getEntryPointCodeBlob doesn't return SLANG_OK on success
+    ComPtr<ISlangBlob> code;
+    request->getEntryPointCodeBlob(0, 0, code.writeRef());
+    if (!code)
+    {
+        return SLANG_FAIL;
+    }
+    outCode = String(UnownedStringSlice((const char*)code->getBufferPointer(), code->getBufferSize()));
+
+    ComPtr<ISlangBlob> trace;
+    SLANG_RETURN_ON_FAIL(spGetCompileTrace(request, trace.writeRef()));
+    outTokenCacheHits = _sumTraceArg(StringUtil::getSlice(trace), toSlice("tokenCacheHits"));
+    outIncludeGuardSkips = _sumTraceArg(StringUtil::getSlice(trace), toSlice("includeGuardSkips"));
+
+    spSetCompileTraceEnabled(request, false);
+    return SLANG_OK;
+}
+
+// Test that a file wholly within an include guard is skipped when it is included again, that a file with an `#else`
+// on the guard isn't, and that the tokens lexed from files are reused by later compile requests on the same session.
+SLANG_UNIT_TEST(preprocessorTokenCache)
+{
+    const char* sourceDirectory = "slang-unit-test-preprocessor-token-cache";
+    Path::createDirectory(sourceDirectory);
+
+    const String guardedPath = Path::combine(sourceDirectory, "guarded.h");
+    const String notGuardedPath = Path::combine(sourceDirectory, "not-guarded.h");
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::writeAllText(guardedPath,
+        "// guarded.h\n"
+        "#ifndef GUARDED_H\n"
+        "#define GUARDED_H\n"
+        "int guarded(int value) { return value + 1; }\n"
+        "#endif\n")));
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::writeAllText(notGuardedPath,
+        "#ifndef NOT_GUARDED_H\n"
+        "#define NOT_GUARDED_H\n"
+        "#define NOT_GUARDED_COUNT 1\n"
+        "#else\n"
+        "#undef NOT_GUARDED_COUNT\n"
+        "#define NOT_GUARDED_COUNT 2\n"
+        "#endif\n")));
+
+    const char* source = R"(
+        #include "guarded.h"
+        #include "not-guarded.h"
+        #include "guarded.h"
+        #include "not-guarded.h"
+
+        #if NOT_GUARDED_COUNT != 2
+        #error not-guarded.h must be included twice
+        #endif
+
+        RWStructuredBuffer<int> buffer;
+
+        [numthreads(4, 1, 1)]
+        void computeMain(uint3 tid : SV_DispatchThreadID)
+        {
+            buffer[tid.x] = guarded(int(tid.x)) * NOT_GUARDED_COUNT;
+        }
+        )";
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef())));
+
+    slang::TargetDesc targetDesc;
+    targetDesc.format = SLANG_HLSL;
+
+    slang::SessionDesc sessionDesc;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.targetCount = 1;
+    sessionDesc.searchPaths = &sourceDirectory;
+    sessionDesc.searchPathCount = 1;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(globalSession->createSession(sessionDesc, session.writeRef())));
+
+    // The second include of the guarded file is skipped, but not the second include of the other one
+    // (or compiling fails with the `#error`)
+    String code;
+    Int tokenCacheHits = 0, includeGuardSkips = 0;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compile(session, source, code, tokenCacheHits, includeGuardSkips)));
+    SLANG_CHECK(includeGuardSkips == 1);
+
+    // Within the first request only the files included again were found in the cache
+    SLANG_CHECK(tokenCacheHits == 2);
+
+    // A later request on the same session lexes nothing, finding every file (including the source itself) in the cache
+    String secondCode;
+    Int secondTokenCacheHits = 0, secondIncludeGuardSkips = 0;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compile(session, source, secondCode, secondTokenCacheHits, secondIncludeGuardSkips)));
+    SLANG_CHECK(secondCode == code);
+    SLANG_CHECK(secondIncludeGuardSkips == 1);
+    SLANG_CHECK(secondTokenCacheHits == tokenCacheHits + 3);
+
+    File::remove(guardedPath);
+    File::remove(notGuardedPath);
+    Path::remove(sourceDirectory);
+}
@@ -0,0 +1,120 @@
+// unit-test-shared-type-checking-cache.cpp
+
+#include "../../slang.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "../../slang-com-ptr.h"
+#include "../../source/core/slang-string.h"
+#include "../../source/core/slang-string-util.h"
+
+using namespace Slang;
+
+    /// Get the total of all of the values of the integer arg `name` in `trace`
+static Int _sumTraceArg(const UnownedStringSlice& trace, const UnownedStringSlice& name)
+{
+    StringBuilder pattern;
+    pattern << "\"" << name << "\":";
+
+    Int total = 0;
+    for (Index index = trace.indexOf(pattern.getUnownedSlice()); index >= 0; )
+    {
+        Index pos = index + pattern.getLength();
+        total += StringUtil::parseIntAndAdvancePos(trace, pos);
+
+        const Index next = trace.tail(pos).indexOf(pattern.getUnownedSlice());
+        index = next >= 0 ? pos + next : -1;
+    }
+    return total;
+}
+
+    /// Compile `source`. The request is returned in `outRequest` (if set) rather than destroyed, so its
+    /// linkage outlives the compilation. `outSharedHitCount` is set to the number of type checking results
+    /// that were found in the cache shared by the session.
+static SlangResult _compile(SlangSession* session, const char* source, String& outCode, Int* outSharedHitCount = nullptr, SlangCompileRequest** outRequest = nullptr)
+{
+    auto request = spCreateCompileRequest(session);
+    spSetCompileTraceEnabled(request, true);
+
+    spAddCodeGenTarget(request, SLANG_HLSL);
+    int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "cacheUnit");
+    spAddTranslationUnitSourceString(request, translationUnitIndex, "cacheFile", source);
+    spAddEntryPoint(request, translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    SlangResult res = spCompile(request);
+    if (SLANG_SUCCEEDED(res))
+    {
+        outCode = spGetEntryPointSource(request, 0);
+    }
+
+    if (outSharedHitCount)
+    {
+        ComPtr<ISlangBlob> trace;
+        *outSharedHitCount = SLANG_SUCCEEDED(spGetCompileTrace(request, trace.writeRef())) ?
+            _sumTraceArg(StringUtil::getSlice(trace), toSlice("sharedTypeCheckingCacheHits")) : 0;
+    }
+
+    if (outRequest)
+    {
+        *outRequest = request;
+    }
+    else
+    {
+        spDestroyCompileRequest(request);
+    }
+    return res;
+}
+
+// Test that compilations on the same global session, which share the stdlib part of the type
+// checking cache, still check operators and conversions correctly.
+SLANG_UNIT_TEST(sharedTypeCheckingCache)
+{
+    const char* source = R"(
+        [shader("compute")]
+        [numthreads(4,1,1)]
+        void computeMain(
+            uint3 sv_dispatchThreadID : SV_DispatchThreadID,
+            uniform RWStructuredBuffer<float> buffer)
+        {
+            int i = int(sv_dispatchThreadID.x);
+            float f = i * 2 + 0.5f;
+            uint u = sv_dispatchThreadID.y - 1;
+            buffer[sv_dispatchThreadID.x] = f + u + float(i << 1);
+        })";
+
+    // Something that needs to fail for the same reason with or without the cache
+    const char* badSource = R"(
+        struct Thing { int a; };
+        [shader("compute")]
+        [numthreads(4,1,1)]
+        void computeMain(uniform RWStructuredBuffer<int> buffer)
+        {
+            Thing t;
+            buffer[0] = t + 1;
+        })";
+
+    auto session = spCreateSession();
+
+    // The request isn't destroyed until the end, so what it shares must be shared once it has been checked
+    String firstCode;
+    SlangCompileRequest* firstRequest = nullptr;
+    SLANG_CHECK(SLANG_SUCCEEDED(_compile(session, source, firstCode, nullptr, &firstRequest)));
+    String badCode;
+    SLANG_CHECK(SLANG_FAILED(_compile(session, badSource, badCode)));
+
+    // Later compilations should use the entries from the earlier ones, and produce the same output
+    for (int i = 0; i < 2; ++i)
+    {
+        String code;
+        Int sharedHitCount = 0;
+        SLANG_CHECK(SLANG_SUCCEEDED(_compile(session, source, code, &sharedHitCount)));
+        SLANG_CHECK(code == firstCode);
+        SLANG_CHECK(sharedHitCount > 0);
+        SLANG_CHECK(SLANG_FAILED(_compile(session, badSource, badCode)));
+    }
+
+    spDestroyCompileRequest(firstRequest);
+    spDestroySession(session);
+}
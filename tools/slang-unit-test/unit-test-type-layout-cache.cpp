@@ -0,0 +1,78 @@
+// unit-test-type-layout-cache.cpp
+
+#include "../../slang.h"
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "../../slang-com-ptr.h"
+#include "../../source/core/slang-blob.h"
+
+using namespace Slang;
+
+// Test that the layout of a type used in several places is computed once and shared.
+SLANG_UNIT_TEST(typeLayoutCache)
+{
+    const char* source = R"(
+        struct Inner
+        {
+            float4 a;
+            float b;
+        };
+
+        struct Outer
+        {
+            Inner x;
+            float c;
+            Inner z;
+        };
+
+        ConstantBuffer<Outer> gOuter;
+        ConstantBuffer<Inner> gInner;
+
+        [shader("compute")]
+        [numthreads(1,1,1)]
+        void computeMain(uniform RWStructuredBuffer<float> buffer)
+        {
+            buffer[0] = gOuter.x.b + gOuter.z.b + gInner.b;
+        })";
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef())));
+
+    slang::TargetDesc targetDesc;
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::SessionDesc sessionDesc;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.targetCount = 1;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(globalSession->createSession(sessionDesc, session.writeRef())));
+
+    ComPtr<ISlangBlob> sourceBlob = StringBlob::create(String(source));
+    slang::IModule* module = session->loadModuleFromSource("typeLayoutCacheTest", "type-layout-cache-test.slang", sourceBlob);
+    SLANG_CHECK_ABORT(module);
+
+    slang::ProgramLayout* layout = module->getLayout();
+    SLANG_CHECK_ABORT(layout && layout->getParameterCount() == 2);
+
+    auto outerTypeLayout = layout->getParameterByIndex(0)->getTypeLayout()->getElementVarLayout()->getTypeLayout();
+    auto innerTypeLayout = layout->getParameterByIndex(1)->getTypeLayout()->getElementVarLayout()->getTypeLayout();
+    SLANG_CHECK_ABORT(outerTypeLayout && outerTypeLayout->getFieldCount() == 3);
+    SLANG_CHECK_ABORT(innerTypeLayout);
+
+    // Both fields of type `Inner`, and the element of `gInner`, share a layout
+    auto xTypeLayout = outerTypeLayout->getFieldByIndex(0)->getTypeLayout();
+    auto zTypeLayout = outerTypeLayout->getFieldByIndex(2)->getTypeLayout();
+    SLANG_CHECK(xTypeLayout == zTypeLayout);
+    SLANG_CHECK(xTypeLayout == innerTypeLayout);
+
+    // The fields are still at different offsets
+    SLANG_CHECK(outerTypeLayout->getFieldByIndex(0)->getOffset() == 0);
+    SLANG_CHECK(outerTypeLayout->getFieldByIndex(2)->getOffset() != 0);
+
+    // As does a layout requested through reflection
+    auto innerType = layout->findTypeByName("Inner");
+    SLANG_CHECK_ABORT(innerType);
+    SLANG_CHECK(layout->getTypeLayout(innerType) == innerTypeLayout);
+}
@@ -0,0 +1,77 @@
+// unit-test-unique-types.cpp
+
+#include "../../slang.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "tools/unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test that types that are structurally equal are the same type object, however they are arrived at.
+// The reflection API returns the checked types directly, so pointer equality of the reflected types
+// is pointer equality of the types.
+SLANG_UNIT_TEST(uniqueTypes)
+{
+    const char* testSource =
+        "struct First {"
+        "   unorm float a;"
+        "   unorm float b;"
+        "   snorm float c;"
+        "   Sampler2D<float4> d;"
+        "};"
+        "struct Second {"
+        "   unorm float a;"
+        "   Sampler2D<float4> d;"
+        "};"
+        "struct Box<T> {"
+        "   T value;"
+        "};";
+    auto session = spCreateSession();
+    auto request = spCreateCompileRequest(session);
+    spAddCodeGenTarget(request, SLANG_DXBC);
+    int tuIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "tu1");
+    spAddTranslationUnitSourceString(request, tuIndex, "internalFile", testSource);
+    spCompile(request);
+
+    auto testBody = [&]()
+    {
+        auto reflection = slang::ShaderReflection::get(request);
+
+        auto first = reflection->findTypeByName("First");
+        auto second = reflection->findTypeByName("Second");
+        SLANG_CHECK_ABORT(first && first->getFieldCount() == 4);
+        SLANG_CHECK_ABORT(second && second->getFieldCount() == 2);
+
+        // Modified types with the same base and modifiers are the same type, in the same or different declarations
+        auto unormType = first->getFieldByIndex(0)->getType();
+        SLANG_CHECK(unormType != nullptr);
+        SLANG_CHECK(first->getFieldByIndex(1)->getType() == unormType);
+        SLANG_CHECK(second->getFieldByIndex(0)->getType() == unormType);
+
+        // ... and differ if the modifiers do
+        SLANG_CHECK(first->getFieldByIndex(2)->getType() != unormType);
+
+        // Texture-sampler types are the same type wherever they are declared, and with or without the default argument
+        auto samplerType = first->getFieldByIndex(3)->getType();
+        SLANG_CHECK(samplerType != nullptr);
+        SLANG_CHECK(second->getFieldByIndex(1)->getType() == samplerType);
+        SLANG_CHECK(reflection->findTypeByName("Sampler2D") == samplerType);
+
+        // Types looked up by name are checked again for each distinct string, and substituting
+        // a modified type into a generic gives the same type as the one written directly
+        auto boxType = reflection->findTypeByName("Box<unorm float>");
+        SLANG_CHECK_ABORT(boxType && boxType->getFieldCount() == 1);
+        SLANG_CHECK(reflection->findTypeByName("Box< unorm  float >") == boxType);
+
+        auto boxLayout = reflection->getTypeLayout(boxType);
+        SLANG_CHECK_ABORT(boxLayout && boxLayout->getFieldCount() == 1);
+        SLANG_CHECK(boxLayout->getFieldByIndex(0)->getTypeLayout()->getType() == unormType);
+    };
+
+    testBody();
+
+    spDestroyCompileRequest(request);
+    spDestroySession(session);
+}